@@ -101,6 +101,26 @@ struct adc_emul_data {
 	/** Stack for acquisition thread */
 	K_KERNEL_STACK_MEMBER(stack,
 			CONFIG_ADC_EMUL_ACQUISITION_THREAD_STACK_SIZE);
+#ifdef CONFIG_ADC_STREAM
+	/** Pending stream reads */
+	struct rtio_iodev_queue stream_q;
+	/** Protects starting and stopping the stream */
+	struct k_spinlock stream_lock;
+	/** Configuration of the running stream, NULL when stopped */
+	const struct adc_stream_config *stream_cfg;
+	/** Read being filled, NULL if none was pending */
+	struct rtio_iodev_sqe *stream_curr;
+	/** Buffer of the read being filled, NULL if none could be allocated */
+	uint8_t *stream_buf;
+	/** Time of the first sampling into the buffer being filled */
+	uint64_t stream_timestamp_ns;
+	/** Samplings lost since the last buffer was completed */
+	uint32_t stream_dropped;
+	/** Expires each time a buffer worth of samplings was taken */
+	struct k_timer stream_timer;
+	/** Fills and completes the buffer, outside of interrupt context */
+	struct k_work stream_work;
+#endif /* CONFIG_ADC_STREAM */
 };
 
 int adc_emul_const_value_set(const struct device *dev, unsigned int chan,
@@ -393,6 +413,7 @@ static void adc_context_update_buffer_pointer(struct adc_context *ctx,
  *
  * @param data Internal data of ADC emulator
  * @param chan ADC channel to sample
+ * @param res_mask Mask created from the requested resolution
  * @param result Raw output value
  *
  * @return 0 on success
@@ -401,7 +422,7 @@ static void adc_context_update_buffer_pointer(struct adc_context *ctx,
  * @return other error code returned by custom function
  */
 static int adc_emul_get_chan_value(struct adc_emul_data *data,
-				   unsigned int chan,
+				   unsigned int chan, uint16_t res_mask,
 				   adc_emul_res_t *result)
 {
 	struct adc_emul_chan_cfg *chan_cfg = &data->chan_cfg[chan];
@@ -444,11 +465,11 @@ static int adc_emul_get_chan_value(struct adc_emul_data *data,
 	}
 
 	/* Calculate output value */
-	temp = (uint64_t)input_mV * data->res_mask / ref_v;
+	temp = (uint64_t)input_mV * res_mask / ref_v;
 
 	/* If output value is greater than resolution, it has to be trimmed */
-	if (temp > data->res_mask) {
-		temp = data->res_mask;
+	if (temp > res_mask) {
+		temp = res_mask;
 	}
 
 	*result = temp;
@@ -489,7 +510,8 @@ static void adc_emul_acquisition_thread(void *p1, void *p2, void *p3)
 
 			LOG_DBG("reading channel %d", chan);
 
-			err = adc_emul_get_chan_value(data, chan, &result);
+			err = adc_emul_get_chan_value(data, chan, data->res_mask,
+						      &result);
 			if (err) {
 				adc_context_complete(&data->ctx, err);
 				break;
@@ -507,6 +529,240 @@ static void adc_emul_acquisition_thread(void *p1, void *p2, void *p3)
 	}
 }
 
+#ifdef CONFIG_ADC_STREAM
+/**
+ * @brief Arm the next stream read, called with the stream lock held
+ *
+ * Stops the stream if no read is pending. The buffer is taken right away, as
+ * a DMA transfer would be set up, if the mempool is out of blocks the
+ * samplings taken until the next buffer is due are lost.
+ *
+ * @param data Internal data of ADC emulator
+ */
+static void adc_emul_stream_arm(struct adc_emul_data *data)
+{
+	const struct adc_stream_config *cfg = data->stream_cfg;
+	uint32_t size = adc_stream_buffer_size(cfg);
+	uint32_t min_len = size;
+	uint32_t buf_len;
+
+	if (data->stream_curr == NULL) {
+		data->stream_curr = rtio_iodev_queue_pop(&data->stream_q);
+	}
+
+	if (data->stream_curr == NULL) {
+		k_timer_stop(&data->stream_timer);
+		(void)k_work_cancel(&data->stream_work);
+		data->stream_cfg = NULL;
+		return;
+	}
+
+	if (FIELD_GET(RTIO_SQE_MEMPOOL_BUFFER, data->stream_curr->sqe.flags)) {
+		min_len = MAX(size, rtio_mempool_block_size(data->stream_curr->r));
+	}
+
+	if (rtio_sqe_rx_buf(data->stream_curr, min_len, min_len, &data->stream_buf,
+			    &buf_len) != 0) {
+		data->stream_buf = NULL;
+	}
+}
+
+/**
+ * @brief Fill the header and samples of a stream buffer
+ *
+ * @param data Internal data of ADC emulator
+ * @param cfg Configuration of the stream
+ * @param buf Buffer to fill
+ *
+ * @return 0 on success
+ * @return other error code returned by adc_emul_get_chan_value
+ */
+static int adc_emul_stream_fill(struct adc_emul_data *data,
+				const struct adc_stream_config *cfg,
+				uint8_t *buf)
+{
+	struct adc_stream_header *hdr = (struct adc_stream_header *)buf;
+	uint16_t res_mask = BIT_MASK(cfg->resolution);
+	uint16_t *sample = hdr->samples;
+	int err;
+
+	hdr->timestamp_ns = data->stream_timestamp_ns;
+	hdr->interval_ns = (uint64_t)cfg->interval_us * NSEC_PER_USEC;
+	hdr->channels = cfg->channels;
+	hdr->samplings = cfg->samplings;
+	hdr->dropped = MIN(data->stream_dropped, UINT16_MAX);
+
+	for (uint16_t i = 0; i < cfg->samplings; i++) {
+		uint32_t channels = cfg->channels;
+
+		while (channels) {
+			unsigned int chan = find_lsb_set(channels) - 1;
+			uint32_t sum = 0;
+
+			/* Each sample is averaged from 2^oversampling conversions */
+			for (uint32_t n = 0; n < BIT(cfg->oversampling); n++) {
+				adc_emul_res_t value;
+
+				err = adc_emul_get_chan_value(data, chan, res_mask,
+							      &value);
+				if (err) {
+					return err;
+				}
+
+				sum += value;
+			}
+
+			*sample++ = sum >> cfg->oversampling;
+			WRITE_BIT(channels, chan, 0);
+		}
+	}
+
+	data->stream_dropped = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Complete the buffer of samplings taken over the last period and
+ *        arm the next one.
+ *
+ * Values are obtained once the whole buffer was sampled, as a DMA transfer
+ * would complete, so the value functions are called from thread context.
+ *
+ * @param work Stream work item of the ADC emulator
+ */
+static void adc_emul_stream_work(struct k_work *work)
+{
+	struct adc_emul_data *data = CONTAINER_OF(work, struct adc_emul_data,
+						  stream_work);
+	const struct adc_stream_config *cfg = data->stream_cfg;
+	struct rtio_iodev_sqe *done = NULL;
+	int err = 0;
+
+	if (cfg == NULL) {
+		return;
+	}
+
+	if (data->stream_buf != NULL) {
+		err = adc_emul_stream_fill(data, cfg, data->stream_buf);
+		done = data->stream_curr;
+		data->stream_curr = NULL;
+		data->stream_buf = NULL;
+	} else {
+		data->stream_dropped += cfg->samplings;
+	}
+
+	data->stream_timestamp_ns += (uint64_t)cfg->samplings *
+				     cfg->interval_us * NSEC_PER_USEC;
+
+	/* A multishot read is queued again while it completes */
+	if (done != NULL) {
+		if (err) {
+			rtio_iodev_sqe_err(done, err);
+		} else {
+			rtio_iodev_sqe_ok(done, 0);
+		}
+	}
+
+	K_SPINLOCK(&data->stream_lock) {
+		adc_emul_stream_arm(data);
+	}
+}
+
+static void adc_emul_stream_timer_expiry(struct k_timer *timer)
+{
+	struct adc_emul_data *data = CONTAINER_OF(timer, struct adc_emul_data,
+						  stream_timer);
+
+	k_work_submit(&data->stream_work);
+}
+
+static int adc_emul_stream_check(const struct device *dev,
+				 const struct adc_stream_config *cfg)
+{
+	const struct adc_emul_config *config = dev->config;
+
+	if (cfg->resolution > ADC_EMUL_MAX_RESOLUTION ||
+	    cfg->resolution == 0) {
+		LOG_ERR("unsupported resolution %d", cfg->resolution);
+		return -ENOTSUP;
+	}
+
+	if (cfg->channels == 0 ||
+	    find_msb_set(cfg->channels) > config->num_channels) {
+		LOG_ERR("unsupported channels in mask: 0x%08x", cfg->channels);
+		return -ENOTSUP;
+	}
+
+	/* The sum of the oversampled conversions must fit in 32 bits */
+	if (cfg->oversampling > ADC_EMUL_MAX_RESOLUTION) {
+		LOG_ERR("unsupported oversampling %d", cfg->oversampling);
+		return -ENOTSUP;
+	}
+
+	if (cfg->interval_us == 0 || cfg->samplings == 0) {
+		LOG_ERR("stream needs an interval and samplings");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void adc_emul_submit(const struct device *dev,
+			    struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct adc_stream_config *cfg = iodev_sqe->sqe.iodev->data;
+	struct adc_emul_data *data = dev->data;
+	k_timeout_t period;
+	int err;
+
+	if (iodev_sqe->sqe.op != RTIO_OP_RX) {
+		rtio_iodev_sqe_err(iodev_sqe, -EINVAL);
+		return;
+	}
+
+	err = adc_emul_stream_check(dev, cfg);
+	if (err) {
+		rtio_iodev_sqe_err(iodev_sqe, err);
+		return;
+	}
+
+	if (!FIELD_GET(RTIO_SQE_MEMPOOL_BUFFER, iodev_sqe->sqe.flags) &&
+	    iodev_sqe->sqe.buf_len < adc_stream_buffer_size(cfg)) {
+		LOG_ERR("buffer size too small");
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	K_SPINLOCK(&data->stream_lock) {
+		if (data->stream_cfg != NULL && data->stream_cfg != cfg) {
+			err = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+
+		rtio_iodev_queue_push(&data->stream_q, iodev_sqe);
+
+		if (data->stream_cfg != NULL) {
+			/* Armed once the buffer being filled is done */
+			K_SPINLOCK_BREAK;
+		}
+
+		data->stream_cfg = cfg;
+		data->stream_dropped = 0;
+		data->stream_timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+		adc_emul_stream_arm(data);
+
+		period = K_USEC((uint64_t)cfg->samplings * cfg->interval_us);
+		k_timer_start(&data->stream_timer, period, period);
+	}
+
+	if (err) {
+		LOG_ERR("another stream is running");
+		rtio_iodev_sqe_err(iodev_sqe, err);
+	}
+}
+#endif /* CONFIG_ADC_STREAM */
+
 /**
  * @brief Function called on init for each ADC emulator device. It setups all
  *        channels to return constant 0 mV and create acquisition thread.
@@ -542,6 +798,12 @@ static int adc_emul_init(const struct device *dev)
 			CONFIG_ADC_EMUL_ACQUISITION_THREAD_PRIO,
 			0, K_NO_WAIT);
 
+#ifdef CONFIG_ADC_STREAM
+	rtio_iodev_queue_init(&data->stream_q);
+	k_timer_init(&data->stream_timer, adc_emul_stream_timer_expiry, NULL);
+	k_work_init(&data->stream_work, adc_emul_stream_work);
+#endif /* CONFIG_ADC_STREAM */
+
 	adc_context_unlock_unconditionally(&data->ctx);
 
 	return 0;
@@ -554,6 +816,8 @@ static int adc_emul_init(const struct device *dev)
 		.ref_internal = DT_INST_PROP(_num, ref_internal_mv),	\
 		IF_ENABLED(CONFIG_ADC_ASYNC,				\
 			(.read_async = adc_emul_read_async,))		\
+		IF_ENABLED(CONFIG_ADC_STREAM,				\
+			(.submit = adc_emul_submit,))			\
 	};								\
 									\
 	static struct adc_emul_chan_cfg					\
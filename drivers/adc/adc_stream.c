@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/adc.h>
+#include <zephyr/rtio/rtio.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(adc_stream, CONFIG_ADC_LOG_LEVEL);
+
+static void adc_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct adc_stream_config *config = iodev_sqe->sqe.iodev->data;
+	const struct adc_driver_api *api = config->dev->api;
+
+	if (api->submit == NULL) {
+		LOG_ERR("%s does not support streaming", config->dev->name);
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+		return;
+	}
+
+	api->submit(config->dev, iodev_sqe);
+}
+
+const struct rtio_iodev_api __adc_iodev_api = {
+	.submit = adc_iodev_submit,
+};
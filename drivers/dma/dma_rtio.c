@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/rtio.h>
+#include <zephyr/rtio/rtio.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(dma_rtio, CONFIG_DMA_LOG_LEVEL);
+
+static void dma_rtio_start_next(struct dma_rtio_data *data, bool completion);
+
+/* Describe one submission as a block, returns its direction or a negative errno */
+static int dma_rtio_block_init(struct dma_rtio_data *data, struct rtio_iodev_sqe *iodev_sqe,
+			       struct dma_block_config *block)
+{
+	struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+	uint32_t len;
+	int rc;
+
+	*block = (struct dma_block_config){0};
+
+	switch (sqe->op) {
+	case RTIO_OP_TXRX:
+		block->source_address = (uintptr_t)sqe->tx_buf;
+		block->dest_address = (uintptr_t)sqe->rx_buf;
+		block->block_size = sqe->txrx_buf_len;
+		return MEMORY_TO_MEMORY;
+	case RTIO_OP_TX:
+		block->source_address = (uintptr_t)sqe->buf;
+		block->dest_address = data->periph_addr;
+		block->dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+		block->block_size = sqe->buf_len;
+		return MEMORY_TO_PERIPHERAL;
+	case RTIO_OP_TINY_TX:
+		block->source_address = (uintptr_t)sqe->tiny_buf;
+		block->dest_address = data->periph_addr;
+		block->dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+		block->block_size = sqe->tiny_buf_len;
+		return MEMORY_TO_PERIPHERAL;
+	case RTIO_OP_RX:
+		/* Reads into the mempool fill one block */
+		len = (sqe->buf_len != 0) ? sqe->buf_len : rtio_mempool_block_size(iodev_sqe->r);
+		rc = rtio_sqe_rx_buf(iodev_sqe, len, len, &buf, &buf_len);
+		if (rc != 0) {
+			return rc;
+		}
+
+		block->source_address = data->periph_addr;
+		block->source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+		block->dest_address = (uintptr_t)buf;
+		block->block_size = buf_len;
+		return PERIPHERAL_TO_MEMORY;
+	default:
+		LOG_ERR("Unsupported op %u", sqe->op);
+		return -ENOTSUP;
+	}
+}
+
+static void dma_rtio_callback(const struct device *dev, void *user_data, uint32_t channel,
+			      int status)
+{
+	struct dma_rtio_data *data = user_data;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(channel);
+
+	if (status == DMA_STATUS_BLOCK) {
+		return;
+	}
+
+	if (status < 0) {
+		rtio_iodev_sqe_err(data->txn_head, status);
+	} else {
+		rtio_iodev_sqe_ok(data->txn_head, 0);
+	}
+
+	dma_rtio_start_next(data, true);
+}
+
+/* Turn the current transaction into one scatter-gather transfer */
+static int dma_rtio_start(struct dma_rtio_data *data)
+{
+	struct rtio_iodev_sqe *curr = data->txn_head;
+	struct dma_config cfg = data->cfg;
+	uint32_t count = 0;
+	int direction = -1;
+	int rc;
+
+	do {
+		if (count == ARRAY_SIZE(data->blocks)) {
+			LOG_ERR("Transaction exceeds %u blocks", CONFIG_DMA_RTIO_MAX_BLOCKS);
+			return -ENOMEM;
+		}
+
+		rc = dma_rtio_block_init(data, curr, &data->blocks[count]);
+		if (rc < 0) {
+			return rc;
+		}
+
+		if (direction >= 0 && rc != direction) {
+			LOG_ERR("Transaction mixes transfer directions");
+			return -EINVAL;
+		}
+		direction = rc;
+
+		if (count > 0) {
+			data->blocks[count - 1].next_block = &data->blocks[count];
+		}
+		count++;
+
+		curr = rtio_txn_next(curr);
+	} while (curr != NULL);
+
+	cfg.channel_direction = direction;
+	cfg.complete_callback_en = 0;
+	cfg.error_callback_dis = 0;
+	cfg.block_count = count;
+	cfg.head_block = &data->blocks[0];
+	cfg.user_data = data;
+	cfg.dma_callback = dma_rtio_callback;
+
+	rc = dma_config(data->dev, data->channel, &cfg);
+	if (rc != 0) {
+		return rc;
+	}
+
+	return dma_start(data->dev, data->channel);
+}
+
+static void dma_rtio_start_next(struct dma_rtio_data *data, bool completion)
+{
+	struct rtio_iodev_sqe *next;
+	int rc;
+
+	do {
+		K_SPINLOCK(&data->lock) {
+			/* Already working on something */
+			if (!completion && data->txn_head != NULL) {
+				next = NULL;
+				K_SPINLOCK_BREAK;
+			}
+
+			next = rtio_iodev_queue_pop(&data->io_q);
+			data->txn_head = next;
+		}
+
+		if (next == NULL) {
+			return;
+		}
+
+		rc = dma_rtio_start(data);
+		if (rc != 0) {
+			rtio_iodev_sqe_err(data->txn_head, rc);
+			completion = true;
+		}
+	} while (rc != 0);
+}
+
+static void dma_rtio_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct dma_rtio_data *data = iodev_sqe->sqe.iodev->data;
+
+	rtio_iodev_queue_push(&data->io_q, iodev_sqe);
+	dma_rtio_start_next(data, false);
+}
+
+const struct rtio_iodev_api dma_iodev_api = {
+	.submit = dma_rtio_submit,
+};
@@ -219,30 +219,25 @@ static struct net_pkt *prepare_pkt(struct eth_context *ctx,
 	return pkt;
 }
 
-static int read_data(struct eth_context *ctx, int fd)
+static struct net_pkt *read_data(struct eth_context *ctx, int fd)
 {
-	struct net_if *iface = ctx->iface;
 	struct net_pkt *pkt = NULL;
 	int status;
 	int count;
 
 	count = nsi_host_read(fd, ctx->recv, sizeof(ctx->recv));
 	if (count <= 0) {
-		return 0;
+		return NULL;
 	}
 
 	pkt = prepare_pkt(ctx, count, &status);
 	if (!pkt) {
-		return status;
+		return NULL;
 	}
 
-	update_gptp(iface, pkt, false);
-
-	if (net_recv_data(iface, pkt) < 0) {
-		net_pkt_unref(pkt);
-	}
+	update_gptp(ctx->iface, pkt, false);
 
-	return 0;
+	return pkt;
 }
 
 static void eth_rx(void *p1, void *p2, void *p3)
@@ -251,14 +246,32 @@ static void eth_rx(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p3);
 
 	struct eth_context *ctx = p1;
+	struct net_pkt *pkts[CONFIG_ETH_NATIVE_POSIX_RX_BATCH];
+	int count;
+
 	LOG_DBG("Starting ZETH RX thread");
 
 	while (1) {
 		if (net_if_is_up(ctx->iface)) {
-			while (!eth_wait_data(ctx->dev_fd)) {
-				read_data(ctx, ctx->dev_fd);
+			do {
+				/* Drain up to a batch of pending frames */
+				for (count = 0; count < (int)ARRAY_SIZE(pkts) &&
+						!eth_wait_data(ctx->dev_fd);) {
+					pkts[count] = read_data(ctx, ctx->dev_fd);
+					if (pkts[count]) {
+						count++;
+					}
+				}
+
+				if (count > 0 &&
+				    net_recv_data_batch(ctx->iface, pkts, count) < 0) {
+					for (int i = 0; i < count; i++) {
+						net_pkt_unref(pkts[i]);
+					}
+				}
+
 				k_yield();
-			}
+			} while (count == (int)ARRAY_SIZE(pkts));
 		}
 
 		k_sleep(K_MSEC(CONFIG_ETH_NATIVE_POSIX_RX_TIMEOUT));
@@ -40,6 +40,8 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #define RESET_TIMEOUT     10
 #define PHY_RESET_TIMEOUT K_MSEC(100)
 #define REG_WRITE_TIMEOUT 50
+/* Delay before polling again once out of RX buffers */
+#define RX_RETRY_DELAY    K_MSEC(10)
 
 /* Controller has only one PHY with address 1 */
 #define PHY_ADDR 1
@@ -50,6 +52,11 @@ struct eth_context {
 #if defined(CONFIG_NET_STATISTICS_ETHERNET)
 	struct net_stats_eth stats;
 #endif
+#if defined(CONFIG_NET_RX_POLL)
+	struct net_rx_poll rx_poll;
+	struct k_work_delayable rx_retry;
+	bool rx_starved;
+#endif
 };
 
 /* SMSC911x helper functions */
@@ -428,6 +435,13 @@ static struct net_stats_eth *get_stats(const struct device *dev)
 }
 #endif
 
+#if defined(CONFIG_NET_RX_POLL)
+static int smsc_rx_poll(struct net_rx_poll *poll, struct net_pkt **pkts,
+			int budget);
+static void smsc_rx_poll_done(struct net_rx_poll *poll);
+static void smsc_rx_retry(struct k_work *work);
+#endif
+
 static void eth_initialize(struct net_if *iface)
 {
 	const struct device *dev = net_if_get_device(iface);
@@ -437,6 +451,12 @@ static void eth_initialize(struct net_if *iface)
 
 	smsc_read_mac_address(context->mac);
 
+#if defined(CONFIG_NET_RX_POLL)
+	net_rx_poll_init(&context->rx_poll, iface, smsc_rx_poll,
+			 smsc_rx_poll_done);
+	k_work_init_delayable(&context->rx_retry, smsc_rx_retry);
+#endif
+
 	SMSC9220->INT_EN |= BIT(SMSC9220_INTERRUPT_RXSTATUS_FIFO_LEVEL);
 
 	net_if_set_link_addr(iface, context->mac, sizeof(context->mac),
@@ -594,6 +614,85 @@ static struct net_pkt *smsc_recv_pkt(const struct device *dev,
 	return pkt;
 }
 
+static struct net_pkt *smsc_rx_next_pkt(const struct device *dev)
+{
+	uint32_t pkt_size;
+	uint32_t rx_stat;
+
+	/* Make sure that any previously started discard op is
+	 * finished.
+	 */
+	smsc_wait_discard_pkt();
+
+	rx_stat = SMSC9220->RX_STAT_PORT;
+	pkt_size = BFIELD(rx_stat, RX_STAT_PORT_PKT_LEN);
+	LOG_DBG("pkt sz: %u", pkt_size);
+
+	return smsc_recv_pkt(dev, pkt_size);
+}
+
+#if defined(CONFIG_NET_RX_POLL)
+static int smsc_rx_poll(struct net_rx_poll *poll, struct net_pkt **pkts,
+			int budget)
+{
+	const struct device *dev = net_if_get_device(poll->iface);
+	struct eth_context *context = dev->data;
+	int count = 0;
+
+	while (count < budget && SMSC9220_BFIELD(RX_FIFO_INF, RXSUSED) > 0U) {
+		struct net_pkt *pkt = smsc_rx_next_pkt(dev);
+
+		if (pkt == NULL) {
+			/* Out of buffers, the frame was dropped */
+			context->rx_starved = true;
+			break;
+		}
+
+		pkts[count++] = pkt;
+	}
+
+	return count;
+}
+
+static void smsc_rx_retry(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct eth_context *context = CONTAINER_OF(dwork, struct eth_context,
+						   rx_retry);
+
+	(void)net_rx_poll_schedule(&context->rx_poll);
+}
+
+static void smsc_rx_poll_done(struct net_rx_poll *poll)
+{
+	struct eth_context *context = net_if_get_device(poll->iface)->data;
+	unsigned int key;
+
+	/* Polling again right away would only drop the frames left in the
+	 * FIFO, so leave them there until buffers are freed.
+	 */
+	if (context->rx_starved) {
+		context->rx_starved = false;
+		(void)k_work_schedule(&context->rx_retry, RX_RETRY_DELAY);
+		return;
+	}
+
+	/* Ack and unmask first, so a frame landing after the last
+	 * check below still raises the interrupt.
+	 */
+	key = irq_lock();
+	SMSC9220->INT_STS = BIT(SMSC9220_INTERRUPT_RXSTATUS_FIFO_LEVEL);
+	SMSC9220->INT_EN |= BIT(SMSC9220_INTERRUPT_RXSTATUS_FIFO_LEVEL);
+
+	if (SMSC9220_BFIELD(RX_FIFO_INF, RXSUSED) > 0U) {
+		SMSC9220->INT_EN &= ~BIT(SMSC9220_INTERRUPT_RXSTATUS_FIFO_LEVEL);
+		(void)net_rx_poll_schedule(poll);
+	}
+
+	irq_unlock(key);
+}
+#endif /* CONFIG_NET_RX_POLL */
+
 static void eth_smsc911x_isr(const struct device *dev)
 {
 	uint32_t int_status = SMSC9220->INT_STS;
@@ -602,10 +701,19 @@ static void eth_smsc911x_isr(const struct device *dev)
 	LOG_DBG("%s: INT_STS=%x INT_EN=%x", __func__,
 		int_status, SMSC9220->INT_EN);
 
+#if defined(CONFIG_NET_RX_POLL)
+	/* Leave the RX interrupt masked and pending until the poll loop
+	 * has drained the FIFO, see smsc_rx_poll_done().
+	 */
+	if (int_status & BIT(SMSC9220_INTERRUPT_RXSTATUS_FIFO_LEVEL)) {
+		SMSC9220->INT_EN &= ~BIT(SMSC9220_INTERRUPT_RXSTATUS_FIFO_LEVEL);
+		int_status &= ~BIT(SMSC9220_INTERRUPT_RXSTATUS_FIFO_LEVEL);
+		(void)net_rx_poll_schedule(&context->rx_poll);
+	}
+#else
 	if (int_status & BIT(SMSC9220_INTERRUPT_RXSTATUS_FIFO_LEVEL)) {
 		struct net_pkt *pkt;
-		uint32_t pkt_size, val;
-		uint32_t rx_stat;
+		uint32_t val;
 
 		val = SMSC9220->RX_FIFO_INF;
 		uint32_t pkt_pending = BFIELD(val, RX_FIFO_INF_RXSUSED);
@@ -626,16 +734,7 @@ static void eth_smsc911x_isr(const struct device *dev)
 
 		int_status &= ~BIT(SMSC9220_INTERRUPT_RXSTATUS_FIFO_LEVEL);
 
-		/* Make sure that any previously started discard op is
-		 * finished.
-		 */
-		smsc_wait_discard_pkt();
-
-		rx_stat = SMSC9220->RX_STAT_PORT;
-		pkt_size = BFIELD(rx_stat, RX_STAT_PORT_PKT_LEN);
-		LOG_DBG("pkt sz: %u", pkt_size);
-
-		pkt = smsc_recv_pkt(dev, pkt_size);
+		pkt = smsc_rx_next_pkt(dev);
 
 		LOG_DBG("out RX FIFO: pkts: %u, bytes: %u",
 			SMSC9220_BFIELD(RX_FIFO_INF, RXSUSED),
@@ -652,6 +751,7 @@ static void eth_smsc911x_isr(const struct device *dev)
 	}
 
 done:
+#endif /* CONFIG_NET_RX_POLL */
 	/* Ack pending interrupts */
 	SMSC9220->INT_STS = int_status;
 
@@ -19,6 +19,8 @@ LOG_MODULE_REGISTER(i2c_emul_ctlr);
 #include <zephyr/drivers/emul.h>
 #include <zephyr/drivers/i2c.h>
 #include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/drivers/i2c/rtio.h>
+#include <zephyr/rtio/rtio.h>
 
 #include "i2c-priv.h"
 
@@ -29,6 +31,15 @@ struct i2c_emul_data {
 	/* I2C host configuration */
 	uint32_t config;
 	uint32_t bitrate;
+#ifdef CONFIG_I2C_RTIO
+	/* Schedules the RTIO transactions on the bus */
+	struct i2c_rtio ctx;
+	/* Result of the transaction in flight */
+	int txn_status;
+	/* Completes the transaction in flight after the latency passed */
+	struct k_timer timer;
+	uint32_t latency_us;
+#endif /* CONFIG_I2C_RTIO */
 };
 
 /**
@@ -100,6 +111,157 @@ static int i2c_emul_transfer(const struct device *dev, struct i2c_msg *msgs, uin
 	return api->transfer(emul->target, msgs, num_msgs, addr);
 }
 
+#ifdef CONFIG_I2C_RTIO
+/**
+ * Pass an RTIO transaction to the emulator as a single transfer
+ *
+ * Each submission of the transaction becomes one I2C message. Configure
+ * and recover requests are handled by the controller itself.
+ */
+static int i2c_emul_iodev_io(const struct device *dev, struct rtio_iodev_sqe *txn_head)
+{
+	const struct i2c_dt_spec *spec = txn_head->sqe.iodev->data;
+	struct i2c_msg msgs[CONFIG_I2C_EMUL_RTIO_MAX_MSGS];
+	uint8_t num_msgs = 0;
+	int ret;
+
+	switch (txn_head->sqe.op) {
+	case RTIO_OP_I2C_CONFIGURE:
+		return i2c_emul_configure(dev, txn_head->sqe.i2c_config);
+	case RTIO_OP_I2C_RECOVER:
+		return 0;
+	default:
+		break;
+	}
+
+	for (struct rtio_iodev_sqe *txn = txn_head; txn != NULL; txn = rtio_txn_next(txn)) {
+		struct rtio_sqe *sqe = &txn->sqe;
+		struct i2c_msg *msg;
+
+		if (num_msgs == ARRAY_SIZE(msgs)) {
+			LOG_ERR("Transaction exceeds %zu submissions", ARRAY_SIZE(msgs));
+			return -ENOMEM;
+		}
+
+		msg = &msgs[num_msgs];
+
+		msg->flags = ((sqe->iodev_flags & RTIO_IODEV_I2C_STOP) ? I2C_MSG_STOP : 0) |
+			     ((sqe->iodev_flags & RTIO_IODEV_I2C_RESTART) ? I2C_MSG_RESTART : 0) |
+			     ((sqe->iodev_flags & RTIO_IODEV_I2C_10_BITS) ?
+				      I2C_MSG_ADDR_10_BITS : 0);
+
+		switch (sqe->op) {
+		case RTIO_OP_RX:
+			ret = rtio_sqe_rx_buf(txn, sqe->buf_len, sqe->buf_len, &msg->buf, &msg->len);
+			if (ret != 0) {
+				return ret;
+			}
+			msg->flags |= I2C_MSG_READ;
+			break;
+		case RTIO_OP_TX:
+			msg->buf = sqe->buf;
+			msg->len = sqe->buf_len;
+			break;
+		case RTIO_OP_TINY_TX:
+			msg->buf = sqe->tiny_buf;
+			msg->len = sqe->tiny_buf_len;
+			break;
+		default:
+			LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+			return -EINVAL;
+		}
+
+		num_msgs++;
+	}
+
+	/* End the transfer with a stop condition, as i2c_transfer() expects */
+	msgs[num_msgs - 1U].flags |= I2C_MSG_STOP;
+
+	return i2c_emul_transfer(dev, msgs, num_msgs, spec->addr);
+}
+
+/**
+ * Report the result of the transaction in flight
+ *
+ * The I2C RTIO context completes transactions a submission at a time, while
+ * the emulator transfers them as a whole.
+ *
+ * @return true if another transaction is to be started
+ */
+static bool i2c_emul_iodev_done(struct i2c_rtio *ctx, int status)
+{
+	bool more;
+
+	do {
+		more = i2c_rtio_complete(ctx, status);
+	} while (more && ctx->txn_curr != ctx->txn_head);
+
+	return more;
+}
+
+/**
+ * Transfer the transactions the I2C RTIO context starts, called by the owner of the bus
+ *
+ * The transactions of a coalesced batch follow each other right away, as on
+ * a controller chaining them, and the latency is spent once at the end. With
+ * no latency transactions are completed right away, so the queue is drained
+ * in a loop rather than through recursion.
+ */
+static void i2c_emul_iodev_run(const struct device *dev)
+{
+	struct i2c_emul_data *data = dev->data;
+	struct i2c_rtio *ctx = &data->ctx;
+	int status;
+
+	do {
+		status = i2c_emul_iodev_io(dev, ctx->txn_head);
+
+		/* Resubmitted multishot requests would complete forever without
+		 * returning, so they always wait for the timer.
+		 */
+		if (!i2c_rtio_txn_batched(ctx) &&
+		    ((data->latency_us > 0U) || (ctx->txn_head->sqe.flags & RTIO_SQE_MULTISHOT))) {
+			data->txn_status = status;
+			k_timer_start(&data->timer, K_USEC(data->latency_us), K_NO_WAIT);
+			return;
+		}
+	} while (i2c_emul_iodev_done(ctx, status));
+}
+
+static void i2c_emul_iodev_timer_expiry(struct k_timer *timer)
+{
+	const struct device *dev = k_timer_user_data_get(timer);
+	struct i2c_emul_data *data = dev->data;
+
+	if (i2c_emul_iodev_done(&data->ctx, data->txn_status)) {
+		i2c_emul_iodev_run(dev);
+	}
+}
+
+static void i2c_emul_iodev_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct i2c_emul_data *data = dev->data;
+
+	if (i2c_rtio_submit(&data->ctx, iodev_sqe)) {
+		i2c_emul_iodev_run(dev);
+	}
+}
+
+void i2c_emul_rtio_latency_set(const struct device *dev, uint32_t latency_us)
+{
+	struct i2c_emul_data *data = dev->data;
+
+	data->latency_us = latency_us;
+}
+
+void i2c_emul_rtio_coalesce_set(const struct device *dev, uint8_t count)
+{
+	struct i2c_emul_data *data = dev->data;
+
+	i2c_rtio_coalesce_set(&data->ctx, count);
+}
+#endif /* CONFIG_I2C_RTIO */
+
 /**
  * Set up a new emulator and add it to the list
  *
@@ -112,6 +274,13 @@ static int i2c_emul_init(const struct device *dev)
 
 	sys_slist_init(&data->emuls);
 
+#ifdef CONFIG_I2C_RTIO
+	i2c_rtio_init(&data->ctx, dev);
+	k_timer_init(&data->timer, i2c_emul_iodev_timer_expiry, NULL);
+	k_timer_user_data_set(&data->timer, (void *)dev);
+	data->latency_us = CONFIG_I2C_EMUL_RTIO_LATENCY_US;
+#endif /* CONFIG_I2C_RTIO */
+
 	rc = emul_init_for_bus(dev);
 
 	/* Set config to an uninitialized state */
@@ -138,6 +307,9 @@ static const struct i2c_driver_api i2c_emul_api = {
 	.configure = i2c_emul_configure,
 	.get_config = i2c_emul_get_config,
 	.transfer = i2c_emul_transfer,
+#ifdef CONFIG_I2C_RTIO
+	.iodev_submit = i2c_emul_iodev_submit,
+#endif /* CONFIG_I2C_RTIO */
 };
 
 #define EMUL_LINK_AND_COMMA(node_id)                                                               \
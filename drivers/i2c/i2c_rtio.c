@@ -55,9 +55,12 @@ struct rtio_sqe *i2c_rtio_copy(struct rtio *r, struct rtio_iodev *iodev, const s
 void i2c_rtio_init(struct i2c_rtio *ctx, const struct device *dev)
 {
 	k_sem_init(&ctx->lock, 1, 1);
-	mpsc_init(&ctx->io_q);
+	rtio_iodev_queue_init(&ctx->io_q);
 	ctx->txn_curr = NULL;
 	ctx->txn_head = NULL;
+	ctx->txn_count = 0;
+	ctx->txn_idx = 0;
+	ctx->coalesce = 1;
 	ctx->dt_spec.bus = dev;
 	ctx->iodev.data = &ctx->dt_spec;
 	ctx->iodev.api = &i2c_iodev_api;
@@ -65,6 +68,36 @@ void i2c_rtio_init(struct i2c_rtio *ctx, const struct device *dev)
 	mpsc_init(&ctx->iodev.iodev_sq);
 }
 
+/**
+ * @private
+ * @brief Take the transactions coalesced with the one just taken from the queue
+ *
+ * Called with the spin lock held.
+ */
+static void i2c_rtio_batch(struct i2c_rtio *ctx, struct rtio_iodev_sqe *head)
+{
+	struct rtio_iodev_sqe *next;
+
+	ctx->txn[0] = head;
+	ctx->txn_count = 1;
+	ctx->txn_idx = 0;
+
+	/* Resubmitted multishot requests would be batched with themselves */
+	if (head->sqe.flags & RTIO_SQE_MULTISHOT) {
+		return;
+	}
+
+	while (ctx->txn_count < ctx->coalesce) {
+		next = rtio_iodev_queue_peek(&ctx->io_q);
+		if (next == NULL || next->sqe.iodev != head->sqe.iodev ||
+		    (next->sqe.flags & RTIO_SQE_MULTISHOT)) {
+			break;
+		}
+
+		ctx->txn[ctx->txn_count++] = rtio_iodev_queue_pop(&ctx->io_q);
+	}
+}
+
 /**
  * @private
  * @brief Setup the next transaction (could be a single op) if needed
@@ -82,17 +115,19 @@ static bool i2c_rtio_next(struct i2c_rtio *ctx, bool completion)
 		return false;
 	}
 
-	struct mpsc_node *next = mpsc_pop(&ctx->io_q);
+	struct rtio_iodev_sqe *next = rtio_iodev_queue_pop(&ctx->io_q);
 
 	/* Nothing left to do */
 	if (next == NULL) {
 		ctx->txn_head = NULL;
 		ctx->txn_curr = NULL;
+		ctx->txn_count = 0;
 		k_spin_unlock(&ctx->slock, key);
 		return false;
 	}
 
-	ctx->txn_head = CONTAINER_OF(next, struct rtio_iodev_sqe, q);
+	i2c_rtio_batch(ctx, next);
+	ctx->txn_head = next;
 	ctx->txn_curr = ctx->txn_head;
 
 	k_spin_unlock(&ctx->slock, key);
@@ -100,12 +135,40 @@ static bool i2c_rtio_next(struct i2c_rtio *ctx, bool completion)
 	return true;
 }
 
+/**
+ * @private
+ * @brief Move on to the next transaction of the batch, or complete the batch
+ *
+ * The current head stays set while completing, so transactions submitted from
+ * the completions are queued rather than started.
+ */
+static bool i2c_rtio_txn_done(struct i2c_rtio *ctx, int status)
+{
+	uint8_t count = ctx->txn_count;
+
+	ctx->txn_status[ctx->txn_idx++] = status;
+	if (ctx->txn_idx < count) {
+		ctx->txn_head = ctx->txn[ctx->txn_idx];
+		ctx->txn_curr = ctx->txn_head;
+		return true;
+	}
+
+	for (uint8_t i = 0; i < count; i++) {
+		if (ctx->txn_status[i] < 0) {
+			rtio_iodev_sqe_err(ctx->txn[i], ctx->txn_status[i]);
+		} else {
+			rtio_iodev_sqe_ok(ctx->txn[i], ctx->txn_status[i]);
+		}
+	}
+
+	return i2c_rtio_next(ctx, true);
+}
+
 bool i2c_rtio_complete(struct i2c_rtio *ctx, int status)
 {
 	/* On error bail */
 	if (status < 0) {
-		rtio_iodev_sqe_err(ctx->txn_head, status);
-		return i2c_rtio_next(ctx, true);
+		return i2c_rtio_txn_done(ctx, status);
 	}
 
 	/* Try for next submission in the transaction */
@@ -114,15 +177,19 @@ bool i2c_rtio_complete(struct i2c_rtio *ctx, int status)
 		return true;
 	}
 
-	rtio_iodev_sqe_ok(ctx->txn_head, status);
-	return i2c_rtio_next(ctx, true);
+	return i2c_rtio_txn_done(ctx, status);
 }
 bool i2c_rtio_submit(struct i2c_rtio *ctx, struct rtio_iodev_sqe *iodev_sqe)
 {
-	mpsc_push(&ctx->io_q, &iodev_sqe->q);
+	rtio_iodev_queue_push(&ctx->io_q, iodev_sqe);
 	return i2c_rtio_next(ctx, false);
 }
 
+void i2c_rtio_coalesce_set(struct i2c_rtio *ctx, uint8_t count)
+{
+	ctx->coalesce = CLAMP(count, 1, CONFIG_I2C_RTIO_COALESCE_MAX);
+}
+
 int i2c_rtio_transfer(struct i2c_rtio *ctx, struct i2c_msg *msgs, uint8_t num_msgs, uint16_t addr)
 {
 	struct rtio_iodev *iodev = &ctx->iodev;
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_SENSOR_DECODE_DSP
+#include <zephyr/dsp/dsp.h>
+#endif
+
+/* Number of frames decoded per call to the decoder by the generic path */
+#define DECODE_CHUNK_FRAMES 16
+
+void sensor_q31_from_s16(const int16_t *in, q31_t *out, size_t count, q31_t scale)
+{
+#ifdef CONFIG_SENSOR_DECODE_DSP
+	/* Widen to q31 (in / 2^15) and let the backend multiply by the scale */
+	for (size_t i = 0; i < count; i++) {
+		out[i] = (q31_t)in[i] << 16;
+	}
+
+	zdsp_scale_q31(out, scale, 0, out, count);
+#else
+	for (size_t i = 0; i < count; i++) {
+		out[i] = (q31_t)(((int64_t)in[i] * scale) >> 15);
+	}
+#endif
+}
+
+static int decode_q31_generic(struct sensor_decode_context *ctx, q31_t *values, int8_t *shift,
+			      uint16_t max_count)
+{
+	const bool three_axis = SENSOR_CHANNEL_3_AXIS(ctx->channel.chan_type);
+	union {
+		struct sensor_three_axis_data three_axis;
+		struct sensor_q31_data q31;
+		uint8_t raw[sizeof(struct sensor_three_axis_data) +
+			    (DECODE_CHUNK_FRAMES - 1) * sizeof(struct sensor_three_axis_sample_data)];
+	} buf;
+	size_t base_size;
+	size_t frame_size;
+	uint16_t count = 0;
+	int rc;
+
+	rc = ctx->decoder->get_size_info(ctx->channel, &base_size, &frame_size);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (base_size != (three_axis ? sizeof(struct sensor_three_axis_data)
+				     : sizeof(struct sensor_q31_data))) {
+		return -ENOTSUP;
+	}
+
+	while (count < max_count) {
+		rc = sensor_decode(ctx, &buf, MIN(max_count - count, DECODE_CHUNK_FRAMES));
+		if (rc <= 0) {
+			break;
+		}
+
+		if (three_axis) {
+			*shift = buf.three_axis.shift;
+			for (int i = 0; i < rc; i++) {
+				values[(count + i) * 3] = buf.three_axis.readings[i].x;
+				values[(count + i) * 3 + 1] = buf.three_axis.readings[i].y;
+				values[(count + i) * 3 + 2] = buf.three_axis.readings[i].z;
+			}
+		} else {
+			*shift = buf.q31.shift;
+			for (int i = 0; i < rc; i++) {
+				values[count + i] = buf.q31.readings[i].value;
+			}
+		}
+
+		count += rc;
+	}
+
+	return (count > 0) ? count : rc;
+}
+
+int sensor_decode_q31(struct sensor_decode_context *ctx, q31_t *values, int8_t *shift,
+		      uint16_t max_count)
+{
+	int rc;
+
+	if (ctx->decoder->decode_q31 != NULL) {
+		rc = ctx->decoder->decode_q31(ctx->buffer, ctx->channel, &ctx->fit, max_count,
+					      shift, values);
+		if (rc != -ENOTSUP) {
+			return rc;
+		}
+	}
+
+	return decode_q31_generic(ctx, values, shift, max_count);
+}
@@ -231,62 +231,67 @@ static inline q31_t icm42688_read_temperature_from_packet(const uint8_t *pkt)
 	return FIELD_PREP(GENMASK(31, 22), whole) | (fraction * GENMASK64(21, 0) / 1000000);
 }
 
-static int icm42688_read_imu_from_packet(const uint8_t *pkt, bool is_accel, int fs,
-					 uint8_t axis_offset, q31_t *out)
+/* Scale applied to 16-bit FIFO readings, a reading of 2^15 decodes to this value */
+static int64_t icm42688_packet_scale(bool is_accel, int fs)
 {
-	int32_t value;
-	int64_t scale = 0;
-	int32_t max = BIT(15);
-	int offset = 1 + (axis_offset * 2);
-
 	if (is_accel) {
 		switch (fs) {
 		case ICM42688_ACCEL_FS_2G:
-			scale = INT64_C(2) * BIT(31 - 5) * 9.80665;
-			break;
+			return INT64_C(2) * BIT(31 - 5) * 9.80665;
 		case ICM42688_ACCEL_FS_4G:
-			scale = INT64_C(4) * BIT(31 - 6) * 9.80665;
-			break;
+			return INT64_C(4) * BIT(31 - 6) * 9.80665;
 		case ICM42688_ACCEL_FS_8G:
-			scale = INT64_C(8) * BIT(31 - 7) * 9.80665;
-			break;
+			return INT64_C(8) * BIT(31 - 7) * 9.80665;
 		case ICM42688_ACCEL_FS_16G:
-			scale = INT64_C(16) * BIT(31 - 8) * 9.80665;
-			break;
-		}
-	} else {
-		switch (fs) {
-		case ICM42688_GYRO_FS_2000:
-			scale = 164;
-			break;
-		case ICM42688_GYRO_FS_1000:
-			scale = 328;
-			break;
-		case ICM42688_GYRO_FS_500:
-			scale = 655;
-			break;
-		case ICM42688_GYRO_FS_250:
-			scale = 1310;
-			break;
-		case ICM42688_GYRO_FS_125:
-			scale = 2620;
-			break;
-		case ICM42688_GYRO_FS_62_5:
-			scale = 5243;
-			break;
-		case ICM42688_GYRO_FS_31_25:
-			scale = 10486;
-			break;
-		case ICM42688_GYRO_FS_15_625:
-			scale = 20972;
-			break;
+			return INT64_C(16) * BIT(31 - 8) * 9.80665;
+		default:
+			return 0;
 		}
 	}
 
+	switch (fs) {
+	case ICM42688_GYRO_FS_2000:
+		return 164;
+	case ICM42688_GYRO_FS_1000:
+		return 328;
+	case ICM42688_GYRO_FS_500:
+		return 655;
+	case ICM42688_GYRO_FS_250:
+		return 1310;
+	case ICM42688_GYRO_FS_125:
+		return 2620;
+	case ICM42688_GYRO_FS_62_5:
+		return 5243;
+	case ICM42688_GYRO_FS_31_25:
+		return 10486;
+	case ICM42688_GYRO_FS_15_625:
+		return 20972;
+	default:
+		return 0;
+	}
+}
+
+/* Offset of the first byte of a 16-bit reading in a FIFO packet */
+static inline int icm42688_packet_offset(const uint8_t *pkt, bool is_accel, uint8_t axis_offset)
+{
+	int offset = 1 + (axis_offset * 2);
+
+	/* Gyro data follows the accel data when both are present */
 	if (!is_accel && FIELD_GET(FIFO_HEADER_ACCEL, pkt[0]) == 1) {
-		offset += 7;
+		offset += 6;
 	}
 
+	return offset;
+}
+
+static int icm42688_read_imu_from_packet(const uint8_t *pkt, bool is_accel, int fs,
+					 uint8_t axis_offset, q31_t *out)
+{
+	int32_t value;
+	int64_t scale = icm42688_packet_scale(is_accel, fs);
+	int32_t max = BIT(15);
+	int offset = icm42688_packet_offset(pkt, is_accel, axis_offset);
+
 	value = (int16_t)sys_le16_to_cpu((pkt[offset] << 8) | pkt[offset + 1]);
 
 	if (FIELD_GET(FIFO_HEADER_20, pkt[0]) == 1) {
@@ -450,6 +455,121 @@ static int icm42688_fifo_decode(const uint8_t *buffer, struct sensor_chan_spec c
 	return count;
 }
 
+/* Number of 16-bit readings converted at once by icm42688_fifo_decode_q31() */
+#define ICM42688_DECODE_Q31_CHUNK 48
+
+static int icm42688_fifo_decode_q31(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
+				    uint32_t *fit, uint16_t max_count, int8_t *shift,
+				    q31_t *values)
+{
+	const struct icm42688_fifo_data *edata = (const struct icm42688_fifo_data *)buffer;
+	const uint8_t *buffer_end = buffer + sizeof(struct icm42688_fifo_data) + edata->fifo_count;
+	const bool is_accel = IS_ACCEL(chan_spec.chan_type);
+	const int fs = is_accel ? edata->header.accel_fs : edata->header.gyro_fs;
+	const q31_t scale = (q31_t)icm42688_packet_scale(is_accel, fs);
+	int16_t raw[ICM42688_DECODE_Q31_CHUNK];
+	uint8_t first_axis;
+	uint8_t num_axes;
+	size_t pending = 0;
+	size_t out = 0;
+	int count = 0;
+	int rc;
+
+	if (!is_accel && !IS_GYRO(chan_spec.chan_type)) {
+		return -ENOTSUP;
+	}
+
+	if ((uintptr_t)buffer_end <= *fit || chan_spec.chan_idx != 0) {
+		return 0;
+	}
+
+	rc = icm42688_get_shift(chan_spec.chan_type, edata->header.accel_fs,
+				edata->header.gyro_fs, shift);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (SENSOR_CHANNEL_3_AXIS(chan_spec.chan_type)) {
+		first_axis = 0;
+		num_axes = 3;
+	} else {
+		first_axis = icm42688_get_channel_position(chan_spec.chan_type) -
+			     (is_accel ? 1 : 4);
+		num_axes = 1;
+	}
+
+	buffer += sizeof(struct icm42688_fifo_data);
+	while (count < max_count && buffer < buffer_end) {
+		const bool is_20b = FIELD_GET(FIFO_HEADER_20, buffer[0]) == 1;
+		const bool has_accel = FIELD_GET(FIFO_HEADER_ACCEL, buffer[0]) == 1;
+		const bool has_gyro = FIELD_GET(FIFO_HEADER_GYRO, buffer[0]) == 1;
+		const uint8_t *frame = buffer;
+		bool valid = true;
+
+		if (is_20b) {
+			buffer += 20;
+		} else if (has_accel && has_gyro) {
+			buffer += 16;
+		} else {
+			buffer += 8;
+		}
+
+		/* Skip frames already decoded and frames without the channel */
+		if ((uintptr_t)frame < *fit || (is_accel ? !has_accel : !has_gyro)) {
+			continue;
+		}
+
+		if (is_20b) {
+			/* High resolution frames are rare, convert them one by one */
+			sensor_q31_from_s16(raw, &values[out], pending, scale);
+			out += pending;
+			pending = 0;
+
+			for (uint8_t axis = 0; axis < num_axes; axis++) {
+				rc = icm42688_read_imu_from_packet(frame, is_accel, fs,
+								   first_axis + axis,
+								   &values[out + axis]);
+				valid = valid && (rc == 0);
+			}
+
+			if (valid) {
+				out += num_axes;
+			}
+		} else {
+			for (uint8_t axis = 0; axis < num_axes; axis++) {
+				int offset = icm42688_packet_offset(frame, is_accel,
+								    first_axis + axis);
+				int16_t value = (int16_t)sys_get_be16(&frame[offset]);
+
+				/* Invalid 16 bit value */
+				valid = valid && (value > -32767);
+				raw[pending + axis] = value;
+			}
+
+			if (valid) {
+				pending += num_axes;
+			}
+		}
+
+		if (!valid) {
+			continue;
+		}
+
+		if (pending > (ARRAY_SIZE(raw) - num_axes)) {
+			sensor_q31_from_s16(raw, &values[out], pending, scale);
+			out += pending;
+			pending = 0;
+		}
+
+		*fit = (uintptr_t)buffer;
+		count++;
+	}
+
+	sensor_q31_from_s16(raw, &values[out], pending, scale);
+
+	return count;
+}
+
 static int icm42688_one_shot_decode(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
 				    uint32_t *fit, uint16_t max_count, void *data_out)
 {
@@ -580,6 +700,19 @@ static int icm42688_decoder_decode(const uint8_t *buffer, struct sensor_chan_spe
 	return icm42688_one_shot_decode(buffer, chan_spec, fit, max_count, data_out);
 }
 
+static int icm42688_decoder_decode_q31(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
+				       uint32_t *fit, uint16_t max_count, int8_t *shift,
+				       q31_t *values)
+{
+	const struct icm42688_decoder_header *header =
+		(const struct icm42688_decoder_header *)buffer;
+
+	if (header->is_fifo) {
+		return icm42688_fifo_decode_q31(buffer, chan_spec, fit, max_count, shift, values);
+	}
+	return -ENOTSUP;
+}
+
 static int icm42688_decoder_get_frame_count(const uint8_t *buffer,
 					    struct sensor_chan_spec chan_spec,
 					    uint16_t *frame_count)
@@ -690,6 +823,7 @@ SENSOR_DECODER_API_DT_DEFINE() = {
 	.get_size_info = icm42688_decoder_get_size_info,
 	.decode = icm42688_decoder_decode,
 	.has_trigger = icm24688_decoder_has_trigger,
+	.decode_q31 = icm42688_decoder_decode_q31,
 };
 
 int icm42688_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder)
@@ -18,8 +18,13 @@ LOG_MODULE_DECLARE(ICM42688, CONFIG_SENSOR_LOG_LEVEL);
 
 #define NUM_REGS (UINT8_MAX >> 1)
 
+/* Size of the hardware FIFO in bytes */
+#define FIFO_SIZE 2048
+
 struct icm42688_emul_data {
 	uint8_t reg[NUM_REGS];
+	uint8_t fifo[FIFO_SIZE];
+	size_t fifo_len;
 };
 
 struct icm42688_emul_cfg {
@@ -42,6 +47,41 @@ void icm42688_emul_get_reg(const struct emul *target, uint8_t reg_addr, uint8_t
 	memcpy(val, data->reg + reg_addr, count);
 }
 
+static void icm42688_emul_fifo_count_update(struct icm42688_emul_data *data)
+{
+	/* The FIFO count is reported big endian by default */
+	data->reg[REG_FIFO_COUNTH] = data->fifo_len >> 8;
+	data->reg[REG_FIFO_COUNTL] = data->fifo_len & 0xff;
+}
+
+int icm42688_emul_fifo_push(const struct emul *target, const uint8_t *frames, size_t len)
+{
+	struct icm42688_emul_data *data = target->data;
+
+	if (len > (FIFO_SIZE - data->fifo_len)) {
+		return -ENOSPC;
+	}
+
+	memcpy(&data->fifo[data->fifo_len], frames, len);
+	data->fifo_len += len;
+	icm42688_emul_fifo_count_update(data);
+
+	return 0;
+}
+
+static void icm42688_emul_fifo_read(struct icm42688_emul_data *data, uint8_t *buf, size_t len)
+{
+	size_t read_len = MIN(len, data->fifo_len);
+
+	memcpy(buf, data->fifo, read_len);
+	/* Reading an empty FIFO returns 0xff */
+	memset(&buf[read_len], 0xff, len - read_len);
+
+	data->fifo_len -= read_len;
+	memmove(data->fifo, &data->fifo[read_len], data->fifo_len);
+	icm42688_emul_fifo_count_update(data);
+}
+
 static void icm42688_emul_handle_write(const struct emul *target, uint8_t regn, uint8_t value)
 {
 	struct icm42688_emul_data *data = target->data;
@@ -51,6 +91,7 @@ static void icm42688_emul_handle_write(const struct emul *target, uint8_t regn,
 		if (FIELD_GET(BIT_SOFT_RESET, value) == 1) {
 			/* Perform a soft reset */
 			memset(data->reg, 0, NUM_REGS);
+			data->fifo_len = 0;
 			/* Initialized the who-am-i register */
 			data->reg[REG_WHO_AM_I] = WHO_AM_I_ICM42688;
 			/* Set the bit for the reset being done */
@@ -86,6 +127,10 @@ static int icm42688_emul_io_spi(const struct emul *target, const struct spi_conf
 		rx = &rx_bufs->buffers[1];
 		__ASSERT_NO_MSG(rx->buf != NULL);
 		__ASSERT_NO_MSG(rx->len > 0);
+		if (regn == REG_FIFO_DATA) {
+			icm42688_emul_fifo_read(data, rx->buf, rx->len);
+			return 0;
+		}
 		for (uint16_t i = 0; i < rx->len; ++i) {
 			((uint8_t *)rx->buf)[i] = data->reg[regn + i];
 		}
@@ -93,11 +138,18 @@ static int icm42688_emul_io_spi(const struct emul *target, const struct spi_conf
 		/* Writing to regn */
 		uint8_t value;
 
-		__ASSERT_NO_MSG(tx_bufs->count > 1);
-		tx = &tx_bufs->buffers[1];
-
-		__ASSERT_NO_MSG(tx->len > 0);
-		value = ((uint8_t *)tx->buf)[0];
+		if (tx->len > 1) {
+			/* Register and value in a single buffer, as written
+			 * by RTIO tiny writes.
+			 */
+			value = ((uint8_t *)tx->buf)[1];
+		} else {
+			__ASSERT_NO_MSG(tx_bufs->count > 1);
+			tx = &tx_bufs->buffers[1];
+
+			__ASSERT_NO_MSG(tx->len > 0);
+			value = ((uint8_t *)tx->buf)[0];
+		}
 		icm42688_emul_handle_write(target, regn, value);
 	}
 
@@ -29,4 +29,18 @@ void icm42688_emul_set_reg(const struct emul *target, uint8_t reg_addr, const ui
  */
 void icm42688_emul_get_reg(const struct emul *target, uint8_t reg_addr, uint8_t *out, size_t count);
 
+/**
+ * @brief Append data to the FIFO
+ *
+ * The data is returned by reads of the FIFO data register, and the FIFO count registers
+ * are updated to match.
+ *
+ * @param target The target emulator to modify
+ * @param frames One or more FIFO packets
+ * @param len The number of bytes in @p frames
+ * @return 0 on success
+ * @return -ENOSPC if the FIFO cannot hold @p len more bytes
+ */
+int icm42688_emul_fifo_push(const struct emul *target, const uint8_t *frames, size_t len);
+
 #endif /* DRIVERS_SENSOR_ICM42688_ICM42688_EMUL_H */
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/serial/uart_rtio.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sys/mpsc_lockfree.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(uart_rtio, CONFIG_UART_LOG_LEVEL);
+
+static struct rtio_iodev_sqe *uart_rtio_pop(struct mpsc *q)
+{
+	struct mpsc_node *node = mpsc_pop(q);
+
+	return (node == NULL) ? NULL : CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+}
+
+/* Get a buffer for the current read, called with the lock held */
+static int uart_rtio_rx_start(struct uart_rtio_data *data)
+{
+	struct rtio_iodev_sqe *iodev_sqe = data->rx_curr;
+	uint32_t min_len = 1;
+	int rc;
+
+	if (FIELD_GET(RTIO_SQE_MEMPOOL_BUFFER, iodev_sqe->sqe.flags)) {
+		min_len = rtio_mempool_block_size(iodev_sqe->r);
+	}
+
+	rc = rtio_sqe_rx_buf(iodev_sqe, min_len, MAX(data->rx_len, min_len), &data->rx_buf,
+			     &data->rx_buf_len);
+	if (rc != 0) {
+		/* Leave the data in the UART and retry once the timer expires */
+		data->rx_buf = NULL;
+		k_timer_start(&data->rx_timer, K_USEC(data->rx_timeout_us), K_NO_WAIT);
+		return rc;
+	}
+
+	data->rx_pos = 0;
+	uart_irq_rx_enable(data->dev);
+
+	return 0;
+}
+
+/* Take the next read if none is in progress, called with the lock held */
+static void uart_rtio_rx_next(struct uart_rtio_data *data)
+{
+	if (data->rx_curr != NULL) {
+		return;
+	}
+
+	data->rx_curr = uart_rtio_pop(&data->rx_q);
+	if (data->rx_curr == NULL) {
+		uart_irq_rx_disable(data->dev);
+		return;
+	}
+
+	(void)uart_rtio_rx_start(data);
+}
+
+/* Take the next transmission if none is in progress, called with the lock held */
+static void uart_rtio_tx_next(struct uart_rtio_data *data)
+{
+	if (data->tx_curr != NULL) {
+		return;
+	}
+
+	data->tx_curr = uart_rtio_pop(&data->tx_q);
+	data->tx_pos = 0;
+	if (data->tx_curr != NULL) {
+		uart_irq_tx_enable(data->dev);
+	}
+}
+
+static void uart_rtio_rx_complete(struct uart_rtio_data *data, struct rtio_iodev_sqe *iodev_sqe,
+				  uint8_t *buf, uint32_t buf_len, uint32_t received)
+{
+	struct rtio_sqe *sqe = &iodev_sqe->sqe;
+
+	if (FIELD_GET(RTIO_SQE_MEMPOOL_BUFFER, sqe->flags)) {
+		struct rtio *r = iodev_sqe->r;
+		uint32_t used = ROUND_UP(received, rtio_mempool_block_size(r));
+
+		/* Give the blocks which were not filled back to the mempool */
+		if (used < buf_len) {
+			rtio_release_buffer(r, buf + used, buf_len - used);
+			sqe->buf_len = used;
+		}
+	}
+
+	rtio_iodev_sqe_ok(iodev_sqe, received);
+
+	K_SPINLOCK(&data->lock) {
+		uart_rtio_rx_next(data);
+	}
+}
+
+static void uart_rtio_rx_timeout(struct k_timer *timer)
+{
+	struct uart_rtio_data *data = CONTAINER_OF(timer, struct uart_rtio_data, rx_timer);
+	struct rtio_iodev_sqe *done = NULL;
+	uint8_t *buf;
+	uint32_t buf_len;
+	uint32_t received;
+
+	K_SPINLOCK(&data->lock) {
+		if (data->rx_curr == NULL) {
+			K_SPINLOCK_BREAK;
+		}
+
+		if (data->rx_buf == NULL) {
+			(void)uart_rtio_rx_start(data);
+			K_SPINLOCK_BREAK;
+		}
+
+		if (data->rx_pos == 0) {
+			K_SPINLOCK_BREAK;
+		}
+
+		done = data->rx_curr;
+		buf = data->rx_buf;
+		buf_len = data->rx_buf_len;
+		received = data->rx_pos;
+		data->rx_curr = NULL;
+		data->rx_buf = NULL;
+	}
+
+	if (done != NULL) {
+		uart_rtio_rx_complete(data, done, buf, buf_len, received);
+	}
+}
+
+static void uart_rtio_rx_isr(struct uart_rtio_data *data)
+{
+	struct rtio_iodev_sqe *done = NULL;
+	uint8_t *buf;
+	uint32_t buf_len;
+	int rc;
+
+	K_SPINLOCK(&data->lock) {
+		if (data->rx_curr == NULL || data->rx_buf == NULL) {
+			uart_irq_rx_disable(data->dev);
+			K_SPINLOCK_BREAK;
+		}
+
+		rc = uart_fifo_read(data->dev, &data->rx_buf[data->rx_pos],
+				    data->rx_buf_len - data->rx_pos);
+		if (rc <= 0) {
+			K_SPINLOCK_BREAK;
+		}
+
+		data->rx_pos += rc;
+		if (data->rx_pos < data->rx_buf_len) {
+			k_timer_start(&data->rx_timer, K_USEC(data->rx_timeout_us), K_NO_WAIT);
+			K_SPINLOCK_BREAK;
+		}
+
+		k_timer_stop(&data->rx_timer);
+		done = data->rx_curr;
+		buf = data->rx_buf;
+		buf_len = data->rx_buf_len;
+		data->rx_curr = NULL;
+		data->rx_buf = NULL;
+	}
+
+	if (done != NULL) {
+		uart_rtio_rx_complete(data, done, buf, buf_len, buf_len);
+	}
+}
+
+static void uart_rtio_tx_isr(struct uart_rtio_data *data)
+{
+	struct rtio_iodev_sqe *done = NULL;
+	const uint8_t *buf;
+	uint32_t len;
+
+	K_SPINLOCK(&data->lock) {
+		if (data->tx_curr == NULL) {
+			uart_irq_tx_disable(data->dev);
+			K_SPINLOCK_BREAK;
+		}
+
+		if (data->tx_curr->sqe.op == RTIO_OP_TINY_TX) {
+			buf = data->tx_curr->sqe.tiny_buf;
+			len = data->tx_curr->sqe.tiny_buf_len;
+		} else {
+			buf = data->tx_curr->sqe.buf;
+			len = data->tx_curr->sqe.buf_len;
+		}
+
+		if (data->tx_pos < len) {
+			data->tx_pos += uart_fifo_fill(data->dev, &buf[data->tx_pos],
+						       len - data->tx_pos);
+		}
+
+		if (data->tx_pos == len) {
+			done = data->tx_curr;
+			data->tx_curr = NULL;
+		}
+	}
+
+	if (done == NULL) {
+		return;
+	}
+
+	/* Chained transmissions get queued while completing */
+	rtio_iodev_sqe_ok(done, 0);
+
+	K_SPINLOCK(&data->lock) {
+		uart_rtio_tx_next(data);
+		if (data->tx_curr == NULL) {
+			uart_irq_tx_disable(data->dev);
+		}
+	}
+}
+
+static void uart_rtio_isr(const struct device *dev, void *user_data)
+{
+	struct uart_rtio_data *data = user_data;
+
+	if (!uart_irq_update(dev)) {
+		return;
+	}
+
+	if (uart_irq_rx_ready(dev)) {
+		uart_rtio_rx_isr(data);
+	}
+
+	if (uart_irq_tx_ready(dev)) {
+		uart_rtio_tx_isr(data);
+	}
+}
+
+static void uart_rtio_init(struct uart_rtio_data *data)
+{
+	K_SPINLOCK(&data->lock) {
+		if (data->initialized) {
+			K_SPINLOCK_BREAK;
+		}
+
+		k_timer_init(&data->rx_timer, uart_rtio_rx_timeout, NULL);
+		uart_irq_callback_user_data_set(data->dev, uart_rtio_isr, data);
+		data->initialized = true;
+	}
+}
+
+static void uart_rtio_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct uart_rtio_data *data = iodev_sqe->sqe.iodev->data;
+
+	uart_rtio_init(data);
+
+	switch (iodev_sqe->sqe.op) {
+	case RTIO_OP_TX:
+	case RTIO_OP_TINY_TX:
+		mpsc_push(&data->tx_q, &iodev_sqe->q);
+		K_SPINLOCK(&data->lock) {
+			uart_rtio_tx_next(data);
+		}
+		break;
+	case RTIO_OP_RX:
+		mpsc_push(&data->rx_q, &iodev_sqe->q);
+		K_SPINLOCK(&data->lock) {
+			uart_rtio_rx_next(data);
+		}
+		break;
+	default:
+		LOG_ERR("Unsupported op %u", iodev_sqe->sqe.op);
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+	}
+}
+
+const struct rtio_iodev_api uart_rtio_iodev_api = {
+	.submit = uart_rtio_submit,
+};
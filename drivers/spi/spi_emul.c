@@ -18,6 +18,8 @@ LOG_MODULE_REGISTER(spi_emul_ctlr);
 #include <zephyr/drivers/emul.h>
 #include <zephyr/drivers/spi.h>
 #include <zephyr/drivers/spi_emul.h>
+#include <zephyr/drivers/spi/rtio.h>
+#include <zephyr/rtio/rtio.h>
 
 /** Working data for the device */
 struct spi_emul_data {
@@ -25,6 +27,15 @@ struct spi_emul_data {
 	sys_slist_t emuls;
 	/* SPI host configuration */
 	uint32_t config;
+#ifdef CONFIG_SPI_RTIO
+	/* Schedules the RTIO transactions on the bus */
+	struct spi_rtio ctx;
+	/* Result of the transfer in flight */
+	int txn_status;
+	/* Completes the transfer in flight after the latency passed */
+	struct k_timer timer;
+	uint32_t latency_us;
+#endif /* CONFIG_SPI_RTIO */
 };
 
 uint32_t spi_emul_get_config(const struct device *dev)
@@ -89,6 +100,149 @@ static int spi_emul_io(const struct device *dev, const struct spi_config *config
 	return api->io(emul->target, config, tx_bufs, rx_bufs);
 }
 
+#ifdef CONFIG_SPI_RTIO
+/**
+ * Pass an RTIO transaction to the emulator as a single transfer
+ *
+ * Each submission of the transaction becomes one buffer in both the
+ * transmit and receive buffer sets, with a NULL buffer on the side it
+ * does not use, so the chip select is held over the whole transaction.
+ */
+static int spi_emul_iodev_io(const struct device *dev, struct rtio_iodev_sqe *txn_head)
+{
+	const struct spi_dt_spec *spec = txn_head->sqe.iodev->data;
+	struct spi_buf tx[CONFIG_SPI_EMUL_RTIO_MAX_BUFS];
+	struct spi_buf rx[CONFIG_SPI_EMUL_RTIO_MAX_BUFS];
+	size_t count = 0;
+	int ret;
+
+	for (struct rtio_iodev_sqe *txn = txn_head; txn != NULL; txn = rtio_txn_next(txn)) {
+		struct rtio_sqe *sqe = &txn->sqe;
+		uint8_t *buf;
+		uint32_t buf_len;
+
+		if (count == ARRAY_SIZE(tx)) {
+			LOG_ERR("Transaction exceeds %zu submissions", ARRAY_SIZE(tx));
+			return -ENOMEM;
+		}
+
+		switch (sqe->op) {
+		case RTIO_OP_RX:
+			ret = rtio_sqe_rx_buf(txn, sqe->buf_len, sqe->buf_len, &buf, &buf_len);
+			if (ret != 0) {
+				return ret;
+			}
+			tx[count] = (struct spi_buf){.buf = NULL, .len = buf_len};
+			rx[count] = (struct spi_buf){.buf = buf, .len = buf_len};
+			break;
+		case RTIO_OP_TX:
+			tx[count] = (struct spi_buf){.buf = sqe->buf, .len = sqe->buf_len};
+			rx[count] = (struct spi_buf){.buf = NULL, .len = sqe->buf_len};
+			break;
+		case RTIO_OP_TINY_TX:
+			tx[count] = (struct spi_buf){.buf = sqe->tiny_buf, .len = sqe->tiny_buf_len};
+			rx[count] = (struct spi_buf){.buf = NULL, .len = sqe->tiny_buf_len};
+			break;
+		case RTIO_OP_TXRX:
+			tx[count] = (struct spi_buf){.buf = sqe->tx_buf, .len = sqe->txrx_buf_len};
+			rx[count] = (struct spi_buf){.buf = sqe->rx_buf, .len = sqe->txrx_buf_len};
+			break;
+		default:
+			LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+			return -EINVAL;
+		}
+
+		count++;
+	}
+
+	const struct spi_buf_set tx_bufs = {.buffers = tx, .count = count};
+	const struct spi_buf_set rx_bufs = {.buffers = rx, .count = count};
+
+	return spi_emul_io(dev, &spec->config, &tx_bufs, &rx_bufs);
+}
+
+/* Transfer the chunk of a chunked transfer the SPI RTIO context asks for, in a frame of its own */
+static int spi_emul_iodev_chunk(const struct device *dev, const struct spi_rtio *ctx)
+{
+	struct rtio_iodev_sqe *txn = ctx->txn_head;
+	const struct spi_dt_spec *spec = txn->sqe.iodev->data;
+	uint8_t *buf = &txn->sqe.buf[ctx->chunk_pos];
+	bool tx = txn->sqe.op == RTIO_OP_TX;
+	const struct spi_buf tx_buf = {.buf = tx ? buf : NULL, .len = ctx->chunk_len};
+	const struct spi_buf rx_buf = {.buf = tx ? NULL : buf, .len = ctx->chunk_len};
+	const struct spi_buf_set tx_bufs = {.buffers = &tx_buf, .count = 1};
+	const struct spi_buf_set rx_bufs = {.buffers = &rx_buf, .count = 1};
+
+	return spi_emul_io(dev, &spec->config, &tx_bufs, &rx_bufs);
+}
+
+/**
+ * Transfer what the SPI RTIO context starts, called by the owner of the bus
+ *
+ * The transactions of a coalesced batch follow each other right away, as on
+ * a controller chaining them, and the latency is spent once at the end. With
+ * no latency transfers are completed right away, so the queue is drained in
+ * a loop rather than through recursion.
+ */
+static void spi_emul_iodev_run(const struct device *dev)
+{
+	struct spi_emul_data *data = dev->data;
+	struct spi_rtio *ctx = &data->ctx;
+	int status;
+
+	do {
+		if (ctx->chunk_len > 0U) {
+			status = spi_emul_iodev_chunk(dev, ctx);
+		} else {
+			status = spi_emul_iodev_io(dev, ctx->txn_head);
+		}
+
+		/* Resubmitted multishot requests would complete forever without
+		 * returning, so they always wait for the timer.
+		 */
+		if (!spi_rtio_txn_batched(ctx) &&
+		    ((data->latency_us > 0U) || (ctx->txn_head->sqe.flags & RTIO_SQE_MULTISHOT))) {
+			data->txn_status = status;
+			k_timer_start(&data->timer, K_USEC(data->latency_us), K_NO_WAIT);
+			return;
+		}
+	} while (spi_rtio_complete(ctx, status));
+}
+
+static void spi_emul_iodev_timer_expiry(struct k_timer *timer)
+{
+	const struct device *dev = k_timer_user_data_get(timer);
+	struct spi_emul_data *data = dev->data;
+
+	if (spi_rtio_complete(&data->ctx, data->txn_status)) {
+		spi_emul_iodev_run(dev);
+	}
+}
+
+static void spi_emul_iodev_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct spi_emul_data *data = dev->data;
+
+	if (spi_rtio_submit(&data->ctx, iodev_sqe)) {
+		spi_emul_iodev_run(dev);
+	}
+}
+
+void spi_emul_rtio_latency_set(const struct device *dev, uint32_t latency_us)
+{
+	struct spi_emul_data *data = dev->data;
+
+	data->latency_us = latency_us;
+}
+
+void spi_emul_rtio_coalesce_set(const struct device *dev, uint8_t count)
+{
+	struct spi_emul_data *data = dev->data;
+
+	spi_rtio_coalesce_set(&data->ctx, count);
+}
+#endif /* CONFIG_SPI_RTIO */
+
 /**
  * @brief This is a no-op stub of the SPI API's `release` method to protect drivers under test
  *        from hitting a segmentation fault when using SPI_LOCK_ON plus spi_release()
@@ -112,6 +266,13 @@ static int spi_emul_init(const struct device *dev)
 
 	sys_slist_init(&data->emuls);
 
+#ifdef CONFIG_SPI_RTIO
+	spi_rtio_init(&data->ctx);
+	k_timer_init(&data->timer, spi_emul_iodev_timer_expiry, NULL);
+	k_timer_user_data_set(&data->timer, (void *)dev);
+	data->latency_us = CONFIG_SPI_EMUL_RTIO_LATENCY_US;
+#endif /* CONFIG_SPI_RTIO */
+
 	return emul_init_for_bus(dev);
 }
 
@@ -131,6 +292,9 @@ int spi_emul_register(const struct device *dev, struct spi_emul *emul)
 
 static const struct spi_driver_api spi_emul_api = {
 	.transceive = spi_emul_io,
+#ifdef CONFIG_SPI_RTIO
+	.iodev_submit = spi_emul_iodev_submit,
+#endif /* CONFIG_SPI_RTIO */
 	.release = spi_emul_release,
 };
 
@@ -5,7 +5,206 @@
  */
 
 #include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/spi/rtio.h>
+#include <zephyr/rtio/rtio.h>
 
 const struct rtio_iodev_api spi_iodev_api = {
 	.submit = spi_iodev_submit,
 };
+
+void spi_rtio_init(struct spi_rtio *ctx)
+{
+	rtio_iodev_queue_init(&ctx->io_q);
+	ctx->txn_head = NULL;
+	ctx->txn_count = 0;
+	ctx->txn_idx = 0;
+	ctx->coalesce = 1;
+	ctx->chunked = NULL;
+	ctx->chunk_pos = 0;
+	ctx->chunk_len = 0;
+}
+
+/**
+ * @private
+ * @brief Check if a transaction may be transferred a chunk at a time
+ */
+static bool spi_rtio_chunkable(const struct rtio_iodev_sqe *txn)
+{
+	const struct rtio_sqe *sqe = &txn->sqe;
+
+	return (sqe->iodev_flags & RTIO_IODEV_SPI_CHUNKED) &&
+	       !(sqe->flags & (RTIO_SQE_TRANSACTION | RTIO_SQE_MEMPOOL_BUFFER)) &&
+	       (sqe->op == RTIO_OP_TX || sqe->op == RTIO_OP_RX) &&
+	       sqe->buf_len > CONFIG_SPI_RTIO_CHUNK_SIZE;
+}
+
+/**
+ * @private
+ * @brief Set up the next chunk of the chunked transfer in progress
+ *
+ * Called with the spin lock held.
+ */
+static void spi_rtio_chunk(struct spi_rtio *ctx)
+{
+	struct rtio_iodev_sqe *txn = ctx->chunked;
+
+	ctx->txn_head = txn;
+	ctx->txn_count = 0;
+	ctx->txn_idx = 0;
+	ctx->chunk_len = MIN(txn->sqe.buf_len - ctx->chunk_pos, CONFIG_SPI_RTIO_CHUNK_SIZE);
+}
+
+/**
+ * @private
+ * @brief Take the transactions coalesced with the one just taken from the queue
+ *
+ * Called with the spin lock held.
+ */
+static void spi_rtio_batch(struct spi_rtio *ctx, struct rtio_iodev_sqe *head)
+{
+	struct rtio_iodev_sqe *next;
+
+	ctx->txn_head = head;
+	ctx->txn[0] = head;
+	ctx->txn_count = 1;
+	ctx->txn_idx = 0;
+	ctx->chunk_len = 0;
+
+	/* Resubmitted multishot requests would be batched with themselves */
+	if (head->sqe.flags & RTIO_SQE_MULTISHOT) {
+		return;
+	}
+
+	while (ctx->txn_count < ctx->coalesce) {
+		next = rtio_iodev_queue_peek(&ctx->io_q);
+		if (next == NULL || next->sqe.iodev != head->sqe.iodev ||
+		    (next->sqe.flags & RTIO_SQE_MULTISHOT) || spi_rtio_chunkable(next)) {
+			break;
+		}
+
+		ctx->txn[ctx->txn_count++] = rtio_iodev_queue_pop(&ctx->io_q);
+	}
+}
+
+/**
+ * @private
+ * @brief Setup the next transfer if needed
+ *
+ * Queued transactions not ranked below a chunked transfer in progress run
+ * before its next chunk.
+ *
+ * @retval true New transfer to start with the hardware is setup
+ * @retval false No new transfer to start
+ */
+static bool spi_rtio_next(struct spi_rtio *ctx, bool completion)
+{
+	k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+	struct rtio_iodev_sqe *next;
+
+	/* Already working on something, bail early */
+	if (!completion && ctx->txn_head != NULL) {
+		k_spin_unlock(&ctx->lock, key);
+		return false;
+	}
+
+	next = rtio_iodev_queue_peek(&ctx->io_q);
+	if (ctx->chunked != NULL &&
+	    (next == NULL || rtio_iodev_sqe_precedes(ctx->chunked, next))) {
+		spi_rtio_chunk(ctx);
+		k_spin_unlock(&ctx->lock, key);
+		return true;
+	}
+
+	next = rtio_iodev_queue_pop(&ctx->io_q);
+
+	/* Nothing left to do */
+	if (next == NULL) {
+		ctx->txn_head = NULL;
+		ctx->txn_count = 0;
+		ctx->chunk_len = 0;
+		k_spin_unlock(&ctx->lock, key);
+		return false;
+	}
+
+	if (ctx->chunked == NULL && spi_rtio_chunkable(next)) {
+		ctx->chunked = next;
+		ctx->chunk_pos = 0;
+		spi_rtio_chunk(ctx);
+	} else {
+		spi_rtio_batch(ctx, next);
+	}
+
+	k_spin_unlock(&ctx->lock, key);
+
+	return true;
+}
+
+/**
+ * @private
+ * @brief Complete a submission with its status
+ */
+static void spi_rtio_txn_complete(struct rtio_iodev_sqe *txn, int status)
+{
+	if (status < 0) {
+		rtio_iodev_sqe_err(txn, status);
+	} else {
+		rtio_iodev_sqe_ok(txn, status);
+	}
+}
+
+bool spi_rtio_complete(struct spi_rtio *ctx, int status)
+{
+	struct rtio_iodev_sqe *txn[CONFIG_SPI_RTIO_COALESCE_MAX];
+	int txn_status[CONFIG_SPI_RTIO_COALESCE_MAX];
+	k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+	uint8_t count = 0;
+
+	/* The state is updated with the lock held and the submissions completed
+	 * after releasing it. The current head stays set while completing, so
+	 * transactions submitted from the completions are queued rather than
+	 * started.
+	 */
+	if (ctx->chunk_len > 0U) {
+		ctx->chunk_pos += ctx->chunk_len;
+		ctx->chunk_len = 0;
+
+		if (status < 0 || ctx->chunk_pos == ctx->chunked->sqe.buf_len) {
+			txn[0] = ctx->chunked;
+			txn_status[0] = status;
+			ctx->chunked = NULL;
+			count = 1;
+		}
+	} else {
+		ctx->txn_status[ctx->txn_idx++] = status;
+		if (ctx->txn_idx < ctx->txn_count) {
+			ctx->txn_head = ctx->txn[ctx->txn_idx];
+			k_spin_unlock(&ctx->lock, key);
+			return true;
+		}
+
+		count = ctx->txn_count;
+		for (uint8_t i = 0; i < count; i++) {
+			txn[i] = ctx->txn[i];
+			txn_status[i] = ctx->txn_status[i];
+		}
+	}
+
+	k_spin_unlock(&ctx->lock, key);
+
+	for (uint8_t i = 0; i < count; i++) {
+		spi_rtio_txn_complete(txn[i], txn_status[i]);
+	}
+
+	return spi_rtio_next(ctx, true);
+}
+
+bool spi_rtio_submit(struct spi_rtio *ctx, struct rtio_iodev_sqe *iodev_sqe)
+{
+	rtio_iodev_queue_push(&ctx->io_q, iodev_sqe);
+	return spi_rtio_next(ctx, false);
+}
+
+void spi_rtio_coalesce_set(struct spi_rtio *ctx, uint8_t count)
+{
+	ctx->coalesce = CLAMP(count, 1, CONFIG_SPI_RTIO_COALESCE_MAX);
+}
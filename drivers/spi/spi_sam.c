@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(spi_sam);
 #include <zephyr/spinlock.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/spi/rtio.h>
 #include <zephyr/drivers/dma.h>
 #include <zephyr/drivers/pinctrl.h>
 #include <zephyr/drivers/clock_control/atmel_sam_pmc.h>
@@ -54,8 +55,8 @@ struct spi_sam_data {
 #ifdef CONFIG_SPI_RTIO
 	struct rtio *r; /* context for thread calls */
 	struct rtio_iodev iodev;
-	struct rtio_iodev_sqe *txn_head;
-	struct rtio_iodev_sqe *txn_curr;
+	struct spi_rtio rtio_ctx; /* schedules the transactions on the bus */
+	struct rtio_iodev_sqe *txn_curr; /* submission of the transaction in flight */
 	struct spi_dt_spec dt_spec;
 #endif
 
@@ -303,7 +304,7 @@ static void dma_callback(const struct device *dma_dev, void *user_data,
 	struct spi_sam_data *drv_data = dev->data;
 
 #ifdef CONFIG_SPI_RTIO
-	if (drv_data->txn_head != NULL) {
+	if (drv_data->rtio_ctx.txn_head != NULL) {
 		spi_sam_iodev_complete(dev, status);
 		return;
 	}
@@ -322,7 +323,7 @@ static int spi_sam_dma_txrx(const struct device *dev,
 	const struct spi_sam_config *drv_cfg = dev->config;
 	struct spi_sam_data *drv_data = dev->data;
 #ifdef CONFIG_SPI_RTIO
-	bool blocking = drv_data->txn_head == NULL;
+	bool blocking = drv_data->rtio_ctx.txn_head == NULL;
 #else
 	bool blocking = true;
 #endif
@@ -645,15 +646,30 @@ static bool spi_sam_is_regular(const struct spi_buf_set *tx_bufs,
 #else
 
 static void spi_sam_iodev_complete(const struct device *dev, int status);
-static void spi_sam_iodev_next(const struct device *dev, bool completion);
 
 static void spi_sam_iodev_start(const struct device *dev)
 {
 	const struct spi_sam_config *cfg = dev->config;
 	struct spi_sam_data *data = dev->data;
+	const struct spi_rtio *rtio_ctx = &data->rtio_ctx;
 	struct rtio_sqe *sqe = &data->txn_curr->sqe;
 	int ret = 0;
 
+	/* Chunk of a chunked TX or RX transfer */
+	if (rtio_ctx->chunk_len > 0U) {
+		uint8_t *buf = &sqe->buf[rtio_ctx->chunk_pos];
+
+		if (sqe->op == RTIO_OP_TX) {
+			ret = spi_sam_tx(dev, cfg->regs, buf, rtio_ctx->chunk_len);
+		} else {
+			ret = spi_sam_rx(dev, cfg->regs, buf, rtio_ctx->chunk_len);
+		}
+		if (ret == 0) {
+			spi_sam_iodev_complete(dev, 0);
+		}
+		return;
+	}
+
 	switch (sqe->op) {
 	case RTIO_OP_RX:
 		ret = spi_sam_rx(dev, cfg->regs, sqe->buf, sqe->buf_len);
@@ -669,65 +685,41 @@ static void spi_sam_iodev_start(const struct device *dev)
 		break;
 	default:
 		LOG_ERR("Invalid op code %d for submission %p\n", sqe->op, (void *)sqe);
-		struct rtio_iodev_sqe *txn_head = data->txn_head;
-
-		spi_sam_iodev_next(dev, true);
-		rtio_iodev_sqe_err(txn_head, -EINVAL);
-		ret = 0;
+		spi_sam_iodev_complete(dev, -EINVAL);
+		return;
 	}
 	if (ret == 0) {
 		spi_sam_iodev_complete(dev, 0);
 	}
 }
 
-static void spi_sam_iodev_next(const struct device *dev, bool completion)
+/* Start the transaction, or the chunk of it, set up by the SPI RTIO context */
+static void spi_sam_iodev_next(const struct device *dev)
 {
 	struct spi_sam_data *data = dev->data;
+	struct spi_dt_spec *spi_dt_spec = data->rtio_ctx.txn_head->sqe.iodev->data;
+	struct spi_config *spi_cfg = &spi_dt_spec->config;
 
-	k_spinlock_key_t key  = spi_spin_lock(dev);
-
-	if (!completion && data->txn_curr != NULL) {
-		spi_spin_unlock(dev, key);
-		return;
-	}
-
-	struct mpsc_node *next = mpsc_pop(&data->iodev.iodev_sq);
-
-	if (next != NULL) {
-		struct rtio_iodev_sqe *next_sqe = CONTAINER_OF(next, struct rtio_iodev_sqe, q);
+	data->txn_curr = data->rtio_ctx.txn_head;
 
-		data->txn_head = next_sqe;
-		data->txn_curr = next_sqe;
-	} else {
-		data->txn_head = NULL;
-		data->txn_curr = NULL;
-	}
-
-	spi_spin_unlock(dev, key);
-
-	if (data->txn_curr != NULL) {
-		struct spi_dt_spec *spi_dt_spec = data->txn_curr->sqe.iodev->data;
-		struct spi_config *spi_cfg = &spi_dt_spec->config;
-
-		spi_sam_configure(dev, spi_cfg);
-		spi_context_cs_control(&data->ctx, true);
-		spi_sam_iodev_start(dev);
-	}
+	spi_sam_configure(dev, spi_cfg);
+	spi_context_cs_control(&data->ctx, true);
+	spi_sam_iodev_start(dev);
 }
 
 static void spi_sam_iodev_complete(const struct device *dev, int status)
 {
 	struct spi_sam_data *data = dev->data;
 
-	if (data->txn_curr->sqe.flags & RTIO_SQE_TRANSACTION) {
+	if (status >= 0 && (data->txn_curr->sqe.flags & RTIO_SQE_TRANSACTION)) {
 		data->txn_curr = rtio_txn_next(data->txn_curr);
 		spi_sam_iodev_start(dev);
-	} else {
-		struct rtio_iodev_sqe *txn_head = data->txn_head;
+		return;
+	}
 
-		spi_context_cs_control(&data->ctx, false);
-		spi_sam_iodev_next(dev, true);
-		rtio_iodev_sqe_ok(txn_head, status);
+	spi_context_cs_control(&data->ctx, false);
+	if (spi_rtio_complete(&data->rtio_ctx, status)) {
+		spi_sam_iodev_next(dev);
 	}
 }
 
@@ -736,8 +728,9 @@ static void spi_sam_iodev_submit(const struct device *dev,
 {
 	struct spi_sam_data *data = dev->data;
 
-	mpsc_push(&data->iodev.iodev_sq, &iodev_sqe->q);
-	spi_sam_iodev_next(dev, false);
+	if (spi_rtio_submit(&data->rtio_ctx, iodev_sqe)) {
+		spi_sam_iodev_next(dev);
+	}
 }
 #endif
 
@@ -867,6 +860,7 @@ static int spi_sam_init(const struct device *dev)
 	data->iodev.api = &spi_iodev_api;
 	data->iodev.data = &data->dt_spec;
 	mpsc_init(&data->iodev.iodev_sq);
+	spi_rtio_init(&data->rtio_ctx);
 #endif
 
 	spi_context_unlock_unconditionally(&data->ctx);
@@ -17,6 +17,10 @@
 #include <zephyr/dt-bindings/adc/adc.h>
 #include <zephyr/kernel.h>
 
+#ifdef CONFIG_ADC_STREAM
+#include <zephyr/rtio/rtio.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -693,6 +697,103 @@ typedef int (*adc_api_read_async)(const struct device *dev,
 				  const struct adc_sequence *sequence,
 				  struct k_poll_signal *async);
 
+#if defined(CONFIG_ADC_STREAM) || defined(__DOXYGEN__)
+/**
+ * @brief Configuration of an ADC stream
+ *
+ * See ADC_DT_STREAM_IODEV().
+ */
+struct adc_stream_config {
+	/** ADC device */
+	const struct device *dev;
+	/** Bit-mask of the channels sampled, as in adc_sequence::channels */
+	uint32_t channels;
+	/** Interval between consecutive samplings, in microseconds */
+	uint32_t interval_us;
+	/** Number of samplings delivered in each buffer */
+	uint16_t samplings;
+	/** ADC resolution, as in adc_sequence::resolution */
+	uint8_t resolution;
+	/**
+	 * Oversampling setting, as in adc_sequence::oversampling. Each sample
+	 * is averaged from 2^oversampling conversion results.
+	 */
+	uint8_t oversampling;
+};
+
+/**
+ * @brief Header of a buffer of streamed samples
+ *
+ * Each buffer starts with this header, followed by the samples of
+ * adc_stream_header::samplings samplings. Each sampling holds one 16 bit sample
+ * for each selected channel, starting from the one with the lowest ID, as
+ * written to adc_sequence::buffer.
+ */
+struct adc_stream_header {
+	/** Time of the first sampling, in nanoseconds since boot */
+	uint64_t timestamp_ns;
+	/** Time between consecutive samplings, in nanoseconds */
+	uint64_t interval_ns;
+	/** Bit-mask of the sampled channels */
+	uint32_t channels;
+	/** Number of samplings in the buffer */
+	uint16_t samplings;
+	/** Number of samplings lost since the previous buffer, for lack of a buffer */
+	uint16_t dropped;
+	/** Samples of the samplings */
+	uint16_t samples[];
+};
+
+/**
+ * @brief Type definition of ADC API function for submitting a stream read.
+ * See adc_stream() for argument descriptions.
+ */
+typedef void (*adc_api_submit)(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe);
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api __adc_iodev_api;
+/** @endcond */
+
+/**
+ * @brief Define an RTIO iodev streaming samples of an ADC
+ *
+ * Reads submitted to the iodev are filled with samplings taken at a fixed
+ * interval. Sampling runs continuously while reads are pending, the next read
+ * is armed as soon as the previous buffer is full, so with a multishot read or
+ * two reads pending no sampling is lost between buffers. Channels must be set
+ * up with adc_channel_setup() before the stream starts.
+ *
+ * @code{.c}
+ * ADC_DT_STREAM_IODEV(adc_stream_iodev, DT_NODELABEL(adc0), BIT(0) | BIT(1), 12, 100, 64);
+ * RTIO_DEFINE_WITH_MEMPOOL(r, 4, 4, 8, 512, 4);
+ *
+ * int main(void) {
+ *   struct rtio_sqe *handle;
+ *
+ *   adc_stream(&adc_stream_iodev, &r, NULL, &handle);
+ *   ...
+ *   rtio_sqe_cancel(handle);
+ * }
+ * @endcode
+ *
+ * @param name Name of the iodev
+ * @param node_id Devicetree node identifier of the ADC
+ * @param _channels Bit-mask of the channels to sample
+ * @param _resolution ADC resolution
+ * @param _interval_us Interval between consecutive samplings, in microseconds
+ * @param _samplings Number of samplings in each buffer
+ */
+#define ADC_DT_STREAM_IODEV(name, node_id, _channels, _resolution, _interval_us, _samplings)     \
+	static struct adc_stream_config _CONCAT(__adc_stream_config_, name) = {                   \
+		.dev = DEVICE_DT_GET(node_id),                                                     \
+		.channels = (_channels),                                                           \
+		.interval_us = (_interval_us),                                                     \
+		.samplings = (_samplings),                                                         \
+		.resolution = (_resolution),                                                       \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &__adc_iodev_api, &_CONCAT(__adc_stream_config_, name))
+#endif /* CONFIG_ADC_STREAM */
+
 /**
  * @brief ADC driver API
  *
@@ -703,6 +804,9 @@ __subsystem struct adc_driver_api {
 	adc_api_read          read;
 #ifdef CONFIG_ADC_ASYNC
 	adc_api_read_async    read_async;
+#endif
+#ifdef CONFIG_ADC_STREAM
+	adc_api_submit        submit;
 #endif
 	uint16_t ref_internal;	/* mV */
 };
@@ -834,6 +938,53 @@ static inline int z_impl_adc_read_async(const struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#if defined(CONFIG_ADC_STREAM) || defined(__DOXYGEN__)
+/**
+ * @brief Get the size of a buffer holding the samplings of a stream
+ *
+ * @param config Configuration of the stream
+ *
+ * @return Size in bytes, including the @ref adc_stream_header.
+ */
+static inline size_t adc_stream_buffer_size(const struct adc_stream_config *config)
+{
+	return sizeof(struct adc_stream_header) +
+	       (size_t)config->samplings * POPCOUNT(config->channels) * sizeof(uint16_t);
+}
+
+/**
+ * @brief Start streaming samples from an ADC
+ *
+ * Submits a multishot read to the iodev, completed with a mempool buffer each
+ * time one is full, see @ref adc_stream_header. The stream runs until the read
+ * is canceled with rtio_sqe_cancel().
+ *
+ * @param iodev Iodev defined with ADC_DT_STREAM_IODEV()
+ * @param ctx RTIO context with a mempool
+ * @param userdata Userdata of the completions
+ * @param handle Set to the submission to cancel the stream with, may be NULL
+ *
+ * @retval 0 On success.
+ * @retval -ENOMEM If no submission is available.
+ */
+static inline int adc_stream(struct rtio_iodev *iodev, struct rtio *ctx, void *userdata,
+			     struct rtio_sqe **handle)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(ctx);
+
+	if (sqe == NULL) {
+		return -ENOMEM;
+	}
+
+	rtio_sqe_prep_read_multishot(sqe, iodev, RTIO_PRIO_NORM, userdata);
+	if (handle != NULL) {
+		*handle = sqe;
+	}
+
+	return rtio_submit(ctx, 0);
+}
+#endif /* CONFIG_ADC_STREAM */
+
 /**
  * @brief Get the internal reference voltage.
  *
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_DMA_RTIO_H_
+#define ZEPHYR_INCLUDE_DRIVERS_DMA_RTIO_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief DMA RTIO iodev
+ * @defgroup dma_rtio DMA RTIO iodev
+ * @ingroup dma_interface
+ * @{
+ *
+ * Moves data with a DMA channel as an RTIO iodev, supported operations are
+ *
+ * - @ref RTIO_OP_TXRX copies memory to memory
+ * - @ref RTIO_OP_TX and @ref RTIO_OP_TINY_TX copy memory to the peripheral address
+ * - @ref RTIO_OP_RX copies the peripheral address to memory, reads into the RTIO
+ *   context mempool fill one block
+ *
+ * Each submission in an RTIO transaction becomes one block of a single scatter-gather
+ * transfer, so all submissions of a transaction must move data in the same direction.
+ * Chained submissions are started one after the other by the RTIO executor.
+ */
+
+/**
+ * @brief Data of a DMA RTIO iodev, defined by DMA_RTIO_IODEV_DEFINE()
+ */
+struct dma_rtio_data {
+	/** DMA controller */
+	const struct device *dev;
+	/** DMA channel owned by the iodev */
+	uint32_t channel;
+	/** Address of the peripheral register for RX and TX */
+	uintptr_t periph_addr;
+	/** Channel configuration, the direction and blocks are set per transfer */
+	struct dma_config cfg;
+	/** @cond INTERNAL_HIDDEN */
+	struct dma_block_config blocks[CONFIG_DMA_RTIO_MAX_BLOCKS];
+	struct k_spinlock lock;
+	struct rtio_iodev_queue io_q;
+	struct rtio_iodev_sqe *txn_head;
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api dma_iodev_api;
+/** @endcond */
+
+/**
+ * @brief Define a DMA RTIO iodev
+ *
+ * The remaining arguments initialize the channel's struct dma_config, for example
+ * @code{.c}
+ * DMA_RTIO_IODEV_DEFINE(dma_iodev, DEVICE_DT_GET(DT_NODELABEL(dma)), 0, 0,
+ *			 .source_data_size = 1, .dest_data_size = 1,
+ *			 .source_burst_length = 16, .dest_burst_length = 16);
+ * @endcode
+ *
+ * @param name Symbolic name of the iodev
+ * @param dev_ DMA controller
+ * @param channel_ DMA channel owned by the iodev
+ * @param periph_addr_ Address of the peripheral register for RX and TX, or 0
+ */
+#define DMA_RTIO_IODEV_DEFINE(name, dev_, channel_, periph_addr_, ...)                             \
+	static struct dma_rtio_data _dma_rtio_data_##name = {                                      \
+		.dev = (dev_),                                                                     \
+		.channel = (channel_),                                                             \
+		.periph_addr = (periph_addr_),                                                     \
+		.cfg = {__VA_ARGS__},                                                              \
+		.io_q = RTIO_IODEV_QUEUE_INIT(_dma_rtio_data_##name.io_q),                         \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &dma_iodev_api, &_dma_rtio_data_##name)
+
+/**
+ * @brief Check that the DMA controller of an iodev is ready
+ *
+ * @param iodev Iodev defined with DMA_RTIO_IODEV_DEFINE()
+ *
+ * @retval true if the DMA controller is ready for use
+ * @retval false otherwise
+ */
+static inline bool dma_rtio_is_ready(const struct rtio_iodev *iodev)
+{
+	const struct dma_rtio_data *data = iodev->data;
+
+	return device_is_ready(data->dev);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_DMA_RTIO_H_ */
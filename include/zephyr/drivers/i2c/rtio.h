@@ -22,11 +22,18 @@ struct i2c_rtio {
 	struct k_sem lock;
 	struct k_spinlock slock;
 	struct rtio *r;
-	struct mpsc io_q;
+	struct rtio_iodev_queue io_q;
 	struct rtio_iodev iodev;
 	struct rtio_iodev_sqe *txn_head;
 	struct rtio_iodev_sqe *txn_curr;
 	struct i2c_dt_spec dt_spec;
+	/* Transactions started back to back, txn_head is txn[txn_idx] */
+	struct rtio_iodev_sqe *txn[CONFIG_I2C_RTIO_COALESCE_MAX];
+	/* Results of the transactions of the batch, reported once all are done */
+	int txn_status[CONFIG_I2C_RTIO_COALESCE_MAX];
+	uint8_t txn_count;
+	uint8_t txn_idx;
+	uint8_t coalesce;
 };
 
 /**
@@ -78,6 +85,33 @@ bool i2c_rtio_complete(struct i2c_rtio *ctx, int status);
  */
 bool i2c_rtio_submit(struct i2c_rtio *ctx, struct rtio_iodev_sqe *iodev_sqe);
 
+/**
+ * @brief Set how many transactions for the same device are coalesced
+ *
+ * Transactions for the same device queued back to back are taken from the
+ * queue together and started one after the other, and their completions are
+ * only reported once the last one is done. A controller able to chain them
+ * can thus interrupt once for the whole batch. Coalescing is off by default.
+ *
+ * @param ctx I2C RTIO driver context
+ * @param count Maximum number of transactions coalesced, 1 to turn coalescing
+ *	off. Limited to CONFIG_I2C_RTIO_COALESCE_MAX.
+ */
+void i2c_rtio_coalesce_set(struct i2c_rtio *ctx, uint8_t count);
+
+/**
+ * @brief Check if the current transaction is followed by another one of its batch
+ *
+ * @param ctx I2C RTIO driver context
+ *
+ * @retval true Another coalesced transaction is started once the current one is done
+ * @retval false The current transaction is the last one of its batch
+ */
+static inline bool i2c_rtio_txn_batched(const struct i2c_rtio *ctx)
+{
+	return (ctx->txn_idx + 1U) < ctx->txn_count;
+}
+
 /**
  * @brief Configure the I2C bus controller
  *
@@ -83,6 +83,28 @@ struct i2c_emul_api {
 	i2c_emul_transfer_t transfer;
 };
 
+/**
+ * Set the time RTIO transactions on the emulated bus take to complete
+ *
+ * @param dev I2C emulation controller device
+ * @param latency_us Latency in microseconds, 0 to complete transactions
+ *	synchronously within their submission.
+ */
+void i2c_emul_rtio_latency_set(const struct device *dev, uint32_t latency_us);
+
+/**
+ * Set how many RTIO transactions for the same device are coalesced
+ *
+ * Sets the coalescing of the I2C RTIO context of the bus, see
+ * i2c_rtio_coalesce_set(). The emulated controller transfers the transactions
+ * of a batch back to back, and completes them together after a single latency.
+ *
+ * @param dev I2C emulation controller device
+ * @param count Maximum number of transactions completed together, 1 to turn
+ *	coalescing off. Limited to CONFIG_I2C_RTIO_COALESCE_MAX.
+ */
+void i2c_emul_rtio_coalesce_set(const struct device *dev, uint8_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -524,6 +524,26 @@ struct sensor_decoder_api {
 	 * @return Whether the trigger is present in the buffer
 	 */
 	bool (*has_trigger)(const uint8_t *buffer, enum sensor_trigger_type trigger);
+
+	/**
+	 * @brief Decode up to @p max_count frames of a channel into a q31 array (optional)
+	 *
+	 * Bulk variant of @ref sensor_decoder_api.decode, see sensor_decode_q31(). Return
+	 * -ENOTSUP for buffers or channels that should be decoded through
+	 * @ref sensor_decoder_api.decode instead.
+	 *
+	 * @param[in]     buffer The buffer provided on the @ref rtio context
+	 * @param[in]     channel The channel to decode
+	 * @param[in,out] fit The current frame iterator
+	 * @param[in]     max_count The maximum number of frames to decode
+	 * @param[out]    shift The shift applied to all decoded values
+	 * @param[out]    values The decoded values
+	 * @return 0 no more samples to decode
+	 * @return >0 the number of decoded frames
+	 * @return <0 on error
+	 */
+	int (*decode_q31)(const uint8_t *buffer, struct sensor_chan_spec channel, uint32_t *fit,
+			  uint16_t max_count, int8_t *shift, q31_t *values);
 };
 
 /**
@@ -581,6 +601,46 @@ static inline int sensor_decode(struct sensor_decode_context *ctx, void *out, ui
 	return ctx->decoder->decode(ctx->buffer, ctx->channel, &ctx->fit, max_count, out);
 }
 
+/**
+ * @brief Decode N frames of a channel into a contiguous q31 array
+ *
+ * Unlike sensor_decode(), no per frame timestamps are produced. One value is written per
+ * frame, or an X, Y, Z triplet for three-axis channels such as @ref SENSOR_CHAN_ACCEL_XYZ,
+ * so @p values must hold @p max_count (three-axis: 3 * @p max_count) entries. Frames
+ * which do not contain the channel are skipped.
+ *
+ * Decoders providing @ref sensor_decoder_api.decode_q31 convert the frames in a single
+ * pass, others are decoded through @ref sensor_decoder_api.decode in chunks.
+ *
+ * Only channels decoded to @ref sensor_q31_data or @ref sensor_three_axis_data are
+ * supported.
+ *
+ * @param[in,out] ctx The context to use for decoding
+ * @param[out]    values The decoded values
+ * @param[out]    shift The shift applied to all decoded values
+ * @param[in]     max_count Maximum number of frames to decode
+ * @return 0 no more samples to decode
+ * @return >0 the number of decoded frames
+ * @return -ENOTSUP if the channel is not decoded to q31 values
+ * @return <0 on other errors
+ */
+int sensor_decode_q31(struct sensor_decode_context *ctx, q31_t *values, int8_t *shift,
+		      uint16_t max_count);
+
+/**
+ * @brief Convert 16-bit raw readings to q31
+ *
+ * Computes `out[i] = in[i] * scale / 2^15` for @p count readings, which is how most
+ * decoders turn a 16-bit register value into a q31 value. Uses the DSP subsystem
+ * when CONFIG_SENSOR_DECODE_DSP is enabled.
+ *
+ * @param[in]  in The raw readings
+ * @param[out] out The q31 values, may not overlap @p in
+ * @param[in]  count The number of readings
+ * @param[in]  scale The value of a full-scale reading (2^15) in the output q31 format
+ */
+void sensor_q31_from_s16(const int16_t *in, q31_t *out, size_t count, q31_t scale);
+
 int sensor_natively_supported_channel_size_info(struct sensor_chan_spec channel, size_t *base_size,
 						size_t *frame_size);
 
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief RTIO iodev streaming data through a UART.
+ *
+ * The iodev drives the UART with the interrupt driven API and takes over the
+ * UART's interrupt callback. Supported operations are
+ *
+ * - @ref RTIO_OP_TX and @ref RTIO_OP_TINY_TX transmit the buffer, chained
+ *   submissions are transmitted back to back.
+ * - @ref RTIO_OP_RX receives into the buffer. Reads into the RTIO context mempool,
+ *   including multishot reads, take a buffer of the iodev's RX length rounded up
+ *   to whole mempool blocks.
+ *
+ * A read completes with the number of bytes received once its buffer is full, or
+ * once the line has been idle for the iodev's RX timeout. Unused mempool blocks
+ * of a partially filled buffer are returned to the mempool before completing.
+ */
+
+#ifndef ZEPHYR_DRIVERS_SERIAL_UART_RTIO_H_
+#define ZEPHYR_DRIVERS_SERIAL_UART_RTIO_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sys/mpsc_lockfree.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Data of a UART RTIO iodev, defined by UART_RTIO_IODEV_DEFINE()
+ */
+struct uart_rtio_data {
+	/** UART device */
+	const struct device *dev;
+
+	/** Bytes received into each mempool buffer */
+	uint32_t rx_len;
+
+	/** Idle time in microseconds after which a partially filled read completes */
+	uint32_t rx_timeout_us;
+
+	/** @cond INTERNAL_HIDDEN */
+	struct k_spinlock lock;
+	bool initialized;
+
+	/* Pending and current transmissions */
+	struct mpsc tx_q;
+	struct rtio_iodev_sqe *tx_curr;
+	uint32_t tx_pos;
+
+	/* Pending and current reads */
+	struct mpsc rx_q;
+	struct rtio_iodev_sqe *rx_curr;
+	uint8_t *rx_buf;
+	uint32_t rx_buf_len;
+	uint32_t rx_pos;
+	struct k_timer rx_timer;
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api uart_rtio_iodev_api;
+/** @endcond */
+
+/**
+ * @brief Define a UART RTIO iodev.
+ *
+ * @param name Symbolic name of the iodev.
+ * @param dev_ UART device, must support the interrupt driven API.
+ * @param rx_len_ Bytes received into each mempool buffer.
+ * @param rx_timeout_us_ Idle time in microseconds after which a partially filled
+ *			 read completes.
+ */
+#define UART_RTIO_IODEV_DEFINE(name, dev_, rx_len_, rx_timeout_us_)                                \
+	static struct uart_rtio_data _uart_rtio_data_##name = {                                    \
+		.dev = (dev_),                                                                     \
+		.rx_len = (rx_len_),                                                               \
+		.rx_timeout_us = (rx_timeout_us_),                                                 \
+		.tx_q = MPSC_INIT((_uart_rtio_data_##name.tx_q)),                                  \
+		.rx_q = MPSC_INIT((_uart_rtio_data_##name.rx_q)),                                  \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &uart_rtio_iodev_api, &_uart_rtio_data_##name)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_DRIVERS_SERIAL_UART_RTIO_H_ */
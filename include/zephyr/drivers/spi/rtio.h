@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_SPI_RTIO_H_
+#define ZEPHYR_DRIVERS_SPI_RTIO_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Driver context for scheduling spi transactions with rtio
+ *
+ * Decides which of the queued transactions the controller transfers next,
+ * while the driver does the transfers:
+ *
+ * - Transactions are taken from an iodev queue, which with
+ *   CONFIG_RTIO_DEADLINE hands out the earliest deadline, then the highest
+ *   priority first.
+ * - A TX or RX submission flagged with RTIO_IODEV_SPI_CHUNKED is transferred
+ *   CONFIG_SPI_RTIO_CHUNK_SIZE bytes at a time, each chunk in a chip select
+ *   frame of its own. Queued transactions not ranked below it run between
+ *   its chunks.
+ * - Transactions for the same device queued back to back are coalesced, up
+ *   to the limit set with spi_rtio_coalesce_set(), and completed together.
+ */
+struct spi_rtio {
+	struct k_spinlock lock;
+	struct rtio_iodev_queue io_q;
+	/* Transaction to transfer, NULL while the bus is idle */
+	struct rtio_iodev_sqe *txn_head;
+	/* Transactions started back to back, txn_head is txn[txn_idx] */
+	struct rtio_iodev_sqe *txn[CONFIG_SPI_RTIO_COALESCE_MAX];
+	/* Results of the transactions of the batch, reported once all are done */
+	int txn_status[CONFIG_SPI_RTIO_COALESCE_MAX];
+	uint8_t txn_count;
+	uint8_t txn_idx;
+	uint8_t coalesce;
+	/* Chunked transfer in progress, and the bytes of it transferred so far */
+	struct rtio_iodev_sqe *chunked;
+	uint32_t chunk_pos;
+	/* Length of the chunk to transfer, 0 if txn_head is to be transferred whole */
+	uint32_t chunk_len;
+};
+
+/**
+ * @brief Initialize a spi rtio context
+ *
+ * @param ctx SPI RTIO driver context
+ */
+void spi_rtio_init(struct spi_rtio *ctx);
+
+/**
+ * @brief Submit, atomically, a submission to work on at some point
+ *
+ * @param ctx SPI RTIO driver context
+ * @param iodev_sqe Submission to queue
+ *
+ * @retval true ctx->txn_head is ready to be transferred by the caller
+ * @retval false No new transaction to start or transactions are in progress already
+ */
+bool spi_rtio_submit(struct spi_rtio *ctx, struct rtio_iodev_sqe *iodev_sqe);
+
+/**
+ * @brief Signal that the transfer of ctx->txn_head has been completed
+ *
+ * Called once the whole transaction, or the chunk of it given by
+ * ctx->chunk_pos and ctx->chunk_len, has been transferred.
+ *
+ * @param ctx SPI RTIO driver context
+ * @param status Completion status, negative values are errors
+ *
+ * @retval true ctx->txn_head is ready to be transferred
+ * @retval false No more transactions to work on
+ */
+bool spi_rtio_complete(struct spi_rtio *ctx, int status);
+
+/**
+ * @brief Set how many transactions for the same device are coalesced
+ *
+ * Transactions for the same device queued back to back are taken from the
+ * queue together and transferred one after the other, and their completions
+ * are only reported once the last one is done. A controller able to chain
+ * them can thus interrupt once for the whole batch. Coalescing is off by
+ * default.
+ *
+ * @param ctx SPI RTIO driver context
+ * @param count Maximum number of transactions coalesced, 1 to turn coalescing
+ *	off. Limited to CONFIG_SPI_RTIO_COALESCE_MAX.
+ */
+void spi_rtio_coalesce_set(struct spi_rtio *ctx, uint8_t count);
+
+/**
+ * @brief Check if the current transaction is followed by another one of its batch
+ *
+ * @param ctx SPI RTIO driver context
+ *
+ * @retval true Another coalesced transaction is started once the current one is done
+ * @retval false The current transaction is the last one of its batch
+ */
+static inline bool spi_rtio_txn_batched(const struct spi_rtio *ctx)
+{
+	return (ctx->txn_idx + 1U) < ctx->txn_count;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_DRIVERS_SPI_RTIO_H_ */
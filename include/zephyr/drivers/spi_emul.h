@@ -94,6 +94,28 @@ struct spi_emul_api {
  */
 uint32_t spi_emul_get_config(const struct device *dev);
 
+/**
+ * Set the time RTIO transactions on the emulated bus take to complete
+ *
+ * @param dev SPI emulation controller device
+ * @param latency_us Latency in microseconds, 0 to complete transactions
+ *	synchronously within their submission.
+ */
+void spi_emul_rtio_latency_set(const struct device *dev, uint32_t latency_us);
+
+/**
+ * Set how many RTIO transactions for the same device are coalesced
+ *
+ * Sets the coalescing of the SPI RTIO context of the bus, see
+ * spi_rtio_coalesce_set(). The emulated controller transfers the transactions
+ * of a batch back to back, and completes them together after a single latency.
+ *
+ * @param dev SPI emulation controller device
+ * @param count Maximum number of transactions completed together, 1 to turn
+ *	coalescing off. Limited to CONFIG_SPI_RTIO_COALESCE_MAX.
+ */
+void spi_emul_rtio_coalesce_set(const struct device *dev, uint8_t count);
+
 #ifdef __cplusplus
 }
 #endif
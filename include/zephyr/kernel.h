@@ -414,12 +414,41 @@ static inline void k_thread_heap_assign(struct k_thread *thread,
  * @return 0 on success
  * @return -EBADF Bad thread object (user mode only)
  * @return -EPERM No permissions on thread object (user mode only)
- * #return -ENOTSUP Forbidden by hardware policy
+ * @return -ENOTSUP Forbidden by hardware policy
  * @return -EINVAL Thread is uninitialized or exited (user mode only)
  * @return -EFAULT Bad memory address for unused_ptr (user mode only)
  */
 __syscall int k_thread_stack_space_get(const struct k_thread *thread,
 				       size_t *unused_ptr);
+
+#if defined(CONFIG_STACK_WATERMARK) || defined(__DOXYGEN__)
+/**
+ * @brief Obtain stack usage information incrementally for the specified thread
+ *
+ * Works like k_thread_stack_space_get(), but caches the result per thread.
+ * The first call performs the same exact scan. Later calls only scan the
+ * stack from the previously found watermark towards the stack bottom, and
+ * end once @kconfig{CONFIG_STACK_WATERMARK_GAP} consecutive bytes are found
+ * untouched, so their cost depends on how much the stack usage grew since
+ * the previous call, not on the stack size.
+ *
+ * Stack usage which grew since the previous call below an untouched area of
+ * at least @kconfig{CONFIG_STACK_WATERMARK_GAP} bytes is not accounted; use
+ * k_thread_stack_space_get() when an exact result is required.
+ *
+ * @param thread Thread to inspect stack information
+ * @param unused_ptr Output parameter, filled in with the unused stack space
+ *	of the target thread in bytes.
+ * @return 0 on success
+ * @return -EBADF Bad thread object (user mode only)
+ * @return -EPERM No permissions on thread object (user mode only)
+ * @return -ENOTSUP Forbidden by hardware policy
+ * @return -EINVAL Thread is uninitialized or exited (user mode only)
+ * @return -EFAULT Bad memory address for unused_ptr (user mode only)
+ */
+__syscall int k_thread_stack_watermark_get(const struct k_thread *thread,
+					   size_t *unused_ptr);
+#endif /* CONFIG_STACK_WATERMARK */
 #endif
 
 #if (K_HEAP_MEM_POOL_SIZE > 0)
@@ -2928,6 +2957,11 @@ struct k_mutex {
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	struct k_obj_core obj_core;
 #endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	/** Histogram of time spent blocked waiting for the mutex */
+	struct k_latency_hist wait_hist;
+#endif
 };
 
 /**
@@ -3120,6 +3154,10 @@ struct k_sem {
 #ifdef CONFIG_OBJ_CORE_SEM
 	struct k_obj_core  obj_core;
 #endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	struct k_latency_hist wait_hist;
+#endif
 };
 
 #define Z_SEM_INITIALIZER(obj, initial_count, count_limit) \
@@ -3893,6 +3931,11 @@ struct k_work {
 	 * It can be RUNNING and CANCELING simultaneously.
 	 */
 	uint32_t flags;
+
+#ifdef CONFIG_OBJ_CORE_STATS_WORK_Q
+	/* Cycle count at which the item was last queued. */
+	uint32_t queued_cycles;
+#endif
 };
 
 #define Z_WORK_INITIALIZER(work_handler) { \
@@ -4023,6 +4066,106 @@ struct k_work_queue_config {
 	bool essential;
 };
 
+#if defined(CONFIG_OBJ_CORE_STATS_WORK_Q) || defined(__DOXYGEN__)
+/** @brief Raw work queue statistics, in cycles.
+ *
+ * The object core statistics of a work queue are its delay histogram,
+ * retrieved as struct k_latency_hist with k_obj_core_stats_raw() and as
+ * struct k_latency_stats with k_obj_core_stats_query(), like the other
+ * latency histograms. k_obj_core_stats_reset() clears all of them.
+ */
+struct k_work_q_stats {
+	/** Number of work items executed */
+	uint32_t count;
+	/** Shortest time between submission and execution */
+	uint32_t delay_min;
+	/** Shortest handler execution time */
+	uint32_t run_min;
+	/** Sum of times between submission and execution */
+	uint64_t delay_total;
+	/** Sum of handler execution times */
+	uint64_t run_total;
+	/** Histogram of times between submission and execution */
+	struct k_latency_hist delay_hist;
+	/** Histogram of handler execution times */
+	struct k_latency_hist run_hist;
+};
+
+/** @brief Summary of one work queue timing, in cycles. */
+struct k_work_q_timing {
+	uint32_t min; /**< Shortest time */
+	uint32_t avg; /**< Average time */
+	uint32_t max; /**< Longest time */
+	uint32_t p50; /**< Median time */
+	uint32_t p90; /**< 90th percentile time */
+	uint32_t p99; /**< 99th percentile time */
+};
+
+/** @brief Work queue statistics summary.
+ *
+ * Retrieved with k_work_queue_stats_get().
+ */
+struct k_work_q_stats_summary {
+	/** Number of work items executed */
+	uint32_t count;
+	/** Time between submission and execution */
+	struct k_work_q_timing delay;
+	/** Handler execution time */
+	struct k_work_q_timing run;
+};
+
+/** @brief Statistics of one work handler function, in cycles. */
+struct k_work_handler_stats {
+	/** Handler function the statistics belong to */
+	k_work_handler_t handler;
+	/** Number of invocations */
+	uint32_t count;
+	/** Longest time between submission and execution */
+	uint32_t delay_max;
+	/** Longest execution time */
+	uint32_t run_max;
+	/** Sum of execution times */
+	uint64_t run_total;
+};
+
+/**
+ * @brief Get the delay and execution time statistics of a work queue
+ *
+ * @param queue Work queue.
+ * @param stats Summary to fill.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if a parameter is NULL
+ */
+int k_work_queue_stats_get(struct k_work_q *queue,
+			   struct k_work_q_stats_summary *stats);
+
+/**
+ * @brief Copy the per handler work statistics
+ *
+ * Handlers are accounted on all work queues together, keyed by the
+ * address of the handler function. At most
+ * CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS handlers are tracked; invocations
+ * of further handlers are only counted in the work queue statistics.
+ *
+ * The statistics can be copied in chunks, by skipping the handlers already
+ * copied, until fewer than @p max are returned.
+ *
+ * @param stats Array to copy the handler statistics to.
+ * @param skip Number of tracked handlers to skip.
+ * @param max Number of elements in @p stats.
+ *
+ * @return Number of handler statistics copied.
+ */
+size_t k_work_handler_stats_get(struct k_work_handler_stats *stats, size_t skip,
+				size_t max);
+
+/**
+ * @brief Reset the per handler work statistics
+ */
+void k_work_handler_stats_reset(void);
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q */
+
 /** @brief A structure used to hold work until it can be processed. */
 struct k_work_q {
 	/* The thread that animates the work. */
@@ -4043,6 +4186,15 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_OBJ_CORE_WORK_Q
+	struct k_obj_core obj_core;
+#endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_WORK_Q
+	/* Delay and execution time statistics of the items. */
+	struct k_work_q_stats stats;
+#endif
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4448,6 +4600,11 @@ struct k_msgq {
 #ifdef CONFIG_OBJ_CORE_MSGQ
 	struct k_obj_core  obj_core;
 #endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+	/** Histogram of time spent blocked in put and get */
+	struct k_latency_hist wait_hist;
+#endif
 };
 /**
  * @cond INTERNAL_HIDDEN
@@ -8,6 +8,7 @@
 #define __KERNEL_OBJ_CORE_H__
 
 #include <zephyr/sys/slist.h>
+#include <zephyr/kernel/stats.h>
 
 /**
  * @defgroup obj_core_apis Object Core APIs
@@ -59,6 +60,10 @@
 #define K_OBJ_TYPE_THREAD_ID     K_OBJ_TYPE_ID_GEN("THRD")
 /** Timer object type */
 #define K_OBJ_TYPE_TIMER_ID      K_OBJ_TYPE_ID_GEN("TIMR")
+/** Work queue object type */
+#define K_OBJ_TYPE_WORK_Q_ID     K_OBJ_TYPE_ID_GEN("WRKQ")
+/** Latency histogram object type */
+#define K_OBJ_TYPE_LATENCY_ID    K_OBJ_TYPE_ID_GEN("LTCY")
 
 struct k_obj_type;
 struct k_obj_core;
@@ -126,6 +131,21 @@ struct k_obj_core {
 #endif /* CONFIG_OBJ_CORE_STATS */
 };
 
+#if defined(CONFIG_OBJ_CORE_STATS_LATENCY) || defined(__DOXYGEN__)
+/**
+ * Standalone latency histogram object
+ *
+ * Used for latencies that do not belong to a single kernel object, such as
+ * the IRQ to thread wakeup latency. Its raw statistics are the histogram,
+ * and queries report a @ref k_latency_stats summary.
+ */
+struct k_obj_core_latency {
+	const char            *name;  /**< Name of the measured latency */
+	struct k_latency_hist  hist;  /**< Latency histogram */
+	struct k_obj_core      obj_core; /**< Object core */
+};
+#endif /* CONFIG_OBJ_CORE_STATS_LATENCY */
+
 /**
  * @brief Initialize a specific object type
  *
@@ -390,5 +410,18 @@ int k_obj_core_stats_disable(struct k_obj_core *obj_core);
  */
 int k_obj_core_stats_enable(struct k_obj_core *obj_core);
 
+#if defined(CONFIG_OBJ_CORE_STATS_LATENCY) || defined(__DOXYGEN__)
+/**
+ * @brief Register a standalone latency histogram object
+ *
+ * Links the object to the list of objects of type
+ * @ref K_OBJ_TYPE_LATENCY_ID and registers its histogram for statistics
+ * gathering.
+ *
+ * @param latency Pointer to the latency histogram object
+ */
+void k_obj_core_latency_register(struct k_obj_core_latency *latency);
+#endif /* CONFIG_OBJ_CORE_STATS_LATENCY */
+
 /** @} */
 #endif /* __KERNEL_OBJ_CORE_H__ */
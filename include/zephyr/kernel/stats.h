@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <zephyr/sys/atomic.h>
 
 /**
  * Structure used to track internal statistics about both thread
@@ -30,4 +31,83 @@ struct k_cycle_stats {
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+#if defined(CONFIG_OBJ_CORE_STATS_LATENCY) || defined(__DOXYGEN__)
+
+/** Number of buckets of a latency histogram */
+#define K_LATENCY_HIST_BUCKETS CONFIG_OBJ_CORE_STATS_LATENCY_BUCKETS
+
+/**
+ * Latency histogram with power of two buckets.
+ *
+ * Bucket 0 counts latencies of zero cycles, bucket N counts latencies
+ * from 2^(N-1) up to 2^N - 1 cycles. The last bucket also counts all
+ * longer latencies. All counters are updated without locking.
+ */
+struct k_latency_hist {
+	atomic_t  buckets[K_LATENCY_HIST_BUCKETS]; /**< sample counts */
+	atomic_t  max;          /**< longest latency in cycles */
+};
+
+/**
+ * Latency summary derived from a latency histogram, in cycles.
+ *
+ * Percentiles are reported as the upper bound of the bucket the percentile
+ * falls in, capped to the longest latency recorded.
+ */
+struct k_latency_stats {
+	uint32_t  count;        /**< number of samples */
+	uint32_t  max;          /**< longest latency */
+	uint32_t  p50;          /**< median latency */
+	uint32_t  p90;          /**< 90th percentile latency */
+	uint32_t  p99;          /**< 99th percentile latency */
+};
+
+/**
+ * @brief Record a latency sample
+ *
+ * May be called from any context.
+ *
+ * @param hist Pointer to the latency histogram
+ * @param cycles Latency in cycles
+ */
+void k_latency_hist_record(struct k_latency_hist *hist, uint32_t cycles);
+
+/**
+ * @brief Get the upper bound of a latency histogram bucket
+ *
+ * @param idx Bucket index
+ *
+ * @return Longest latency in cycles counted by the bucket
+ */
+uint32_t k_latency_hist_bucket_max(unsigned int idx);
+
+/**
+ * @brief Get a percentile of a latency histogram
+ *
+ * @param hist Pointer to the latency histogram
+ * @param permille Percentile in tenths of a percent (e.g. 999 for p99.9)
+ *
+ * @return Latency in cycles, or 0 if no samples have been recorded
+ */
+uint32_t k_latency_hist_percentile(const struct k_latency_hist *hist,
+				   unsigned int permille);
+
+/**
+ * @brief Summarize a latency histogram
+ *
+ * @param hist Pointer to the latency histogram
+ * @param stats Pointer to the summary to fill
+ */
+void k_latency_hist_summarize(const struct k_latency_hist *hist,
+			      struct k_latency_stats *stats);
+
+/**
+ * @brief Clear a latency histogram
+ *
+ * @param hist Pointer to the latency histogram
+ */
+void k_latency_hist_reset(struct k_latency_hist *hist);
+
+#endif /* CONFIG_OBJ_CORE_STATS_LATENCY */
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_STATS_H_ */
@@ -145,10 +145,26 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
+
+#ifdef CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP
+	/* Cycle count at which an ISR made the thread ready, 0 if none */
+	uint32_t irq_ready_cycles;
+#endif /* CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP */
 };
 
 typedef struct _thread_base _thread_base_t;
 
+#if defined(CONFIG_STACK_WATERMARK)
+/* Stack usage found by the last watermark scan of a stack */
+struct _stack_watermark {
+	/* Unused stack size, only valid once scanned */
+	size_t unused;
+
+	/* The stack was scanned at least once */
+	bool scanned;
+};
+#endif /* CONFIG_STACK_WATERMARK */
+
 #if defined(CONFIG_THREAD_STACK_INFO)
 /* Contains the stack information of a thread */
 struct _thread_stack_info {
@@ -172,6 +188,11 @@ struct _thread_stack_info {
 	 */
 	size_t delta;
 
+#if defined(CONFIG_STACK_WATERMARK)
+	/* Stack usage found by the last watermark scan */
+	struct _stack_watermark watermark;
+#endif /* CONFIG_STACK_WATERMARK */
+
 #if defined(CONFIG_THREAD_STACK_MEM_MAPPED)
 	struct {
 		/** Base address of the memory mapped thread stack */
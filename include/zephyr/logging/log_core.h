@@ -252,7 +252,8 @@ static inline char z_log_minimal_level_to_char(int level)
 	\
 	bool is_user_context = k_is_user_context(); \
 	if (!IS_ENABLED(CONFIG_LOG_FRONTEND) && IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
-	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER((_dsource)->filters)) { \
+	    !is_user_context && (!Z_LOG_RUNTIME_LEVEL_ENABLED(_level) || \
+				 _level > Z_LOG_RUNTIME_FILTER((_dsource)->filters))) { \
 		break; \
 	} \
 	int _mode; \
@@ -336,7 +337,8 @@ static inline char z_log_minimal_level_to_char(int level)
 		break; \
 	} \
 	if (!IS_ENABLED(CONFIG_LOG_FRONTEND) && IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
-	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER(filters)) { \
+	    !is_user_context && (!Z_LOG_RUNTIME_LEVEL_ENABLED(_level) || \
+				 _level > Z_LOG_RUNTIME_FILTER(filters))) { \
 		break; \
 	} \
 	int mode; \
@@ -419,6 +421,23 @@ static inline char z_log_minimal_level_to_char(int level)
 #define Z_LOG_RUNTIME_FILTER(_filter) \
 	LOG_FILTER_SLOT_GET(&_filter, LOG_FILTER_AGGR_SLOT_IDX)
 
+#ifdef CONFIG_LOG_RUNTIME_FILTERING_SUMMARY
+/* Bit n is set when at least one local source has an aggregated runtime
+ * level of n or above. Kept in sync with the per source filters by
+ * log_filter_set().
+ */
+extern uint32_t z_log_runtime_level_summary;
+
+/* Return false if no source has level _level enabled, which rejects a
+ * disabled message with a single bit test, without loading the filters of
+ * its source.
+ */
+#define Z_LOG_RUNTIME_LEVEL_ENABLED(_level) \
+	((z_log_runtime_level_summary & BIT(_level)) != 0U)
+#else
+#define Z_LOG_RUNTIME_LEVEL_ENABLED(_level) true
+#endif
+
 /** @brief Log level value used to indicate log entry that should not be
  *	   formatted (raw string).
  */
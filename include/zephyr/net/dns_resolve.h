@@ -416,6 +416,14 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+#if defined(CONFIG_DNS_RESOLVER_COALESCE) || defined(__DOXYGEN__)
+		/** Query of the same name and type this query is waiting
+		 * for, instead of sending its own request. NULL if this
+		 * query sent a request itself.
+		 */
+		struct dns_pending_query *leader;
+#endif
 	} queries[DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
@@ -537,6 +545,9 @@ int dns_resolve_cancel_with_name(struct dns_resolve_context *ctx,
  * We might send the query to multiple servers (if there are more than one
  * server configured), but we only use the result of the first received
  * response.
+ * With CONFIG_DNS_RESOLVER_COALESCE, a query for a name and type that is
+ * already being resolved sends no request of its own and gets the results
+ * of the query in flight.
  *
  * @param ctx DNS context
  * @param query What the caller wants to resolve.
@@ -199,6 +199,9 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload supported, see net_pkt_gso_size() */
+	ETHERNET_HW_TCP_SEG_OFFLOAD	= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
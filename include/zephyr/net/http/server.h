@@ -50,6 +50,9 @@ extern "C" {
 
 #define HTTP2_PREFACE "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
 
+/* Maximum length of the HPACK encoded header block of a response. */
+#define HTTP_SERVER_MAX_HEADERS_BLOCK_LEN 64
+
 /** @endcond */
 
 /**
@@ -108,6 +111,16 @@ struct http_resource_detail_static {
 
 	/** Size of the static resource. */
 	size_t static_data_len;
+
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_HTTP_SERVER_STATIC_HEADERS_CACHE)
+	/* HPACK encoded HTTP/2 response headers, built on the first request. */
+	uint8_t headers_block[HTTP_SERVER_MAX_HEADERS_BLOCK_LEN];
+
+	/* Length of the cached headers, 0 if not built yet. */
+	uint8_t headers_block_len;
+#endif
+/** @endcond */
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -266,6 +279,8 @@ enum http1_parser_state {
 };
 
 #define HTTP_SERVER_INITIAL_WINDOW_SIZE 65536
+#define HTTP_SERVER_DEFAULT_SEND_WINDOW_SIZE 65535
+#define HTTP_SERVER_DEFAULT_MAX_FRAME_SIZE 16384
 #define HTTP_SERVER_WS_MAX_SEC_KEY_LEN 32
 
 /** @endcond */
@@ -275,6 +290,9 @@ struct http_stream_ctx {
 	int stream_id; /**< Stream identifier. */
 	enum http_stream_state stream_state; /**< Stream state. */
 	int window_size; /**< Stream-level window size. */
+	int send_window_size; /**< Stream-level window size of the peer. */
+	const uint8_t *send_data; /**< Static response data not sent yet. */
+	size_t send_len; /**< Length of the static response data not sent yet. */
 };
 
 /** @brief HTTP/2 frame representation. */
@@ -286,6 +304,30 @@ struct http_frame {
 	uint8_t *payload; /**< A pointer to the frame payload. */
 };
 
+/**
+ * @brief Buffers of an HTTP client.
+ *
+ * The buffers are taken from a pool shared by all clients when the client
+ * starts sending a request, and given back when the request has been
+ * received, so that idle connections do not hold them.
+ */
+struct http_client_buffers {
+	/** Client data buffer.  */
+	unsigned char buffer[HTTP_SERVER_CLIENT_BUFFER_SIZE];
+
+	/** HTTP/2 header parser context. */
+	struct http_hpack_header_buf header_field;
+
+	/** Request URL. */
+	unsigned char url_buffer[HTTP_SERVER_MAX_URL_LENGTH];
+
+	/** Request content type. */
+	unsigned char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN];
+
+	/** Temp buffer for currently processed header (HTTP/1 only). */
+	unsigned char header_buffer[HTTP_SERVER_MAX_HEADER_LEN];
+};
+
 /**
  * @brief Representation of an HTTP client connected to the server.
  */
@@ -293,8 +335,8 @@ struct http_client_ctx {
 	/** Socket descriptor associated with the server. */
 	int fd;
 
-	/** Client data buffer.  */
-	unsigned char buffer[HTTP_SERVER_CLIENT_BUFFER_SIZE];
+	/** Client buffers, NULL while no request is in progress. */
+	struct http_client_buffers *bufs;
 
 	/** Cursor indicating currently processed byte. */
 	unsigned char *cursor;
@@ -305,6 +347,12 @@ struct http_client_ctx {
 	/** Connection-level window size. */
 	int window_size;
 
+	/** Connection-level window size of the peer. */
+	int send_window_size;
+
+	/** Initial stream-level window size of the peer. */
+	int initial_send_window_size;
+
 	/** Server state for the associated client. */
 	enum http_server_state server_state;
 
@@ -314,9 +362,6 @@ struct http_client_ctx {
 	/** Currently processed resource detail. */
 	struct http_resource_detail *current_detail;
 
-	/** HTTP/2 header parser context. */
-	struct http_hpack_header_buf header_field;
-
 	/** HTTP/2 streams context. */
 	struct http_stream_ctx streams[HTTP_SERVER_MAX_STREAMS];
 
@@ -326,15 +371,6 @@ struct http_client_ctx {
 	/** HTTP/1 parser context. */
 	struct http_parser parser;
 
-	/** Request URL. */
-	unsigned char url_buffer[HTTP_SERVER_MAX_URL_LENGTH];
-
-	/** Request content type. */
-	unsigned char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN];
-
-	/** Temp buffer for currently processed header (HTTP/1 only). */
-	unsigned char header_buffer[HTTP_SERVER_MAX_HEADER_LEN];
-
 	/** Request content length. */
 	size_t content_len;
 
@@ -380,9 +416,10 @@ struct http_client_ctx {
 
 /** @brief Start the HTTP2 server.
  *
- * The server runs in a background thread. Once started, the server will create
- * a server socket for all HTTP services registered in the system and accept
- * connections from clients (see @ref HTTP_SERVICE_DEFINE).
+ * The server runs in a background thread, which is woken up by the socket
+ * service when there is activity on its sockets. Once started, the server will
+ * create a server socket for all HTTP services registered in the system and
+ * accept connections from clients (see @ref HTTP_SERVICE_DEFINE).
  */
 int http_server_start(void);
 
@@ -467,6 +467,19 @@ struct mqtt_transport {
 #endif
 };
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+/** @brief QoS 1 or QoS 2 message waiting for its acknowledgment. */
+struct mqtt_inflight {
+	/** Message id of the message. */
+	uint16_t message_id;
+
+	/** Type of the packet expected from the broker next, 0 if the entry
+	 *  is free.
+	 */
+	uint8_t expected;
+};
+#endif /* CONFIG_MQTT_LIB_PUBLISH_PIPELINE */
+
 /** @brief MQTT internal state. */
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
@@ -485,6 +498,17 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+	/** Internal. Length of the messages queued in the transmit buffer. */
+	uint32_t tx_batch_len;
+
+	/** Internal. Number of messages waiting for an acknowledgment. */
+	uint8_t inflight_count;
+
+	/** Internal. Messages waiting for an acknowledgment. */
+	struct mqtt_inflight inflight[CONFIG_MQTT_LIB_PUBLISH_WINDOW];
+#endif /* CONFIG_MQTT_LIB_PUBLISH_PIPELINE */
 };
 
 /**
@@ -622,11 +646,44 @@ int mqtt_connect(struct mqtt_client *client);
  * @param[in] param Parameters to be used for the publish message.
  *                  Shall not be NULL.
  *
+ * @note With @kconfig{CONFIG_MQTT_LIB_PUBLISH_PIPELINE} the message may be
+ *       queued in the transmit buffer and sent later along with other
+ *       messages, see @ref mqtt_publish_flush. The payload is copied, so
+ *       its buffer can be reused as soon as the function returns.
+ *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ * @retval -EAGAIN @kconfig{CONFIG_MQTT_LIB_PUBLISH_WINDOW} QoS 1 or QoS 2
+ *         messages are already waiting for their acknowledgment.
+ * @retval -EBUSY A message with the same message id is waiting for its
+ *         acknowledgment and @p param does not have the DUP flag set.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+/**
+ * @brief Send the messages queued by @ref mqtt_publish.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_publish_flush(struct mqtt_client *client);
+
+/**
+ * @brief Get the number of QoS 1 and QoS 2 messages waiting for their
+ *        acknowledgment.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return Number of messages for which the PUBACK or PUBCOMP has not been
+ *         received yet.
+ */
+int mqtt_publish_in_flight(struct mqtt_client *client);
+#endif /* CONFIG_MQTT_LIB_PUBLISH_PIPELINE */
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -753,6 +810,8 @@ int mqtt_abort(struct mqtt_client *client);
  *        makes it possible to respect the Keep Alive time agreed with the
  *        broker on connection. @ref mqtt_connect for details on Keep Alive
  *        time.
+ * @note  With @kconfig{CONFIG_MQTT_LIB_PUBLISH_PIPELINE} this also sends the
+ *        messages queued by @ref mqtt_publish.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  */
@@ -766,7 +825,8 @@ int mqtt_live(struct mqtt_client *client);
  *
  * @return Time in milliseconds until next keep alive message is expected to
  *         be sent. Function will return -1 if keep alive messages are
- *         not enabled.
+ *         not enabled, and 0 if messages queued by @ref mqtt_publish wait
+ *         to be sent by @ref mqtt_live.
  */
 int mqtt_keepalive_time_left(const struct mqtt_client *client);
 
@@ -120,6 +120,91 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by network device driver when several network packets have
+ * been received. The packets are pushed up in the network stack together,
+ * waking up each RX traffic class thread at most once.
+ *
+ * @param iface Network interface where the packets were received.
+ * @param pkts Network packets, NULL entries are skipped.
+ * @param count Number of entries in @p pkts.
+ *
+ * @return 0 if ok, in which case the network stack owns the packets.
+ * @return <0 if error, in which case the caller needs to unref the packets.
+ */
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			size_t count);
+
+#if defined(CONFIG_NET_RX_POLL) || defined(__DOXYGEN__)
+struct net_rx_poll;
+
+/**
+ * @brief Poll a network device for received packets
+ *
+ * Called from the RX poll work queue while the device RX interrupt is
+ * masked.
+ *
+ * @param poll RX poll context of the device.
+ * @param pkts Array to store the received packets into.
+ * @param budget Maximum number of packets to store.
+ *
+ * @return Number of packets stored. When less than @p budget the device
+ * has no more packets pending and the done callback is called.
+ */
+typedef int (*net_rx_poll_cb_t)(struct net_rx_poll *poll,
+				struct net_pkt **pkts, int budget);
+
+/**
+ * @brief Polling of a network device has ended
+ *
+ * The device should unmask its RX interrupt.
+ *
+ * @param poll RX poll context of the device.
+ */
+typedef void (*net_rx_poll_done_cb_t)(struct net_rx_poll *poll);
+
+/**
+ * @brief RX poll context of a network device
+ *
+ * Instead of passing each packet to net_recv_data() from its interrupt
+ * handler, the driver masks its RX interrupt and schedules a poll. The poll
+ * callback then drains up to @kconfig{CONFIG_NET_RX_POLL_BUDGET} packets at
+ * a time, which are passed to net_recv_data_batch(), until the device runs
+ * out of packets and the interrupt is unmasked again.
+ */
+struct net_rx_poll {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_work work;
+	struct net_if *iface;
+	net_rx_poll_cb_t poll;
+	net_rx_poll_done_cb_t done;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize the RX poll context of a network device
+ *
+ * @param poll RX poll context.
+ * @param iface Network interface the packets are received on.
+ * @param poll_cb Callback draining the device.
+ * @param done_cb Callback unmasking the device RX interrupt.
+ */
+void net_rx_poll_init(struct net_rx_poll *poll, struct net_if *iface,
+		      net_rx_poll_cb_t poll_cb, net_rx_poll_done_cb_t done_cb);
+
+/**
+ * @brief Schedule polling of a network device
+ *
+ * Typically called from the RX interrupt handler once the RX interrupt is
+ * masked. Scheduling an already scheduled poll has no effect.
+ *
+ * @param poll RX poll context.
+ *
+ * @return 0 if ok, <0 if the poll could not be scheduled.
+ */
+int net_rx_poll_schedule(struct net_rx_poll *poll);
+#endif /* CONFIG_NET_RX_POLL */
+
 /**
  * @brief Send data to network.
  *
@@ -57,10 +57,33 @@ extern struct npf_rule npf_default_ok;
 /** @brief Default rule list termination for rejecting a packet */
 extern struct npf_rule npf_default_drop;
 
+/** @cond INTERNAL_HIDDEN */
+
+/* One instruction of a compiled rule list */
+struct npf_insn {
+	uint8_t op;		/* operation */
+	uint8_t key;		/* packet field switched on */
+	uint16_t count;		/* number of cases of a switch */
+	uint16_t next;		/* jump target */
+	union {
+		struct npf_test *test;		/* test to call */
+		uintptr_t value;		/* value of a case */
+		enum net_verdict result;	/* verdict to return */
+	};
+};
+
+/** @endcond */
+
 /** @brief rule set for a given test location */
 struct npf_rule_list {
 	sys_slist_t rule_head;   /**< List head */
 	struct k_spinlock lock;  /**< Lock protecting the list access */
+#if defined(CONFIG_NET_PKT_FILTER_COMPILE) || defined(__DOXYGEN__)
+	/** Rules compiled after each change of the list, NULL if not compiled */
+	struct npf_insn *prog;
+	/** Length of the program */
+	uint16_t prog_len;
+#endif
 };
 
 /** @brief  rule list applied to outgoing packets */
@@ -191,6 +214,11 @@ bool npf_remove_all_rules(struct npf_rule_list *rules);
  * the fate of the packet. If one condition is false then the next rule in
  * the list is evaluated.
  *
+ * With @kconfig{CONFIG_NET_PKT_FILTER_COMPILE}, the interface, original
+ * interface and Ethernet type of the match conditions are copied when their
+ * rule is inserted or appended, and must not change until it is removed.
+ * The conditions of a rule may be evaluated in any order.
+ *
  * @param _name Name for this rule.
  * @param _result Fate of the packet if all conditions are true, either
  *                <tt>NET_OK</tt> or <tt>NET_DROP</tt>.
@@ -0,0 +1,153 @@
+/** @file
+ * @brief IPv4 routing table public header file
+ *
+ * Static IPv4 routes, selected by longest prefix match. Destinations
+ * outside the local networks of an interface are sent to the gateway of
+ * the matching route.
+ */
+
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_NET_ROUTE_IPV4_H_
+#define ZEPHYR_INCLUDE_NET_NET_ROUTE_IPV4_H_
+
+#include <stdbool.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief IPv4 routing table
+ * @defgroup net_route_ipv4 IPv4 routing table
+ * @ingroup networking
+ * @{
+ */
+
+/**
+ * @brief IPv4 route entry.
+ */
+struct net_route_entry_ipv4 {
+	/** Network interface for the route. */
+	struct net_if *iface;
+
+	/** Next route with the same prefix on another interface. */
+	struct net_route_entry_ipv4 *lpm_next;
+
+	/** IPv4 address/prefix of the route. */
+	struct in_addr addr;
+
+	/** Gateway, unspecified if the prefix is on-link. */
+	struct in_addr gw;
+
+	/** IPv4 address/prefix length. */
+	uint8_t prefix_len;
+
+	/** Is this entry in use or not */
+	bool is_used;
+};
+
+/**
+ * @brief Callback used while iterating over the IPv4 routes.
+ *
+ * Called with the routing table locked, the entry is only valid until it
+ * returns.
+ *
+ * @param entry Route entry.
+ * @param user_data User specified data.
+ */
+typedef void (*net_route_ipv4_cb_t)(struct net_route_entry_ipv4 *entry,
+				    void *user_data);
+
+#if defined(CONFIG_NET_ROUTE_IPV4) && defined(CONFIG_NET_NATIVE)
+/**
+ * @brief Lookup the IPv4 route with the longest prefix matching a
+ * destination.
+ *
+ * The routes of an interface that is down are skipped.
+ *
+ * @param iface Network interface. If NULL, then check against all interfaces.
+ * @param dst Destination IPv4 address.
+ * @param nexthop Set to the gateway of the route, or to the destination if
+ *	the route is on-link. Can be NULL or dst.
+ *
+ * @return Network interface of the route, NULL if not found.
+ */
+struct net_if *net_route_ipv4_lookup(struct net_if *iface,
+				     const struct in_addr *dst,
+				     struct in_addr *nexthop);
+
+/**
+ * @brief Add an IPv4 route, or update the gateway of an existing one.
+ *
+ * @param iface Network interface that this route is tied to.
+ * @param addr IPv4 address/prefix.
+ * @param prefix_len Length of the IPv4 prefix.
+ * @param gw Gateway, NULL if the prefix is on-link.
+ *
+ * @return Route entry, NULL if could not be created.
+ */
+struct net_route_entry_ipv4 *net_route_ipv4_add(struct net_if *iface,
+						const struct in_addr *addr,
+						uint8_t prefix_len,
+						const struct in_addr *gw);
+
+/**
+ * @brief Delete an IPv4 route.
+ *
+ * @param route Existing route entry.
+ *
+ * @return 0 if ok, <0 if error
+ */
+int net_route_ipv4_del(struct net_route_entry_ipv4 *route);
+
+/**
+ * @brief Delete the IPv4 route of an interface to a prefix.
+ *
+ * @param iface Network interface of the route.
+ * @param addr IPv4 address/prefix.
+ * @param prefix_len Length of the IPv4 prefix.
+ *
+ * @return 0 if ok, -ENOENT if there is no such route.
+ */
+int net_route_ipv4_del_prefix(struct net_if *iface, const struct in_addr *addr,
+			      uint8_t prefix_len);
+
+/**
+ * @brief Go through all the IPv4 routing entries and call callback
+ * for each entry that is in use.
+ *
+ * @param cb User supplied callback function to call.
+ * @param user_data User specified data.
+ *
+ * @return Total number of IPv4 routing entries found.
+ */
+int net_route_ipv4_foreach(net_route_ipv4_cb_t cb, void *user_data);
+#else
+static inline struct net_if *net_route_ipv4_lookup(struct net_if *iface,
+						   const struct in_addr *dst,
+						   struct in_addr *nexthop)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(nexthop);
+
+	return NULL;
+}
+#endif /* CONFIG_NET_ROUTE_IPV4 && CONFIG_NET_NATIVE */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_NET_ROUTE_IPV4_H_ */
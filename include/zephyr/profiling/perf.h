@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_PERF_H_
+#define ZEPHYR_INCLUDE_PROFILING_PERF_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sampling profiler
+ * @defgroup profiling_perf Sampling profiler
+ * @ingroup os_services
+ * @{
+ */
+
+/**
+ * @brief Magic value starting each sample record sent to a tracing backend
+ *
+ * The value reads "ZPRF" when dumped as little-endian bytes.
+ */
+#define PERF_RECORD_MAGIC 0x46525a50U
+
+/**
+ * @brief Header of a sample record sent to a tracing backend
+ *
+ * The header is followed by @ref perf_record_hdr.depth words of
+ * @ref perf_record_hdr.word_size bytes, innermost frame first.
+ */
+struct perf_record_hdr {
+	/** Always @ref PERF_RECORD_MAGIC */
+	uint32_t magic;
+	/** Number of return addresses following the header */
+	uint16_t depth;
+	/** Size of each return address in bytes */
+	uint8_t word_size;
+	/** Reserved, set to zero */
+	uint8_t reserved;
+};
+
+/**
+ * @brief Start sampling
+ *
+ * Samples the call stack of the code interrupted by the system timer
+ * @p frequency times per second, and stores them in the sample buffer.
+ * Samples are dropped once the buffer is full.
+ *
+ * Each sample is stored in the buffer as a word holding the number of
+ * return addresses, followed by the return addresses themselves,
+ * innermost frame first.
+ *
+ * @param frequency Sampling frequency in Hz.
+ *
+ * @retval 0 Sampling started.
+ * @retval -EINVAL @p frequency is zero or above the system tick rate.
+ * @retval -EALREADY Sampling is already running.
+ */
+int perf_start(uint32_t frequency);
+
+/**
+ * @brief Stop sampling
+ *
+ * If CONFIG_PROFILING_PERF_TRACING is enabled, the collected samples are
+ * also written to the active tracing backend.
+ *
+ * @retval 0 Sampling stopped.
+ * @retval -EALREADY Sampling was not running.
+ */
+int perf_stop(void);
+
+/**
+ * @brief Check if sampling is running
+ *
+ * @return true if sampling is running, false otherwise.
+ */
+bool perf_is_running(void);
+
+/**
+ * @brief Get the sample buffer
+ *
+ * The buffer contents are stable only while sampling is stopped.
+ *
+ * @param[out] buf Set to the start of the sample buffer.
+ *
+ * @return Number of words used in the sample buffer.
+ */
+size_t perf_buf_get(const uintptr_t **buf);
+
+/**
+ * @brief Get the number of samples dropped because the buffer was full
+ *
+ * @return Number of dropped samples since the last call to perf_start().
+ */
+uint32_t perf_dropped_get(void);
+
+/**
+ * @brief Write the sample buffer to the tracing backend
+ *
+ * Each sample is written as a @ref perf_record_hdr followed by its return
+ * addresses.
+ *
+ * @retval 0 Samples written.
+ * @retval -EBUSY Sampling is running.
+ * @retval -ENOTSUP Tracing output is not enabled.
+ */
+int perf_trace_flush(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_PERF_H_ */
@@ -140,6 +140,14 @@ extern "C" {
  */
 #define RTIO_SQE_NO_RESPONSE BIT(5)
 
+/**
+ * @brief The SQE should be done by its deadline.
+ *
+ * Set by rtio_sqe_set_deadline(). With CONFIG_RTIO_DEADLINE iodev queues start
+ * the SQE with the earliest deadline first, ahead of SQEs without a deadline.
+ */
+#define RTIO_SQE_DEADLINE BIT(6)
+
 /**
  * @}
  */
@@ -192,6 +200,15 @@ extern "C" {
  * @}
  */
 
+/**
+ * @brief The SPI transfer may be split into several chip select frames
+ *
+ * Lets the bus run other transactions in between, so a long transfer does not
+ * hold off more urgent ones. Only applies to a submission which is not part of
+ * a transaction.
+ */
+#define RTIO_IODEV_SPI_CHUNKED BIT(0)
+
 /**
  * @brief Equivalent to the I2C_MSG_STOP flag
  */
@@ -240,6 +257,10 @@ struct rtio_sqe {
 
 	uint16_t _resv0;
 
+#ifdef CONFIG_RTIO_DEADLINE
+	k_timeout_t deadline; /**< Time the op should be done within, see rtio_sqe_set_deadline() */
+#endif
+
 	const struct rtio_iodev *iodev; /**< Device to operation on */
 
 	/**
@@ -304,6 +325,10 @@ struct rtio_sqe_pool {
 	const uint16_t pool_size;
 	uint16_t pool_free;
 	struct rtio_iodev_sqe *pool;
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	/* Serializes taking entries, the free queue has a single consumer */
+	struct k_spinlock lock;
+#endif
 };
 
 struct rtio_cqe_pool {
@@ -311,6 +336,10 @@ struct rtio_cqe_pool {
 	const uint16_t pool_size;
 	uint16_t pool_free;
 	struct rtio_cqe *pool;
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	/* Serializes taking entries, the free queue has a single consumer */
+	struct k_spinlock lock;
+#endif
 };
 
 /**
@@ -364,8 +393,26 @@ struct rtio {
 	/* Submission queue */
 	struct mpsc sq;
 
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	/* Keeps entries added by one caller back to back in the submission queue */
+	struct k_spinlock sq_lock;
+
+	/* Acquired entries not submitted yet, private to the caller which acquired them */
+	struct rtio_iodev_sqe *pending;
+	struct rtio_iodev_sqe *pending_tail;
+
+	/* Number of callers wanting the submission queue drained */
+	atomic_t submitters;
+
+	/* Completion queue for each CPU */
+	struct mpsc cq[CONFIG_MP_MAX_NUM_CPUS];
+
+	/* Completion queue the consumer is currently draining */
+	uint8_t cq_next;
+#else
 	/* Completion queue */
 	struct mpsc cq;
+#endif
 };
 
 /** The memory partition associated with all RTIO context information */
@@ -425,6 +472,14 @@ struct rtio_iodev_sqe {
 	struct mpsc_node q;
 	struct rtio_iodev_sqe *next;
 	struct rtio *r;
+#ifdef CONFIG_RTIO_DEADLINE
+	/* Deadline of the submission, resolved when queued on an iodev queue */
+	k_timepoint_t deadline;
+#endif
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	/* Caller which acquired the entry, until it is submitted */
+	uintptr_t producer;
+#endif
 };
 
 /**
@@ -623,31 +678,127 @@ static inline void rtio_sqe_prep_transceive(struct rtio_sqe *sqe,
 	sqe->userdata = userdata;
 }
 
+#if defined(CONFIG_RTIO_DEADLINE) || defined(__DOXYGEN__)
+/**
+ * @brief Set the deadline of a submission
+ *
+ * Call after preparing the submission. Iodev queues start the submission with
+ * the earliest deadline first, ahead of those without a deadline. A deadline only
+ * orders pending work, it neither preempts work in progress nor fails the
+ * submission once passed.
+ *
+ * The deadline is relative to the time the submission is queued on its iodev,
+ * which happens each time a multishot submission is resubmitted as well.
+ *
+ * @param sqe Submission to set the deadline of
+ * @param timeout Time from queueing the submission should be done by, K_NO_WAIT
+ *		  for as soon as possible, K_FOREVER clears the deadline
+ */
+static inline void rtio_sqe_set_deadline(struct rtio_sqe *sqe, k_timeout_t timeout)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		sqe->flags &= ~RTIO_SQE_DEADLINE;
+		return;
+	}
+
+	sqe->deadline = timeout;
+	sqe->flags |= RTIO_SQE_DEADLINE;
+}
+#endif
+
+/**
+ * @brief Check if a submission should be started before another one
+ *
+ * With CONFIG_RTIO_DEADLINE submissions with a deadline go first, earliest
+ * deadline first. Otherwise the one with the highest priority goes first.
+ * Deadlines are only known once the submissions were queued on an iodev
+ * queue.
+ *
+ * @param a Submission to compare
+ * @param b Submission to compare against
+ *
+ * @retval true if @p a should be started before @p b
+ * @retval false if @p b should be started first or they compare equal
+ */
+static inline bool rtio_iodev_sqe_precedes(const struct rtio_iodev_sqe *a,
+					   const struct rtio_iodev_sqe *b)
+{
+#ifdef CONFIG_RTIO_DEADLINE
+	const bool a_deadline = FIELD_GET(RTIO_SQE_DEADLINE, a->sqe.flags);
+	const bool b_deadline = FIELD_GET(RTIO_SQE_DEADLINE, b->sqe.flags);
+	int cmp;
+
+	if (a_deadline != b_deadline) {
+		return a_deadline;
+	}
+
+	if (a_deadline) {
+		cmp = sys_timepoint_cmp(a->deadline, b->deadline);
+		if (cmp != 0) {
+			return cmp < 0;
+		}
+	}
+#endif
+
+	return a->sqe.prio > b->sqe.prio;
+}
+
+/** @cond INTERNAL_HIDDEN */
+static inline struct mpsc_node *z_rtio_pool_pop(struct mpsc *free_q, uint16_t *pool_free)
+{
+	struct mpsc_node *node = mpsc_pop(free_q);
+
+	if (node != NULL) {
+		(*pool_free)--;
+	}
+
+	return node;
+}
+/** @endcond */
+
 static inline struct rtio_iodev_sqe *rtio_sqe_pool_alloc(struct rtio_sqe_pool *pool)
 {
-	struct mpsc_node *node = mpsc_pop(&pool->free_q);
+	struct mpsc_node *node;
+
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	K_SPINLOCK(&pool->lock) {
+		node = z_rtio_pool_pop(&pool->free_q, &pool->pool_free);
+	}
+#else
+	node = z_rtio_pool_pop(&pool->free_q, &pool->pool_free);
+#endif
 
 	if (node == NULL) {
 		return NULL;
 	}
 
-	struct rtio_iodev_sqe *iodev_sqe = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
-
-	pool->pool_free--;
-
-	return iodev_sqe;
+	return CONTAINER_OF(node, struct rtio_iodev_sqe, q);
 }
 
 static inline void rtio_sqe_pool_free(struct rtio_sqe_pool *pool, struct rtio_iodev_sqe *iodev_sqe)
 {
 	mpsc_push(&pool->free_q, &iodev_sqe->q);
 
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	K_SPINLOCK(&pool->lock) {
+		pool->pool_free++;
+	}
+#else
 	pool->pool_free++;
+#endif
 }
 
 static inline struct rtio_cqe *rtio_cqe_pool_alloc(struct rtio_cqe_pool *pool)
 {
-	struct mpsc_node *node = mpsc_pop(&pool->free_q);
+	struct mpsc_node *node;
+
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	K_SPINLOCK(&pool->lock) {
+		node = z_rtio_pool_pop(&pool->free_q, &pool->pool_free);
+	}
+#else
+	node = z_rtio_pool_pop(&pool->free_q, &pool->pool_free);
+#endif
 
 	if (node == NULL) {
 		return NULL;
@@ -657,8 +808,6 @@ static inline struct rtio_cqe *rtio_cqe_pool_alloc(struct rtio_cqe_pool *pool)
 
 	memset(cqe, 0, sizeof(struct rtio_cqe));
 
-	pool->pool_free--;
-
 	return cqe;
 }
 
@@ -666,7 +815,13 @@ static inline void rtio_cqe_pool_free(struct rtio_cqe_pool *pool, struct rtio_cq
 {
 	mpsc_push(&pool->free_q, &cqe->q);
 
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	K_SPINLOCK(&pool->lock) {
+		pool->pool_free++;
+	}
+#else
 	pool->pool_free++;
+#endif
 }
 
 static inline int rtio_block_pool_alloc(struct rtio *r, size_t min_sz,
@@ -783,6 +938,8 @@ static inline void rtio_block_pool_free(struct rtio *r, void *buf, uint32_t buf_
 	_SYS_MEM_BLOCKS_DEFINE_WITH_EXT_BUF(name, WB_UP(blk_sz), blk_cnt,                          \
 					    CONCAT(_block_pool_, name),	RTIO_DMEM)
 
+#define Z_RTIO_CQ_INIT(i, name) MPSC_INIT((name.cq[i]))
+
 #define Z_RTIO_DEFINE(name, _sqe_pool, _cqe_pool, _block_pool)                                     \
 	IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM,                                                         \
 		   (static K_SEM_DEFINE(CONCAT(_submit_sem_, name), 0, K_SEM_MAX_LIMIT)))          \
@@ -798,7 +955,10 @@ static inline void rtio_block_pool_free(struct rtio *r, void *buf, uint32_t buf_
 		.cqe_pool = _cqe_pool,                                                             \
 		IF_ENABLED(CONFIG_RTIO_SYS_MEM_BLOCKS, (.block_pool = _block_pool,))               \
 		.sq = MPSC_INIT((name.sq)),                                                        \
-		.cq = MPSC_INIT((name.cq)),                                                        \
+		COND_CODE_1(CONFIG_RTIO_MULTI_PRODUCER,                                            \
+			    (.submitters = ATOMIC_INIT(0),                                         \
+			     .cq = {LISTIFY(CONFIG_MP_MAX_NUM_CPUS, Z_RTIO_CQ_INIT, (,), name)},),  \
+			    (.cq = MPSC_INIT((name.cq)),))                                         \
 	}
 
 /**
@@ -894,9 +1054,207 @@ static inline struct rtio_iodev_sqe *rtio_iodev_sqe_next(const struct rtio_iodev
 	return iodev_sqe->next;
 }
 
+/**
+ * @brief Queue of submissions pending on an iodev
+ *
+ * A first in first out queue, or with CONFIG_RTIO_DEADLINE a queue handing out
+ * the submission with the earliest deadline first, then the one with the highest
+ * priority. Submissions which compare equal are handed out in the order queued.
+ */
+struct rtio_iodev_queue {
+	/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_RTIO_DEADLINE
+	struct k_spinlock lock;
+	struct mpsc_node *head;
+#else
+	struct mpsc q;
+#endif
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_RTIO_DEADLINE
+#define Z_RTIO_IODEV_QUEUE_INIT(name) {.head = NULL}
+#else
+#define Z_RTIO_IODEV_QUEUE_INIT(name) {.q = MPSC_INIT((name.q))}
+#endif
+
+void z_rtio_iodev_queue_push(struct rtio_iodev_queue *queue, struct rtio_iodev_sqe *iodev_sqe);
+struct rtio_iodev_sqe *z_rtio_iodev_queue_pop(struct rtio_iodev_queue *queue);
+struct rtio_iodev_sqe *z_rtio_iodev_queue_peek(struct rtio_iodev_queue *queue);
+/** @endcond */
+
+/**
+ * @brief Statically initialize an iodev queue
+ *
+ * @param name Name of the queue being initialized
+ */
+#define RTIO_IODEV_QUEUE_INIT(name) Z_RTIO_IODEV_QUEUE_INIT(name)
+
+/**
+ * @brief Initialize an iodev queue
+ *
+ * @param queue Queue to initialize
+ */
+static inline void rtio_iodev_queue_init(struct rtio_iodev_queue *queue)
+{
+#ifdef CONFIG_RTIO_DEADLINE
+	queue->head = NULL;
+#else
+	mpsc_init(&queue->q);
+#endif
+}
+
+/**
+ * @brief Queue a submission on an iodev
+ *
+ * May be called from any context, concurrently with rtio_iodev_queue_pop().
+ *
+ * @param queue Queue of the iodev
+ * @param iodev_sqe Submission to queue
+ */
+static inline void rtio_iodev_queue_push(struct rtio_iodev_queue *queue,
+					 struct rtio_iodev_sqe *iodev_sqe)
+{
+#ifdef CONFIG_RTIO_DEADLINE
+	z_rtio_iodev_queue_push(queue, iodev_sqe);
+#else
+	mpsc_push(&queue->q, &iodev_sqe->q);
+#endif
+}
+
+/**
+ * @brief Take the next submission to start from an iodev queue
+ *
+ * Must be called by one consumer at a time.
+ *
+ * @param queue Queue of the iodev
+ *
+ * @retval NULL if the queue is empty
+ * @retval struct rtio_iodev_sqe * next submission to start
+ */
+static inline struct rtio_iodev_sqe *rtio_iodev_queue_pop(struct rtio_iodev_queue *queue)
+{
+#ifdef CONFIG_RTIO_DEADLINE
+	return z_rtio_iodev_queue_pop(queue);
+#else
+	struct mpsc_node *node = mpsc_pop(&queue->q);
+
+	return (node == NULL) ? NULL : CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+#endif
+}
+
+/**
+ * @brief Get the submission rtio_iodev_queue_pop() would take next
+ *
+ * The submission stays queued. A submission queued in between may still be
+ * taken first by the next rtio_iodev_queue_pop(). Must be called by the consumer.
+ *
+ * @param queue Queue of the iodev
+ *
+ * @retval NULL if the queue is empty
+ * @retval struct rtio_iodev_sqe * next submission to start
+ */
+static inline struct rtio_iodev_sqe *rtio_iodev_queue_peek(struct rtio_iodev_queue *queue)
+{
+#ifdef CONFIG_RTIO_DEADLINE
+	return z_rtio_iodev_queue_peek(queue);
+#else
+	struct mpsc_node *node = mpsc_peek(&queue->q);
+
+	return (node == NULL) ? NULL : CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+#endif
+}
+
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+/** @cond INTERNAL_HIDDEN */
+/* Identifies the caller owning the entries it acquires. An ISR runs to
+ * completion on its CPU, so each interrupt nesting level of each CPU is a
+ * caller of its own. It is identified by the CPU id and nesting level,
+ * tagged with the lowest bit which is clear in thread pointers.
+ */
+static inline uintptr_t z_rtio_producer(void)
+{
+	if (k_is_in_isr()) {
+		struct _cpu *cpu = arch_curr_cpu();
+
+		return ((uintptr_t)cpu->id << 16) | ((uintptr_t)cpu->nested << 1) | 1U;
+	}
+
+	return (uintptr_t)k_current_get();
+}
+
+/* Take the entries acquired by the caller off the pending list, in
+ * acquisition order and linked through next. Called with sq_lock held.
+ */
+static inline struct rtio_iodev_sqe *z_rtio_sqe_pending_take(struct rtio *r)
+{
+	uintptr_t producer = z_rtio_producer();
+	struct rtio_iodev_sqe *first = NULL;
+	struct rtio_iodev_sqe *last = NULL;
+	struct rtio_iodev_sqe *prev = NULL;
+	struct rtio_iodev_sqe *curr = r->pending;
+	struct rtio_iodev_sqe *next;
+
+	while (curr != NULL) {
+		next = curr->next;
+
+		if (curr->producer != producer) {
+			prev = curr;
+			curr = next;
+			continue;
+		}
+
+		if (prev == NULL) {
+			r->pending = next;
+		} else {
+			prev->next = next;
+		}
+
+		if (r->pending_tail == curr) {
+			r->pending_tail = prev;
+		}
+
+		curr->next = NULL;
+		if (last == NULL) {
+			first = curr;
+		} else {
+			last->next = curr;
+		}
+		last = curr;
+
+		curr = next;
+	}
+
+	return first;
+}
+
+/* Make the entries acquired by the caller visible to the executor. Called
+ * with sq_lock held, so they stay back to back in the submission queue.
+ */
+static inline void z_rtio_sqe_pending_queue(struct rtio *r)
+{
+	struct rtio_iodev_sqe *iodev_sqe = z_rtio_sqe_pending_take(r);
+	struct rtio_iodev_sqe *next;
+
+	while (iodev_sqe != NULL) {
+		/* Once queued the executor may reuse the link */
+		next = iodev_sqe->next;
+		mpsc_push(&r->sq, &iodev_sqe->q);
+		iodev_sqe = next;
+	}
+}
+/** @endcond */
+#endif /* CONFIG_RTIO_MULTI_PRODUCER */
+
 /**
  * @brief Acquire a single submission queue event if available
  *
+ * With @kconfig{CONFIG_RTIO_MULTI_PRODUCER} the entry stays private to the
+ * calling thread, or interrupt, until it calls rtio_submit() or
+ * rtio_sqe_copy_in() on the same context, so it is never executed while
+ * being filled in.
+ *
  * @param r RTIO context
  *
  * @retval sqe A valid submission queue event acquired from the submission queue
@@ -910,7 +1268,21 @@ static inline struct rtio_sqe *rtio_sqe_acquire(struct rtio *r)
 		return NULL;
 	}
 
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	iodev_sqe->producer = z_rtio_producer();
+	iodev_sqe->next = NULL;
+
+	K_SPINLOCK(&r->sq_lock) {
+		if (r->pending_tail == NULL) {
+			r->pending = iodev_sqe;
+		} else {
+			r->pending_tail->next = iodev_sqe;
+		}
+		r->pending_tail = iodev_sqe;
+	}
+#else
 	mpsc_push(&r->sq, &iodev_sqe->q);
+#endif
 
 	return &iodev_sqe->sqe;
 }
@@ -918,11 +1290,28 @@ static inline struct rtio_sqe *rtio_sqe_acquire(struct rtio *r)
 /**
  * @brief Drop all previously acquired sqe
  *
+ * With @kconfig{CONFIG_RTIO_MULTI_PRODUCER} only the entries acquired by the
+ * caller are dropped.
+ *
  * @param r RTIO context
  */
 static inline void rtio_sqe_drop_all(struct rtio *r)
 {
 	struct rtio_iodev_sqe *iodev_sqe;
+
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	struct rtio_iodev_sqe *next;
+
+	K_SPINLOCK(&r->sq_lock) {
+		iodev_sqe = z_rtio_sqe_pending_take(r);
+	}
+
+	while (iodev_sqe != NULL) {
+		next = iodev_sqe->next;
+		rtio_sqe_pool_free(r->sqe_pool, iodev_sqe);
+		iodev_sqe = next;
+	}
+#else
 	struct mpsc_node *node = mpsc_pop(&r->sq);
 
 	while (node != NULL) {
@@ -930,6 +1319,7 @@ static inline void rtio_sqe_drop_all(struct rtio *r)
 		rtio_sqe_pool_free(r->sqe_pool, iodev_sqe);
 		node = mpsc_pop(&r->sq);
 	}
+#endif
 }
 
 /**
@@ -953,9 +1343,42 @@ static inline struct rtio_cqe *rtio_cqe_acquire(struct rtio *r)
  */
 static inline void rtio_cqe_produce(struct rtio *r, struct rtio_cqe *cqe)
 {
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+#ifdef CONFIG_SMP
+	/* Migrating after reading the CPU id is harmless, any CPU may push to any queue */
+	mpsc_push(&r->cq[arch_curr_cpu()->id], &cqe->q);
+#else
+	mpsc_push(&r->cq[0], &cqe->q);
+#endif
+#else
 	mpsc_push(&r->cq, &cqe->q);
+#endif
 }
 
+/** @cond INTERNAL_HIDDEN */
+static inline struct mpsc_node *z_rtio_cq_pop(struct rtio *r)
+{
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	const unsigned int num_cpus = arch_num_cpus();
+	struct mpsc_node *node;
+
+	/* Take completions from one CPU in a batch before moving on to the next */
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		node = mpsc_pop(&r->cq[r->cq_next]);
+		if (node != NULL) {
+			return node;
+		}
+
+		r->cq_next = (r->cq_next + 1) % num_cpus;
+	}
+
+	return NULL;
+#else
+	return mpsc_pop(&r->cq);
+#endif
+}
+/** @endcond */
+
 /**
  * @brief Consume a single completion queue event if available
  *
@@ -978,7 +1401,7 @@ static inline struct rtio_cqe *rtio_cqe_consume(struct rtio *r)
 	}
 #endif
 
-	node = mpsc_pop(&r->cq);
+	node = z_rtio_cq_pop(r);
 	if (node == NULL) {
 		return NULL;
 	}
@@ -1005,10 +1428,10 @@ static inline struct rtio_cqe *rtio_cqe_consume_block(struct rtio *r)
 #ifdef CONFIG_RTIO_CONSUME_SEM
 	k_sem_take(r->consume_sem, K_FOREVER);
 #endif
-	node = mpsc_pop(&r->cq);
+	node = z_rtio_cq_pop(r);
 	while (node == NULL) {
 		Z_SPIN_DELAY(1);
-		node = mpsc_pop(&r->cq);
+		node = z_rtio_cq_pop(r);
 	}
 	cqe = CONTAINER_OF(node, struct rtio_cqe, q);
 
@@ -1309,6 +1732,66 @@ static inline int z_impl_rtio_sqe_cancel(struct rtio_sqe *sqe)
 	return 0;
 }
 
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+/** @cond INTERNAL_HIDDEN */
+static inline void z_rtio_sqe_batch_free(struct rtio *r, struct rtio_iodev_sqe *first, size_t count)
+{
+	struct rtio_iodev_sqe *next;
+
+	for (size_t i = 0; i < count; i++) {
+		next = first->next;
+		rtio_sqe_pool_free(r->sqe_pool, first);
+		first = next;
+	}
+}
+
+/* Take and fill in entries linked through next, without queueing them yet */
+static inline int z_rtio_sqe_batch_alloc(struct rtio *r, const struct rtio_sqe *sqes,
+					 size_t count, struct rtio_iodev_sqe **first)
+{
+	struct rtio_iodev_sqe *last = NULL;
+	struct rtio_iodev_sqe *iodev_sqe;
+
+	for (size_t i = 0; i < count; i++) {
+		iodev_sqe = rtio_sqe_pool_alloc(r->sqe_pool);
+		if (iodev_sqe == NULL) {
+			z_rtio_sqe_batch_free(r, *first, i);
+			return -ENOMEM;
+		}
+
+		iodev_sqe->sqe = sqes[i];
+		if (last == NULL) {
+			*first = iodev_sqe;
+		} else {
+			last->next = iodev_sqe;
+		}
+		last = iodev_sqe;
+	}
+
+	return 0;
+}
+
+/* Queue entries back to back so chains from different callers do not interleave.
+ * Entries the caller acquired before are queued first, as they were acquired first.
+ */
+static inline void z_rtio_sqe_batch_queue(struct rtio *r, struct rtio_iodev_sqe *first,
+					  size_t count)
+{
+	K_SPINLOCK(&r->sq_lock) {
+		z_rtio_sqe_pending_queue(r);
+
+		for (size_t i = 0; i < count; i++) {
+			/* Once queued the executor may reuse the link */
+			struct rtio_iodev_sqe *next = first->next;
+
+			mpsc_push(&r->sq, &first->q);
+			first = next;
+		}
+	}
+}
+/** @endcond */
+#endif /* CONFIG_RTIO_MULTI_PRODUCER */
+
 /**
  * @brief Copy an array of SQEs into the queue and get resulting handles back
  *
@@ -1331,6 +1814,23 @@ static inline int z_impl_rtio_sqe_copy_in_get_handles(struct rtio *r, const stru
 						      struct rtio_sqe **handle,
 						      size_t sqe_count)
 {
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	struct rtio_iodev_sqe *first;
+	int rc;
+
+	rc = z_rtio_sqe_batch_alloc(r, sqes, sqe_count, &first);
+	if (rc != 0 || sqe_count == 0) {
+		return rc;
+	}
+
+	if (handle != NULL) {
+		*handle = &first->sqe;
+	}
+
+	z_rtio_sqe_batch_queue(r, first, sqe_count);
+
+	return 0;
+#else
 	struct rtio_sqe *sqe;
 	uint32_t acquirable = rtio_sqe_acquirable(r);
 
@@ -1348,6 +1848,7 @@ static inline int z_impl_rtio_sqe_copy_in_get_handles(struct rtio *r, const stru
 	}
 
 	return 0;
+#endif
 }
 
 /**
@@ -1451,6 +1952,13 @@ static inline int z_impl_rtio_submit(struct rtio *r, uint32_t wait_count)
 	uintptr_t cq_count = (uintptr_t)atomic_get(&r->cq_count) + wait_count;
 #endif
 
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	/* Entries acquired by the caller are complete now */
+	K_SPINLOCK(&r->sq_lock) {
+		z_rtio_sqe_pending_queue(r);
+	}
+#endif
+
 	/* Submit the queue to the executor which consumes submissions
 	 * and produces completions through ISR chains or other means.
 	 */
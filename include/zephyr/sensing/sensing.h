@@ -115,6 +115,9 @@ typedef void *sensing_sensor_handle_t;
 /**
  * @brief Sensor data event receive callback.
  *
+ * The data buffer is shared by all clients of the sensor, and is only valid until the
+ * callback returns unless a reference is taken with @ref sensing_data_ref.
+ *
  * @param handle The sensor instance handle.
  * @param buf The data buffer with sensor data.
  * @param context User provided context pointer.
@@ -282,6 +285,32 @@ int sensing_get_config(
 const struct sensing_sensor_info *sensing_get_sensor_info(
 		sensing_sensor_handle_t handle);
 
+/**
+ * @brief Keep a sensor data buffer after the data event callback returns.
+ *
+ * Must be called from the @ref sensing_data_event_t callback the buffer was passed to.
+ * The buffer is not copied; it stays valid, and is not reused for new samples, until
+ * every reference taken on it is dropped with @ref sensing_data_unref.
+ *
+ * @param buf The data buffer passed to the data event callback.
+ * @return 0 on success.
+ * @return -EINVAL if @p buf is not a sensor data buffer in use.
+ * @return -ENOTSUP if CONFIG_SENSING_DATA_REF is disabled.
+ */
+int sensing_data_ref(const void *buf);
+
+/**
+ * @brief Drop a reference taken with @ref sensing_data_ref.
+ *
+ * The buffer must not be accessed anymore by the caller.
+ *
+ * @param buf The data buffer.
+ * @return 0 on success.
+ * @return -EINVAL if @p buf is not a sensor data buffer in use.
+ * @return -ENOTSUP if CONFIG_SENSING_DATA_REF is disabled.
+ */
+int sensing_data_unref(const void *buf);
+
 #ifdef __cplusplus
 }
 #endif
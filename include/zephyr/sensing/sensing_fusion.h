@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SENSING_FUSION_H_
+#define ZEPHYR_INCLUDE_SENSING_FUSION_H_
+
+#include <zephyr/sensing/sensing_datatypes.h>
+#include <zephyr/sys/util.h>
+
+/**
+ * @defgroup sensing_fusion Multi-rate Fusion Stage
+ * @ingroup sensing
+ * @{
+ *
+ * A fusion stage aligns the samples of several 3D sensor streams, typically the
+ * reporters of a virtual sensor, by timestamp. It resamples them to a common
+ * rate by linear interpolation and hands the result to a callback one window of
+ * samples at a time. Sensors reporting at different or jittery rates then look
+ * like one synchronous stream, and filters such as complementary or Madgwick
+ * filters run once per window instead of once per dispatched sample.
+ *
+ * The stage is not thread safe, all samples must be added from the same thread,
+ * which is the case for data event callbacks of the sensing subsystem.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Window of resampled samples
+ */
+struct sensing_fusion_window {
+	/** Timestamp of the first sample in the window, in micro seconds */
+	uint64_t timestamp;
+	/** Time between samples, in micro seconds */
+	uint32_t period_us;
+	/** Number of samples of each stream */
+	uint16_t len;
+	/** Number of streams */
+	uint8_t num_streams;
+	/** Shift of the q31_t values of each stream */
+	const int8_t *shift;
+	/** @cond INTERNAL_HIDDEN */
+	q31_t (*data)[3];
+	/** @endcond */
+};
+
+struct sensing_fusion;
+
+/**
+ * @brief Callback invoked with each complete window
+ *
+ * @param fusion Fusion stage
+ * @param window Window of resampled samples, valid during the callback
+ * @param user_data User data given to SENSING_FUSION_DEFINE()
+ */
+typedef void (*sensing_fusion_window_t)(struct sensing_fusion *fusion,
+					const struct sensing_fusion_window *window,
+					void *user_data);
+
+/** @cond INTERNAL_HIDDEN */
+struct sensing_fusion_sample {
+	uint64_t timestamp;
+	q31_t v[3];
+};
+
+struct sensing_fusion_stream {
+	uint16_t head;
+	uint16_t count;
+	uint32_t dropped;
+};
+/** @endcond */
+
+/**
+ * @brief Fusion stage, defined by SENSING_FUSION_DEFINE()
+ */
+struct sensing_fusion {
+	/** @cond INTERNAL_HIDDEN */
+	struct sensing_fusion_stream *streams;
+	struct sensing_fusion_sample *samples;
+	uint16_t depth;
+	int8_t *shift;
+	sensing_fusion_window_t cb;
+	void *user_data;
+	struct sensing_fusion_window window;
+	uint16_t filled;
+	bool aligned;
+	uint64_t next_timestamp;
+	/** @endcond */
+};
+
+/**
+ * @brief Define a fusion stage
+ *
+ * @param _name Name of the fusion stage
+ * @param _num_streams Number of input streams
+ * @param _depth Number of samples buffered per stream, must cover the samples of a
+ *		 stream arriving before the slowest stream catches up
+ * @param _window_len Number of resampled samples per stream in each window
+ * @param _period_us Time between resampled samples, in micro seconds
+ * @param _cb Callback invoked with each window, see @ref sensing_fusion_window_t
+ * @param _user_data User data passed to the callback
+ */
+#define SENSING_FUSION_DEFINE(_name, _num_streams, _depth, _window_len, _period_us, _cb,          \
+			      _user_data)                                                          \
+	BUILD_ASSERT((_depth) >= 2, "Interpolation needs two samples per stream");                \
+	static struct sensing_fusion_stream _CONCAT(_name, _streams)[_num_streams];                \
+	static struct sensing_fusion_sample _CONCAT(_name, _samples)[(_num_streams) * (_depth)];   \
+	static int8_t _CONCAT(_name, _shift)[_num_streams];                                       \
+	static q31_t _CONCAT(_name, _data)[(_num_streams) * (_window_len)][3];                     \
+	static struct sensing_fusion _name = {                                                     \
+		.streams = _CONCAT(_name, _streams),                                               \
+		.samples = _CONCAT(_name, _samples),                                               \
+		.depth = (_depth),                                                                 \
+		.shift = _CONCAT(_name, _shift),                                                   \
+		.cb = (_cb),                                                                       \
+		.user_data = (_user_data),                                                         \
+		.window = {                                                                        \
+			.period_us = (_period_us),                                                 \
+			.len = (_window_len),                                                      \
+			.num_streams = (_num_streams),                                             \
+			.shift = _CONCAT(_name, _shift),                                           \
+			.data = _CONCAT(_name, _data),                                             \
+		},                                                                                 \
+	}
+
+/**
+ * @brief Add the readings of a stream to a fusion stage
+ *
+ * Readings must be in timestamp order, readings older than the last one added to
+ * the stream are ignored. When the stream buffer is full the oldest sample is
+ * dropped. Complete windows are passed to the callback before returning.
+ *
+ * @param fusion Fusion stage
+ * @param stream Index of the stream
+ * @param value Readings of the stream, as passed to the data event callback
+ *
+ * @return 0 on success.
+ * @return -EINVAL if @p stream is out of range.
+ */
+int sensing_fusion_add(struct sensing_fusion *fusion, uint8_t stream,
+		       const struct sensing_sensor_value_3d_q31 *value);
+
+/**
+ * @brief Set the time between resampled samples of a fusion stage
+ *
+ * Typically follows the interval the streams are configured with. Takes
+ * effect from the next resampled sample.
+ *
+ * @param fusion Fusion stage
+ * @param period_us Time between resampled samples, in micro seconds
+ *
+ * @return 0 on success.
+ * @return -EINVAL if @p period_us is 0.
+ */
+int sensing_fusion_period_set(struct sensing_fusion *fusion, uint32_t period_us);
+
+/**
+ * @brief Drop all buffered samples and the partial window of a fusion stage
+ *
+ * The next window starts once every stream has a sample again.
+ *
+ * @param fusion Fusion stage
+ */
+void sensing_fusion_reset(struct sensing_fusion *fusion);
+
+/**
+ * @brief Get the number of samples a stream dropped because its buffer was full
+ *
+ * @param fusion Fusion stage
+ * @param stream Index of the stream
+ *
+ * @return Number of dropped samples.
+ */
+static inline uint32_t sensing_fusion_dropped(const struct sensing_fusion *fusion,
+					      uint8_t stream)
+{
+	return fusion->streams[stream].dropped;
+}
+
+/**
+ * @brief Get a resampled sample of a window
+ *
+ * @param window Window passed to the callback
+ * @param stream Index of the stream
+ * @param idx Index of the sample in the window
+ *
+ * @return The 3D vector of the sample, in the stream's shift.
+ */
+static inline const q31_t *sensing_fusion_window_get(const struct sensing_fusion_window *window,
+						     uint8_t stream, uint16_t idx)
+{
+	return window->data[stream * window->len + idx];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_SENSING_FUSION_H_ */
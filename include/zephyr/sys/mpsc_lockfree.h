@@ -186,6 +186,26 @@ static inline struct mpsc_node *mpsc_pop(struct mpsc *q)
 	return NULL;
 }
 
+/**
+ * @brief Get the node the next mpsc_pop() returns without removing it
+ *
+ * Must be called by the consumer, like mpsc_pop().
+ *
+ * @retval NULL When no node is available
+ * @retval node When node is available
+ */
+static inline struct mpsc_node *mpsc_peek(struct mpsc *q)
+{
+	struct mpsc_node *tail = q->tail;
+
+	/* Skip over the stub/sentinel */
+	if (tail == &q->stub) {
+		return (struct mpsc_node *)mpsc_ptr_get(tail->next);
+	}
+
+	return tail;
+}
+
 /**
  * @}
  */
@@ -160,6 +160,14 @@ extern uint8_t *z_priv_stack_find(k_thread_stack_t *stack);
 /* Calculate stack usage. */
 int z_stack_space_get(const uint8_t *stack_start, size_t size, size_t *unused_ptr);
 
+#ifdef CONFIG_STACK_WATERMARK
+/* Calculate stack usage incrementally. @p watermark holds the result of
+ * the previous call, zero initialized if the stack was not scanned yet.
+ */
+int z_stack_watermark_get(const uint8_t *stack_start, size_t size,
+			  struct _stack_watermark *watermark, size_t *unused_ptr);
+#endif /* CONFIG_STACK_WATERMARK */
+
 #ifdef CONFIG_USERSPACE
 bool z_stack_is_user_capable(k_thread_stack_t *stack);
 
@@ -277,6 +285,17 @@ int z_kernel_stats_raw(struct k_obj_core *obj_core, void *stats);
 int z_kernel_stats_query(struct k_obj_core *obj_core, void *stats);
 #endif /* CONFIG_OBJ_CORE_STATS_SYSTEM */
 
+#ifdef CONFIG_OBJ_CORE_STATS_LATENCY
+/* Statistics descriptor shared by object types whose raw statistics are a
+ * single struct k_latency_hist.
+ */
+extern struct k_obj_core_stats_desc z_latency_stats_desc;
+#endif /* CONFIG_OBJ_CORE_STATS_LATENCY */
+
+#ifdef CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP
+void z_irq_wakeup_latency_record(uint32_t cycles);
+#endif /* CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP */
+
 #if defined(CONFIG_THREAD_ABORT_NEED_CLEANUP)
 /**
  * Perform cleanup at the end of k_thread_abort().
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <kernel_internal.h>
+
+void k_latency_hist_record(struct k_latency_hist *hist, uint32_t cycles)
+{
+	unsigned int idx = MIN(find_msb_set(cycles), K_LATENCY_HIST_BUCKETS - 1U);
+	atomic_val_t max;
+
+	(void)atomic_inc(&hist->buckets[idx]);
+
+	do {
+		max = atomic_get(&hist->max);
+		if (cycles <= (uint32_t)max) {
+			break;
+		}
+	} while (!atomic_cas(&hist->max, max, (atomic_val_t)cycles));
+}
+
+uint32_t k_latency_hist_bucket_max(unsigned int idx)
+{
+	if (idx == 0U) {
+		return 0U;
+	}
+
+	if ((idx >= 32U) || (idx >= (K_LATENCY_HIST_BUCKETS - 1U))) {
+		return UINT32_MAX;
+	}
+
+	return BIT(idx) - 1U;
+}
+
+static uint32_t latency_hist_count(const struct k_latency_hist *hist)
+{
+	uint32_t count = 0;
+
+	for (unsigned int i = 0; i < K_LATENCY_HIST_BUCKETS; i++) {
+		count += (uint32_t)atomic_get(&hist->buckets[i]);
+	}
+
+	return count;
+}
+
+static uint32_t latency_hist_percentile(const struct k_latency_hist *hist,
+					uint32_t count, unsigned int permille)
+{
+	uint32_t max = (uint32_t)atomic_get(&hist->max);
+	uint64_t target;
+	uint64_t seen = 0;
+
+	if (count == 0U) {
+		return 0U;
+	}
+
+	/* Rank of the sample the percentile falls on, rounded up */
+	target = DIV_ROUND_UP((uint64_t)count * MIN(permille, 1000U), 1000U);
+	target = MAX(target, 1U);
+
+	for (unsigned int i = 0; i < K_LATENCY_HIST_BUCKETS; i++) {
+		seen += (uint32_t)atomic_get(&hist->buckets[i]);
+		if (seen >= target) {
+			return MIN(k_latency_hist_bucket_max(i), max);
+		}
+	}
+
+	return max;
+}
+
+uint32_t k_latency_hist_percentile(const struct k_latency_hist *hist,
+				   unsigned int permille)
+{
+	return latency_hist_percentile(hist, latency_hist_count(hist), permille);
+}
+
+void k_latency_hist_summarize(const struct k_latency_hist *hist,
+			      struct k_latency_stats *stats)
+{
+	stats->count = latency_hist_count(hist);
+	stats->max = (uint32_t)atomic_get(&hist->max);
+	stats->p50 = latency_hist_percentile(hist, stats->count, 500U);
+	stats->p90 = latency_hist_percentile(hist, stats->count, 900U);
+	stats->p99 = latency_hist_percentile(hist, stats->count, 990U);
+}
+
+void k_latency_hist_reset(struct k_latency_hist *hist)
+{
+	for (unsigned int i = 0; i < K_LATENCY_HIST_BUCKETS; i++) {
+		atomic_clear(&hist->buckets[i]);
+	}
+
+	atomic_clear(&hist->max);
+}
+
+static int latency_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	const struct k_latency_hist *hist = obj_core->stats;
+	struct k_latency_hist *ptr = stats;
+
+	for (unsigned int i = 0; i < K_LATENCY_HIST_BUCKETS; i++) {
+		atomic_set(&ptr->buckets[i], atomic_get(&hist->buckets[i]));
+	}
+
+	atomic_set(&ptr->max, atomic_get(&hist->max));
+
+	return 0;
+}
+
+static int latency_stats_query(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	k_latency_hist_summarize(obj_core->stats, stats);
+
+	return 0;
+}
+
+static int latency_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	k_latency_hist_reset(obj_core->stats);
+
+	return 0;
+}
+
+struct k_obj_core_stats_desc z_latency_stats_desc = {
+	.raw_size = sizeof(struct k_latency_hist),
+	.query_size = sizeof(struct k_latency_stats),
+	.raw = latency_stats_raw,
+	.query = latency_stats_query,
+	.reset = latency_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+
+static struct k_obj_type obj_type_latency;
+
+void k_obj_core_latency_register(struct k_obj_core_latency *latency)
+{
+	k_obj_core_init_and_link(K_OBJ_CORE(latency), &obj_type_latency);
+	k_obj_core_stats_register(K_OBJ_CORE(latency), &latency->hist,
+				  sizeof(struct k_latency_hist));
+}
+
+#ifdef CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP
+static struct k_obj_core_latency irq_wakeup_latency = {
+	.name = "irq_wakeup",
+};
+
+void z_irq_wakeup_latency_record(uint32_t cycles)
+{
+	k_latency_hist_record(&irq_wakeup_latency.hist, cycles);
+}
+#endif /* CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP */
+
+static int init_latency_obj_core_list(void)
+{
+	/* Initialize latency histogram object type */
+
+	z_obj_type_init(&obj_type_latency, K_OBJ_TYPE_LATENCY_ID,
+			offsetof(struct k_obj_core_latency, obj_core));
+	k_obj_type_stats_init(&obj_type_latency, &z_latency_stats_desc);
+
+#ifdef CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP
+	k_obj_core_latency_register(&irq_wakeup_latency);
+#endif /* CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP */
+
+	return 0;
+}
+
+SYS_INIT(init_latency_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
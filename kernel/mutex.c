@@ -64,6 +64,11 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
 #endif /* CONFIG_OBJ_CORE_MUTEX */
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_latency_hist_reset(&mutex->wait_hist);
+	k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->wait_hist,
+				  sizeof(struct k_latency_hist));
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_mutex, mutex, 0);
 
@@ -153,8 +158,16 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	uint32_t start = k_cycle_get_32();
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_latency_hist_record(&mutex->wait_hist, k_cycle_get_32() - start);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
 
 	LOG_DBG("%p got mutex %p (y/n): %c", _current, mutex,
@@ -299,11 +312,18 @@ static int init_mutex_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_mutex, K_OBJ_TYPE_MUTEX_ID,
 			offsetof(struct k_mutex, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_obj_type_stats_init(&obj_type_mutex, &z_latency_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 
 	/* Initialize and link statically defined mutexes */
 
 	STRUCT_SECTION_FOREACH(k_mutex, mutex) {
 		k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+		k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->wait_hist,
+					  sizeof(struct k_latency_hist));
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 	}
 
 	return 0;
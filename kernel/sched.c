@@ -382,6 +382,15 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP
+		if (arch_is_in_isr()) {
+			uint32_t now = k_cycle_get_32();
+
+			/* Zero marks "not readied by an ISR" */
+			thread->base.irq_ready_cycles = (now != 0U) ? now : 1U;
+		}
+#endif /* CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP */
+
 		queue_thread(thread);
 		update_cache(0);
 
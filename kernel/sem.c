@@ -68,6 +68,11 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 #ifdef CONFIG_OBJ_CORE_SEM
 	k_obj_core_init_and_link(K_OBJ_CORE(sem), &obj_type_sem);
 #endif /* CONFIG_OBJ_CORE_SEM */
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	k_latency_hist_reset(&sem->wait_hist);
+	k_obj_core_stats_register(K_OBJ_CORE(sem), &sem->wait_hist,
+				  sizeof(struct k_latency_hist));
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 
 	return 0;
 }
@@ -132,6 +137,9 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
 	int ret;
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	uint32_t start;
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 
 	__ASSERT(((arch_is_in_isr() == false) ||
 		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
@@ -155,8 +163,16 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	start = k_cycle_get_32();
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
+
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	k_latency_hist_record(&sem->wait_hist, k_cycle_get_32() - start);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
+
 out:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, take, sem, timeout, ret);
 
@@ -216,11 +232,18 @@ static int init_sem_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_sem, K_OBJ_TYPE_SEM_ID,
 			offsetof(struct k_sem, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	k_obj_type_stats_init(&obj_type_sem, &z_latency_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 
 	/* Initialize and link statically defined semaphores */
 
 	STRUCT_SECTION_FOREACH(k_sem, sem) {
 		k_obj_core_init_and_link(K_OBJ_CORE(sem), &obj_type_sem);
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+		k_obj_core_stats_register(K_OBJ_CORE(sem), &sem->wait_hist,
+					  sizeof(struct k_latency_hist));
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 	}
 
 	return 0;
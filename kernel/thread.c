@@ -503,6 +503,10 @@ static char *setup_thread_stack(struct k_thread *new_thread,
 	new_thread->stack_info.size = stack_buf_size;
 	new_thread->stack_info.delta = delta;
 #endif /* CONFIG_THREAD_STACK_INFO */
+#ifdef CONFIG_STACK_WATERMARK
+	new_thread->stack_info.watermark.unused = 0;
+	new_thread->stack_info.watermark.scanned = false;
+#endif /* CONFIG_STACK_WATERMARK */
 	stack_ptr -= delta;
 
 	return stack_ptr;
@@ -765,6 +769,10 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->slice_expired = NULL;
 #endif /* CONFIG_TIMESLICE_PER_THREAD */
 
+#ifdef CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP
+	thread_base->irq_ready_cycles = 0U;
+#endif /* CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP */
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
@@ -897,6 +905,117 @@ int z_vrfy_k_thread_stack_space_get(const struct k_thread *thread,
 }
 #include <zephyr/syscalls/k_thread_stack_space_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
+
+#ifdef CONFIG_STACK_WATERMARK
+int z_stack_watermark_get(const uint8_t *stack_start, size_t size,
+			  struct _stack_watermark *watermark, size_t *unused_ptr)
+{
+	const uint8_t *checked_stack = stack_start;
+	const uint8_t *stack_pointer = (const uint8_t *)&stack_start;
+	size_t unused;
+	size_t gap = 0;
+	int ret;
+
+	/* See z_stack_space_get() */
+	if ((stack_pointer > stack_start) && (stack_pointer <= (stack_start + size)) &&
+	    IS_ENABLED(CONFIG_NO_UNUSED_STACK_INSPECTION)) {
+		return -ENOTSUP;
+	}
+
+	if (IS_ENABLED(CONFIG_STACK_SENTINEL)) {
+		checked_stack += 4;
+	}
+
+	/* The first query has no previous watermark to start from. Walking
+	 * down from the top of the stack would stop at the first untouched
+	 * area of the gap size, such as a large local buffer, and every later
+	 * query would then start from that underestimate. Seed the watermark
+	 * with the exact scan from the bottom instead. A fully used stack
+	 * leaves an unused size of 0, so whether it was scanned is tracked
+	 * apart.
+	 */
+	if (!watermark->scanned || (watermark->unused > size)) {
+		ret = z_stack_space_get(stack_start, size, &unused);
+		if (ret == 0) {
+			watermark->unused = unused;
+			watermark->scanned = true;
+			*unused_ptr = unused;
+		}
+
+		return ret;
+	}
+
+	if (IS_ENABLED(CONFIG_STACK_SENTINEL)) {
+		size -= 4;
+	}
+
+	/* Stack usage only grows, so everything above the previous watermark
+	 * is known to be used. Walk down from there, moving the watermark to
+	 * each location no longer holding the initialization pattern, until
+	 * a long enough untouched area shows the unused bottom of the stack
+	 * is reached.
+	 */
+	unused = MIN(watermark->unused, size);
+
+	for (size_t i = unused; (i > 0U) && (gap < CONFIG_STACK_WATERMARK_GAP); i--) {
+		if (checked_stack[i - 1U] == 0xaaU) {
+			gap++;
+		} else {
+			gap = 0;
+			unused = i - 1U;
+		}
+	}
+
+	watermark->unused = unused;
+	*unused_ptr = unused;
+
+	return 0;
+}
+
+int z_impl_k_thread_stack_watermark_get(const struct k_thread *thread,
+					size_t *unused_ptr)
+{
+	/* The cached watermark is not part of the thread's observable state */
+	struct k_thread *t = (struct k_thread *)thread;
+
+#ifdef CONFIG_THREAD_STACK_MEM_MAPPED
+	if (thread->stack_info.mapped.addr == NULL) {
+		return -EINVAL;
+	}
+#endif /* CONFIG_THREAD_STACK_MEM_MAPPED */
+
+	return z_stack_watermark_get((const uint8_t *)thread->stack_info.start,
+				     thread->stack_info.size,
+				     &t->stack_info.watermark, unused_ptr);
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_thread_stack_watermark_get(const struct k_thread *thread,
+					size_t *unused_ptr)
+{
+	size_t unused;
+	int ret;
+
+	ret = K_SYSCALL_OBJ(thread, K_OBJ_THREAD);
+	CHECKIF(ret != 0) {
+		return ret;
+	}
+
+	ret = z_impl_k_thread_stack_watermark_get(thread, &unused);
+	CHECKIF(ret != 0) {
+		return ret;
+	}
+
+	ret = k_usermode_to_copy(unused_ptr, &unused, sizeof(size_t));
+	CHECKIF(ret != 0) {
+		return ret;
+	}
+
+	return 0;
+}
+#include <zephyr/syscalls/k_thread_stack_watermark_get_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_STACK_WATERMARK */
 #endif /* CONFIG_INIT_STACKS && CONFIG_THREAD_STACK_INFO */
 
 #ifdef CONFIG_USERSPACE
@@ -924,6 +1043,14 @@ void z_thread_mark_switched_in(void)
 	z_sched_usage_start(_current);
 #endif /* CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
+#ifdef CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP
+	if (_current->base.irq_ready_cycles != 0U) {
+		z_irq_wakeup_latency_record(k_cycle_get_32() -
+					    _current->base.irq_ready_cycles);
+		_current->base.irq_ready_cycles = 0U;
+	}
+#endif /* CONFIG_OBJ_CORE_STATS_IRQ_WAKEUP */
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
 #endif /* CONFIG_TRACING */
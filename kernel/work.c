@@ -15,9 +15,20 @@
 #include <wait_q.h>
 #include <zephyr/spinlock.h>
 #include <errno.h>
+#include <string.h>
 #include <ksched.h>
+#include <zephyr/init.h>
 #include <zephyr/sys/printk.h>
 
+#ifdef CONFIG_OBJ_CORE_WORK_Q
+static struct k_obj_type obj_type_work_q;
+#endif /* CONFIG_OBJ_CORE_WORK_Q */
+
+#if CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS > 0
+/* Per handler statistics, open addressed on the handler address. */
+static struct k_work_handler_stats work_handler_stats[CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS];
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS > 0 */
+
 static inline void flag_clear(uint32_t *flagp,
 			      uint32_t bit)
 {
@@ -290,6 +301,9 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
 	} else {
+#ifdef CONFIG_OBJ_CORE_STATS_WORK_Q
+		work->queued_cycles = k_cycle_get_32();
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q */
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
 		(void)notify_queue_locked(queue);
@@ -609,6 +623,208 @@ bool k_work_cancel_sync(struct k_work *work,
 	return pending;
 }
 
+#ifdef CONFIG_OBJ_CORE_STATS_WORK_Q
+static void work_q_stats_clear(struct k_work_q_stats *stats)
+{
+	stats->count = 0U;
+	stats->delay_min = UINT32_MAX;
+	stats->run_min = UINT32_MAX;
+	stats->delay_total = 0U;
+	stats->run_total = 0U;
+	k_latency_hist_reset(&stats->delay_hist);
+	k_latency_hist_reset(&stats->run_hist);
+}
+
+#if CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS > 0
+/* Find the statistics entry of a handler, claiming a free entry for
+ * handlers not seen before.
+ *
+ * @return the entry, or NULL if the table is full.
+ */
+static struct k_work_handler_stats *work_handler_stats_find_locked(k_work_handler_t handler)
+{
+	const size_t size = ARRAY_SIZE(work_handler_stats);
+	size_t idx = ((uintptr_t)handler >> 2) % size;
+
+	for (size_t i = 0; i < size; i++) {
+		struct k_work_handler_stats *entry = &work_handler_stats[idx];
+
+		if (entry->handler == handler) {
+			return entry;
+		}
+
+		if (entry->handler == NULL) {
+			entry->handler = handler;
+			return entry;
+		}
+
+		idx = (idx + 1U) % size;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS > 0 */
+
+static void work_q_stats_record_locked(struct k_work_q_stats *stats,
+				       k_work_handler_t handler,
+				       uint32_t delay, uint32_t run)
+{
+	stats->count++;
+	stats->delay_min = MIN(stats->delay_min, delay);
+	stats->run_min = MIN(stats->run_min, run);
+	stats->delay_total += delay;
+	stats->run_total += run;
+	k_latency_hist_record(&stats->delay_hist, delay);
+	k_latency_hist_record(&stats->run_hist, run);
+
+#if CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS > 0
+	struct k_work_handler_stats *entry = work_handler_stats_find_locked(handler);
+
+	if (entry != NULL) {
+		entry->count++;
+		entry->delay_max = MAX(entry->delay_max, delay);
+		entry->run_max = MAX(entry->run_max, run);
+		entry->run_total += run;
+	}
+#else
+	ARG_UNUSED(handler);
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS > 0 */
+}
+
+size_t k_work_handler_stats_get(struct k_work_handler_stats *stats, size_t skip,
+				size_t max)
+{
+	size_t n = 0;
+
+#if CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS > 0
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; (i < ARRAY_SIZE(work_handler_stats)) && (n < max); i++) {
+		if (work_handler_stats[i].handler == NULL) {
+			continue;
+		}
+
+		if (skip > 0U) {
+			skip--;
+		} else {
+			stats[n++] = work_handler_stats[i];
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+#else
+	ARG_UNUSED(stats);
+	ARG_UNUSED(skip);
+	ARG_UNUSED(max);
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS > 0 */
+
+	return n;
+}
+
+void k_work_handler_stats_reset(void)
+{
+#if CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS > 0
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	(void)memset(work_handler_stats, 0, sizeof(work_handler_stats));
+
+	k_spin_unlock(&lock, key);
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS > 0 */
+}
+
+static void work_q_timing_summarize(struct k_work_q_timing *timing,
+				    const struct k_latency_hist *hist,
+				    uint32_t min, uint64_t total, uint32_t count)
+{
+	struct k_latency_stats summary;
+
+	k_latency_hist_summarize(hist, &summary);
+
+	timing->min = (count == 0U) ? 0U : min;
+	timing->avg = (count == 0U) ? 0U : (uint32_t)(total / count);
+	timing->max = summary.max;
+	timing->p50 = summary.p50;
+	timing->p90 = summary.p90;
+	timing->p99 = summary.p99;
+}
+
+int k_work_queue_stats_get(struct k_work_q *queue,
+			   struct k_work_q_stats_summary *stats)
+{
+	struct k_work_q_stats raw;
+	k_spinlock_key_t key;
+
+	if ((queue == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	/* Summarized once the work queues are no longer held up */
+	key = k_spin_lock(&lock);
+	raw = queue->stats;
+	k_spin_unlock(&lock, key);
+
+	stats->count = raw.count;
+	work_q_timing_summarize(&stats->delay, &raw.delay_hist,
+				raw.delay_min, raw.delay_total, raw.count);
+	work_q_timing_summarize(&stats->run, &raw.run_hist,
+				raw.run_min, raw.run_total, raw.count);
+
+	return 0;
+}
+
+/* The object core statistics of a queue are its delay histogram, the
+ * registered stats pointer being queue->stats.delay_hist.
+ */
+static int work_q_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memcpy(stats, obj_core->stats, sizeof(struct k_latency_hist));
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static int work_q_stats_query(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_latency_hist hist;
+
+	(void)work_q_stats_raw(obj_core, &hist);
+	k_latency_hist_summarize(&hist, stats);
+
+	return 0;
+}
+
+static int work_q_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_work_q *queue = CONTAINER_OF(obj_core, struct k_work_q, obj_core);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	work_q_stats_clear(&queue->stats);
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc work_q_stats_desc = {
+	.raw_size = sizeof(struct k_latency_hist),
+	.query_size = sizeof(struct k_latency_stats),
+	.raw = work_q_stats_raw,
+	.query = work_q_stats_query,
+	.reset = work_q_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q */
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -626,6 +842,11 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		k_work_handler_t handler = NULL;
 		k_spinlock_key_t key = k_spin_lock(&lock);
 		bool yield;
+#ifdef CONFIG_OBJ_CORE_STATS_WORK_Q
+		uint32_t start;
+		uint32_t delay;
+		uint32_t run;
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q */
 
 		/* Check for and prepare any new work. */
 		node = sys_slist_get(&queue->pending);
@@ -682,11 +903,20 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			continue;
 		}
 
+#ifdef CONFIG_OBJ_CORE_STATS_WORK_Q
+		start = k_cycle_get_32();
+		delay = start - work->queued_cycles;
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q */
+
 		k_spin_unlock(&lock, key);
 
 		__ASSERT_NO_MSG(handler != NULL);
 		handler(work);
 
+#ifdef CONFIG_OBJ_CORE_STATS_WORK_Q
+		run = k_cycle_get_32() - start;
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q */
+
 		/* Mark the work item as no longer running and deal
 		 * with any cancellation and flushing issued while it
 		 * was running.  Clear the BUSY flag and optionally
@@ -694,6 +924,14 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		 */
 		key = k_spin_lock(&lock);
 
+#ifdef CONFIG_OBJ_CORE_STATS_WORK_Q
+		/* The work item may have been freed or resubmitted by
+		 * its handler, so only the handler and the cycle counts
+		 * sampled above are used here.
+		 */
+		work_q_stats_record_locked(&queue->stats, handler, delay, run);
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q */
+
 		flag_clear(&work->flags, K_WORK_RUNNING_BIT);
 		if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
 			finalize_flush_locked(work);
@@ -715,14 +953,43 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 	}
 }
 
+#ifdef CONFIG_OBJ_CORE_WORK_Q
+static int work_q_obj_core_match(struct k_obj_core *obj_core, void *data)
+{
+	return (obj_core == data) ? 1 : 0;
+}
+
+/* A queue stays linked to the work queue object type once it was started.
+ * The list is walked under the object core lock, as other queues may be
+ * linked meanwhile.
+ */
+static bool work_q_obj_core_linked(struct k_work_q *queue)
+{
+	return k_obj_type_walk_locked(&obj_type_work_q, work_q_obj_core_match,
+				      K_OBJ_CORE(queue)) != 0;
+}
+#endif /* CONFIG_OBJ_CORE_WORK_Q */
+
 void k_work_queue_init(struct k_work_q *queue)
 {
 	__ASSERT_NO_MSG(queue != NULL);
 
+#ifdef CONFIG_OBJ_CORE_WORK_Q
+	/* Keep the list node of a queue being reinitialized intact */
+	struct k_obj_core obj_core = queue->obj_core;
+	bool linked = work_q_obj_core_linked(queue);
+#endif /* CONFIG_OBJ_CORE_WORK_Q */
+
 	*queue = (struct k_work_q) {
 		.flags = 0,
 	};
 
+#ifdef CONFIG_OBJ_CORE_WORK_Q
+	if (linked) {
+		queue->obj_core = obj_core;
+	}
+#endif /* CONFIG_OBJ_CORE_WORK_Q */
+
 	SYS_PORT_TRACING_OBJ_INIT(k_work_queue, queue);
 }
 
@@ -753,6 +1020,17 @@ void k_work_queue_start(struct k_work_q *queue,
 	 */
 	flags_set(&queue->flags, flags);
 
+#ifdef CONFIG_OBJ_CORE_WORK_Q
+	if (!work_q_obj_core_linked(queue)) {
+		k_obj_core_init_and_link(K_OBJ_CORE(queue), &obj_type_work_q);
+	}
+#endif /* CONFIG_OBJ_CORE_WORK_Q */
+#ifdef CONFIG_OBJ_CORE_STATS_WORK_Q
+	work_q_stats_clear(&queue->stats);
+	k_obj_core_stats_register(K_OBJ_CORE(queue), &queue->stats.delay_hist,
+				  sizeof(struct k_latency_hist));
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q */
+
 	(void)k_thread_create(&queue->thread, stack, stack_size,
 			      work_queue_main, queue, NULL, NULL,
 			      prio, 0, K_FOREVER);
@@ -1144,3 +1422,21 @@ bool k_work_flush_delayable(struct k_work_delayable *dwork,
 }
 
 #endif /* CONFIG_SYS_CLOCK_EXISTS */
+
+#ifdef CONFIG_OBJ_CORE_WORK_Q
+static int init_work_q_obj_core_list(void)
+{
+	/* Initialize work queue object type */
+
+	z_obj_type_init(&obj_type_work_q, K_OBJ_TYPE_WORK_Q_ID,
+			offsetof(struct k_work_q, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_WORK_Q
+	k_obj_type_stats_init(&obj_type_work_q, &work_q_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_WORK_Q */
+
+	return 0;
+}
+
+SYS_INIT(init_work_q_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_WORK_Q */
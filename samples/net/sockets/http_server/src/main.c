@@ -40,6 +40,23 @@ struct http_resource_detail_static index_html_gz_resource_detail = {
 HTTP_RESOURCE_DEFINE(index_html_gz_resource, test_http_service, "/",
 		     &index_html_gz_resource_detail);
 
+#if CONFIG_NET_SAMPLE_HTTP_SERVER_LARGE_RESOURCE_SIZE > 0
+static const uint8_t large_data[CONFIG_NET_SAMPLE_HTTP_SERVER_LARGE_RESOURCE_SIZE];
+
+struct http_resource_detail_static large_resource_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "application/octet-stream",
+		},
+	.static_data = large_data,
+	.static_data_len = sizeof(large_data),
+};
+
+HTTP_RESOURCE_DEFINE(large_resource, test_http_service, "/large",
+		     &large_resource_detail);
+#endif
+
 static uint8_t recv_buffer[1024];
 
 static int dyn_handler(struct http_client_ctx *client, enum http_data_status status,
@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Trackunit Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Convert samples recorded by the sampling profiler (CONFIG_PROFILING_PERF)
+into folded stacks, as consumed by flamegraph.pl or speedscope.
+
+The samples are read either from the output of the "perf printbuf" shell
+command, or from a binary tracing dump (RAM or posix tracing backend)
+containing the records written by CONFIG_PROFILING_PERF_TRACING:
+
+    uart:~$ perf record 5000 100
+    uart:~$ perf printbuf
+
+    ./scripts/profiling/stackcollapse.py build/zephyr/zephyr.elf perf.log \\
+        > perf.folded
+    flamegraph.pl perf.folded > perf.svg
+
+Samples start at the program counter of the interrupted code. On the POSIX
+architecture they start in the timer callback instead, and the frames of the
+interrupt handling are dropped, see --irq-frames.
+"""
+
+import argparse
+import bisect
+import re
+import struct
+import sys
+from collections import Counter
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+PERF_RECORD_MAGIC = 0x46525a50
+
+DEFAULT_IRQ_FRAMES = [
+    "perf_sample",
+    "z_timer_expiration_handler",
+    "sys_clock_announce",
+    "posix_irq_handler",
+]
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("elf", help="zephyr.elf of the profiled image")
+    parser.add_argument("samples",
+                        help="'perf printbuf' output, or binary dump with --binary")
+    parser.add_argument("-b", "--binary", action="store_true",
+                        help="samples file is a binary tracing dump")
+    parser.add_argument("--irq-frames", default=",".join(DEFAULT_IRQ_FRAMES),
+                        help="comma separated list of symbols on the timer interrupt "
+                             "path; frames up to the outermost of them are dropped")
+    return parser.parse_args()
+
+
+class Symbolizer:
+    def __init__(self, elf_path):
+        symbols = []
+        with open(elf_path, "rb") as f:
+            elf = ELFFile(f)
+            self.word_size = elf.elfclass // 8
+            self.little_endian = elf.little_endian
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if sym["st_info"]["type"] != "STT_FUNC" or sym["st_size"] == 0:
+                        continue
+                    symbols.append((sym["st_value"] & ~1, sym["st_size"], sym.name))
+        symbols.sort()
+        self.addrs = [s[0] for s in symbols]
+        self.symbols = symbols
+
+    def lookup(self, addr):
+        # Return addresses point after the call instruction, look up the
+        # call itself so tail calls at the end of a function resolve correctly
+        addr -= 1
+        idx = bisect.bisect_right(self.addrs, addr) - 1
+        if idx >= 0:
+            start, size, name = self.symbols[idx]
+            if addr < start + size:
+                return name
+        return f"0x{addr + 1:x}"
+
+
+def words_from_text(path):
+    words = []
+    with open(path, "r", errors="ignore") as f:
+        for line in f:
+            line = line.strip()
+            if re.fullmatch(r"[0-9a-fA-F]{8}|[0-9a-fA-F]{16}", line):
+                words.append(int(line, 16))
+    return words
+
+
+def samples_from_words(words):
+    i = 0
+    while i < len(words):
+        depth = words[i]
+        if depth == 0 or i + 1 + depth > len(words):
+            break
+        yield words[i + 1:i + 1 + depth]
+        i += 1 + depth
+
+
+def samples_from_binary(path, little_endian):
+    endian = "<" if little_endian else ">"
+    hdr = struct.Struct(endian + "IHBB")
+    with open(path, "rb") as f:
+        data = f.read()
+    magic = struct.pack(endian + "I", PERF_RECORD_MAGIC)
+    pos = data.find(magic)
+    while pos >= 0 and pos + hdr.size <= len(data):
+        _, depth, word_size, _ = hdr.unpack_from(data, pos)
+        end = pos + hdr.size + depth * word_size
+        if word_size in (4, 8) and depth > 0 and end <= len(data):
+            fmt = endian + ("I" if word_size == 4 else "Q") * depth
+            yield list(struct.unpack_from(fmt, data, pos + hdr.size))
+            pos = data.find(magic, end)
+        else:
+            pos = data.find(magic, pos + 1)
+
+
+def strip_irq_frames(names, irq_frames):
+    # names are innermost first
+    last = -1
+    for idx, name in enumerate(names):
+        if name in irq_frames:
+            last = idx
+    names = names[last + 1:]
+    # The return address register recorded after the program counter may
+    # point into the interrupted function itself
+    if len(names) > 1 and names[0] == names[1]:
+        names = names[1:]
+    return names
+
+
+def main():
+    args = parse_args()
+    symbolizer = Symbolizer(args.elf)
+    irq_frames = set(filter(None, args.irq_frames.split(",")))
+
+    if args.binary:
+        samples = samples_from_binary(args.samples, symbolizer.little_endian)
+    else:
+        samples = samples_from_words(words_from_text(args.samples))
+
+    folded = Counter()
+    for frames in samples:
+        names = strip_irq_frames([symbolizer.lookup(a) for a in frames], irq_frames)
+        if names:
+            folded[";".join(reversed(names))] += 1
+
+    for stack, count in sorted(folded.items()):
+        print(f"{stack} {count}")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
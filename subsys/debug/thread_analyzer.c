@@ -94,7 +94,11 @@ static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
 		snprintk(hexname, sizeof(hexname), "%p", (void *)thread);
 	}
 
+#ifdef CONFIG_STACK_WATERMARK
+	err = k_thread_stack_watermark_get(thread, &unused);
+#else
 	err = k_thread_stack_space_get(thread, &unused);
+#endif
 	if (err) {
 		THREAD_ANALYZER_PRINT(
 			THREAD_ANALYZER_FMT(
@@ -129,6 +133,10 @@ static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
 K_KERNEL_STACK_ARRAY_DECLARE(z_interrupt_stacks, CONFIG_MP_MAX_NUM_CPUS,
 			     CONFIG_ISR_STACK_SIZE);
 
+#ifdef CONFIG_STACK_WATERMARK
+static struct _stack_watermark isr_stack_watermark[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
 static void isr_stacks(void)
 {
 	unsigned int num_cpus = arch_num_cpus();
@@ -139,7 +147,11 @@ static void isr_stacks(void)
 		size_t unused;
 		int err;
 
+#ifdef CONFIG_STACK_WATERMARK
+		err = z_stack_watermark_get(buf, size, &isr_stack_watermark[i], &unused);
+#else
 		err = z_stack_space_get(buf, size, &unused);
+#endif
 		if (err == 0) {
 			THREAD_ANALYZER_PRINT(
 				THREAD_ANALYZER_FMT(
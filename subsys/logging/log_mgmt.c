@@ -329,6 +329,45 @@ int z_log_link_set_runtime_level(uint8_t domain_id, uint16_t source_id, uint8_t
 	return log_link_set_runtime_level(link, rel_domain_id, source_id, level);
 }
 
+#ifdef CONFIG_LOG_RUNTIME_FILTERING_SUMMARY
+/* All levels pass until the runtime filters are initialized. */
+uint32_t z_log_runtime_level_summary = BIT_MASK(LOG_LEVEL_DBG + 1);
+
+/* Number of local sources per aggregated runtime level, protected by
+ * level_summary_lock together with the aggregated filter slots.
+ */
+static uint16_t level_source_cnt[LOG_LEVEL_DBG + 1];
+static struct k_spinlock level_summary_lock;
+
+static void level_summary_sync(void)
+{
+	uint32_t summary = 0U;
+	uint32_t cnt = 0U;
+
+	for (int level = LOG_LEVEL_DBG; level > LOG_LEVEL_NONE; level--) {
+		cnt += level_source_cnt[level];
+		if (cnt > 0U) {
+			summary |= BIT(level);
+		}
+	}
+
+	z_log_runtime_level_summary = summary;
+}
+
+static void level_summary_update(uint32_t prev_level, uint32_t new_level)
+{
+	prev_level = MIN(prev_level, LOG_LEVEL_DBG);
+	new_level = MIN(new_level, LOG_LEVEL_DBG);
+
+	if (level_source_cnt[prev_level] > 0U) {
+		level_source_cnt[prev_level]--;
+	}
+	level_source_cnt[new_level]++;
+
+	level_summary_sync();
+}
+#endif /* CONFIG_LOG_RUNTIME_FILTERING_SUMMARY */
+
 static uint32_t *get_dynamic_filter(uint8_t domain_id, uint32_t source_id)
 {
 	if (z_log_is_local_domain(domain_id)) {
@@ -349,6 +388,12 @@ void z_log_runtime_filters_init(void)
 	 * compile-time level. When backends are attached later on in
 	 * log_init(), they'll be initialized to the same value.
 	 */
+#ifdef CONFIG_LOG_RUNTIME_FILTERING_SUMMARY
+	k_spinlock_key_t key = k_spin_lock(&level_summary_lock);
+
+	memset(level_source_cnt, 0, sizeof(level_source_cnt));
+#endif
+
 	for (int i = 0; i < z_log_sources_count(); i++) {
 		uint32_t *filters = z_log_dynamic_filters_get(i);
 		uint8_t level = log_compiled_level_get(Z_LOG_LOCAL_DOMAIN_ID, i);
@@ -357,7 +402,15 @@ void z_log_runtime_filters_init(void)
 		LOG_FILTER_SLOT_SET(filters,
 				    LOG_FILTER_AGGR_SLOT_IDX,
 				    level);
+#ifdef CONFIG_LOG_RUNTIME_FILTERING_SUMMARY
+		level_source_cnt[MIN(level, LOG_LEVEL_DBG)]++;
+#endif
 	}
+
+#ifdef CONFIG_LOG_RUNTIME_FILTERING_SUMMARY
+	level_summary_sync();
+	k_spin_unlock(&level_summary_lock, key);
+#endif
 }
 
 int log_source_id_get(const char *name)
@@ -395,6 +448,13 @@ static void set_runtime_filter(uint8_t backend_id, uint8_t domain_id,
 	uint32_t prev_max;
 	uint32_t new_max;
 	uint32_t *filters = get_dynamic_filter(domain_id, source_id);
+#ifdef CONFIG_LOG_RUNTIME_FILTERING_SUMMARY
+	/* Filters may be set from several threads at once. The aggregated
+	 * slot and the per level counters must change together, or the
+	 * counters drift and the summary rejects enabled levels.
+	 */
+	k_spinlock_key_t key = k_spin_lock(&level_summary_lock);
+#endif
 
 	prev_max = LOG_FILTER_SLOT_GET(filters, LOG_FILTER_AGGR_SLOT_IDX);
 
@@ -407,7 +467,15 @@ static void set_runtime_filter(uint8_t backend_id, uint8_t domain_id,
 
 	LOG_FILTER_SLOT_SET(filters, LOG_FILTER_AGGR_SLOT_IDX, new_max);
 
-	if (!z_log_is_local_domain(domain_id) && (new_max != prev_max)) {
+#ifdef CONFIG_LOG_RUNTIME_FILTERING_SUMMARY
+	if ((new_max != prev_max) && z_log_is_local_domain(domain_id)) {
+		level_summary_update(prev_max, new_max);
+	}
+
+	k_spin_unlock(&level_summary_lock, key);
+#endif
+
+	if ((new_max != prev_max) && !z_log_is_local_domain(domain_id)) {
 		(void)z_log_link_set_runtime_level(domain_id, source_id, level);
 	}
 }
@@ -513,6 +513,7 @@ int net_icmpv4_send_error(struct net_pkt *orig, uint8_t type, uint8_t code)
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
 	int err = -EIO;
 	struct net_ipv4_hdr *ip_hdr;
+	const struct in_addr *src;
 	struct net_pkt *pkt;
 	size_t copy_len;
 
@@ -567,8 +568,15 @@ int net_icmpv4_send_error(struct net_pkt *orig, uint8_t type, uint8_t code)
 		goto drop_no_pkt;
 	}
 
-	if (net_ipv4_create(pkt, (struct in_addr *)ip_hdr->dst,
-			    (struct in_addr *)ip_hdr->src) ||
+	/* A forwarded packet was not for us, answer from our own address */
+	if (net_ipv4_is_my_addr((struct in_addr *)ip_hdr->dst)) {
+		src = (struct in_addr *)ip_hdr->dst;
+	} else {
+		src = net_if_ipv4_select_src_addr(net_pkt_iface(orig),
+						  (struct in_addr *)ip_hdr->src);
+	}
+
+	if (net_ipv4_create(pkt, src, (struct in_addr *)ip_hdr->src) ||
 	    net_icmpv4_create(pkt, type, code) ||
 	    net_pkt_memset(pkt, 0, NET_ICMPV4_UNUSED_LEN) ||
 	    net_pkt_copy(pkt, orig, copy_len)) {
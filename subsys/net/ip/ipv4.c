@@ -25,6 +25,7 @@ LOG_MODULE_REGISTER(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
 #include "tcp_internal.h"
 #include "dhcpv4/dhcpv4_internal.h"
 #include "ipv4.h"
+#include "route.h"
 
 BUILD_ASSERT(sizeof(struct in_addr) == NET_IPV4_ADDR_SIZE);
 
@@ -232,6 +233,119 @@ int net_ipv4_parse_hdr_options(struct net_pkt *pkt,
 }
 #endif
 
+#if defined(CONFIG_NET_IPV4_FORWARDING)
+/* Interface of the local network of the destination, or of its route */
+static struct net_if *ipv4_route_iface(const struct in_addr *dst)
+{
+	STRUCT_SECTION_FOREACH(net_if, iface) {
+		if (net_if_ipv4_addr_mask_cmp(iface, dst)) {
+			return iface;
+		}
+	}
+
+	return net_route_ipv4_lookup(NULL, dst, NULL);
+}
+
+static enum net_verdict ipv4_forward_packet(struct net_pkt *pkt,
+					    struct net_ipv4_hdr *hdr,
+					    struct net_if *iface)
+{
+	/* The time to live shares its checksum word with the protocol */
+	uint16_t old_word = UNALIGNED_GET((uint16_t *)&hdr->ttl);
+	int ret;
+
+	hdr->ttl--;
+	hdr->chksum = net_ipv4_chksum_update(hdr->chksum, old_word,
+					     UNALIGNED_GET((uint16_t *)&hdr->ttl));
+
+	net_pkt_set_orig_iface(pkt, net_pkt_iface(pkt));
+	net_pkt_set_iface(pkt, iface);
+	net_pkt_set_forwarding(pkt, true);
+
+	net_pkt_lladdr_src(pkt)->addr = net_pkt_lladdr_if(pkt)->addr;
+	net_pkt_lladdr_src(pkt)->type = net_pkt_lladdr_if(pkt)->type;
+	net_pkt_lladdr_src(pkt)->len = net_pkt_lladdr_if(pkt)->len;
+
+	/* Resolved again for the new link */
+	net_pkt_lladdr_dst(pkt)->addr = NULL;
+	net_pkt_lladdr_dst(pkt)->len = 0U;
+
+	ret = net_send_data(pkt);
+	if (ret < 0) {
+		NET_DBG("Cannot forward pkt %p to iface %d (%d)", pkt,
+			net_if_get_by_iface(iface), ret);
+		return NET_DROP;
+	}
+
+	return NET_OK;
+}
+
+/* Forward a packet that is not for us */
+static enum net_verdict ipv4_route_packet(struct net_pkt *pkt,
+					  struct net_ipv4_hdr *hdr)
+{
+	struct in_addr *dst = (struct in_addr *)hdr->dst;
+	struct net_if *iface;
+	int ret;
+
+	if (net_ipv4_is_addr_mcast(dst) ||
+	    net_ipv4_is_addr_bcast(net_pkt_iface(pkt), dst) ||
+	    net_ipv4_is_addr_unspecified(dst) ||
+	    /* RFC 3927 ch. 2.7 */
+	    net_ipv4_is_ll_addr(dst) ||
+	    net_ipv4_is_ll_addr((struct in_addr *)hdr->src)) {
+		return NET_DROP;
+	}
+
+	iface = ipv4_route_iface(dst);
+	if (iface == NULL) {
+		NET_DBG("No route to %s pkt %p dropped",
+			net_sprint_ipv4_addr(dst), pkt);
+		return NET_DROP;
+	}
+
+	if (hdr->ttl <= 1U) {
+		net_icmpv4_send_error(pkt, NET_ICMPV4_TIME_EXCEEDED, 0);
+		return NET_DROP;
+	}
+
+	ret = net_ipv4_nat_out(pkt, iface);
+	if (ret < 0 && ret != -ENOENT) {
+		NET_DBG("Cannot translate pkt %p (%d)", pkt, ret);
+		return NET_DROP;
+	}
+
+	return ipv4_forward_packet(pkt, hdr, iface);
+}
+
+/* Translate back and forward the packets of the NAT flows, before they
+ * reach the connection and socket layers. Expiring packets are left to
+ * the local delivery, which answers them like any other packet for us.
+ */
+static enum net_verdict ipv4_nat_packet(struct net_pkt *pkt,
+					struct net_ipv4_hdr *hdr)
+{
+	struct net_if *iface;
+	int ret;
+
+	if (hdr->ttl <= 1U) {
+		return NET_CONTINUE;
+	}
+
+	ret = net_ipv4_nat_in(pkt, &iface);
+	if (ret == -ENOENT) {
+		return NET_CONTINUE;
+	} else if (ret < 0) {
+		return NET_DROP;
+	}
+
+	return ipv4_forward_packet(pkt, hdr, iface);
+}
+#else
+#define ipv4_route_packet(...) NET_DROP
+#define ipv4_nat_packet(...) NET_CONTINUE
+#endif /* CONFIG_NET_IPV4_FORWARDING */
+
 enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
@@ -338,6 +452,15 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 		return NET_DROP;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_IPV4_NAT) && !is_loopback) {
+		verdict = ipv4_nat_packet(pkt, hdr);
+		if (verdict == NET_DROP) {
+			goto drop;
+		} else if (verdict == NET_OK) {
+			return verdict;
+		}
+	}
+
 	if ((!net_ipv4_is_my_addr((struct in_addr *)hdr->dst) &&
 	     !net_ipv4_is_addr_mcast((struct in_addr *)hdr->dst) &&
 	     !(hdr->proto == IPPROTO_UDP &&
@@ -349,6 +472,13 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 		net_dhcpv4_accept_unicast(pkt)))) ||
 	    (hdr->proto == IPPROTO_TCP &&
 	     net_ipv4_is_addr_bcast(net_pkt_iface(pkt), (struct in_addr *)hdr->dst))) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_FORWARDING) && !is_loopback) {
+			verdict = ipv4_route_packet(pkt, hdr);
+			if (verdict == NET_OK) {
+				return verdict;
+			}
+		}
+
 		NET_DBG("DROP: not for me");
 		goto drop;
 	}
@@ -449,4 +579,6 @@ void net_ipv4_init(void)
 	if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT)) {
 		net_ipv4_setup_fragment_buffers();
 	}
+
+	net_ipv4_nat_init();
 }
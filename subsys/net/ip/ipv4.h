@@ -314,6 +314,30 @@ static inline void net_ipv4_set_ecn(uint8_t *tos, uint8_t ecn)
 	*tos |= ecn & NET_IPV4_ECN_MASK;
 }
 
+/**
+ * @brief Update a checksum for a changed 16-bit word (RFC 1624).
+ *
+ * The words and the checksum are all in network byte order, or all in
+ * host byte order.
+ *
+ * @param chksum Checksum covering the word.
+ * @param old_word Previous value of the word.
+ * @param new_word New value of the word.
+ *
+ * @return Updated checksum.
+ */
+static inline uint16_t net_ipv4_chksum_update(uint16_t chksum,
+					      uint16_t old_word,
+					      uint16_t new_word)
+{
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_word + new_word;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
+}
+
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
 /** Store pending IPv4 fragment information that is needed for reassembly. */
 struct net_ipv4_reassembly {
@@ -357,6 +381,161 @@ typedef void (*net_ipv4_frag_cb_t)(struct net_ipv4_reassembly *reass, void *user
  */
 void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data);
 
+/**
+ * @brief IPv4 NAT translation of a flow.
+ *
+ * Addresses and ports are in network byte order. For ICMPv4 echo the
+ * ports are the echo identifier and the remote port is zero.
+ */
+struct net_ipv4_nat_entry {
+	/** Node in the hash chain of the inside address and port */
+	sys_snode_t inside_node;
+
+	/** Node in the hash chain of the outside port */
+	sys_snode_t outside_node;
+
+	/** Idle timeout, the node links the active translations */
+	struct net_timeout timeout;
+
+	/** Interface the inside host is reached on */
+	struct net_if *inside_iface;
+
+	/** Interface the flow is masqueraded on */
+	struct net_if *outside_iface;
+
+	/** Address of the inside host */
+	struct in_addr inside_addr;
+
+	/** Address the flow is masqueraded behind */
+	struct in_addr outside_addr;
+
+	/** Address of the remote host */
+	struct in_addr remote_addr;
+
+	/** Port of the inside host */
+	uint16_t inside_port;
+
+	/** Port the flow is masqueraded behind */
+	uint16_t outside_port;
+
+	/** Port of the remote host */
+	uint16_t remote_port;
+
+	/** IPPROTO_TCP, IPPROTO_UDP or IPPROTO_ICMP */
+	uint8_t proto;
+
+	/** TCP connection state, see ipv4_nat.c */
+	uint8_t tcp_state;
+};
+
+/**
+ * @typedef net_ipv4_nat_cb_t
+ * @brief Callback used while iterating over the NAT translations.
+ *
+ * @param entry NAT translation
+ * @param user_data A valid pointer on some user data or NULL
+ */
+typedef void (*net_ipv4_nat_cb_t)(struct net_ipv4_nat_entry *entry,
+				  void *user_data);
+
+#if defined(CONFIG_NET_IPV4_NAT)
+/**
+ * @brief Masquerade the flows forwarded out of an interface.
+ *
+ * @param iface Outside network interface, usually the uplink.
+ *
+ * @return 0 if ok, -ENOMEM if no more interfaces can be enabled.
+ */
+int net_ipv4_nat_enable(struct net_if *iface);
+
+/**
+ * @brief Stop masquerading the flows forwarded out of an interface and
+ * remove their translations.
+ *
+ * @param iface Outside network interface.
+ *
+ * @return 0 if ok, -ENOENT if NAT was not enabled on the interface.
+ */
+int net_ipv4_nat_disable(struct net_if *iface);
+
+/**
+ * @brief Check if the flows forwarded out of an interface are masqueraded.
+ *
+ * @param iface Network interface.
+ *
+ * @return True if NAT is enabled on the interface.
+ */
+bool net_ipv4_nat_is_enabled(struct net_if *iface);
+
+/**
+ * @brief Go through all the NAT translations.
+ *
+ * @param cb Callback to call for each translation.
+ * @param user_data User specified data or NULL.
+ *
+ * @return Number of translations.
+ */
+int net_ipv4_nat_foreach(net_ipv4_nat_cb_t cb, void *user_data);
+
+/**
+ * @brief Translate a packet forwarded out of a NAT enabled interface.
+ *
+ * When @p iface has NAT enabled and the interface the packet was received
+ * on has not, the source address and port are replaced with the ones of
+ * the translation of the flow, which is created if needed.
+ *
+ * @param pkt Packet being forwarded, cursor at the IPv4 header.
+ * @param iface Network interface the packet is sent to.
+ *
+ * @return 0 if ok, -ENOENT if the packet is not to be translated, other
+ * <0 if the packet cannot be translated.
+ */
+int net_ipv4_nat_out(struct net_pkt *pkt, struct net_if *iface);
+
+/**
+ * @brief Translate back a packet received on a NAT enabled interface.
+ *
+ * The destination address and port are replaced with the ones of the
+ * inside host, when the packet belongs to a translated flow.
+ *
+ * @param pkt Received packet, cursor at the IPv4 header.
+ * @param iface Set to the interface of the inside host.
+ *
+ * @return 0 if ok, -ENOENT if the packet is not of a translated flow.
+ */
+int net_ipv4_nat_in(struct net_pkt *pkt, struct net_if **iface);
+
+/**
+ * @brief Initialize the NAT translation table.
+ */
+void net_ipv4_nat_init(void);
+#else
+static inline bool net_ipv4_nat_is_enabled(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	return false;
+}
+
+static inline int net_ipv4_nat_out(struct net_pkt *pkt, struct net_if *iface)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(iface);
+
+	return -ENOENT;
+}
+
+static inline int net_ipv4_nat_in(struct net_pkt *pkt, struct net_if **iface)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(iface);
+
+	return -ENOENT;
+}
+
+#define net_ipv4_nat_init(...)
+#endif /* CONFIG_NET_IPV4_NAT */
+
 #if defined(CONFIG_NET_NATIVE_IPV4)
 /**
  * @brief Initialises IPv4
@@ -0,0 +1,754 @@
+/** @file
+ * @brief IPv4 network address and port translation
+ */
+
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_ipv4_nat, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+#include "icmpv4.h"
+#include "ipv4.h"
+
+#define NAT_PORT_COUNT (CONFIG_NET_IPV4_NAT_PORT_MAX - \
+			CONFIG_NET_IPV4_NAT_PORT_MIN + 1)
+
+#define NAT_TCP_FIN BIT(0)
+#define NAT_TCP_RST BIT(2)
+
+#define NAT_ICMP_ECHO_REPLY   0
+#define NAT_ICMP_ECHO_REQUEST 8
+
+/* TCP connection states, deciding the timeout of a translation */
+enum nat_tcp_state {
+	NAT_TCP_OPENING,
+	NAT_TCP_ESTABLISHED,
+	NAT_TCP_CLOSING,
+};
+
+struct nat_icmp_echo {
+	struct net_icmp_hdr hdr;
+	struct net_icmpv4_echo_req echo;
+} __packed;
+
+/* Addresses and ports of a packet, in network byte order */
+struct nat_tuple {
+	struct in_addr src;
+	struct in_addr dst;
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint8_t proto;
+	uint8_t tcp_flags;
+};
+
+static struct net_ipv4_nat_entry nat_entries[CONFIG_NET_IPV4_NAT_MAX_ENTRIES];
+static sys_slist_t nat_inside_hash[CONFIG_NET_IPV4_NAT_HASH_SIZE];
+static sys_slist_t nat_outside_hash[CONFIG_NET_IPV4_NAT_HASH_SIZE];
+
+/* Unused entries are linked through inside_node, used ones through
+ * timeout.node.
+ */
+static sys_slist_t nat_free;
+static sys_slist_t nat_active;
+
+static struct net_if *nat_ifaces[CONFIG_NET_IF_MAX_IPV4_COUNT];
+/* Number of NAT enabled interfaces, checked without the lock so that the
+ * packets do not pay for NAT while it is not used.
+ */
+static atomic_t nat_iface_count;
+static uint16_t nat_next_port;
+
+static struct k_work_delayable nat_timer;
+static K_MUTEX_DEFINE(nat_lock);
+
+static sys_slist_t *nat_chain(sys_slist_t *hash, uint32_t key)
+{
+	key *= 0x9e3779b1U;
+
+	return &hash[(key >> 16) % CONFIG_NET_IPV4_NAT_HASH_SIZE];
+}
+
+static sys_slist_t *nat_inside_chain(const struct in_addr *inside_addr,
+				     uint16_t inside_port,
+				     const struct in_addr *remote_addr,
+				     uint16_t remote_port, uint8_t proto)
+{
+	return nat_chain(nat_inside_hash,
+			 inside_addr->s_addr ^ (remote_addr->s_addr * 31U) ^
+			 ((uint32_t)inside_port << 16 | remote_port) ^ proto);
+}
+
+static sys_slist_t *nat_outside_chain(uint16_t outside_port, uint8_t proto)
+{
+	return nat_chain(nat_outside_hash, (uint32_t)proto << 16 | outside_port);
+}
+
+static struct net_if **nat_iface_slot(struct net_if *iface)
+{
+	ARRAY_FOR_EACH_PTR(nat_ifaces, slot) {
+		if (*slot == iface) {
+			return slot;
+		}
+	}
+
+	return NULL;
+}
+
+static uint32_t nat_timeout(struct net_ipv4_nat_entry *entry)
+{
+	switch (entry->proto) {
+	case IPPROTO_TCP:
+		return entry->tcp_state == NAT_TCP_ESTABLISHED ?
+			CONFIG_NET_IPV4_NAT_TCP_TIMEOUT :
+			CONFIG_NET_IPV4_NAT_TCP_TRANSITORY_TIMEOUT;
+	case IPPROTO_UDP:
+		return CONFIG_NET_IPV4_NAT_UDP_TIMEOUT;
+	default:
+		return CONFIG_NET_IPV4_NAT_ICMP_TIMEOUT;
+	}
+}
+
+/* Get the addresses and ports of a packet that can be translated. The port
+ * of ICMPv4 echo is the identifier, of the sender for requests going out
+ * and of the receiver for replies coming in.
+ */
+static int nat_tuple_get(struct net_pkt *pkt, bool out, struct nat_tuple *tuple)
+{
+	struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+	struct net_pkt_cursor backup;
+	int ret = -ENOBUFS;
+
+	/* Only the first fragment has the ports */
+	if ((sys_get_be16(hdr->offset) &
+	     (NET_IPV4_FRAGH_OFFSET_MASK | NET_IPV4_MORE_FRAG_MASK)) != 0) {
+		return -ENOTSUP;
+	}
+
+	net_ipv4_addr_copy_raw(tuple->src.s4_addr, hdr->src);
+	net_ipv4_addr_copy_raw(tuple->dst.s4_addr, hdr->dst);
+	tuple->proto = hdr->proto;
+	tuple->tcp_flags = 0U;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ipv4_opts_len(pkt))) {
+		goto out;
+	}
+
+	switch (hdr->proto) {
+	case IPPROTO_TCP: {
+		NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+		struct net_tcp_hdr *tcp_hdr;
+
+		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+		if (!tcp_hdr) {
+			goto out;
+		}
+
+		tuple->src_port = tcp_hdr->src_port;
+		tuple->dst_port = tcp_hdr->dst_port;
+		tuple->tcp_flags = tcp_hdr->flags;
+		break;
+	}
+	case IPPROTO_UDP: {
+		NET_PKT_DATA_ACCESS_DEFINE(udp_access, struct net_udp_hdr);
+		struct net_udp_hdr *udp_hdr;
+
+		udp_hdr = (struct net_udp_hdr *)net_pkt_get_data(pkt, &udp_access);
+		if (!udp_hdr) {
+			goto out;
+		}
+
+		tuple->src_port = udp_hdr->src_port;
+		tuple->dst_port = udp_hdr->dst_port;
+		break;
+	}
+	case IPPROTO_ICMP: {
+		NET_PKT_DATA_ACCESS_DEFINE(icmp_access, struct nat_icmp_echo);
+		struct nat_icmp_echo *icmp;
+
+		icmp = (struct nat_icmp_echo *)net_pkt_get_data(pkt, &icmp_access);
+		if (!icmp) {
+			goto out;
+		}
+
+		if (icmp->hdr.type != (out ? NAT_ICMP_ECHO_REQUEST :
+					     NAT_ICMP_ECHO_REPLY)) {
+			ret = -ENOTSUP;
+			goto out;
+		}
+
+		tuple->src_port = out ? icmp->echo.identifier : 0U;
+		tuple->dst_port = out ? 0U : icmp->echo.identifier;
+		break;
+	}
+	default:
+		ret = -ENOTSUP;
+		goto out;
+	}
+
+	ret = 0;
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return ret;
+}
+
+static uint16_t nat_chksum_update_addr(uint16_t chksum, const uint8_t *old_addr,
+				       const uint8_t *new_addr)
+{
+	chksum = net_ipv4_chksum_update(chksum, UNALIGNED_GET((uint16_t *)old_addr),
+					UNALIGNED_GET((uint16_t *)new_addr));
+
+	return net_ipv4_chksum_update(chksum,
+				      UNALIGNED_GET((uint16_t *)&old_addr[2]),
+				      UNALIGNED_GET((uint16_t *)&new_addr[2]));
+}
+
+/* Replace the source or the destination address and port of a packet,
+ * updating the checksums instead of computing them again.
+ */
+static int nat_rewrite(struct net_pkt *pkt, bool src, const struct in_addr *addr,
+		       uint16_t port)
+{
+	struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+	uint8_t *hdr_addr = src ? hdr->src : hdr->dst;
+	struct net_pkt_cursor backup;
+	int ret = -ENOBUFS;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ipv4_opts_len(pkt))) {
+		goto out;
+	}
+
+	switch (hdr->proto) {
+	case IPPROTO_TCP: {
+		NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+		struct net_tcp_hdr *tcp_hdr;
+
+		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+		if (!tcp_hdr) {
+			goto out;
+		}
+
+		tcp_hdr->chksum = nat_chksum_update_addr(tcp_hdr->chksum, hdr_addr,
+							 addr->s4_addr);
+
+		if (src) {
+			tcp_hdr->chksum = net_ipv4_chksum_update(tcp_hdr->chksum,
+								 tcp_hdr->src_port,
+								 port);
+			tcp_hdr->src_port = port;
+		} else {
+			tcp_hdr->chksum = net_ipv4_chksum_update(tcp_hdr->chksum,
+								 tcp_hdr->dst_port,
+								 port);
+			tcp_hdr->dst_port = port;
+		}
+
+		ret = net_pkt_set_data(pkt, &tcp_access);
+		break;
+	}
+	case IPPROTO_UDP: {
+		NET_PKT_DATA_ACCESS_DEFINE(udp_access, struct net_udp_hdr);
+		struct net_udp_hdr *udp_hdr;
+		uint16_t old_port;
+
+		udp_hdr = (struct net_udp_hdr *)net_pkt_get_data(pkt, &udp_access);
+		if (!udp_hdr) {
+			goto out;
+		}
+
+		old_port = src ? udp_hdr->src_port : udp_hdr->dst_port;
+
+		if (src) {
+			udp_hdr->src_port = port;
+		} else {
+			udp_hdr->dst_port = port;
+		}
+
+		/* A zero UDP checksum means that there is none */
+		if (udp_hdr->chksum != 0U) {
+			udp_hdr->chksum = nat_chksum_update_addr(udp_hdr->chksum,
+								 hdr_addr,
+								 addr->s4_addr);
+			udp_hdr->chksum = net_ipv4_chksum_update(udp_hdr->chksum,
+								 old_port, port);
+			if (udp_hdr->chksum == 0U) {
+				udp_hdr->chksum = 0xffff;
+			}
+		}
+
+		ret = net_pkt_set_data(pkt, &udp_access);
+		break;
+	}
+	case IPPROTO_ICMP: {
+		NET_PKT_DATA_ACCESS_DEFINE(icmp_access, struct nat_icmp_echo);
+		struct nat_icmp_echo *icmp;
+
+		icmp = (struct nat_icmp_echo *)net_pkt_get_data(pkt, &icmp_access);
+		if (!icmp) {
+			goto out;
+		}
+
+		/* No pseudo header in the ICMPv4 checksum */
+		icmp->hdr.chksum = net_ipv4_chksum_update(icmp->hdr.chksum,
+							  icmp->echo.identifier,
+							  port);
+		icmp->echo.identifier = port;
+
+		ret = net_pkt_set_data(pkt, &icmp_access);
+		break;
+	}
+	default:
+		ret = -ENOTSUP;
+		break;
+	}
+
+	if (ret < 0) {
+		goto out;
+	}
+
+	hdr->chksum = nat_chksum_update_addr(hdr->chksum, hdr_addr, addr->s4_addr);
+	net_ipv4_addr_copy_raw(hdr_addr, addr->s4_addr);
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return ret;
+}
+
+static void nat_timer_schedule(uint32_t timeout)
+{
+	if (!k_work_delayable_is_pending(&nat_timer) ||
+	    k_ticks_to_ms_floor64(k_work_delayable_remaining_get(&nat_timer)) >
+	    (uint64_t)timeout * MSEC_PER_SEC) {
+		k_work_reschedule(&nat_timer, K_SECONDS(timeout));
+	}
+}
+
+/* Restart the idle timeout, the timer only needs to be moved when the
+ * timeout gets shorter.
+ */
+static void nat_refresh(struct net_ipv4_nat_entry *entry, uint8_t tcp_flags,
+			bool out, bool created)
+{
+	uint8_t state = entry->tcp_state;
+	uint32_t timeout;
+
+	if (entry->proto == IPPROTO_TCP) {
+		if (tcp_flags & (NAT_TCP_FIN | NAT_TCP_RST)) {
+			entry->tcp_state = NAT_TCP_CLOSING;
+		} else if (!out && entry->tcp_state == NAT_TCP_OPENING) {
+			/* The remote host answered */
+			entry->tcp_state = NAT_TCP_ESTABLISHED;
+		}
+	}
+
+	timeout = nat_timeout(entry);
+
+	net_timeout_set(&entry->timeout, timeout, k_uptime_get_32());
+
+	if (created || (state != entry->tcp_state &&
+			entry->tcp_state == NAT_TCP_CLOSING)) {
+		nat_timer_schedule(timeout);
+	}
+}
+
+static bool nat_port_in_use(uint8_t proto, uint16_t port,
+			    const struct in_addr *addr)
+{
+	struct net_ipv4_nat_entry *entry;
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+	};
+
+	SYS_SLIST_FOR_EACH_CONTAINER(nat_outside_chain(port, proto), entry,
+				     outside_node) {
+		if (entry->proto == proto && entry->outside_port == port) {
+			return true;
+		}
+	}
+
+	if (proto == IPPROTO_ICMP) {
+		return false;
+	}
+
+	/* Do not steal the replies of the local connections */
+	net_ipaddr_copy(&local.sin_addr, addr);
+
+	return net_context_port_in_use(proto, ntohs(port),
+				       (struct sockaddr *)&local);
+}
+
+static int nat_port_alloc(uint8_t proto, const struct in_addr *addr,
+			  uint16_t *port)
+{
+	for (int i = 0; i < NAT_PORT_COUNT; i++) {
+		uint16_t candidate = htons(nat_next_port);
+
+		nat_next_port = nat_next_port == CONFIG_NET_IPV4_NAT_PORT_MAX ?
+			CONFIG_NET_IPV4_NAT_PORT_MIN : nat_next_port + 1;
+
+		if (!nat_port_in_use(proto, candidate, addr)) {
+			*port = candidate;
+			return 0;
+		}
+	}
+
+	return -EADDRINUSE;
+}
+
+static struct net_ipv4_nat_entry *nat_create(const struct nat_tuple *tuple,
+					     struct net_if *inside_iface,
+					     struct net_if *outside_iface)
+{
+	const struct in_addr *addr;
+	struct net_ipv4_nat_entry *entry;
+	sys_snode_t *node;
+	uint16_t port;
+
+	addr = net_if_ipv4_select_src_addr(outside_iface, &tuple->dst);
+	if (addr == NULL || net_ipv4_is_addr_unspecified(addr)) {
+		NET_DBG("No address to masquerade on iface %d",
+			net_if_get_by_iface(outside_iface));
+		return NULL;
+	}
+
+	if (tuple->proto == IPPROTO_ICMP) {
+		/* Echo identifiers are not ports, keep the one of the host
+		 * if nobody else uses it.
+		 */
+		port = tuple->src_port;
+		if (nat_port_in_use(tuple->proto, port, addr) &&
+		    nat_port_alloc(tuple->proto, addr, &port) < 0) {
+			return NULL;
+		}
+	} else if (nat_port_alloc(tuple->proto, addr, &port) < 0) {
+		NET_DBG("No free port to masquerade");
+		return NULL;
+	}
+
+	node = sys_slist_get(&nat_free);
+	if (node == NULL) {
+		NET_DBG("No free NAT entry");
+		return NULL;
+	}
+
+	entry = CONTAINER_OF(node, struct net_ipv4_nat_entry, inside_node);
+
+	(void)memset(entry, 0, sizeof(*entry));
+
+	entry->inside_iface = inside_iface;
+	entry->outside_iface = outside_iface;
+	net_ipaddr_copy(&entry->inside_addr, &tuple->src);
+	net_ipaddr_copy(&entry->outside_addr, addr);
+	net_ipaddr_copy(&entry->remote_addr, &tuple->dst);
+	entry->inside_port = tuple->src_port;
+	entry->outside_port = port;
+	entry->remote_port = tuple->dst_port;
+	entry->proto = tuple->proto;
+	entry->tcp_state = NAT_TCP_OPENING;
+
+	sys_slist_prepend(nat_inside_chain(&entry->inside_addr,
+					   entry->inside_port,
+					   &entry->remote_addr,
+					   entry->remote_port, entry->proto),
+			  &entry->inside_node);
+	sys_slist_prepend(nat_outside_chain(entry->outside_port, entry->proto),
+			  &entry->outside_node);
+	sys_slist_append(&nat_active, &entry->timeout.node);
+
+	NET_DBG("Masquerading %s %s:%u as %s:%u",
+		net_proto2str(AF_INET, entry->proto),
+		net_sprint_ipv4_addr(&entry->inside_addr),
+		ntohs(entry->inside_port),
+		net_sprint_ipv4_addr(&entry->outside_addr),
+		ntohs(entry->outside_port));
+
+	return entry;
+}
+
+/* The caller removes the entry from nat_active */
+static void nat_release(struct net_ipv4_nat_entry *entry)
+{
+	NET_DBG("Removing %s translation %s:%u",
+		net_proto2str(AF_INET, entry->proto),
+		net_sprint_ipv4_addr(&entry->outside_addr),
+		ntohs(entry->outside_port));
+
+	(void)sys_slist_find_and_remove(nat_inside_chain(&entry->inside_addr,
+							 entry->inside_port,
+							 &entry->remote_addr,
+							 entry->remote_port,
+							 entry->proto),
+					&entry->inside_node);
+	(void)sys_slist_find_and_remove(nat_outside_chain(entry->outside_port,
+							  entry->proto),
+					&entry->outside_node);
+
+	sys_slist_prepend(&nat_free, &entry->inside_node);
+}
+
+static void nat_timeout_handler(struct k_work *work)
+{
+	uint32_t next_update = UINT32_MAX;
+	uint32_t current_time = k_uptime_get_32();
+	sys_snode_t *node, *next, *prev = NULL;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&nat_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_NODE_SAFE(&nat_active, node, next) {
+		struct net_ipv4_nat_entry *entry =
+			CONTAINER_OF(node, struct net_ipv4_nat_entry, timeout.node);
+		uint32_t this_update = net_timeout_evaluate(&entry->timeout,
+							    current_time);
+
+		if (this_update == 0U) {
+			sys_slist_remove(&nat_active, prev, node);
+			nat_release(entry);
+			continue;
+		}
+
+		if (this_update < next_update) {
+			next_update = this_update;
+		}
+
+		prev = node;
+	}
+
+	if (next_update != UINT32_MAX) {
+		k_work_reschedule(&nat_timer, K_MSEC(next_update));
+	}
+
+	k_mutex_unlock(&nat_lock);
+}
+
+int net_ipv4_nat_out(struct net_pkt *pkt, struct net_if *iface)
+{
+	struct net_ipv4_nat_entry *entry;
+	struct nat_tuple tuple;
+	bool created = false;
+	int ret;
+
+	if (atomic_get(&nat_iface_count) == 0) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&nat_lock, K_FOREVER);
+
+	/* Only the flows leaving through an outside interface from an
+	 * inside one are masqueraded.
+	 */
+	if (nat_iface_slot(iface) == NULL ||
+	    nat_iface_slot(net_pkt_iface(pkt)) != NULL) {
+		ret = -ENOENT;
+		goto out;
+	}
+
+	ret = nat_tuple_get(pkt, true, &tuple);
+	if (ret < 0) {
+		goto out;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(nat_inside_chain(&tuple.src, tuple.src_port,
+						      &tuple.dst, tuple.dst_port,
+						      tuple.proto),
+				     entry, inside_node) {
+		if (entry->proto == tuple.proto &&
+		    entry->inside_port == tuple.src_port &&
+		    entry->remote_port == tuple.dst_port &&
+		    entry->outside_iface == iface &&
+		    net_ipv4_addr_cmp(&entry->inside_addr, &tuple.src) &&
+		    net_ipv4_addr_cmp(&entry->remote_addr, &tuple.dst)) {
+			goto found;
+		}
+	}
+
+	entry = nat_create(&tuple, net_pkt_iface(pkt), iface);
+	if (entry == NULL) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	created = true;
+
+found:
+	nat_refresh(entry, tuple.tcp_flags, true, created);
+
+	ret = nat_rewrite(pkt, true, &entry->outside_addr, entry->outside_port);
+
+out:
+	k_mutex_unlock(&nat_lock);
+
+	return ret;
+}
+
+int net_ipv4_nat_in(struct net_pkt *pkt, struct net_if **iface)
+{
+	struct net_ipv4_nat_entry *entry;
+	struct nat_tuple tuple;
+	int ret = -ENOENT;
+
+	if (atomic_get(&nat_iface_count) == 0) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&nat_lock, K_FOREVER);
+
+	if (nat_iface_slot(net_pkt_iface(pkt)) == NULL ||
+	    nat_tuple_get(pkt, false, &tuple) < 0) {
+		goto out;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(nat_outside_chain(tuple.dst_port,
+						       tuple.proto),
+				     entry, outside_node) {
+		if (entry->proto == tuple.proto &&
+		    entry->outside_port == tuple.dst_port &&
+		    entry->remote_port == tuple.src_port &&
+		    entry->outside_iface == net_pkt_iface(pkt) &&
+		    net_ipv4_addr_cmp(&entry->outside_addr, &tuple.dst) &&
+		    net_ipv4_addr_cmp(&entry->remote_addr, &tuple.src)) {
+			nat_refresh(entry, tuple.tcp_flags, false, false);
+
+			*iface = entry->inside_iface;
+			ret = nat_rewrite(pkt, false, &entry->inside_addr,
+					  entry->inside_port);
+			break;
+		}
+	}
+
+out:
+	k_mutex_unlock(&nat_lock);
+
+	return ret;
+}
+
+int net_ipv4_nat_enable(struct net_if *iface)
+{
+	struct net_if **slot;
+	int ret = 0;
+
+	k_mutex_lock(&nat_lock, K_FOREVER);
+
+	if (nat_iface_slot(iface) != NULL) {
+		goto out;
+	}
+
+	slot = nat_iface_slot(NULL);
+	if (slot == NULL) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	*slot = iface;
+	atomic_inc(&nat_iface_count);
+
+	NET_DBG("NAT enabled on iface %d", net_if_get_by_iface(iface));
+
+out:
+	k_mutex_unlock(&nat_lock);
+
+	return ret;
+}
+
+int net_ipv4_nat_disable(struct net_if *iface)
+{
+	struct net_ipv4_nat_entry *entry, *next;
+	struct net_if **slot;
+	int ret = 0;
+
+	k_mutex_lock(&nat_lock, K_FOREVER);
+
+	slot = nat_iface_slot(iface);
+	if (slot == NULL) {
+		ret = -ENOENT;
+		goto out;
+	}
+
+	*slot = NULL;
+	atomic_dec(&nat_iface_count);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&nat_active, entry, next,
+					  timeout.node) {
+		if (entry->outside_iface == iface) {
+			(void)sys_slist_find_and_remove(&nat_active,
+							&entry->timeout.node);
+			nat_release(entry);
+		}
+	}
+
+	NET_DBG("NAT disabled on iface %d", net_if_get_by_iface(iface));
+
+out:
+	k_mutex_unlock(&nat_lock);
+
+	return ret;
+}
+
+bool net_ipv4_nat_is_enabled(struct net_if *iface)
+{
+	bool enabled;
+
+	if (iface == NULL || atomic_get(&nat_iface_count) == 0) {
+		return false;
+	}
+
+	k_mutex_lock(&nat_lock, K_FOREVER);
+	enabled = iface != NULL && nat_iface_slot(iface) != NULL;
+	k_mutex_unlock(&nat_lock);
+
+	return enabled;
+}
+
+int net_ipv4_nat_foreach(net_ipv4_nat_cb_t cb, void *user_data)
+{
+	struct net_ipv4_nat_entry *entry;
+	int count = 0;
+
+	k_mutex_lock(&nat_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&nat_active, entry, timeout.node) {
+		cb(entry, user_data);
+		count++;
+	}
+
+	k_mutex_unlock(&nat_lock);
+
+	return count;
+}
+
+void net_ipv4_nat_init(void)
+{
+	ARRAY_FOR_EACH_PTR(nat_entries, entry) {
+		sys_slist_append(&nat_free, &entry->inside_node);
+	}
+
+	/* Start at a random port so that the ports are hard to guess */
+	nat_next_port = CONFIG_NET_IPV4_NAT_PORT_MIN +
+			sys_rand32_get() % NAT_PORT_COUNT;
+
+	k_work_init_delayable(&nat_timer, nat_timeout_handler);
+}
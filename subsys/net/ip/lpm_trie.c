@@ -0,0 +1,259 @@
+/** @file
+ * @brief Longest prefix match trie
+ */
+
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/util.h>
+
+#include "lpm_trie.h"
+
+static inline uint8_t lpm_bit(const uint8_t *key, uint8_t bit)
+{
+	return (key[bit / 8U] >> (7U - (bit % 8U))) & 1U;
+}
+
+/* Number of leading bits of key matching the node prefix, at most limit */
+static uint8_t lpm_match_len(const struct net_lpm_node *node,
+			     const uint8_t *key, uint8_t limit)
+{
+	uint8_t len = 0U;
+
+	limit = MIN(limit, node->prefix_len);
+
+	for (int i = 0; len < limit; i++) {
+		uint8_t diff = node->key[i] ^ key[i];
+
+		if (diff != 0U) {
+			len += u32_count_leading_zeros(diff) - 24;
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, limit);
+}
+
+static struct net_lpm_node *lpm_node_alloc(struct net_lpm_trie *trie,
+					   const uint8_t *key,
+					   uint8_t prefix_len)
+{
+	struct net_lpm_node *node = trie->free;
+	uint8_t bytes = prefix_len / 8U;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	trie->free = node->child[0];
+
+	memset(node, 0, sizeof(*node));
+	memcpy(node->key, key, bytes);
+
+	if (prefix_len % 8U) {
+		node->key[bytes] = key[bytes] & (0xff << (8U - prefix_len % 8U));
+	}
+
+	node->prefix_len = prefix_len;
+
+	return node;
+}
+
+static void lpm_node_free(struct net_lpm_trie *trie, struct net_lpm_node *node)
+{
+	node->child[0] = trie->free;
+	trie->free = node;
+}
+
+void net_lpm_init(struct net_lpm_trie *trie, struct net_lpm_node *nodes,
+		  size_t count, uint8_t key_bits)
+{
+	__ASSERT_NO_MSG(key_bits <= NET_LPM_KEY_MAX_LEN * 8);
+
+	trie->root = NULL;
+	trie->free = NULL;
+	trie->key_bits = key_bits;
+
+	for (size_t i = 0; i < count; i++) {
+		lpm_node_free(trie, &nodes[i]);
+	}
+}
+
+int net_lpm_insert(struct net_lpm_trie *trie, const uint8_t *key,
+		   uint8_t prefix_len, void *value)
+{
+	struct net_lpm_node **slot = &trie->root;
+	struct net_lpm_node *node, *new, *glue;
+	uint8_t match_len = 0U;
+
+	if (prefix_len > trie->key_bits || value == NULL) {
+		return -EINVAL;
+	}
+
+	/* Descend while the node prefix is a strict prefix of the key */
+	while ((node = *slot) != NULL) {
+		match_len = lpm_match_len(node, key, prefix_len);
+
+		if (match_len != node->prefix_len ||
+		    node->prefix_len == prefix_len) {
+			break;
+		}
+
+		slot = &node->child[lpm_bit(key, node->prefix_len)];
+	}
+
+	if (node != NULL && match_len == prefix_len &&
+	    node->prefix_len == prefix_len) {
+		node->value = value;
+		return 0;
+	}
+
+	new = lpm_node_alloc(trie, key, prefix_len);
+	if (new == NULL) {
+		return -ENOMEM;
+	}
+
+	new->value = value;
+
+	if (node == NULL) {
+		*slot = new;
+		return 0;
+	}
+
+	/* The new prefix is a prefix of the node */
+	if (match_len == prefix_len) {
+		new->child[lpm_bit(node->key, prefix_len)] = node;
+		*slot = new;
+		return 0;
+	}
+
+	/* The prefixes diverge after match_len bits */
+	glue = lpm_node_alloc(trie, key, match_len);
+	if (glue == NULL) {
+		lpm_node_free(trie, new);
+		return -ENOMEM;
+	}
+
+	if (lpm_bit(key, match_len)) {
+		glue->child[0] = node;
+		glue->child[1] = new;
+	} else {
+		glue->child[0] = new;
+		glue->child[1] = node;
+	}
+
+	*slot = glue;
+
+	return 0;
+}
+
+void *net_lpm_remove(struct net_lpm_trie *trie, const uint8_t *key,
+		     uint8_t prefix_len)
+{
+	struct net_lpm_node **parent_slot = NULL;
+	struct net_lpm_node **slot = &trie->root;
+	struct net_lpm_node *node, *parent;
+	uint8_t match_len = 0U;
+	void *value;
+
+	if (prefix_len > trie->key_bits) {
+		return NULL;
+	}
+
+	while ((node = *slot) != NULL) {
+		match_len = lpm_match_len(node, key, prefix_len);
+
+		if (match_len != node->prefix_len ||
+		    node->prefix_len == prefix_len) {
+			break;
+		}
+
+		parent_slot = slot;
+		slot = &node->child[lpm_bit(key, node->prefix_len)];
+	}
+
+	if (node == NULL || node->value == NULL ||
+	    match_len != prefix_len || node->prefix_len != prefix_len) {
+		return NULL;
+	}
+
+	value = node->value;
+
+	/* Still needed to join its children */
+	if (node->child[0] != NULL && node->child[1] != NULL) {
+		node->value = NULL;
+		return value;
+	}
+
+	if (node->child[0] != NULL || node->child[1] != NULL) {
+		*slot = node->child[0] != NULL ? node->child[0] : node->child[1];
+		lpm_node_free(trie, node);
+		return value;
+	}
+
+	*slot = NULL;
+	lpm_node_free(trie, node);
+
+	/* An intermediate parent is left with a single child */
+	if (parent_slot != NULL && (*parent_slot)->value == NULL) {
+		parent = *parent_slot;
+		*parent_slot = parent->child[0] != NULL ? parent->child[0] :
+							  parent->child[1];
+		lpm_node_free(trie, parent);
+	}
+
+	return value;
+}
+
+void *net_lpm_get(struct net_lpm_trie *trie, const uint8_t *key,
+		  uint8_t prefix_len)
+{
+	struct net_lpm_node *node = trie->root;
+
+	while (node != NULL && node->prefix_len <= prefix_len &&
+	       lpm_match_len(node, key, prefix_len) == node->prefix_len) {
+		if (node->prefix_len == prefix_len) {
+			return node->value;
+		}
+
+		node = node->child[lpm_bit(key, node->prefix_len)];
+	}
+
+	return NULL;
+}
+
+void *net_lpm_lookup(struct net_lpm_trie *trie, const uint8_t *key,
+		     net_lpm_select_t select, void *user_data)
+{
+	struct net_lpm_node *node = trie->root;
+	void *found = NULL;
+
+	while (node != NULL &&
+	       lpm_match_len(node, key, trie->key_bits) == node->prefix_len) {
+		if (node->value != NULL) {
+			void *value = select != NULL ?
+				select(node->value, user_data) : node->value;
+
+			if (value != NULL) {
+				found = value;
+			}
+		}
+
+		if (node->prefix_len == trie->key_bits) {
+			break;
+		}
+
+		node = node->child[lpm_bit(key, node->prefix_len)];
+	}
+
+	return found;
+}
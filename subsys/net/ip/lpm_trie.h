@@ -0,0 +1,143 @@
+/** @file
+ * @brief Longest prefix match trie
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LPM_TRIE_H
+#define __LPM_TRIE_H
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum key length in bytes, enough for an IPv6 address */
+#define NET_LPM_KEY_MAX_LEN 16
+
+/**
+ * @brief Trie node.
+ *
+ * A node either holds a prefix added with net_lpm_insert(), or is an
+ * intermediate node without value joining two diverging prefixes.
+ * Intermediate nodes always have two children, so a trie of N prefixes
+ * never needs more than 2 * N - 1 nodes.
+ */
+struct net_lpm_node {
+	/** Children, indexed by the first bit after the prefix */
+	struct net_lpm_node *child[2];
+
+	/** Value of the prefix, NULL for intermediate nodes */
+	void *value;
+
+	/** Prefix, bits after prefix_len are zero */
+	uint8_t key[NET_LPM_KEY_MAX_LEN];
+
+	/** Prefix length in bits */
+	uint8_t prefix_len;
+};
+
+/**
+ * @brief Path compressed binary trie (Patricia trie).
+ *
+ * Each node skips all the bits its children have in common, so a lookup
+ * visits at most one node per distinct prefix length on the path to the
+ * destination, however many prefixes are stored. The trie does no
+ * locking of its own.
+ */
+struct net_lpm_trie {
+	/** Root node */
+	struct net_lpm_node *root;
+
+	/** Unused nodes, linked through child[0] */
+	struct net_lpm_node *free;
+
+	/** Key length in bits */
+	uint8_t key_bits;
+};
+
+/**
+ * @brief Select a value on the path of a lookup.
+ *
+ * @param value Value of a prefix matching the key.
+ * @param user_data User data given to net_lpm_lookup().
+ *
+ * @return Value to return if no longer prefix matches, NULL to skip the
+ * prefix.
+ */
+typedef void *(*net_lpm_select_t)(void *value, void *user_data);
+
+/**
+ * @brief Initialize a trie.
+ *
+ * @param trie Trie to initialize.
+ * @param nodes Node storage, two nodes per prefix to store.
+ * @param count Number of nodes in @p nodes.
+ * @param key_bits Key length in bits, 32 for IPv4 and 128 for IPv6.
+ */
+void net_lpm_init(struct net_lpm_trie *trie, struct net_lpm_node *nodes,
+		  size_t count, uint8_t key_bits);
+
+/**
+ * @brief Add a prefix to the trie, or update the value of a prefix.
+ *
+ * @param trie Trie.
+ * @param key Key, bits after @p prefix_len are ignored.
+ * @param prefix_len Prefix length in bits.
+ * @param value Value of the prefix, must not be NULL.
+ *
+ * @return 0 if ok, -ENOMEM if out of nodes, -EINVAL if invalid.
+ */
+int net_lpm_insert(struct net_lpm_trie *trie, const uint8_t *key,
+		   uint8_t prefix_len, void *value);
+
+/**
+ * @brief Remove a prefix from the trie.
+ *
+ * @param trie Trie.
+ * @param key Key, bits after @p prefix_len are ignored.
+ * @param prefix_len Prefix length in bits.
+ *
+ * @return Value of the removed prefix, NULL if not found.
+ */
+void *net_lpm_remove(struct net_lpm_trie *trie, const uint8_t *key,
+		     uint8_t prefix_len);
+
+/**
+ * @brief Get the value of an exact prefix.
+ *
+ * @param trie Trie.
+ * @param key Key, bits after @p prefix_len are ignored.
+ * @param prefix_len Prefix length in bits.
+ *
+ * @return Value of the prefix, NULL if not found.
+ */
+void *net_lpm_get(struct net_lpm_trie *trie, const uint8_t *key,
+		  uint8_t prefix_len);
+
+/**
+ * @brief Find the longest prefix matching a key.
+ *
+ * @param trie Trie.
+ * @param key Key of trie->key_bits bits.
+ * @param select Optional callback choosing among the matching prefixes,
+ * if NULL the value of the longest matching prefix is returned.
+ * @param user_data User data passed to @p select.
+ *
+ * @return Value of the longest matching prefix, NULL if none matches.
+ */
+void *net_lpm_lookup(struct net_lpm_trie *trie, const uint8_t *key,
+		     net_lpm_select_t select, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LPM_TRIE_H */
@@ -463,10 +463,11 @@ void net_process_rx_packet(struct net_pkt *pkt)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
-static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+static uint8_t net_rx_account(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
-	uint8_t tc = net_rx_priority2tc(prio);
+	uint8_t tc = IS_ENABLED(CONFIG_NET_RX_FLOW_STEERING) ?
+		     net_rx_flow2tc(pkt) : net_rx_priority2tc(prio);
 
 #if defined(CONFIG_NET_STATISTICS)
 	net_stats_update_tc_recv_pkt(iface, tc);
@@ -478,6 +479,13 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
 #endif
 
+	return tc;
+}
+
+static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint8_t tc = net_rx_account(iface, pkt);
+
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
 	} else {
@@ -485,6 +493,30 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	}
 }
 
+/* Prepare a received packet for queueing, false if it was filtered out */
+static bool net_recv_accept(struct net_if *iface, struct net_pkt *pkt)
+{
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
+		iface, pkt, net_pkt_get_len(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
+		net_pkt_set_orig_iface(pkt, iface);
+	}
+
+	net_pkt_set_iface(pkt, iface);
+
+	if (!net_pkt_filter_recv_ok(pkt)) {
+		/* silently drop the packet */
+		net_pkt_unref(pkt);
+		return false;
+	}
+
+	return true;
+}
+
 /* Called by driver when a packet has been received */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 {
@@ -500,24 +532,70 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 		return -ENETDOWN;
 	}
 
-	net_pkt_set_overwrite(pkt, true);
-	net_pkt_cursor_init(pkt);
+	if (net_recv_accept(iface, pkt)) {
+		net_queue_rx(iface, pkt);
+	}
 
-	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
-		iface, pkt, net_pkt_get_len(pkt));
+	return 0;
+}
 
-	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
-		net_pkt_set_orig_iface(pkt, iface);
+/* Called by driver when several packets have been received */
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			size_t count)
+{
+#if NET_TC_RX_COUNT > 0
+	sys_slist_t queues[NET_TC_RX_COUNT];
+#endif
+
+	if (!iface || (!pkts && count > 0)) {
+		return -EINVAL;
 	}
 
-	net_pkt_set_iface(pkt, iface);
+	if (!net_if_flag_is_set(iface, NET_IF_UP)) {
+		return -ENETDOWN;
+	}
 
-	if (!net_pkt_filter_recv_ok(pkt)) {
-		/* silently drop the packet */
-		net_pkt_unref(pkt);
-	} else {
-		net_queue_rx(iface, pkt);
+#if NET_TC_RX_COUNT > 0
+	for (int i = 0; i < NET_TC_RX_COUNT; i++) {
+		sys_slist_init(&queues[i]);
+	}
+#endif
+
+	for (size_t i = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
+		uint8_t tc;
+
+		if (!pkt) {
+			continue;
+		}
+
+		if (net_pkt_is_empty(pkt)) {
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		if (!net_recv_accept(iface, pkt)) {
+			continue;
+		}
+
+		tc = net_rx_account(iface, pkt);
+
+#if NET_TC_RX_COUNT > 0
+		net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+		sys_slist_append(&queues[tc], (sys_snode_t *)&pkt->fifo);
+#else
+		ARG_UNUSED(tc);
+		net_process_rx_packet(pkt);
+#endif
+	}
+
+#if NET_TC_RX_COUNT > 0
+	for (int i = 0; i < NET_TC_RX_COUNT; i++) {
+		if (!sys_slist_is_empty(&queues[i])) {
+			net_tc_submit_list_to_rx_queue(i, &queues[i]);
+		}
 	}
+#endif
 
 	return 0;
 }
@@ -542,6 +620,8 @@ static inline void l3_init(void)
 
 	net_route_init();
 
+	net_route_ipv4_init();
+
 	NET_DBG("Network L3 init done");
 }
 
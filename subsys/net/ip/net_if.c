@@ -31,6 +31,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "route.h"
 
 #include "net_stats.h"
 
@@ -5014,6 +5015,7 @@ static void notify_iface_up(struct net_if *iface)
 	net_if_flag_set(iface, NET_IF_RUNNING);
 	net_mgmt_event_notify(NET_EVENT_IF_UP, iface);
 	net_virtual_enable(iface);
+	net_route_ipv4_iface_update(iface);
 
 	/* If the interface is only having point-to-point traffic then we do
 	 * not need to run DAD etc for it.
@@ -5041,6 +5043,9 @@ static void notify_iface_down(struct net_if *iface)
 		clear_joined_ipv6_mcast_groups(iface);
 		net_ipv4_autoconf_reset(iface);
 	}
+
+	/* The routes through the interface are skipped until it is up again */
+	net_route_ipv4_iface_update(iface);
 }
 
 static inline const char *net_if_oper_state2str(enum net_if_oper_state state)
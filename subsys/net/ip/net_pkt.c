@@ -966,6 +966,11 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 			max_len = size;
 		}
 
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && proto == IPPROTO_TCP) {
+			/* TCP GSO packets are segmented before they are sent */
+			max_len = MAX(max_len, size);
+		}
+
 		max_len = MAX(max_len, NET_IPV6_MTU);
 	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
 		if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT) && (size > max_len)) {
@@ -973,6 +978,11 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 			max_len = size;
 		}
 
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && proto == IPPROTO_TCP) {
+			/* TCP GSO packets are segmented before they are sent */
+			max_len = MAX(max_len, size);
+		}
+
 		max_len = MAX(max_len, NET_IPV4_MTU);
 	} else { /* family == AF_UNSPEC */
 #if defined (CONFIG_NET_L2_ETHERNET)
@@ -1866,6 +1876,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_ip_dscp(clone_pkt, net_pkt_ip_dscp(pkt));
 	net_pkt_set_ip_ecn(clone_pkt, net_pkt_ip_ecn(pkt));
 	net_pkt_set_vlan_tag(clone_pkt, net_pkt_vlan_tag(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 	net_pkt_set_timestamp(clone_pkt, net_pkt_timestamp(pkt));
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
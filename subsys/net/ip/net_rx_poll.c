@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_core, CONFIG_NET_CORE_LOG_LEVEL);
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+
+#if defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
+#define THREAD_PRIORITY K_PRIO_COOP(CONFIG_NET_RX_POLL_THREAD_PRIO)
+#else
+#define THREAD_PRIORITY K_PRIO_PREEMPT(CONFIG_NET_RX_POLL_THREAD_PRIO)
+#endif
+
+static K_KERNEL_STACK_DEFINE(rx_poll_stack, CONFIG_NET_RX_POLL_STACK_SIZE);
+static struct k_work_q rx_poll_work_q;
+
+static void rx_poll_handler(struct k_work *work)
+{
+	struct net_rx_poll *poll = CONTAINER_OF(work, struct net_rx_poll, work);
+	struct net_pkt *pkts[CONFIG_NET_RX_POLL_BUDGET];
+	int count;
+
+	count = poll->poll(poll, pkts, ARRAY_SIZE(pkts));
+	if (count > 0 && net_recv_data_batch(poll->iface, pkts, count) < 0) {
+		for (int i = 0; i < count; i++) {
+			net_pkt_unref(pkts[i]);
+		}
+	}
+
+	NET_DBG("iface %p: %d packet(s)", poll->iface, count);
+
+	if (count < (int)ARRAY_SIZE(pkts)) {
+		poll->done(poll);
+		return;
+	}
+
+	/* Budget exhausted, let the other devices be polled first */
+	k_work_submit_to_queue(&rx_poll_work_q, work);
+}
+
+void net_rx_poll_init(struct net_rx_poll *poll, struct net_if *iface,
+		      net_rx_poll_cb_t poll_cb, net_rx_poll_done_cb_t done_cb)
+{
+	k_work_init(&poll->work, rx_poll_handler);
+	poll->iface = iface;
+	poll->poll = poll_cb;
+	poll->done = done_cb;
+}
+
+int net_rx_poll_schedule(struct net_rx_poll *poll)
+{
+	int ret;
+
+	ret = k_work_submit_to_queue(&rx_poll_work_q, &poll->work);
+
+	return ret < 0 ? ret : 0;
+}
+
+/* Started ahead of the network drivers which may schedule polls from init */
+static int net_rx_poll_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "net_rx_poll",
+	};
+
+	k_work_queue_start(&rx_poll_work_q, rx_poll_stack,
+			   K_KERNEL_STACK_SIZEOF(rx_poll_stack),
+			   THREAD_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(net_rx_poll_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
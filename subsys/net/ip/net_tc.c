@@ -8,14 +8,17 @@
 LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
 #include <string.h>
 
 #include <zephyr/net/net_core.h>
+#include <zephyr/net/ethernet.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
 
 #include "net_private.h"
 #include "net_stats.h"
+#include "ipv4.h"
 #include "net_tc_mapping.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
@@ -72,6 +75,17 @@ void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #endif
 }
 
+/* The packets are linked through their fifo field, one wakeup for the list */
+void net_tc_submit_list_to_rx_queue(uint8_t tc, sys_slist_t *list)
+{
+#if NET_TC_RX_COUNT > 0
+	k_fifo_put_slist(&rx_classes[tc].fifo, list);
+#else
+	ARG_UNUSED(tc);
+	ARG_UNUSED(list);
+#endif
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -104,6 +118,123 @@ int net_rx_priority2tc(enum net_priority prio)
 #endif
 }
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+static uint32_t rx_flow_seed;
+
+/* Link layers handing over the IP packet without any header of their own */
+static bool rx_flow_raw_ip(const struct net_l2 *l2)
+{
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (l2 == &NET_L2_GET_NAME(DUMMY)) {
+		return true;
+	}
+#endif
+#if defined(CONFIG_NET_L2_VIRTUAL)
+	if (l2 == &NET_L2_GET_NAME(VIRTUAL)) {
+		return true;
+	}
+#endif
+	ARG_UNUSED(l2);
+
+	return false;
+}
+
+/* Hash the addresses, protocol and ports of a received IP packet, before
+ * its link layer header is parsed. Fragments are hashed without the ports
+ * so that all the fragments of a datagram go to the same thread.
+ *
+ * Only Ethernet frames and raw IP packets are hashed. The frames of the
+ * other link layers, 802.15.4 with 6LoWPAN compressed headers for instance,
+ * all go to the first thread so that they stay in order.
+ */
+static uint32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	const struct net_l2 *l2 = net_if_l2(net_pkt_iface(pkt));
+	const uint8_t *data = pkt->buffer->data;
+	size_t len = pkt->buffer->len;
+	const uint8_t *addr;
+	size_t addr_len;
+	size_t hdr_len;
+	uint32_t hash = rx_flow_seed;
+	uint8_t proto;
+	bool ports;
+
+	if (IS_ENABLED(CONFIG_NET_L2_ETHERNET) &&
+	    l2 == &NET_L2_GET_NAME(ETHERNET)) {
+		size_t eth_len = sizeof(struct net_eth_hdr);
+		uint16_t type;
+
+		if (len < sizeof(struct net_eth_hdr)) {
+			return 0;
+		}
+
+		type = sys_get_be16(data + offsetof(struct net_eth_hdr, type));
+		if (type == NET_ETH_PTYPE_VLAN) {
+			if (len < sizeof(struct net_eth_vlan_hdr)) {
+				return 0;
+			}
+
+			type = sys_get_be16(data + offsetof(struct net_eth_vlan_hdr,
+							    type));
+			eth_len = sizeof(struct net_eth_vlan_hdr);
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			return 0;
+		}
+
+		data += eth_len;
+		len -= eth_len;
+	} else if (!rx_flow_raw_ip(l2)) {
+		return 0;
+	}
+
+	if (len < sizeof(struct net_ipv4_hdr)) {
+		return 0;
+	}
+
+	if ((data[0] & 0xf0) == 0x40) {
+		const struct net_ipv4_hdr *hdr = (const struct net_ipv4_hdr *)data;
+
+		addr = hdr->src;
+		addr_len = 2 * sizeof(struct in_addr);
+		hdr_len = (hdr->vhl & NET_IPV4_IHL_MASK) * 4U;
+		proto = hdr->proto;
+		/* More fragments flag or fragment offset */
+		ports = ((hdr->offset[0] & 0x3f) | hdr->offset[1]) == 0U;
+	} else if ((data[0] & 0xf0) == 0x60 &&
+		   len >= sizeof(struct net_ipv6_hdr)) {
+		const struct net_ipv6_hdr *hdr = (const struct net_ipv6_hdr *)data;
+
+		addr = hdr->src;
+		addr_len = 2 * sizeof(struct in6_addr);
+		hdr_len = sizeof(struct net_ipv6_hdr);
+		proto = hdr->nexthdr;
+		ports = true;
+	} else {
+		return 0;
+	}
+
+	for (size_t i = 0; i < addr_len; i += sizeof(uint32_t)) {
+		hash = (hash ^ sys_get_be32(&addr[i])) * 0x9e3779b1U;
+	}
+
+	if (ports && (proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    len >= hdr_len + 2 * sizeof(uint16_t)) {
+		hash = (hash ^ sys_get_be32(&data[hdr_len])) * 0x9e3779b1U;
+	}
+
+	hash = (hash ^ proto) * 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+int net_rx_flow2tc(struct net_pkt *pkt)
+{
+	return rx_flow_hash(pkt) % NET_TC_RX_COUNT;
+}
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+
 #if defined(CONFIG_NET_TC_THREAD_PRIO_CUSTOM)
 #define BASE_PRIO_TX CONFIG_NET_TC_TX_THREAD_BASE_PRIO
 #elif defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
@@ -186,6 +317,11 @@ static uint8_t rx_tc2thread(uint8_t tc)
 
 	NET_ASSERT(tc < ARRAY_SIZE(thread_priorities));
 
+	/* Flows are all equal, none may starve the others */
+	if (IS_ENABLED(CONFIG_NET_RX_FLOW_STEERING)) {
+		return thread_priorities[0];
+	}
+
 	return thread_priorities[tc];
 }
 #endif
@@ -354,6 +490,10 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	rx_flow_seed = sys_rand32_get();
+#endif
+
 	for (i = 0; i < NET_TC_RX_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
@@ -393,6 +533,12 @@ void net_tc_rx_init(void)
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING_CPU_PIN)
+		if (k_thread_cpu_pin(tid, i % arch_num_cpus()) < 0) {
+			NET_ERR("Cannot pin RX handler thread %d", i);
+		}
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
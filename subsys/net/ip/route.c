@@ -28,6 +28,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include "icmpv6.h"
 #include "nbr.h"
 #include "route.h"
+#include "lpm_trie.h"
 
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
@@ -125,6 +126,107 @@ static inline struct net_route_entry *net_route_data(struct net_nbr *nbr)
 	return (struct net_route_entry *)nbr->data;
 }
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+/* Intermediate nodes need at most one extra node per route */
+static struct net_lpm_node route_lpm_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct net_lpm_trie route_lpm;
+
+/* Routes with the same prefix on different interfaces share a trie node,
+ * they are chained through lpm_next.
+ */
+static void route_lpm_add(struct net_route_entry *route)
+{
+	struct net_route_entry *head;
+
+	head = net_lpm_get(&route_lpm, route->addr.s6_addr, route->prefix_len);
+	route->lpm_next = head;
+
+	if (net_lpm_insert(&route_lpm, route->addr.s6_addr, route->prefix_len,
+			   route) < 0) {
+		/* Cannot happen as the node pool covers all the routes */
+		NET_ERR("Route trie out of nodes");
+	}
+}
+
+static void route_lpm_del(struct net_route_entry *route)
+{
+	struct net_route_entry *head, *prev;
+
+	head = net_lpm_get(&route_lpm, route->addr.s6_addr, route->prefix_len);
+	if (head == route) {
+		if (route->lpm_next != NULL) {
+			(void)net_lpm_insert(&route_lpm, route->addr.s6_addr,
+					     route->prefix_len, route->lpm_next);
+		} else {
+			(void)net_lpm_remove(&route_lpm, route->addr.s6_addr,
+					     route->prefix_len);
+		}
+
+		return;
+	}
+
+	for (prev = head; prev != NULL; prev = prev->lpm_next) {
+		if (prev->lpm_next == route) {
+			prev->lpm_next = route->lpm_next;
+			break;
+		}
+	}
+}
+
+static void *route_lpm_select(void *value, void *user_data)
+{
+	struct net_route_entry *route = value;
+	struct net_if *iface = user_data;
+
+	if (iface == NULL) {
+		return route;
+	}
+
+	for (; route != NULL; route = route->lpm_next) {
+		if (route->iface == iface) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+#else
+#define route_lpm_add(...)
+#define route_lpm_del(...)
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Direct mapped cache of the latest lookups, flushed on any route change */
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+static struct route_cache_entry *route_cache_slot(struct net_if *iface,
+						  struct in6_addr *dst)
+{
+	uint32_t hash = (uint32_t)(uintptr_t)iface;
+
+	for (int i = 0; i < ARRAY_SIZE(dst->s6_addr32); i++) {
+		hash ^= UNALIGNED_GET(&dst->s6_addr32[i]);
+	}
+
+	hash *= 0x9e3779b1U;
+
+	return &route_cache[(hash >> 16) % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static void route_cache_flush(void)
+{
+	(void)memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+#define route_cache_flush(...)
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
 struct net_nbr *net_route_get_nbr(struct net_route_entry *route)
 {
 	struct net_nbr *ret = NULL;
@@ -267,15 +369,16 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+static struct net_route_entry *route_lookup(struct net_if *iface,
+					   struct in6_addr *dst)
 {
+#if defined(CONFIG_NET_ROUTE_LPM)
+	return net_lpm_lookup(&route_lpm, dst->s6_addr, route_lpm_select, iface);
+#else
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +401,37 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+#endif /* CONFIG_NET_ROUTE_LPM */
+}
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	struct route_cache_entry *cached;
+#endif
+
+	net_ipv6_nbr_lock();
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	cached = route_cache_slot(iface, dst);
+	if (cached->route != NULL && cached->iface == iface &&
+	    net_ipv6_addr_cmp(&cached->dst, dst)) {
+		found = cached->route;
+	} else {
+		found = route_lookup(iface, dst);
+		if (found) {
+			net_ipaddr_copy(&cached->dst, dst);
+			cached->iface = iface;
+			cached->route = found;
+		}
+	}
+#else
+	found = route_lookup(iface, dst);
+#endif
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -446,6 +580,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	sys_slist_prepend(&routes, &route->node);
 
+	route_lpm_add(route);
+	route_cache_flush();
+
 	tmp = nbr_nexthop_get(iface, nexthop);
 
 	NET_ASSERT(tmp == nbr_nexthop);
@@ -596,6 +733,9 @@ int net_route_del(struct net_route_entry *route)
 
 	net_route_info("Deleted", route, &route->addr);
 
+	route_lpm_del(route);
+	route_cache_flush();
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
 		if (!nexthop_route->nbr) {
 			continue;
@@ -1112,6 +1252,10 @@ void net_route_init(void)
 
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
+#endif
+#if defined(CONFIG_NET_ROUTE_LPM)
+	net_lpm_init(&route_lpm, route_lpm_nodes, ARRAY_SIZE(route_lpm_nodes),
+		     128);
 #endif
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
 }
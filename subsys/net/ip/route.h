@@ -17,6 +17,7 @@
 #include <zephyr/sys/slist.h>
 
 #include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_route_ipv4.h>
 #include <zephyr/net/net_timeout.h>
 
 #include "nbr.h"
@@ -68,6 +69,11 @@ struct net_route_entry {
 
 	/** Is the route valid forever */
 	uint8_t is_infinite : 1;
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	/** Next route with the same prefix on another interface. */
+	struct net_route_entry *lpm_next;
+#endif
 };
 
 /* Route preference values, as defined in RFC 4191 */
@@ -328,6 +334,36 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+#if defined(CONFIG_NET_ROUTE_IPV4) && defined(CONFIG_NET_NATIVE)
+/**
+ * @brief Delete all the IPv4 routes of a network interface.
+ *
+ * @param iface Network interface.
+ *
+ * @return Number of routes deleted.
+ */
+int net_route_ipv4_del_by_iface(struct net_if *iface);
+
+/**
+ * @brief Signal that a network interface went up or down.
+ *
+ * The routes of an interface are kept while it is down, but skipped by the
+ * lookups.
+ *
+ * @param iface Network interface.
+ */
+void net_route_ipv4_iface_update(struct net_if *iface);
+
+void net_route_ipv4_init(void);
+#else
+static inline void net_route_ipv4_iface_update(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+}
+
+#define net_route_ipv4_init(...)
+#endif /* CONFIG_NET_ROUTE_IPV4 */
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
@@ -0,0 +1,331 @@
+/** @file
+ * @brief IPv4 route handling.
+ */
+
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_route_ipv4, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+
+#include "net_private.h"
+#include "route.h"
+#include "lpm_trie.h"
+
+static struct net_route_entry_ipv4 routes_ipv4[CONFIG_NET_MAX_IPV4_ROUTES];
+static struct net_lpm_node route_ipv4_nodes[2 * CONFIG_NET_MAX_IPV4_ROUTES];
+static struct net_lpm_trie route_ipv4_lpm;
+
+static K_MUTEX_DEFINE(route_ipv4_lock);
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Direct mapped cache of the latest lookups, flushed on any route change */
+struct route_ipv4_cache_entry {
+	struct in_addr dst;
+	struct net_if *iface;
+	struct net_route_entry_ipv4 *route;
+};
+
+static struct route_ipv4_cache_entry route_ipv4_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+static struct route_ipv4_cache_entry *route_cache_slot(struct net_if *iface,
+						       const struct in_addr *dst)
+{
+	uint32_t hash = (uint32_t)(uintptr_t)iface ^ UNALIGNED_GET(&dst->s_addr);
+
+	hash *= 0x9e3779b1U;
+
+	return &route_ipv4_cache[(hash >> 16) % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static void route_cache_flush(void)
+{
+	(void)memset(route_ipv4_cache, 0, sizeof(route_ipv4_cache));
+}
+#else
+#define route_cache_flush(...)
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+/* Routes with the same prefix on different interfaces share a trie node,
+ * they are chained through lpm_next. The routes of an interface that is down
+ * are skipped, so that a shorter prefix matches instead.
+ */
+static void *route_select(void *value, void *user_data)
+{
+	struct net_route_entry_ipv4 *route = value;
+	struct net_if *iface = user_data;
+
+	for (; route != NULL; route = route->lpm_next) {
+		if ((iface == NULL || route->iface == iface) &&
+		    net_if_is_up(route->iface)) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+
+struct net_if *net_route_ipv4_lookup(struct net_if *iface,
+				     const struct in_addr *dst,
+				     struct in_addr *nexthop)
+{
+	struct net_route_entry_ipv4 *route;
+	struct net_if *route_iface = NULL;
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	struct route_ipv4_cache_entry *cached;
+#endif
+
+	k_mutex_lock(&route_ipv4_lock, K_FOREVER);
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	cached = route_cache_slot(iface, dst);
+	if (cached->route != NULL && cached->iface == iface &&
+	    net_ipv4_addr_cmp(&cached->dst, dst)) {
+		route = cached->route;
+		goto out;
+	}
+#endif
+
+	route = net_lpm_lookup(&route_ipv4_lpm, dst->s4_addr, route_select,
+			       iface);
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	if (route != NULL) {
+		net_ipaddr_copy(&cached->dst, dst);
+		cached->iface = iface;
+		cached->route = route;
+	}
+
+out:
+#endif
+	/* The entry can be deleted and reused as soon as the lock is released */
+	if (route != NULL) {
+		route_iface = route->iface;
+
+		if (nexthop != NULL &&
+		    !net_ipv4_is_addr_unspecified(&route->gw)) {
+			net_ipv4_addr_copy_raw(nexthop->s4_addr,
+					       route->gw.s4_addr);
+		} else if (nexthop != NULL && nexthop != dst) {
+			net_ipv4_addr_copy_raw(nexthop->s4_addr, dst->s4_addr);
+		}
+	}
+
+	k_mutex_unlock(&route_ipv4_lock);
+
+	return route_iface;
+}
+
+struct net_route_entry_ipv4 *net_route_ipv4_add(struct net_if *iface,
+						const struct in_addr *addr,
+						uint8_t prefix_len,
+						const struct in_addr *gw)
+{
+	struct net_route_entry_ipv4 *route = NULL, *head;
+
+	NET_ASSERT(iface);
+	NET_ASSERT(addr);
+
+	if (prefix_len > 32) {
+		return NULL;
+	}
+
+	k_mutex_lock(&route_ipv4_lock, K_FOREVER);
+
+	head = net_lpm_get(&route_ipv4_lpm, addr->s4_addr, prefix_len);
+
+	for (route = head; route != NULL; route = route->lpm_next) {
+		if (route->iface == iface) {
+			goto update;
+		}
+	}
+
+	ARRAY_FOR_EACH_PTR(routes_ipv4, entry) {
+		if (!entry->is_used) {
+			route = entry;
+			break;
+		}
+	}
+
+	if (route == NULL) {
+		NET_DBG("No free IPv4 route entry");
+		goto out;
+	}
+
+	route->is_used = true;
+	route->iface = iface;
+	route->prefix_len = prefix_len;
+	net_ipv4_addr_copy_raw(route->addr.s4_addr, addr->s4_addr);
+	route->lpm_next = head;
+
+	if (net_lpm_insert(&route_ipv4_lpm, addr->s4_addr, prefix_len,
+			   route) < 0) {
+		/* Cannot happen as the node pool covers all the routes */
+		NET_ERR("Route trie out of nodes");
+		route->is_used = false;
+		route = NULL;
+		goto out;
+	}
+
+update:
+	if (gw != NULL) {
+		net_ipv4_addr_copy_raw(route->gw.s4_addr, gw->s4_addr);
+	} else {
+		route->gw.s_addr = INADDR_ANY;
+	}
+
+	route_cache_flush();
+
+	NET_DBG("Added route to %s/%u via %s (iface %p)",
+		net_sprint_ipv4_addr(addr), prefix_len,
+		net_sprint_ipv4_addr(&route->gw), iface);
+
+out:
+	k_mutex_unlock(&route_ipv4_lock);
+
+	return route;
+}
+
+int net_route_ipv4_del(struct net_route_entry_ipv4 *route)
+{
+	struct net_route_entry_ipv4 *head, *prev;
+	int ret = 0;
+
+	if (route == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&route_ipv4_lock, K_FOREVER);
+
+	if (!route->is_used) {
+		ret = -ENOENT;
+		goto out;
+	}
+
+	head = net_lpm_get(&route_ipv4_lpm, route->addr.s4_addr,
+			   route->prefix_len);
+	if (head == route) {
+		if (route->lpm_next != NULL) {
+			(void)net_lpm_insert(&route_ipv4_lpm, route->addr.s4_addr,
+					     route->prefix_len, route->lpm_next);
+		} else {
+			(void)net_lpm_remove(&route_ipv4_lpm, route->addr.s4_addr,
+					     route->prefix_len);
+		}
+	} else {
+		for (prev = head; prev != NULL; prev = prev->lpm_next) {
+			if (prev->lpm_next == route) {
+				prev->lpm_next = route->lpm_next;
+				break;
+			}
+		}
+	}
+
+	NET_DBG("Deleted route to %s/%u (iface %p)",
+		net_sprint_ipv4_addr(&route->addr), route->prefix_len,
+		route->iface);
+
+	route->is_used = false;
+	route->lpm_next = NULL;
+
+	route_cache_flush();
+
+out:
+	k_mutex_unlock(&route_ipv4_lock);
+
+	return ret;
+}
+
+int net_route_ipv4_del_prefix(struct net_if *iface, const struct in_addr *addr,
+			      uint8_t prefix_len)
+{
+	struct net_route_entry_ipv4 *route;
+	int ret = -ENOENT;
+
+	if (prefix_len > 32) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&route_ipv4_lock, K_FOREVER);
+
+	route = net_lpm_get(&route_ipv4_lpm, addr->s4_addr, prefix_len);
+
+	for (; route != NULL; route = route->lpm_next) {
+		if (route->iface == iface) {
+			ret = net_route_ipv4_del(route);
+			break;
+		}
+	}
+
+	k_mutex_unlock(&route_ipv4_lock);
+
+	return ret;
+}
+
+int net_route_ipv4_del_by_iface(struct net_if *iface)
+{
+	int count = 0;
+
+	k_mutex_lock(&route_ipv4_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(routes_ipv4, route) {
+		if (route->is_used && route->iface == iface &&
+		    net_route_ipv4_del(route) == 0) {
+			count++;
+		}
+	}
+
+	k_mutex_unlock(&route_ipv4_lock);
+
+	return count;
+}
+
+void net_route_ipv4_iface_update(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	/* The cached lookups may select a route of the interface, or a
+	 * shorter prefix selected while it was down.
+	 */
+	k_mutex_lock(&route_ipv4_lock, K_FOREVER);
+	route_cache_flush();
+	k_mutex_unlock(&route_ipv4_lock);
+}
+
+int net_route_ipv4_foreach(net_route_ipv4_cb_t cb, void *user_data)
+{
+	int count = 0;
+
+	k_mutex_lock(&route_ipv4_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(routes_ipv4, route) {
+		if (!route->is_used) {
+			continue;
+		}
+
+		cb(route, user_data);
+		count++;
+	}
+
+	k_mutex_unlock(&route_ipv4_lock);
+
+	return count;
+}
+
+void net_route_ipv4_init(void)
+{
+	NET_DBG("Allocated %d IPv4 routing entries (%zu bytes)",
+		CONFIG_NET_MAX_IPV4_ROUTES,
+		sizeof(routes_ipv4) + sizeof(route_ipv4_nodes));
+
+	net_lpm_init(&route_ipv4_lpm, route_ipv4_nodes,
+		     ARRAY_SIZE(route_ipv4_nodes), 32);
+}
@@ -1547,6 +1547,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	if (data) {
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 		data->buffer = NULL;
 	}
 
@@ -1721,13 +1722,42 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* Number of MSS sized segments a data packet may carry down to the L2 */
+static int tcp_gso_segs(struct tcp *conn)
+{
+	if (conn->data_mode == TCP_DATA_MODE_RESEND || tcp_send_cb != NULL ||
+	    net_if_l2(conn->iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return 1;
+	}
+
+	/* Locally delivered packets skip the L2, keep them MSS sized */
+	if (IS_ENABLED(CONFIG_NET_IPV4) && conn->dst.sa.sa_family == AF_INET &&
+	    (net_ipv4_is_addr_loopback(&conn->dst.sin.sin_addr) ||
+	     net_ipv4_is_my_addr(&conn->dst.sin.sin_addr))) {
+		return 1;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->dst.sa.sa_family == AF_INET6 &&
+	    (net_ipv6_is_addr_loopback(&conn->dst.sin6.sin6_addr) ||
+	     net_ipv6_is_my_addr(&conn->dst.sin6.sin6_addr))) {
+		return 1;
+	}
+
+	return CONFIG_NET_TCP_GSO_MAX_SEGS;
+}
+#else
+#define tcp_gso_segs(...) 1
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
+	int mss = conn_mss(conn);
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	len = MIN(tcp_unsent_len(conn), mss * tcp_gso_segs(conn));
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1739,12 +1769,22 @@ static int tcp_send_data(struct tcp *conn)
 	}
 
 	pkt = tcp_pkt_alloc(conn, len);
+	if (!pkt && len > mss) {
+		/* Not enough buffers for a GSO packet, send a single segment */
+		len = mss;
+		pkt = tcp_pkt_alloc(conn, len);
+	}
+
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
 		goto out;
 	}
 
+	if (len > mss) {
+		net_pkt_set_gso_size(pkt, mss);
+	}
+
 	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1761,7 +1801,10 @@ static int tcp_send_data(struct tcp *conn)
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+
+			for (int sent = 0; sent < len; sent += mss) {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
 		}
 	}
 
@@ -4051,7 +4094,9 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) || force_chksum) {
+	/* The checksum of a GSO packet is computed for each of its segments */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	     net_pkt_gso_size(pkt) == 0U) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -263,6 +263,46 @@ static inline int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 }
 #endif
 
+/**
+ * @brief Callback receiving the segments of a TCP GSO packet
+ *
+ * @param seg Segment, released by net_tcp_gso_segment() once the callback
+ *	      returns, take a reference to keep it
+ * @param user_data User data given to net_tcp_gso_segment()
+ *
+ * @return 0 to continue with the next segment, negative errno to stop.
+ */
+typedef int (*net_tcp_gso_cb_t)(struct net_pkt *seg, void *user_data);
+
+/**
+ * @brief Split a TCP GSO packet into segments
+ *
+ * Each segment carries net_pkt_gso_size() bytes of the payload, the last
+ * one possibly less, behind a copy of the IP and TCP headers with length,
+ * sequence number and flags updated. Checksums are computed unless the
+ * interface offloads them.
+ *
+ * @param pkt TCP GSO packet, starting at the IP header
+ * @param cb Callback invoked with each segment, in sequence order
+ * @param user_data User data passed to the callback
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_segment(struct net_pkt *pkt, net_tcp_gso_cb_t cb,
+			void *user_data);
+#else
+static inline int net_tcp_gso_segment(struct net_pkt *pkt,
+				      net_tcp_gso_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Get pointer to TCP header in net_pkt
  *
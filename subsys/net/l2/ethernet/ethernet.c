@@ -28,6 +28,7 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
 #include "bridge.h"
+#include "tcp_internal.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
@@ -599,6 +600,77 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 	net_pkt_frag_unref(buf);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+struct ethernet_gso {
+	struct ethernet_context *ctx;
+	struct net_if *iface;
+	uint16_t ptype;
+	int len;
+};
+
+static int ethernet_send_segment(struct net_pkt *seg, void *user_data)
+{
+	struct ethernet_gso *gso = user_data;
+	const struct ethernet_api *api = net_if_get_device(gso->iface)->api;
+	int ret;
+
+	if (!ethernet_fill_header(gso->ctx, gso->iface, seg, gso->ptype)) {
+		return -ENOMEM;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	ret = net_l2_send(api->send, net_if_get_device(gso->iface), gso->iface, seg);
+	if (ret != 0) {
+		eth_stats_update_errors_tx(gso->iface);
+		return ret;
+	}
+
+	ethernet_update_tx_stats(gso->iface, seg);
+	gso->len += net_pkt_get_len(seg);
+
+	return 0;
+}
+
+/* Segment a TCP GSO packet the driver cannot segment itself */
+static int ethernet_send_gso(struct ethernet_context *ctx, struct net_if *iface,
+			     struct net_pkt *pkt, uint16_t ptype)
+{
+	struct ethernet_gso gso = {
+		.ctx = ctx,
+		.iface = iface,
+		.ptype = ptype,
+	};
+	int ret;
+
+	ret = net_tcp_gso_segment(pkt, ethernet_send_segment, &gso);
+	if (ret < 0 && gso.len == 0) {
+		return ret;
+	}
+
+	/* Once a segment is on the wire, the packet is reported as sent. The
+	 * segments left out are lost as if dropped on the link and TCP only
+	 * retransmits them, rather than the whole packet.
+	 */
+	if (ret < 0) {
+		NET_DBG("iface %p sent %d bytes of pkt %p (%d)", iface, gso.len, pkt, ret);
+	}
+
+	net_pkt_unref(pkt);
+
+	return gso.len;
+}
+
+static inline bool ethernet_needs_gso(struct net_if *iface, struct net_pkt *pkt)
+{
+	return net_pkt_gso_size(pkt) > 0U &&
+	       !(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TCP_SEG_OFFLOAD);
+}
+#else
+#define ethernet_send_gso(...) -ENOTSUP
+#define ethernet_needs_gso(...) false
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct ethernet_api *api = net_if_get_device(iface)->api;
@@ -696,6 +768,11 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 		net_pkt_lladdr_dst(pkt)->len = sizeof(struct net_eth_addr);
 	}
 
+	/* Link addresses are resolved, TCP GSO packets can be segmented now */
+	if (ethernet_needs_gso(iface, pkt)) {
+		return ethernet_send_gso(ctx, iface, pkt, ptype);
+	}
+
 	/* Then set the ethernet header. Note that the iface parameter tells
 	 * where we are actually sending the packet. The interface in net_pkt
 	 * is used to determine if the VLAN header is added to Ethernet frame.
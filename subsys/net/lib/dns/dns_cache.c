@@ -9,14 +9,194 @@
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+/* Entries are referred to by their index + 1, 0 ends a chain */
+#define ENTRY_NONE 0U
+
+static int dns_cache_check_query(char const *query)
+{
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* FNV-1a */
+static uint32_t dns_cache_hash(char const *query)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*query != '\0') {
+		hash ^= (uint8_t)*query++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static inline struct dns_cache_entry *entry_at(struct dns_cache const *cache, uint16_t ref)
+{
+	return &cache->entries[ref - 1];
+}
+
+static inline uint16_t *bucket_of(struct dns_cache const *cache, uint32_t hash)
+{
+	return &cache->buckets[hash % cache->size];
+}
+
+static inline bool entry_matches(struct dns_cache_entry const *entry, uint32_t hash,
+				 char const *query)
+{
+	return entry->hash == hash && strcmp(entry->query, query) == 0;
+}
+
+static k_timepoint_t dns_cache_prefetch_point(uint32_t ttl)
+{
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+	uint64_t ms = (uint64_t)ttl * MSEC_PER_SEC *
+		      (100U - CONFIG_DNS_RESOLVER_CACHE_PREFETCH_PERCENT) / 100U;
+
+	return sys_timepoint_calc(K_MSEC(ms));
+#else
+	return sys_timepoint_calc(K_SECONDS(ttl));
+#endif
+}
+
+/* Needs to be called when lock is already acquired. Moves the entry *prev
+ * refers to from its chain to the free list.
+ */
+static void dns_cache_unlink(struct dns_cache *cache, uint16_t *prev)
+{
+	uint16_t ref = *prev;
+	struct dns_cache_entry *entry = entry_at(cache, ref);
+
+	*prev = entry->next;
+	entry->in_use = false;
+	entry->next = cache->free;
+	cache->free = ref;
+}
+
+/* Needs to be called when lock is already acquired */
+static uint16_t dns_cache_alloc(struct dns_cache *cache)
+{
+	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
+	uint16_t victim = 1U;
+	uint16_t *prev;
+
+	if (cache->free == ENTRY_NONE && cache->used < cache->size) {
+		return ++cache->used;
+	}
+
+	if (cache->free == ENTRY_NONE) {
+		for (size_t i = 0; i < cache->size; i++) {
+			if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
+				victim = i + 1;
+				closest_to_expiry = cache->entries[i].expiry;
+			}
+		}
+
+		NET_DBG("Overwrite \"%s\"", entry_at(cache, victim)->query);
+
+		prev = bucket_of(cache, entry_at(cache, victim)->hash);
+		while (*prev != victim) {
+			prev = &entry_at(cache, *prev)->next;
+		}
+
+		dns_cache_unlink(cache, prev);
+	}
+
+	victim = cache->free;
+	cache->free = entry_at(cache, victim)->next;
+
+	return victim;
+}
+
+/* Needs to be called when lock is already acquired. Walks the chain of the
+ * query, dropping the expired entries and the entries of the query matching
+ * the filter on the way.
+ */
+static void dns_cache_purge(struct dns_cache *cache, char const *query, uint32_t hash,
+				 bool (*filter)(struct dns_cache_entry const *entry,
+						sa_family_t family),
+				 sa_family_t family)
+{
+	uint16_t *prev = bucket_of(cache, hash);
+
+	while (*prev != ENTRY_NONE) {
+		struct dns_cache_entry *entry = entry_at(cache, *prev);
+
+		if (sys_timepoint_expired(entry->expiry)) {
+			NET_DBG("Remove \"%s\"", entry->query);
+			dns_cache_unlink(cache, prev);
+		} else if (filter != NULL && entry_matches(entry, hash, query) &&
+			   filter(entry, family)) {
+			dns_cache_unlink(cache, prev);
+		} else {
+			prev = &entry->next;
+		}
+	}
+}
+
+static bool filter_all(struct dns_cache_entry const *entry, sa_family_t family)
+{
+	ARG_UNUSED(entry);
+	ARG_UNUSED(family);
+
+	return true;
+}
+
+static bool filter_negative(struct dns_cache_entry const *entry, sa_family_t family)
+{
+	ARG_UNUSED(family);
+
+	return entry->negative;
+}
+
+static bool filter_family(struct dns_cache_entry const *entry, sa_family_t family)
+{
+	return entry->negative || family == AF_UNSPEC || entry->data.ai_family == family;
+}
+
+/* Needs to be called when lock is already acquired */
+static struct dns_cache_entry *dns_cache_insert(struct dns_cache *cache, char const *query,
+						uint32_t hash, uint32_t ttl)
+{
+	uint16_t ref = dns_cache_alloc(cache);
+	struct dns_cache_entry *entry = entry_at(cache, ref);
+	uint16_t *tail = bucket_of(cache, hash);
+
+	while (*tail != ENTRY_NONE) {
+		tail = &entry_at(cache, *tail)->next;
+	}
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->hash = hash;
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->prefetch = dns_cache_prefetch_point(ttl);
+	entry->next = ENTRY_NONE;
+	entry->hits = 0U;
+	entry->in_use = true;
+	entry->negative = false;
+	entry->prefetching = false;
+
+	/* Appended, so that the answers are found in the order they came in */
+	*tail = ref;
+
+	return entry;
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
 	k_mutex_lock(cache->lock, K_FOREVER);
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
+		cache->buckets[i] = ENTRY_NONE;
 	}
+	cache->used = 0U;
+	cache->free = ENTRY_NONE;
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -25,47 +205,58 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	struct dns_cache_entry *entry;
+	uint32_t hash;
 
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
 
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
-	dns_cache_clean(cache);
+	/* The name exists after all */
+	dns_cache_purge(cache, query, hash, filter_negative, AF_UNSPEC);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	entry = dns_cache_insert(cache, query, hash, ttl);
+	entry->data = *addrinfo;
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	uint32_t hash;
+
+	if (cache == NULL || query == NULL || ttl == 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (dns_cache_check_query(query) < 0) {
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" with TTL %" PRIu32, query, ttl);
+
+	dns_cache_purge(cache, query, hash, filter_all, AF_UNSPEC);
+
+	entry = dns_cache_insert(cache, query, hash, ttl);
+	memset(&entry->data, 0, sizeof(entry->data));
+	entry->negative = true;
 
 	k_mutex_unlock(cache->lock);
 
@@ -75,22 +266,19 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
 	NET_DBG("Remove all entries with query \"%s\"", query);
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+
+	return dns_cache_remove_family(cache, query, AF_UNSPEC);
+}
+
+int dns_cache_remove_family(struct dns_cache *cache, char const *query, sa_family_t family)
+{
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
-
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
-		}
-	}
+	dns_cache_purge(cache, query, dns_cache_hash(query), filter_family, family);
 
 	k_mutex_unlock(cache->lock);
 
@@ -101,34 +289,33 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 		   size_t addrinfo_array_len)
 {
 	size_t found = 0;
+	uint32_t hash;
+	uint16_t ref;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
 		return -EINVAL;
 	}
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
+	for (ref = *bucket_of(cache, hash); ref != ENTRY_NONE; ref = entry_at(cache, ref)->next) {
+		struct dns_cache_entry const *entry = entry_at(cache, ref);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
-		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (entry->negative || !entry_matches(entry, hash, query) ||
+		    sys_timepoint_expired(entry->expiry)) {
 			continue;
 		}
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
@@ -146,17 +333,81 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 	return found;
 }
 
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+int dns_cache_lookup(struct dns_cache *cache, const char *query, sa_family_t family,
+		     struct dns_addrinfo *addrinfo, size_t addrinfo_array_len, bool *prefetch)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	bool negative = false;
+	bool refresh = false;
+	size_t found = 0;
+	uint32_t hash;
+	uint16_t ref;
+
+	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
+		return -EINVAL;
+	}
+	if (dns_cache_check_query(query) < 0) {
+		return -EINVAL;
+	}
+
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	dns_cache_purge(cache, query, hash, NULL, AF_UNSPEC);
+
+	for (ref = *bucket_of(cache, hash); ref != ENTRY_NONE; ref = entry_at(cache, ref)->next) {
+		struct dns_cache_entry *entry = entry_at(cache, ref);
+
+		if (!entry_matches(entry, hash, query)) {
+			continue;
+		}
+
+		if (entry->negative) {
+			negative = true;
+			continue;
+		}
+
+		if (family != AF_UNSPEC && entry->data.ai_family != family) {
 			continue;
 		}
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+		if (found < addrinfo_array_len) {
+			addrinfo[found] = entry->data;
+		}
+
+		found++;
+
+		if (entry->hits < UINT16_MAX) {
+			entry->hits++;
+		}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+		if (!entry->prefetching &&
+		    entry->hits >= CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS &&
+		    sys_timepoint_expired(entry->prefetch)) {
+			entry->prefetching = true;
+			refresh = true;
 		}
+#endif
+	}
+
+	k_mutex_unlock(cache->lock);
+
+	if (prefetch != NULL) {
+		*prefetch = refresh;
+	}
+
+	if (found > addrinfo_array_len) {
+		NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
+		return -ENOSR;
 	}
+
+	if (found == 0 && negative) {
+		NET_DBG("\"%s\" does not exist", query);
+		return -ENXIO;
+	}
+
+	NET_DBG("%s \"%s\"", found > 0 ? "Found" : "Could not find", query);
+
+	return found;
 }
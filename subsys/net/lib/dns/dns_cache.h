@@ -22,12 +22,27 @@ struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Point after which a lookup asks for the entry to be refreshed */
+	k_timepoint_t prefetch;
+	uint32_t hash;
+	/* Next entry in the bucket or in the free list, index + 1 */
+	uint16_t next;
+	uint16_t hits;
 	bool in_use;
+	/* The name does not exist, data only holds the family */
+	bool negative;
+	bool prefetching;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	/* First entry of each hash chain, index + 1 */
+	uint16_t *buckets;
+	/* Number of entries ever taken from the array */
+	uint16_t used;
+	/* First entry of the free list, index + 1 */
+	uint16_t free;
 	struct k_mutex *lock;
 };
 
@@ -41,10 +56,13 @@ struct dns_cache {
  * @param name Name of the cache.
  */
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
+	BUILD_ASSERT((cache_size) < UINT16_MAX);                                                   \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static uint16_t name##_buckets[cache_size];                                                \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries, .buckets = name##_buckets, .size = cache_size,          \
+		.lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -97,4 +115,54 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
 int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len);
 
+/**
+ * @brief Adds a negative entry, recording that the queried name does not exist.
+ *
+ * All the other entries of the query are removed.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param ttl Time to live for the entry in seconds.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, uint32_t ttl);
+
+/**
+ * @brief Removes the entries of the given query and address family.
+ *
+ * Negative entries of the query are removed too. This is used before the
+ * answers of a new response are added so that they replace the old ones.
+ *
+ * @param cache Cache where the entries should be removed.
+ * @param query Query which should be searched for.
+ * @param family Address family of the entries to remove.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_remove_family(struct dns_cache *cache, char const *query, sa_family_t family);
+
+/**
+ * @brief Looks up the entries of the given query and address family.
+ *
+ * Unlike dns_cache_find(), the lookup counts as a use of the entries. Once
+ * an entry was used often enough and gets close to its expiry, @p prefetch
+ * is set so that the caller can refresh it before it expires. This is only
+ * reported once per entry.
+ *
+ * @param cache Cache where the entry should be searched.
+ * @param query Query which should be searched for.
+ * @param family Address family of the entries, AF_UNSPEC for all.
+ * @param addrinfo dns_addrinfo array which will be written if the query was found.
+ * @param addrinfo_array_len Array size of the dns_addrinfo array
+ * @param prefetch Set to true if the entries should be refreshed, can be NULL.
+ * @retval on success the amount of dns_addrinfo written into the addrinfo array will be returned.
+ * A cache miss will therefore return a 0.
+ * @retval -ENXIO if the name is cached as not existing.
+ * @retval -ENOSR if there was not enough space in the addrinfo array.
+ * @retval On other errors a negative value is returned.
+ */
+int dns_cache_lookup(struct dns_cache *cache, const char *query, sa_family_t family,
+		     struct dns_addrinfo *addrinfo, size_t addrinfo_array_len, bool *prefetch);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
@@ -597,6 +597,24 @@ static inline void invoke_query_callback(int status,
 	if (pending_query->query != NULL && pending_query->cb != NULL)  {
 		pending_query->cb(status, info, pending_query->user_data);
 	}
+
+#if defined(CONFIG_DNS_RESOLVER_COALESCE)
+	/* The queries waiting for this one get the same results, but not its
+	 * cancellation, see dns_query_promote().
+	 */
+	if (status == DNS_EAI_CANCELED) {
+		return;
+	}
+
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		struct dns_pending_query *waiting = &pending_query->ctx->queries[i];
+
+		if (waiting->leader == pending_query &&
+		    waiting->query != NULL && waiting->cb != NULL) {
+			waiting->cb(status, info, waiting->user_data);
+		}
+	}
+#endif
 }
 
 /* Release a query slot reserved by get_cb_slot().
@@ -620,6 +638,17 @@ static void release_query(struct dns_pending_query *pending_query)
 		 */
 		pending_query->query = NULL;
 	}
+
+#if defined(CONFIG_DNS_RESOLVER_COALESCE)
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		struct dns_pending_query *waiting = &pending_query->ctx->queries[i];
+
+		if (waiting->leader == pending_query) {
+			waiting->leader = NULL;
+			release_query(waiting);
+		}
+	}
+#endif
 }
 
 /* Must be invoked with context lock held */
@@ -817,6 +846,13 @@ query_known:
 			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
 					      &ctx->queries[*query_idx]);
 #ifdef CONFIG_DNS_RESOLVER_CACHE
+			/* The answers replace the ones cached before */
+			if (items == 0) {
+				dns_cache_remove_family(&dns_cache,
+							ctx->queries[*query_idx].query,
+							info.ai_family);
+			}
+
 			dns_cache_add(&dns_cache,
 				ctx->queries[*query_idx].query, &info, ttl);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
@@ -886,6 +922,15 @@ query_known:
 	}
 
 	if (items == 0) {
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+		if (CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL > 0 &&
+		    dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+			dns_cache_add_negative(&dns_cache,
+					       ctx->queries[*query_idx].query,
+					       CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+		}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 		ret = DNS_EAI_NODATA;
 	} else {
 		ret = DNS_EAI_ALLDONE;
@@ -903,16 +948,11 @@ static int dns_read(struct dns_resolve_context *ctx,
 		    uint16_t *query_hash)
 {
 	/* Helper struct to track the dns msg received from the server */
-	struct dns_msg_t dns_msg;
-	int data_len;
+	struct dns_msg_t dns_msg = DNS_MSG_INIT(dns_data->data,
+						MIN(buf_len, DNS_RESOLVER_MAX_BUF_SIZE));
 	int ret;
 	int query_idx = -1;
 
-	data_len = MIN(buf_len, DNS_RESOLVER_MAX_BUF_SIZE);
-
-	dns_msg.msg = dns_data->data;
-	dns_msg.msg_size = data_len;
-
 	ret = dns_validate_msg(ctx, &dns_msg, dns_id, &query_idx,
 			       dns_cname, query_hash);
 	if (ret == DNS_EAI_AGAIN) {
@@ -1049,11 +1089,67 @@ static int dns_write(struct dns_resolve_context *ctx,
 	return 0;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_COALESCE)
+static int dns_query_send(struct dns_resolve_context *ctx, int i,
+			  uint16_t *dns_id);
+
+/* A query cancelled or timed out has not answered the queries waiting for
+ * it. The first of them sends its own request, within the time it has left,
+ * and the others wait for it instead.
+ *
+ * Must be invoked with context lock held.
+ */
+static void dns_query_promote(struct dns_resolve_context *ctx, int slot)
+{
+	struct dns_pending_query *leader = &ctx->queries[slot];
+	struct dns_pending_query *promoted = NULL;
+	int ret;
+
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		struct dns_pending_query *waiting = &ctx->queries[i];
+
+		if (waiting->leader != leader) {
+			continue;
+		}
+
+		if (promoted == NULL) {
+			promoted = waiting;
+			promoted->leader = NULL;
+		} else {
+			waiting->leader = promoted;
+		}
+	}
+
+	if (promoted == NULL) {
+		return;
+	}
+
+	promoted->timeout = K_TICKS(k_work_delayable_remaining_get(&promoted->timer));
+
+	NET_DBG("[%u] sending the query of [%u]",
+		(unsigned int)(promoted - ctx->queries), slot);
+
+	ret = dns_query_send(ctx, promoted - ctx->queries, NULL);
+	if (ret < 0) {
+		NET_DBG("Cannot send query (%d)", ret);
+		invoke_query_callback(DNS_EAI_SYSTEM, NULL, promoted);
+		release_query(promoted);
+	}
+}
+#else
+#define dns_query_promote(...)
+#endif /* CONFIG_DNS_RESOLVER_COALESCE */
+
 /* Must be invoked with context lock held */
 static void dns_resolve_cancel_slot(struct dns_resolve_context *ctx, int slot)
 {
 	invoke_query_callback(DNS_EAI_CANCELED, NULL, &ctx->queries[slot]);
 
+	/* Not when the context is being closed */
+	if (ctx->state == DNS_RESOLVE_CONTEXT_ACTIVE) {
+		dns_query_promote(ctx, slot);
+	}
+
 	release_query(&ctx->queries[slot]);
 }
 
@@ -1207,123 +1303,21 @@ static void query_timeout(struct k_work *work)
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
-int dns_resolve_name(struct dns_resolve_context *ctx,
-		     const char *query,
-		     enum dns_query_type type,
-		     uint16_t *dns_id,
-		     dns_resolve_cb_t cb,
-		     void *user_data,
-		     int32_t timeout)
+/* Send the request of a query slot to the servers, with the id set in the
+ * slot unless it is an mDNS query.
+ *
+ * Must be invoked with context lock held.
+ */
+static int dns_query_send(struct dns_resolve_context *ctx, int i,
+			  uint16_t *dns_id)
 {
-	k_timeout_t tout;
+	const char *query = ctx->queries[i].query;
 	struct net_buf *dns_data = NULL;
 	struct net_buf *dns_qname = NULL;
-	struct sockaddr addr;
-	int ret, i = -1, j = 0;
+	int ret, j = 0;
 	int failure = 0;
 	bool mdns_query = false;
 	uint8_t hop_limit;
-#ifdef CONFIG_DNS_RESOLVER_CACHE
-	struct dns_addrinfo cached_info[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES] = {0};
-#endif /* CONFIG_DNS_RESOLVER_CACHE */
-
-	if (!ctx || !query || !cb) {
-		return -EINVAL;
-	}
-
-	tout = SYS_TIMEOUT_MS(timeout);
-
-	/* Timeout cannot be 0 as we cannot resolve name that fast.
-	 */
-	if (K_TIMEOUT_EQ(tout, K_NO_WAIT)) {
-		return -EINVAL;
-	}
-
-	ret = net_ipaddr_parse(query, strlen(query), &addr);
-	if (ret) {
-		/* The query name was already in numeric form, no
-		 * need to continue further.
-		 */
-		struct dns_addrinfo info = { 0 };
-
-		if (type == DNS_QUERY_TYPE_A) {
-			if (net_sin(&addr)->sin_family == AF_INET6) {
-				return -EPFNOSUPPORT;
-			}
-
-			memcpy(net_sin(&info.ai_addr), net_sin(&addr),
-			       sizeof(struct sockaddr_in));
-			info.ai_family = AF_INET;
-			info.ai_addr.sa_family = AF_INET;
-			info.ai_addrlen = sizeof(struct sockaddr_in);
-		} else if (type == DNS_QUERY_TYPE_AAAA) {
-			/* We do not support AI_V4MAPPED atm, so if the user
-			 * asks an IPv6 address but it is an IPv4 one, then
-			 * return an error. Note that getaddrinfo() will swap
-			 * the error to EINVAL, the EPFNOSUPPORT is returned
-			 * here so that we can find it easily.
-			 */
-			if (net_sin(&addr)->sin_family == AF_INET) {
-				return -EPFNOSUPPORT;
-			}
-
-#if defined(CONFIG_NET_IPV6)
-			memcpy(net_sin6(&info.ai_addr), net_sin6(&addr),
-			       sizeof(struct sockaddr_in6));
-			info.ai_family = AF_INET6;
-			info.ai_addr.sa_family = AF_INET6;
-			info.ai_addrlen = sizeof(struct sockaddr_in6);
-#else
-			return -EAFNOSUPPORT;
-#endif
-		} else {
-			goto try_resolve;
-		}
-
-		cb(DNS_EAI_INPROGRESS, &info, user_data);
-		cb(DNS_EAI_ALLDONE, NULL, user_data);
-
-		return 0;
-	}
-
-try_resolve:
-#ifdef CONFIG_DNS_RESOLVER_CACHE
-	ret = dns_cache_find(&dns_cache, query, cached_info, sizeof(cached_info));
-	if (ret > 0) {
-		/* The query was cached, no
-		 * need to continue further.
-		 */
-		for (size_t cache_index = 0; cache_index < ret; cache_index++) {
-			cb(DNS_EAI_INPROGRESS, &cached_info[cache_index], user_data);
-		}
-		cb(DNS_EAI_ALLDONE, NULL, user_data);
-
-		return 0;
-	}
-#endif /* CONFIG_DNS_RESOLVER_CACHE */
-
-	k_mutex_lock(&ctx->lock, K_FOREVER);
-
-	if (ctx->state != DNS_RESOLVE_CONTEXT_ACTIVE) {
-		ret = -EINVAL;
-		goto fail;
-	}
-
-	i = get_cb_slot(ctx);
-	if (i < 0) {
-		ret = -EAGAIN;
-		goto fail;
-	}
-
-	ctx->queries[i].cb = cb;
-	ctx->queries[i].timeout = tout;
-	ctx->queries[i].query = query;
-	ctx->queries[i].query_type = type;
-	ctx->queries[i].user_data = user_data;
-	ctx->queries[i].ctx = ctx;
-	ctx->queries[i].query_hash = 0;
-
-	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
 
 	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
 	if (!dns_data) {
@@ -1343,8 +1337,6 @@ try_resolve:
 		goto quit;
 	}
 
-	ctx->queries[i].id = sys_rand16_get();
-
 	/* If mDNS is enabled, then send .local queries only to multicast
 	 * address. For mDNS the id should be set to 0, see RFC 6762 ch. 18.1
 	 * for details.
@@ -1423,30 +1415,313 @@ try_resolve:
 	ret = 0;
 
 quit:
+	if (dns_data) {
+		net_buf_unref(dns_data);
+	}
+
+	if (dns_qname) {
+		net_buf_unref(dns_qname);
+	}
+
+	return ret;
+}
+
+/* Must be invoked with context lock held */
+static int dns_query_locked(struct dns_resolve_context *ctx,
+			    const char *query,
+			    enum dns_query_type type,
+			    uint16_t *dns_id,
+			    dns_resolve_cb_t cb,
+			    void *user_data,
+			    k_timeout_t tout)
+{
+	int ret, i;
+
+	i = get_cb_slot(ctx);
+	if (i < 0) {
+		return -EAGAIN;
+	}
+
+	ctx->queries[i].cb = cb;
+	ctx->queries[i].timeout = tout;
+	ctx->queries[i].query = query;
+	ctx->queries[i].query_type = type;
+	ctx->queries[i].user_data = user_data;
+	ctx->queries[i].ctx = ctx;
+	ctx->queries[i].query_hash = 0;
+	ctx->queries[i].id = sys_rand16_get();
+#if defined(CONFIG_DNS_RESOLVER_COALESCE)
+	ctx->queries[i].leader = NULL;
+#endif
+
+	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
+
+	ret = dns_query_send(ctx, i, dns_id);
 	if (ret < 0) {
-		if (i >= 0) {
-			release_query(&ctx->queries[i]);
-		}
+		release_query(&ctx->queries[i]);
 
 		if (dns_id) {
 			*dns_id = 0U;
 		}
 	}
 
-	if (dns_data) {
-		net_buf_unref(dns_data);
+	return ret;
+}
+
+#if defined(CONFIG_DNS_RESOLVER_COALESCE)
+/* Must be invoked with context lock held */
+static int dns_query_coalesce(struct dns_resolve_context *ctx,
+			      const char *query,
+			      enum dns_query_type type,
+			      uint16_t *dns_id,
+			      dns_resolve_cb_t cb,
+			      void *user_data,
+			      k_timeout_t tout)
+{
+	struct dns_pending_query *leader = NULL;
+	int ret, i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		struct dns_pending_query *pending = &ctx->queries[i];
+
+		if (check_query_active(pending, false) &&
+		    pending->query != NULL && pending->leader == NULL &&
+		    pending->query_type == type &&
+		    strcmp(pending->query, query) == 0) {
+			leader = pending;
+			break;
+		}
 	}
 
-	if (dns_qname) {
-		net_buf_unref(dns_qname);
+	if (leader == NULL) {
+		return -ENOENT;
 	}
 
-fail:
+	i = get_cb_slot(ctx);
+	if (i < 0) {
+		return -EAGAIN;
+	}
+
+	ctx->queries[i].cb = cb;
+	ctx->queries[i].timeout = tout;
+	ctx->queries[i].query = query;
+	ctx->queries[i].query_type = type;
+	ctx->queries[i].user_data = user_data;
+	ctx->queries[i].ctx = ctx;
+	ctx->queries[i].leader = leader;
+	/* The id is only used to cancel the query, the answer is matched
+	 * against the query it waits for.
+	 */
+	ctx->queries[i].id = sys_rand16_get();
+	ctx->queries[i].query_hash = leader->query_hash;
+
+	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
+
+	ret = k_work_reschedule(&ctx->queries[i].timer, tout);
+	if (ret < 0) {
+		ctx->queries[i].leader = NULL;
+		release_query(&ctx->queries[i]);
+		return ret;
+	}
+
+	if (dns_id) {
+		*dns_id = ctx->queries[i].id;
+	}
+
+	NET_DBG("[%u] waiting for the answer to [%u] id %u", i,
+		(unsigned int)(leader - ctx->queries), leader->id);
+
+	return 0;
+}
+#endif /* CONFIG_DNS_RESOLVER_COALESCE */
+
+static int dns_query(struct dns_resolve_context *ctx,
+		     const char *query,
+		     enum dns_query_type type,
+		     uint16_t *dns_id,
+		     dns_resolve_cb_t cb,
+		     void *user_data,
+		     k_timeout_t tout)
+{
+	int ret;
+
+	k_mutex_lock(&ctx->lock, K_FOREVER);
+
+	if (ctx->state != DNS_RESOLVE_CONTEXT_ACTIVE) {
+		ret = -EINVAL;
+		goto unlock;
+	}
+
+#if defined(CONFIG_DNS_RESOLVER_COALESCE)
+	ret = dns_query_coalesce(ctx, query, type, dns_id, cb, user_data, tout);
+	if (ret != -ENOENT) {
+		goto unlock;
+	}
+#endif
+
+	ret = dns_query_locked(ctx, query, type, dns_id, cb, user_data, tout);
+
+unlock:
 	k_mutex_unlock(&ctx->lock);
 
 	return ret;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+/* One cache entry is refreshed at a time, from its own copy of the name */
+static char prefetch_query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+static atomic_t prefetch_busy;
+
+/* Used when the query that hit the cache does not time out */
+#define PREFETCH_TIMEOUT K_SECONDS(5)
+
+static void prefetch_cb(enum dns_resolve_status status,
+			struct dns_addrinfo *info,
+			void *user_data)
+{
+	ARG_UNUSED(info);
+	ARG_UNUSED(user_data);
+
+	/* The answers have reached the cache on their way here */
+	if (status != DNS_EAI_INPROGRESS) {
+		atomic_clear(&prefetch_busy);
+	}
+}
+
+static void dns_prefetch(struct dns_resolve_context *ctx,
+			 const char *query,
+			 enum dns_query_type type,
+			 k_timeout_t tout)
+{
+	if (!atomic_cas(&prefetch_busy, 0, 1)) {
+		return;
+	}
+
+	strncpy(prefetch_query, query, sizeof(prefetch_query) - 1);
+
+	if (K_TIMEOUT_EQ(tout, K_FOREVER)) {
+		tout = PREFETCH_TIMEOUT;
+	}
+
+	NET_DBG("Refreshing \"%s\"", prefetch_query);
+
+	if (dns_query(ctx, prefetch_query, type, NULL, prefetch_cb, NULL,
+		      tout) < 0) {
+		atomic_clear(&prefetch_busy);
+	}
+}
+#else
+#define dns_prefetch(...)
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
+int dns_resolve_name(struct dns_resolve_context *ctx,
+		     const char *query,
+		     enum dns_query_type type,
+		     uint16_t *dns_id,
+		     dns_resolve_cb_t cb,
+		     void *user_data,
+		     int32_t timeout)
+{
+	k_timeout_t tout;
+	struct sockaddr addr;
+	int ret;
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+	struct dns_addrinfo cached_info[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES] = {0};
+	bool prefetch = false;
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+	if (!ctx || !query || !cb) {
+		return -EINVAL;
+	}
+
+	tout = SYS_TIMEOUT_MS(timeout);
+
+	/* Timeout cannot be 0 as we cannot resolve name that fast.
+	 */
+	if (K_TIMEOUT_EQ(tout, K_NO_WAIT)) {
+		return -EINVAL;
+	}
+
+	ret = net_ipaddr_parse(query, strlen(query), &addr);
+	if (ret) {
+		/* The query name was already in numeric form, no
+		 * need to continue further.
+		 */
+		struct dns_addrinfo info = { 0 };
+
+		if (type == DNS_QUERY_TYPE_A) {
+			if (net_sin(&addr)->sin_family == AF_INET6) {
+				return -EPFNOSUPPORT;
+			}
+
+			memcpy(net_sin(&info.ai_addr), net_sin(&addr),
+			       sizeof(struct sockaddr_in));
+			info.ai_family = AF_INET;
+			info.ai_addr.sa_family = AF_INET;
+			info.ai_addrlen = sizeof(struct sockaddr_in);
+		} else if (type == DNS_QUERY_TYPE_AAAA) {
+			/* We do not support AI_V4MAPPED atm, so if the user
+			 * asks an IPv6 address but it is an IPv4 one, then
+			 * return an error. Note that getaddrinfo() will swap
+			 * the error to EINVAL, the EPFNOSUPPORT is returned
+			 * here so that we can find it easily.
+			 */
+			if (net_sin(&addr)->sin_family == AF_INET) {
+				return -EPFNOSUPPORT;
+			}
+
+#if defined(CONFIG_NET_IPV6)
+			memcpy(net_sin6(&info.ai_addr), net_sin6(&addr),
+			       sizeof(struct sockaddr_in6));
+			info.ai_family = AF_INET6;
+			info.ai_addr.sa_family = AF_INET6;
+			info.ai_addrlen = sizeof(struct sockaddr_in6);
+#else
+			return -EAFNOSUPPORT;
+#endif
+		} else {
+			goto try_resolve;
+		}
+
+		cb(DNS_EAI_INPROGRESS, &info, user_data);
+		cb(DNS_EAI_ALLDONE, NULL, user_data);
+
+		return 0;
+	}
+
+try_resolve:
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+	ret = dns_cache_lookup(&dns_cache, query,
+			       type == DNS_QUERY_TYPE_A ? AF_INET :
+			       (type == DNS_QUERY_TYPE_AAAA ? AF_INET6 : AF_UNSPEC),
+			       cached_info, ARRAY_SIZE(cached_info), &prefetch);
+	if (ret == -ENXIO) {
+		/* The name is known not to exist */
+		cb(DNS_EAI_NODATA, NULL, user_data);
+
+		return 0;
+	}
+
+	if (ret > 0) {
+		/* The query was cached, no
+		 * need to continue further.
+		 */
+		for (size_t cache_index = 0; cache_index < ret; cache_index++) {
+			cb(DNS_EAI_INPROGRESS, &cached_info[cache_index], user_data);
+		}
+		cb(DNS_EAI_ALLDONE, NULL, user_data);
+
+		if (prefetch) {
+			dns_prefetch(ctx, query, type, tout);
+		}
+
+		return 0;
+	}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+	return dns_query(ctx, query, type, dns_id, cb, user_data, tout);
+}
+
 /* Must be invoked with context lock held */
 static int dns_resolve_close_locked(struct dns_resolve_context *ctx)
 {
@@ -38,6 +38,10 @@ int enter_http_done_state(struct http_client_ctx *client);
 /* Others */
 struct http_resource_detail *get_resource_detail(const char *path, int *len, bool is_ws);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
+int http_server_sendall_iov(struct http_client_ctx *client, struct iovec *iov,
+			    size_t iovcnt);
+int send_http2_pending_data(struct http_client_ctx *client);
+bool http2_request_in_progress(struct http_client_ctx *client);
 void http_client_timer_restart(struct http_client_ctx *client);
 
 /* TODO Could be static, but currently used in tests. */
@@ -12,13 +12,15 @@
 #include <string.h>
 #include <strings.h>
 
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/service.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/net/socket_service.h>
 #include <zephyr/net/tls_credentials.h>
-#include <zephyr/posix/sys/eventfd.h>
+#include <zephyr/posix/fcntl.h>
 #include <zephyr/posix/fnmatch.h>
 
 LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
@@ -38,24 +40,37 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
-#define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#define HTTP_SERVER_SOCK_COUNT (HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
 
 struct http_server_ctx {
 	int num_clients;
-	int listen_fds; /* max value of 1 + MAX_SERVICES */
+	int listen_fds; /* max value of MAX_SERVICES */
 
-	/* First pollfd is eventfd that can be used to stop the server,
-	 * then we have the server listen sockets,
-	 * and then the accepted sockets.
+	/* First we have the server listen sockets, and then the accepted
+	 * sockets. A client socket with no events is waiting for a buffer.
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
 	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
 };
 
 static struct http_server_ctx server_ctx;
-static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
 
+K_MEM_SLAB_DEFINE_STATIC(client_buffers, sizeof(struct http_client_buffers),
+			 CONFIG_HTTP_SERVER_CLIENT_BUFFER_COUNT, sizeof(void *));
+
+/* The sockets are polled by the socket service, which hands the events
+ * over to the server thread.
+ */
+static K_THREAD_STACK_DEFINE(http_server_stack, CONFIG_HTTP_SERVER_STACK_SIZE);
+static struct k_work_q http_server_work_q;
+
+static void http_server_svc_handler(struct k_work *work);
+
+NET_SOCKET_SERVICE_ASYNC_DEFINE_STATIC(http_server_svc, &http_server_work_q,
+				       http_server_svc_handler,
+				       HTTP_SERVER_SOCK_COUNT);
+
 int http_server_init(struct http_server_ctx *ctx)
 {
 	int proto;
@@ -82,18 +97,10 @@ int http_server_init(struct http_server_ctx *ctx)
 		ctx->fds[i].fd = INVALID_SOCK;
 	}
 
-	/* Create an eventfd that can be used to trigger events during polling */
-	fd = eventfd(0, 0);
-	if (fd < 0) {
-		fd = -errno;
-		LOG_ERR("eventfd failed (%d)", fd);
-		return fd;
+	ARRAY_FOR_EACH_PTR(ctx->clients, client) {
+		client->fd = INVALID_SOCK;
 	}
 
-	ctx->fds[count].fd = fd;
-	ctx->fds[count].events = ZSOCK_POLLIN;
-	count++;
-
 	HTTP_SERVICE_FOREACH(svc) {
 		/* set the default address (in6addr_any / INADDR_ANY are all 0) */
 		memset(&addr_storage, 0, sizeof(struct sockaddr_storage));
@@ -200,6 +207,16 @@ int http_server_init(struct http_server_ctx *ctx)
 			continue;
 		}
 
+		/* The socket service may report an event that has already
+		 * been handled, accept() must not block then.
+		 */
+		if (zsock_fcntl(fd, F_SETFL, O_NONBLOCK) < 0) {
+			LOG_ERR("fcntl: %d", errno);
+			failed++;
+			zsock_close(fd);
+			continue;
+		}
+
 		LOG_DBG("Initialized HTTP Service %s:%u", svc->host, *svc->port);
 
 		ctx->fds[count].fd = fd;
@@ -241,23 +258,87 @@ static int accept_new_client(int server_fd)
 	return new_socket;
 }
 
-static int close_all_sockets(struct http_server_ctx *ctx)
+static int register_sockets(struct http_server_ctx *ctx)
 {
-	zsock_close(ctx->fds[0].fd); /* close eventfd */
-	ctx->fds[0].fd = -1;
+	int ret;
 
-	for (int i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
-		if (ctx->fds[i].fd < 0) {
-			continue;
-		}
+	/* Sockets closed while the server is being stopped are not polled
+	 * anymore anyway.
+	 */
+	if (!server_running) {
+		return 0;
+	}
 
-		zsock_close(ctx->fds[i].fd);
-		ctx->fds[i].fd = -1;
+	ret = net_socket_service_register(&http_server_svc, ctx->fds,
+					  ARRAY_SIZE(ctx->fds), NULL);
+	if (ret < 0) {
+		LOG_ERR("Cannot register socket service (%d)", ret);
 	}
 
+	return ret;
+}
+
+static int client_buffers_alloc(struct http_client_ctx *client)
+{
+	void *bufs;
+
+	if (client->bufs != NULL) {
+		return 0;
+	}
+
+	if (k_mem_slab_alloc(&client_buffers, &bufs, K_NO_WAIT) < 0) {
+		return -ENOBUFS;
+	}
+
+	client->bufs = bufs;
+	memset(client->bufs, 0, sizeof(*client->bufs));
+
 	return 0;
 }
 
+static bool client_buffers_free(struct http_client_ctx *client)
+{
+	if (client->bufs == NULL) {
+		return false;
+	}
+
+	k_mem_slab_free(&client_buffers, client->bufs);
+	client->bufs = NULL;
+
+	return true;
+}
+
+/* Stop polling a client until a buffer is available for it, the data is left
+ * in the socket meanwhile.
+ */
+static void client_wait_for_buffer(struct http_server_ctx *ctx,
+				   struct http_client_ctx *client)
+{
+	int i = ctx->listen_fds + ARRAY_INDEX(ctx->clients, client);
+
+	LOG_DBG("No free buffer for client #%d", i - ctx->listen_fds);
+
+	ctx->fds[i].events = 0;
+	(void)register_sockets(ctx);
+}
+
+/* A buffer was freed, let the clients waiting for one try again. Returns
+ * true if the sockets need to be registered again.
+ */
+static bool resume_waiting_clients(struct http_server_ctx *ctx)
+{
+	bool resumed = false;
+
+	for (int i = ctx->listen_fds; i < ARRAY_SIZE(ctx->fds); i++) {
+		if (ctx->fds[i].fd != INVALID_SOCK && ctx->fds[i].events == 0) {
+			ctx->fds[i].events = ZSOCK_POLLIN;
+			resumed = true;
+		}
+	}
+
+	return resumed;
+}
+
 static void client_release_resources(struct http_client_ctx *client)
 {
 	struct http_resource_detail *detail;
@@ -308,12 +389,20 @@ void http_server_release_client(struct http_client_ctx *client)
 	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
 		if (server_ctx.fds[i].fd == client->fd) {
 			server_ctx.fds[i].fd = INVALID_SOCK;
+			server_ctx.fds[i].events = 0;
 			break;
 		}
 	}
 
+	if (client_buffers_free(client)) {
+		(void)resume_waiting_clients(&server_ctx);
+	}
+
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
+
+	/* Stop polling the socket before it is closed or handed over. */
+	(void)register_sockets(&server_ctx);
 }
 
 static void close_client_connection(struct http_client_ctx *client)
@@ -325,6 +414,26 @@ static void close_client_connection(struct http_client_ctx *client)
 	(void)zsock_close(fd);
 }
 
+static void close_all_sockets(struct http_server_ctx *ctx)
+{
+	ARRAY_FOR_EACH_PTR(ctx->clients, client) {
+		if (client->fd != INVALID_SOCK) {
+			close_client_connection(client);
+		}
+	}
+
+	for (int i = 0; i < ctx->listen_fds; i++) {
+		if (ctx->fds[i].fd < 0) {
+			continue;
+		}
+
+		zsock_close(ctx->fds[i].fd);
+		ctx->fds[i].fd = INVALID_SOCK;
+	}
+
+	ctx->listen_fds = 0;
+}
+
 static void client_timeout(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -354,15 +463,17 @@ static void init_client_ctx(struct http_client_ctx *client, int new_socket)
 	client->has_upgrade_header = false;
 	client->preface_sent = false;
 	client->window_size = HTTP_SERVER_INITIAL_WINDOW_SIZE;
+	client->send_window_size = HTTP_SERVER_DEFAULT_SEND_WINDOW_SIZE;
+	client->initial_send_window_size = HTTP_SERVER_DEFAULT_SEND_WINDOW_SIZE;
+	client->bufs = NULL;
 
-	memset(client->buffer, 0, sizeof(client->buffer));
-	memset(client->url_buffer, 0, sizeof(client->url_buffer));
 	k_work_init_delayable(&client->inactivity_timer, client_timeout);
 	http_client_timer_restart(client);
 
 	ARRAY_FOR_EACH(client->streams, i) {
 		client->streams[i].stream_state = HTTP_SERVER_STREAM_IDLE;
 		client->streams[i].stream_id = 0;
+		client->streams[i].send_data = NULL;
 	}
 }
 
@@ -404,7 +515,7 @@ static int handle_http_request(struct http_client_ctx *client)
 {
 	int ret = -EINVAL;
 
-	client->cursor = client->buffer;
+	client->cursor = client->bufs->buffer;
 
 	do {
 		switch (client->server_state) {
@@ -454,167 +565,233 @@ static int handle_http_request(struct http_client_ctx *client)
 		return ret;
 	}
 
+	/* Continue the static responses the processed frames have started
+	 * or allowed to continue by opening the flow control windows.
+	 */
+	ret = send_http2_pending_data(client);
+	if (ret < 0) {
+		return ret;
+	}
+
 	if (client->data_len > 0) {
 		/* Move any remaining data in the buffer. */
-		memmove(client->buffer, client->cursor, client->data_len);
+		memmove(client->bufs->buffer, client->cursor, client->data_len);
 	}
 
 	return 0;
 }
 
-static int http_server_run(struct http_server_ctx *ctx)
+/* A client needs its buffers only while a request is being received. */
+static bool client_request_in_progress(struct http_client_ctx *client)
 {
-	struct http_client_ctx *client;
-	eventfd_t value;
-	bool found_slot;
-	int new_socket;
-	int ret, i, j;
+	if (client->data_len > 0) {
+		return true;
+	}
+
+	switch (client->server_state) {
+	case HTTP_SERVER_PREFACE_STATE:
+		return false;
+	case HTTP_SERVER_FRAME_HEADER_STATE:
+		return http2_request_in_progress(client);
+	default:
+		return true;
+	}
+}
+
+static void handle_client_event(struct http_server_ctx *ctx,
+				struct http_client_ctx *client, short revents)
+{
+	int client_idx = ARRAY_INDEX(ctx->clients, client);
 	int sock_error;
 	socklen_t optlen = sizeof(int);
+	int ret;
 
-	value = 0;
+	if (revents & ZSOCK_POLLHUP) {
+		LOG_DBG("Client #%d has disconnected", client_idx);
+		close_client_connection(client);
+		return;
+	}
 
-	while (1) {
-		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
-		if (ret < 0) {
-			ret = -errno;
-			LOG_DBG("poll failed (%d)", ret);
-			return ret;
-		}
+	if (revents & ZSOCK_POLLERR) {
+		(void)zsock_getsockopt(client->fd, SOL_SOCKET, SO_ERROR,
+				       &sock_error, &optlen);
+		LOG_DBG("Error on fd %d %d", client->fd, sock_error);
+		close_client_connection(client);
+		return;
+	}
+
+	if (!(revents & ZSOCK_POLLIN)) {
+		return;
+	}
 
+	if (client_buffers_alloc(client) < 0) {
+		client_wait_for_buffer(ctx, client);
+		return;
+	}
+
+	ret = zsock_recv(client->fd, client->bufs->buffer + client->data_len,
+			 sizeof(client->bufs->buffer) - client->data_len,
+			 ZSOCK_MSG_DONTWAIT);
+	if (ret < 0 && errno == EAGAIN) {
+		/* The data was already read on an earlier event. */
+		goto out;
+	}
+
+	if (ret <= 0) {
 		if (ret == 0) {
-			/* should not happen because timeout is -1 */
-			break;
+			LOG_DBG("Connection closed by peer for client #%d",
+				client_idx);
+		} else {
+			ret = -errno;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
 		}
 
-		if (ret == 1 && ctx->fds[0].revents) {
-			eventfd_read(ctx->fds[0].fd, &value);
-			LOG_DBG("Received stop event. exiting ..");
-			goto closing;
-		}
+		close_client_connection(client);
+		return;
+	}
 
-		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
-			if (ctx->fds[i].fd < 0) {
-				continue;
-			}
+	client->data_len += ret;
 
-			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
-				if (i >= ctx->listen_fds) {
-					LOG_DBG("Client #%d has disconnected",
-						i - ctx->listen_fds);
+	http_client_timer_restart(client);
 
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-				}
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+		close_client_connection(client);
+		return;
+	} else if (client->data_len == sizeof(client->bufs->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+		return;
+	}
 
-				continue;
-			}
+out:
+	/* The client may have been released while handling the request. */
+	if (client->fd == INVALID_SOCK || client_request_in_progress(client)) {
+		return;
+	}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLERR) {
-				(void)zsock_getsockopt(ctx->fds[i].fd, SOL_SOCKET,
-						       SO_ERROR, &sock_error, &optlen);
-				LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
+	if (client_buffers_free(client) && resume_waiting_clients(ctx)) {
+		(void)register_sockets(ctx);
+	}
+}
 
-				if (i >= ctx->listen_fds) {
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-					continue;
-				}
+static int handle_listen_event(struct http_server_ctx *ctx, int i,
+			       short revents)
+{
+	int new_socket;
+	int sock_error;
+	socklen_t optlen = sizeof(int);
+	int j;
 
-				/* Listening socket error, abort. */
-				LOG_ERR("Listening socket error, aborting.");
-				return -sock_error;
+	if (revents & ZSOCK_POLLERR) {
+		(void)zsock_getsockopt(ctx->fds[i].fd, SOL_SOCKET,
+				       SO_ERROR, &sock_error, &optlen);
+		LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
 
-			}
+		/* Listening socket error, abort. */
+		LOG_ERR("Listening socket error, aborting.");
+		return -sock_error;
+	}
 
-			if (!(ctx->fds[i].revents & ZSOCK_POLLIN)) {
-				continue;
-			}
+	if (!(revents & ZSOCK_POLLIN)) {
+		return 0;
+	}
 
-			/* First check if we have something to accept */
-			if (i < ctx->listen_fds) {
-				new_socket = accept_new_client(ctx->fds[i].fd);
-				if (new_socket < 0) {
-					ret = -errno;
-					LOG_DBG("accept: %d", ret);
-					continue;
-				}
+	new_socket = accept_new_client(ctx->fds[i].fd);
+	if (new_socket < 0) {
+		return 0;
+	}
 
-				found_slot = false;
+	for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
+		if (ctx->fds[j].fd != INVALID_SOCK) {
+			continue;
+		}
 
-				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
-						continue;
-					}
+		ctx->fds[j].fd = new_socket;
+		ctx->fds[j].events = ZSOCK_POLLIN;
+		ctx->fds[j].revents = 0;
 
-					ctx->fds[j].fd = new_socket;
-					ctx->fds[j].events = ZSOCK_POLLIN;
-					ctx->fds[j].revents = 0;
+		ctx->num_clients++;
 
-					ctx->num_clients++;
+		LOG_DBG("Init client #%d", j - ctx->listen_fds);
 
-					LOG_DBG("Init client #%d", j - ctx->listen_fds);
+		init_client_ctx(&ctx->clients[j - ctx->listen_fds], new_socket);
 
-					init_client_ctx(&ctx->clients[j - ctx->listen_fds],
-							new_socket);
-					found_slot = true;
-					break;
-				}
+		return register_sockets(ctx);
+	}
 
-				if (!found_slot) {
-					LOG_DBG("No free slot found.");
-					zsock_close(new_socket);
-				}
+	LOG_DBG("No free slot found.");
+	zsock_close(new_socket);
 
-				continue;
-			}
+	return 0;
+}
 
-			/* Client sock */
-			client = &ctx->clients[i - ctx->listen_fds];
+static int start_sockets(struct http_server_ctx *ctx)
+{
+	int ret;
 
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
+	ret = http_server_init(ctx);
+	if (ret < 0) {
+		LOG_ERR("Failed to initialize HTTP2 server");
+		return ret;
+	}
 
-				close_client_connection(client);
-				continue;
-			}
+	ret = register_sockets(ctx);
+	if (ret < 0) {
+		close_all_sockets(ctx);
+	}
 
-			client->data_len += ret;
+	return ret;
+}
 
-			http_client_timer_restart(client);
+static void http_server_svc_handler(struct k_work *work)
+{
+	struct net_socket_service_event *pev =
+		CONTAINER_OF(work, struct net_socket_service_event, work);
+	struct http_server_ctx *ctx = &server_ctx;
+	int ret;
+	int i;
 
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
-			}
+	if (!server_running || pev->event.fd < 0) {
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(ctx->fds); i++) {
+		if (ctx->fds[i].fd == pev->event.fd) {
+			break;
 		}
 	}
 
-	return 0;
+	if (i == ARRAY_SIZE(ctx->fds)) {
+		/* The socket was closed after the event was reported. */
+		return;
+	}
+
+	if (i >= ctx->listen_fds) {
+		handle_client_event(ctx, &ctx->clients[i - ctx->listen_fds],
+				    pev->event.revents);
+		return;
+	}
+
+	ret = handle_listen_event(ctx, i, pev->event.revents);
+	if (ret < 0) {
+		close_all_sockets(ctx);
+
+		LOG_INF("Re-starting server (%d)", ret);
 
-closing:
-	/* Close all client connections and the server socket */
-	return close_all_sockets(ctx);
+		if (start_sockets(ctx) < 0) {
+			server_running = false;
+		}
+	}
 }
 
 /* Compare two strings where the terminator is either "\0" or "?" */
@@ -704,6 +881,83 @@ int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t
 	return 0;
 }
 
+int http_server_sendall_iov(struct http_client_ctx *client, struct iovec *iov,
+			    size_t iovcnt)
+{
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = iovcnt,
+	};
+
+	while (msg.msg_iovlen > 0) {
+		ssize_t out_len;
+
+		if (msg.msg_iov->iov_len == 0) {
+			msg.msg_iov++;
+			msg.msg_iovlen--;
+			continue;
+		}
+
+		out_len = zsock_sendmsg(client->fd, &msg, 0);
+		if (out_len < 0) {
+			return -errno;
+		}
+
+		/* Skip what was sent, the rest is sent on the next round. */
+		while (out_len > 0) {
+			if (out_len < msg.msg_iov->iov_len) {
+				msg.msg_iov->iov_base =
+					(uint8_t *)msg.msg_iov->iov_base + out_len;
+				msg.msg_iov->iov_len -= out_len;
+				break;
+			}
+
+			out_len -= msg.msg_iov->iov_len;
+			msg.msg_iov++;
+			msg.msg_iovlen--;
+		}
+
+		http_client_timer_restart(client);
+	}
+
+	return 0;
+}
+
+static void server_start_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (start_sockets(&server_ctx) < 0) {
+		server_running = false;
+	}
+}
+
+static void server_stop_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)net_socket_service_unregister(&http_server_svc);
+
+	close_all_sockets(&server_ctx);
+}
+
+static K_WORK_DEFINE(server_start_work, server_start_handler);
+static K_WORK_DEFINE(server_stop_work, server_stop_handler);
+
+/* Run the work on the server thread and wait until it is done, unless called
+ * from the server thread itself, e.g. from a resource callback.
+ */
+static void server_work_run(struct k_work *work)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_submit_to_queue(&http_server_work_q, work);
+
+	if (k_current_get() != k_work_queue_thread_get(&http_server_work_q)) {
+		(void)k_work_flush(work, &sync);
+	}
+}
+
 int http_server_start(void)
 {
 	if (server_running) {
@@ -712,7 +966,7 @@ int http_server_start(void)
 	}
 
 	server_running = true;
-	k_sem_give(&server_start);
+	server_work_run(&server_start_work);
 
 	LOG_DBG("Starting HTTP server");
 
@@ -727,39 +981,24 @@ int http_server_stop(void)
 	}
 
 	server_running = false;
-	k_sem_reset(&server_start);
-	eventfd_write(server_ctx.fds[0].fd, 1);
+	server_work_run(&server_stop_work);
 
 	LOG_DBG("Stopping HTTP server");
 
 	return 0;
 }
 
-static void http_server_thread(void *p1, void *p2, void *p3)
+static int http_server_work_q_init(void)
 {
-	int ret;
-
-	ARG_UNUSED(p1);
-	ARG_UNUSED(p2);
-	ARG_UNUSED(p3);
-
-	while (true) {
-		k_sem_take(&server_start, K_FOREVER);
+	struct k_work_queue_config cfg = {
+		.name = "http_server",
+	};
 
-		while (server_running) {
-			ret = http_server_init(&server_ctx);
-			if (ret < 0) {
-				LOG_ERR("Failed to initialize HTTP2 server");
-				return;
-			}
+	k_work_queue_start(&http_server_work_q, http_server_stack,
+			   K_THREAD_STACK_SIZEOF(http_server_stack),
+			   THREAD_PRIORITY, &cfg);
 
-			ret = http_server_run(&server_ctx);
-			if (server_running) {
-				LOG_INF("Re-starting server (%d)", ret);
-			}
-		}
-	}
+	return 0;
 }
 
-K_THREAD_DEFINE(http_server_tid, CONFIG_HTTP_SERVER_STACK_SIZE,
-		http_server_thread, NULL, NULL, NULL, THREAD_PRIORITY, 0, 0);
+SYS_INIT(http_server_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -40,6 +40,7 @@ static int handle_http1_static_resource(
 			   sizeof("Content-Type: \r\n") + HTTP_SERVER_MAX_CONTENT_TYPE_LEN +
 			   sizeof("xxxx") +
 			   sizeof("\r\n")];
+	struct iovec iov[2];
 	const char *data;
 	int len;
 	int ret;
@@ -65,13 +66,12 @@ static int handle_http1_static_resource(
 				 len);
 		}
 
-		ret = http_server_sendall(client, http_response,
-					  strlen(http_response));
-		if (ret < 0) {
-			return ret;
-		}
+		iov[0].iov_base = http_response;
+		iov[0].iov_len = strlen(http_response);
+		iov[1].iov_base = (void *)data;
+		iov[1].iov_len = len;
 
-		ret = http_server_sendall(client, data, len);
+		ret = http_server_sendall_iov(client, iov, ARRAY_SIZE(iov));
 		if (ret < 0) {
 			return ret;
 		}
@@ -119,14 +119,15 @@ static int dynamic_get_req(struct http_resource_detail_dynamic *dynamic_detail,
 		return ret;
 	}
 
-	remaining = strlen(&client->url_buffer[dynamic_detail->common.path_len]);
+	remaining = strlen(
+		&client->bufs->url_buffer[dynamic_detail->common.path_len]);
 
 	/* Pass URL to the client */
 	while (1) {
 		int copy_len, send_len;
 		enum http_data_status status;
 
-		ptr = &client->url_buffer[offset];
+		ptr = &client->bufs->url_buffer[offset];
 		copy_len = MIN(remaining, dynamic_detail->data_buffer_len);
 
 		memcpy(dynamic_detail->data_buffer, ptr, copy_len);
@@ -336,31 +337,32 @@ static int on_header_field(struct http_parser *parser, const char *at,
 	struct http_client_ctx *ctx = CONTAINER_OF(parser,
 						   struct http_client_ctx,
 						   parser);
-	size_t offset = strnlen(ctx->header_buffer, sizeof(ctx->header_buffer));
+	size_t offset = strnlen(ctx->bufs->header_buffer,
+				sizeof(ctx->bufs->header_buffer));
 
-	if (offset + length > sizeof(ctx->header_buffer) - 1U) {
+	if (offset + length > sizeof(ctx->bufs->header_buffer) - 1U) {
 		LOG_DBG("Header %s too long (by %zu bytes)", "field",
-			offset + length - sizeof(ctx->header_buffer) - 1U);
-		ctx->header_buffer[0] = '\0';
+			offset + length - sizeof(ctx->bufs->header_buffer) - 1U);
+		ctx->bufs->header_buffer[0] = '\0';
 	} else {
-		memcpy(ctx->header_buffer + offset, at, length);
+		memcpy(ctx->bufs->header_buffer + offset, at, length);
 		offset += length;
-		ctx->header_buffer[offset] = '\0';
+		ctx->bufs->header_buffer[offset] = '\0';
 
 		if (parser->state == s_header_value_discard_ws) {
 			/* This means that the header field is fully parsed,
 			 * and we can use it directly.
 			 */
-			if (strncasecmp(ctx->header_buffer, "Upgrade",
+			if (strncasecmp(ctx->bufs->header_buffer, "Upgrade",
 					sizeof("Upgrade") - 1) == 0) {
 				ctx->has_upgrade_header = true;
-			} else if (strncasecmp(ctx->header_buffer,
+			} else if (strncasecmp(ctx->bufs->header_buffer,
 					       "Sec-WebSocket-Key",
 					       sizeof("Sec-WebSocket-Key") - 1) == 0) {
 				ctx->websocket_sec_key_next = true;
 			}
 
-			ctx->header_buffer[0] = '\0';
+			ctx->bufs->header_buffer[0] = '\0';
 		}
 	}
 
@@ -375,23 +377,24 @@ static int on_header_value(struct http_parser *parser,
 	struct http_client_ctx *ctx = CONTAINER_OF(parser,
 						   struct http_client_ctx,
 						   parser);
-	size_t offset = strnlen(ctx->header_buffer, sizeof(ctx->header_buffer));
+	size_t offset = strnlen(ctx->bufs->header_buffer,
+				sizeof(ctx->bufs->header_buffer));
 
-	if (offset + length > sizeof(ctx->header_buffer) - 1U) {
+	if (offset + length > sizeof(ctx->bufs->header_buffer) - 1U) {
 		LOG_DBG("Header %s too long (by %zu bytes)", "value",
-			offset + length - sizeof(ctx->header_buffer) - 1U);
-		ctx->header_buffer[0] = '\0';
+			offset + length - sizeof(ctx->bufs->header_buffer) - 1U);
+		ctx->bufs->header_buffer[0] = '\0';
 	} else {
-		memcpy(ctx->header_buffer + offset, at, length);
+		memcpy(ctx->bufs->header_buffer + offset, at, length);
 		offset += length;
-		ctx->header_buffer[offset] = '\0';
+		ctx->bufs->header_buffer[offset] = '\0';
 
 		if (parser->state == s_header_almost_done) {
 			if (ctx->has_upgrade_header) {
-				if (strncasecmp(ctx->header_buffer, "h2c",
+				if (strncasecmp(ctx->bufs->header_buffer, "h2c",
 						sizeof("h2c") - 1) == 0) {
 					ctx->http2_upgrade = true;
-				} else if (strncasecmp(ctx->header_buffer,
+				} else if (strncasecmp(ctx->bufs->header_buffer,
 						       "websocket",
 						       sizeof("websocket") - 1) == 0) {
 					ctx->websocket_upgrade = true;
@@ -402,13 +405,13 @@ static int on_header_value(struct http_parser *parser,
 
 			if (ctx->websocket_sec_key_next) {
 #if defined(CONFIG_WEBSOCKET)
-				strncpy(ctx->ws_sec_key, ctx->header_buffer,
+				strncpy(ctx->ws_sec_key, ctx->bufs->header_buffer,
 					MIN(sizeof(ctx->ws_sec_key), offset));
 #endif
 				ctx->websocket_sec_key_next = false;
 			}
 
-			ctx->header_buffer[0] = '\0';
+			ctx->bufs->header_buffer[0] = '\0';
 		}
 	}
 
@@ -431,18 +434,18 @@ static int on_url(struct http_parser *parser, const char *at, size_t length)
 	struct http_client_ctx *ctx = CONTAINER_OF(parser,
 						   struct http_client_ctx,
 						   parser);
-	size_t offset = strlen(ctx->url_buffer);
+	size_t offset = strlen(ctx->bufs->url_buffer);
 
 	ctx->parser_state = HTTP1_WAITING_HEADER_STATE;
 
-	if (offset + length > sizeof(ctx->url_buffer) - 1) {
+	if (offset + length > sizeof(ctx->bufs->url_buffer) - 1) {
 		LOG_DBG("URL too long to handle");
 		return -EMSGSIZE;
 	}
 
-	memcpy(ctx->url_buffer + offset, at, length);
+	memcpy(ctx->bufs->url_buffer + offset, at, length);
 	offset += length;
-	ctx->url_buffer[offset] = '\0';
+	ctx->bufs->url_buffer[offset] = '\0';
 
 	return 0;
 }
@@ -486,7 +489,8 @@ int enter_http1_request(struct http_client_ctx *client)
 	client->parser_settings.on_message_complete = on_message_complete;
 	client->parser_state = HTTP1_INIT_HEADER_STATE;
 
-	memset(client->header_buffer, 0, sizeof(client->header_buffer));
+	memset(client->bufs->header_buffer, 0,
+	       sizeof(client->bufs->header_buffer));
 
 	return 0;
 }
@@ -526,7 +530,7 @@ int handle_http1_request(struct http_client_ctx *client)
 	client->has_upgrade_header = client->parser.upgrade;
 
 	if (skip_headers) {
-		LOG_DBG("Requested URL: %s", client->url_buffer);
+		LOG_DBG("Requested URL: %s", client->bufs->url_buffer);
 
 		size_t frag_headers_len;
 
@@ -552,7 +556,7 @@ int handle_http1_request(struct http_client_ctx *client)
 
 		if (client->websocket_upgrade) {
 			if (IS_ENABLED(CONFIG_HTTP_SERVER_WEBSOCKET)) {
-				detail = get_resource_detail(client->url_buffer,
+				detail = get_resource_detail(client->bufs->url_buffer,
 							     &path_len, true);
 				if (detail == NULL) {
 					goto not_found;
@@ -592,7 +596,7 @@ upgrade_not_found:
 		}
 	}
 
-	detail = get_resource_detail(client->url_buffer, &path_len, false);
+	detail = get_resource_detail(client->bufs->url_buffer, &path_len, false);
 	if (detail != NULL) {
 		detail->path_len = path_len;
 
@@ -97,6 +97,10 @@ static struct http_stream_ctx *allocate_http_stream_context(
 			client->streams[i].stream_state = HTTP_SERVER_STREAM_OPEN;
 			client->streams[i].window_size =
 				HTTP_SERVER_INITIAL_WINDOW_SIZE;
+			client->streams[i].send_window_size =
+				client->initial_send_window_size;
+			client->streams[i].send_data = NULL;
+			client->streams[i].send_len = 0;
 			return &client->streams[i];
 		}
 	}
@@ -111,22 +115,40 @@ static void release_http_stream_context(struct http_client_ctx *client,
 		if (client->streams[i].stream_id == stream_id) {
 			client->streams[i].stream_id = 0;
 			client->streams[i].stream_state = HTTP_SERVER_STREAM_IDLE;
+			client->streams[i].send_data = NULL;
 			break;
 		}
 	}
 }
 
+/* The peer has ended the stream, release it unless a response is still
+ * being sent on it.
+ */
+static void close_remote_http_stream(struct http_client_ctx *client,
+				     uint32_t stream_id)
+{
+	struct http_stream_ctx *stream;
+
+	stream = find_http_stream_context(client, stream_id);
+	if (stream != NULL && stream->send_data != NULL) {
+		stream->stream_state = HTTP_SERVER_STREAM_HALF_CLOSED_REMOTE;
+		return;
+	}
+
+	release_http_stream_context(client, stream_id);
+}
+
 static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 			    size_t *buflen, const char *name, const char *value)
 {
 	int ret;
 
-	client->header_field.name = name;
-	client->header_field.name_len = strlen(name);
-	client->header_field.value = value;
-	client->header_field.value_len = strlen(value);
+	client->bufs->header_field.name = name;
+	client->bufs->header_field.name_len = strlen(name);
+	client->bufs->header_field.value = value;
+	client->bufs->header_field.value_len = strlen(value);
 
-	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+	ret = http_hpack_encode_header(*buf, *buflen, &client->bufs->header_field);
 	if (ret < 0) {
 		return ret;
 	}
@@ -147,16 +169,13 @@ static void encode_frame_header(uint8_t *buf, uint32_t payload_len,
 	sys_put_be32(stream_id, &buf[HTTP_SERVER_FRAME_STREAM_ID_OFFSET]);
 }
 
-static int send_headers_frame(struct http_client_ctx *client,
-			      enum http_status status, uint32_t stream_id,
-			      struct http_resource_detail *detail_common,
-			      uint8_t flags)
+static int encode_headers_block(struct http_client_ctx *client, uint8_t *buf,
+				size_t buflen, enum http_status status,
+				struct http_resource_detail *detail_common,
+				const char *content_len)
 {
-	uint8_t headers_frame[64];
 	uint8_t status_str[4];
-	uint8_t *buf = headers_frame + HTTP_SERVER_FRAME_HEADER_SIZE;
-	size_t buflen = sizeof(headers_frame) - HTTP_SERVER_FRAME_HEADER_SIZE;
-	size_t payload_len;
+	size_t total = buflen;
 	int ret;
 
 	ret = snprintf(status_str, sizeof(status_str), "%d", status);
@@ -169,9 +188,10 @@ static int send_headers_frame(struct http_client_ctx *client,
 		return ret;
 	}
 
-	if (detail_common && detail_common->content_encoding != NULL) {
+	if (detail_common && detail_common->content_encoding != NULL &&
+	    detail_common->content_encoding[0] != '\0') {
 		ret = add_header_field(client, &buf, &buflen, "content-encoding",
-				       "gzip");
+				       detail_common->content_encoding);
 		if (ret < 0) {
 			return ret;
 		}
@@ -185,14 +205,34 @@ static int send_headers_frame(struct http_client_ctx *client,
 		}
 	}
 
-	payload_len = sizeof(headers_frame) - buflen - HTTP_SERVER_FRAME_HEADER_SIZE;
+	if (content_len != NULL) {
+		ret = add_header_field(client, &buf, &buflen, "content-length",
+				       content_len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return total - buflen;
+}
+
+static int send_headers_block(struct http_client_ctx *client,
+			      const uint8_t *block, size_t block_len,
+			      uint32_t stream_id, uint8_t flags)
+{
+	uint8_t frame_header[HTTP_SERVER_FRAME_HEADER_SIZE];
+	struct iovec iov[] = {
+		{ .iov_base = frame_header, .iov_len = sizeof(frame_header) },
+		{ .iov_base = (void *)block, .iov_len = block_len },
+	};
+	int ret;
+
 	flags |= HTTP_SERVER_FLAG_END_HEADERS;
 
-	encode_frame_header(headers_frame, payload_len, HTTP_SERVER_HEADERS_FRAME,
+	encode_frame_header(frame_header, block_len, HTTP_SERVER_HEADERS_FRAME,
 			    flags, stream_id);
 
-	ret = http_server_sendall(client, headers_frame,
-				  payload_len + HTTP_SERVER_FRAME_HEADER_SIZE);
+	ret = http_server_sendall_iov(client, iov, ARRAY_SIZE(iov));
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
 		return ret;
@@ -201,10 +241,69 @@ static int send_headers_frame(struct http_client_ctx *client,
 	return 0;
 }
 
+static int send_headers_frame(struct http_client_ctx *client,
+			      enum http_status status, uint32_t stream_id,
+			      struct http_resource_detail *detail_common,
+			      uint8_t flags)
+{
+	uint8_t block[HTTP_SERVER_MAX_HEADERS_BLOCK_LEN];
+	int ret;
+
+	ret = encode_headers_block(client, block, sizeof(block), status,
+				   detail_common, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return send_headers_block(client, block, ret, stream_id, flags);
+}
+
+static int send_static_headers_frame(
+	struct http_client_ctx *client,
+	struct http_resource_detail_static *static_detail,
+	uint32_t stream_id, uint8_t flags)
+{
+	uint8_t block[HTTP_SERVER_MAX_HEADERS_BLOCK_LEN];
+	char content_len[sizeof("4294967295")];
+	int ret;
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_HEADERS_CACHE)
+	if (static_detail->headers_block_len > 0) {
+		return send_headers_block(client, static_detail->headers_block,
+					  static_detail->headers_block_len,
+					  stream_id, flags);
+	}
+#endif
+
+	snprintk(content_len, sizeof(content_len), "%u",
+		 (unsigned int)static_detail->static_data_len);
+
+	ret = encode_headers_block(client, block, sizeof(block), HTTP_200_OK,
+				   &static_detail->common, content_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_HEADERS_CACHE)
+	/* The encoder does not index headers, so the block does not depend
+	 * on the connection and can be sent as is to any client.
+	 */
+	memcpy(static_detail->headers_block, block, ret);
+	static_detail->headers_block_len = ret;
+#endif
+
+	return send_headers_block(client, block, ret, stream_id, flags);
+}
+
 static int send_data_frame(struct http_client_ctx *client, const char *payload,
 			   size_t length, uint32_t stream_id, uint8_t flags)
 {
 	uint8_t frame_header[HTTP_SERVER_FRAME_HEADER_SIZE];
+	struct iovec iov[] = {
+		{ .iov_base = frame_header, .iov_len = sizeof(frame_header) },
+		{ .iov_base = (void *)payload, .iov_len = payload ? length : 0 },
+	};
+	struct http_stream_ctx *stream;
 	int ret;
 
 	encode_frame_header(frame_header, length, HTTP_SERVER_DATA_FRAME,
@@ -212,19 +311,93 @@ static int send_data_frame(struct http_client_ctx *client, const char *payload,
 			    HTTP_SERVER_FLAG_END_STREAM : 0,
 			    stream_id);
 
-	ret = http_server_sendall(client, frame_header, sizeof(frame_header));
+	/* The payload is sent straight from where it is, no copy is made
+	 * before the socket.
+	 */
+	ret = http_server_sendall_iov(client, iov, ARRAY_SIZE(iov));
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
-	} else {
-		if (payload != NULL && length > 0) {
-			ret = http_server_sendall(client, payload, length);
+		return ret;
+	}
+
+	client->send_window_size -= length;
+
+	stream = find_http_stream_context(client, stream_id);
+	if (stream != NULL) {
+		stream->send_window_size -= length;
+	}
+
+	return ret;
+}
+
+/* Send the next DATA frame of the static response on the stream, as much as
+ * the flow control windows allow. Returns the number of bytes sent.
+ */
+static int send_stream_data(struct http_client_ctx *client,
+			    struct http_stream_ctx *stream)
+{
+	size_t len;
+	int window;
+	int ret;
+
+	window = MIN(stream->send_window_size, client->send_window_size);
+	if (window <= 0) {
+		return 0;
+	}
+
+	len = MIN(stream->send_len, HTTP_SERVER_DEFAULT_MAX_FRAME_SIZE);
+	len = MIN(len, window);
+
+	ret = send_data_frame(client, stream->send_data, len, stream->stream_id,
+			      len == stream->send_len ?
+			      HTTP_SERVER_FLAG_END_STREAM : 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	stream->send_data += len;
+	stream->send_len -= len;
+
+	if (stream->send_len == 0) {
+		stream->send_data = NULL;
+
+		if (stream->stream_state == HTTP_SERVER_STREAM_HALF_CLOSED_REMOTE) {
+			release_http_stream_context(client, stream->stream_id);
+		} else {
+			stream->stream_state = HTTP_SERVER_STREAM_HALF_CLOSED_LOCAL;
+		}
+	}
+
+	return len;
+}
+
+/* Send the static responses in progress as far as the flow control windows
+ * allow. The streams take turns sending a frame each, so that a large
+ * response does not hold the others back.
+ */
+int send_http2_pending_data(struct http_client_ctx *client)
+{
+	bool progress;
+	int ret;
+
+	do {
+		progress = false;
+
+		ARRAY_FOR_EACH_PTR(client->streams, stream) {
+			if (stream->send_data == NULL) {
+				continue;
+			}
+
+			ret = send_stream_data(client, stream);
 			if (ret < 0) {
-				LOG_DBG("Cannot write to socket (%d)", ret);
+				return ret;
 			}
+
+			progress |= ret > 0;
 		}
-	}
+	} while (progress);
 
-	return ret;
+	return 0;
 }
 
 int send_settings_frame(struct http_client_ctx *client, bool ack)
@@ -346,34 +519,51 @@ static int handle_http2_static_resource(
 	struct http_resource_detail_static *static_detail,
 	struct http_frame *frame, struct http_client_ctx *client)
 {
-	const char *content_200;
-	size_t content_len;
+	struct http_stream_ctx *stream;
 	int ret;
 
 	if (!(static_detail->common.bitmask_of_supported_http_methods & BIT(HTTP_GET))) {
 		return -ENOTSUP;
 	}
 
-	content_200 = static_detail->static_data;
-	content_len = static_detail->static_data_len;
+	stream = find_http_stream_context(client, frame->stream_identifier);
+	if (stream == NULL) {
+		/* The request upgraded from HTTP/1.1 has no stream yet. */
+		stream = allocate_http_stream_context(client,
+						      frame->stream_identifier);
+		if (stream == NULL) {
+			LOG_DBG("No available stream slots.");
+			return -ENOMEM;
+		}
+	}
 
-	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier,
-				 &static_detail->common, 0);
+	if (static_detail->static_data_len == 0) {
+		return send_static_headers_frame(client, static_detail,
+						 frame->stream_identifier,
+						 HTTP_SERVER_FLAG_END_STREAM);
+	}
+
+	ret = send_static_headers_frame(client, static_detail,
+					frame->stream_identifier, 0);
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
-		goto out;
+		return ret;
 	}
 
-	ret = send_data_frame(client, content_200, content_len,
-			      frame->stream_identifier,
-			      HTTP_SERVER_FLAG_END_STREAM);
+	/* The data is sent in frames taking turns with the other streams,
+	 * as the flow control windows allow. The first frame goes out right
+	 * away, so that small responses are sent in the order requested.
+	 */
+	stream->send_data = static_detail->static_data;
+	stream->send_len = static_detail->static_data_len;
+
+	ret = send_stream_data(client, stream);
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
-		goto out;
+		return ret;
 	}
 
-out:
-	return ret;
+	return 0;
 }
 
 static int dynamic_get_req_v2(struct http_resource_detail_dynamic *dynamic_detail,
@@ -390,14 +580,15 @@ static int dynamic_get_req_v2(struct http_resource_detail_dynamic *dynamic_detai
 		return ret;
 	}
 
-	remaining = strlen(&client->url_buffer[dynamic_detail->common.path_len]);
+	remaining = strlen(
+		&client->bufs->url_buffer[dynamic_detail->common.path_len]);
 
 	/* Pass URL to the client */
 	while (1) {
 		int copy_len, send_len;
 		enum http_data_status status;
 
-		ptr = &client->url_buffer[offset];
+		ptr = &client->bufs->url_buffer[offset];
 		copy_len = MIN(remaining, dynamic_detail->data_buffer_len);
 
 		if (copy_len > 0) {
@@ -652,6 +843,7 @@ static int enter_http_frame_data_state(struct http_client_ctx *client)
 	}
 
 	if (stream->stream_state != HTTP_SERVER_STREAM_OPEN &&
+	    stream->stream_state != HTTP_SERVER_STREAM_HALF_CLOSED_LOCAL &&
 	    stream->stream_state != HTTP_SERVER_STREAM_HALF_CLOSED_REMOTE) {
 		LOG_DBG("Stream ID %d in a wrong state %d", stream->stream_id,
 			stream->stream_state);
@@ -811,7 +1003,7 @@ int handle_http1_to_http2_upgrade(struct http_client_ctx *client)
 		client->preface_sent = true;
 	}
 
-	detail = get_resource_detail(client->url_buffer, &path_len, false);
+	detail = get_resource_detail(client->bufs->url_buffer, &path_len, false);
 	if (detail != NULL) {
 		detail->path_len = path_len;
 
@@ -851,6 +1043,7 @@ int handle_http1_to_http2_upgrade(struct http_client_ctx *client)
 	 * to HTTP2.
 	 */
 	if (client->parser_state == HTTP1_MESSAGE_COMPLETE_STATE) {
+		close_remote_http_stream(client, frame->stream_identifier);
 		client->current_detail = NULL;
 		client->server_state = HTTP_SERVER_PREFACE_STATE;
 		client->cursor += client->data_len;
@@ -915,7 +1108,7 @@ int handle_http_frame_data(struct http_client_ctx *client)
 
 		if (end_stream_flag(frame->flags)) {
 			client->current_detail = NULL;
-			release_http_stream_context(client, frame->stream_identifier);
+			close_remote_http_stream(client, frame->stream_identifier);
 		}
 	}
 
@@ -940,22 +1133,22 @@ static int process_header(struct http_client_ctx *client,
 		}
 	} else if (header->name_len == (sizeof(":path") - 1) &&
 		   memcmp(header->name, ":path", header->name_len) == 0) {
-		if (header->value_len > sizeof(client->url_buffer) - 1) {
+		if (header->value_len > sizeof(client->bufs->url_buffer) - 1) {
 			/* URL too long to handle */
 			return -ENOBUFS;
 		}
 
-		memcpy(client->url_buffer, header->value, header->value_len);
-		client->url_buffer[header->value_len] = '\0';
+		memcpy(client->bufs->url_buffer, header->value, header->value_len);
+		client->bufs->url_buffer[header->value_len] = '\0';
 	} else if (header->name_len == (sizeof("content-type") - 1) &&
 		   memcmp(header->name, "content-type", header->name_len) == 0) {
-		if (header->value_len > sizeof(client->content_type) - 1) {
+		if (header->value_len > sizeof(client->bufs->content_type) - 1) {
 			/* Content-type too long to handle */
 			return -ENOBUFS;
 		}
 
-		memcpy(client->content_type, header->value, header->value_len);
-		client->content_type[header->value_len] = '\0';
+		memcpy(client->bufs->content_type, header->value, header->value_len);
+		client->bufs->content_type[header->value_len] = '\0';
 	} else if (header->name_len == (sizeof("content-length") - 1) &&
 		   memcmp(header->name, "content-length", header->name_len) == 0) {
 		char len_str[16] = { 0 };
@@ -990,7 +1183,7 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 	print_http_frames(client);
 
 	while (frame->length > 0) {
-		struct http_hpack_header_buf *header = &client->header_field;
+		struct http_hpack_header_buf *header = &client->bufs->header_field;
 
 		ret = http_hpack_decode_header(client->cursor, client->data_len,
 					       header);
@@ -1026,7 +1219,7 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		return 0;
 	}
 
-	detail = get_resource_detail(client->url_buffer, &path_len, false);
+	detail = get_resource_detail(client->bufs->url_buffer, &path_len, false);
 	if (detail != NULL) {
 		detail->path_len = path_len;
 
@@ -1054,7 +1247,7 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 	}
 
 	if (end_stream_flag(frame->flags)) {
-		release_http_stream_context(client, frame->stream_identifier);
+		close_remote_http_stream(client, frame->stream_identifier);
 	}
 
 	client->server_state = HTTP_SERVER_FRAME_HEADER_STATE;
@@ -1101,11 +1294,52 @@ int handle_http_frame_rst_frame(struct http_client_ctx *client)
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
 
+	/* Stop sending a response the peer no longer wants. */
+	release_http_stream_context(client, frame->stream_identifier);
+
 	client->server_state = HTTP_SERVER_FRAME_HEADER_STATE;
 
 	return 0;
 }
 
+static int apply_settings(struct http_client_ctx *client, const uint8_t *buf,
+			  size_t len)
+{
+	if (len % sizeof(struct http_settings_field) != 0) {
+		return -EBADMSG;
+	}
+
+	for (; len > 0; len -= sizeof(struct http_settings_field),
+			buf += sizeof(struct http_settings_field)) {
+		uint16_t id = sys_get_be16(buf);
+		uint32_t value = sys_get_be32(buf + sizeof(uint16_t));
+		int delta;
+
+		if (id != HTTP_SETTINGS_INITIAL_WINDOW_SIZE) {
+			/* The frame size is kept at the minimum all peers
+			 * accept, the rest do not affect the responses.
+			 */
+			continue;
+		}
+
+		if (value > INT32_MAX) {
+			return -EBADMSG;
+		}
+
+		/* Applies to the open streams too, RFC 9113 ch 6.9.2. */
+		delta = (int)value - client->initial_send_window_size;
+		client->initial_send_window_size = value;
+
+		ARRAY_FOR_EACH_PTR(client->streams, stream) {
+			if (stream->stream_state != HTTP_SERVER_STREAM_IDLE) {
+				stream->send_window_size += delta;
+			}
+		}
+	}
+
+	return 0;
+}
+
 int handle_http_frame_settings(struct http_client_ctx *client)
 {
 	struct http_frame *frame = &client->current_frame;
@@ -1119,6 +1353,15 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+	if (!settings_ack_flag(frame->flags)) {
+		int ret;
+
+		ret = apply_settings(client, client->cursor, frame->length);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -1163,18 +1406,43 @@ int handle_http_frame_goaway(struct http_client_ctx *client)
 int handle_http_frame_window_update(struct http_client_ctx *client)
 {
 	struct http_frame *frame = &client->current_frame;
+	struct http_stream_ctx *stream;
+	uint32_t increment;
 	int bytes_consumed;
+	int *window;
 
 	LOG_DBG("HTTP_SERVER_FRAME_WINDOW_UPDATE");
 
 	print_http_frames(client);
 
-	/* TODO Implement flow control, for now just ignore. */
-
 	if (client->data_len < frame->length) {
 		return -EAGAIN;
 	}
 
+	if (frame->length != sizeof(uint32_t)) {
+		return -EBADMSG;
+	}
+
+	increment = sys_get_be32(client->cursor) & 0x7FFFFFFF;
+
+	if (frame->stream_identifier == 0) {
+		window = &client->send_window_size;
+	} else {
+		stream = find_http_stream_context(client, frame->stream_identifier);
+		window = stream != NULL ? &stream->send_window_size : NULL;
+	}
+
+	/* Updates of already closed streams are ignored. The data waiting
+	 * for the window is sent once all received frames are processed.
+	 */
+	if (window != NULL) {
+		if (increment == 0 || *window > INT32_MAX - (int)increment) {
+			return -EBADMSG;
+		}
+
+		*window += increment;
+	}
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -1192,6 +1460,21 @@ int handle_http_frame_continuation(struct http_client_ctx *client)
 	return 0;
 }
 
+bool http2_request_in_progress(struct http_client_ctx *client)
+{
+	struct http_frame *frame = &client->current_frame;
+
+	/* The request headers continue in a CONTINUATION frame. */
+	if ((frame->type == HTTP_SERVER_HEADERS_FRAME ||
+	     frame->type == HTTP_SERVER_CONTINUATION_FRAME) &&
+	    !end_headers_flag(frame->flags)) {
+		return true;
+	}
+
+	/* The request body comes in DATA frames. */
+	return client->current_detail != NULL;
+}
+
 const char *get_frame_type_name(enum http_frame_type type)
 {
 	switch (type) {
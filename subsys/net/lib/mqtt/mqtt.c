@@ -25,11 +25,28 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+	client->internal.tx_batch_len = 0U;
+#endif
+
+	inflight_reset(client);
 }
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+static int publish_batch_flush(struct mqtt_client *client);
+#endif
+
 /** @brief Initialize tx buffer. */
 static void tx_buf_init(struct mqtt_client *client, struct buf_ctx *buf)
 {
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+	/* The queued messages go out before the packet about to be encoded.
+	 * A failure disconnects the client, which is reported by the
+	 * following verify_tx_state().
+	 */
+	(void)publish_batch_flush(client);
+#endif
+
 	memset(client->tx_buf, 0, client->tx_buf_size);
 	buf->cur = client->tx_buf;
 	buf->end = client->tx_buf + client->tx_buf_size;
@@ -167,6 +184,92 @@ static int client_write_msg(struct mqtt_client *client,
 	return 0;
 }
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+static int publish_batch_flush(struct mqtt_client *client)
+{
+	uint32_t len = client->internal.tx_batch_len;
+
+	if (len == 0U) {
+		return 0;
+	}
+
+	client->internal.tx_batch_len = 0U;
+
+	return client_write(client, client->tx_buf, len);
+}
+
+/** @brief Append a publish message to the ones queued in the tx buffer. */
+static int publish_batch_append(struct mqtt_client *client,
+				const struct mqtt_publish_param *param)
+{
+	uint8_t *batch_end = client->tx_buf + client->internal.tx_batch_len;
+	uint8_t *buf_end = client->tx_buf + client->tx_buf_size;
+	struct buf_ctx packet = {
+		.cur = batch_end,
+		.end = buf_end,
+	};
+	size_t free_len = client->tx_buf_size - client->internal.tx_batch_len;
+	size_t max_len;
+	uint32_t header_len;
+	int err_code;
+
+	/* publish_encode() reserves the maximum fixed header size and moves
+	 * past the payload without checking, so the whole message must fit
+	 * before it is encoded.
+	 */
+	max_len = MQTT_FIXED_HEADER_MAX_SIZE + sizeof(uint16_t) +
+		  param->message.topic.topic.size;
+	if (param->message.topic.qos != MQTT_QOS_0_AT_MOST_ONCE) {
+		max_len += sizeof(uint16_t);
+	}
+
+	if (max_len > free_len ||
+	    param->message.payload.len > free_len - max_len) {
+		return -ENOMEM;
+	}
+
+	err_code = publish_encode(param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	/* The fixed header is encoded right before the variable header, so
+	 * there is a gap after the previous message if it is shorter than
+	 * its maximum size.
+	 */
+	header_len = packet.end - packet.cur;
+	memmove(batch_end, packet.cur, header_len);
+	memcpy(batch_end + header_len, param->message.payload.data,
+	       param->message.payload.len);
+
+	client->internal.tx_batch_len += header_len + param->message.payload.len;
+
+	return 0;
+}
+
+/** @brief Queue a publish message, -ENOMEM if it does not fit in the tx buffer
+ *         even on its own.
+ */
+static int publish_batch_queue(struct mqtt_client *client,
+			       const struct mqtt_publish_param *param)
+{
+	int err_code;
+
+	err_code = publish_batch_append(client, param);
+	if (err_code != -ENOMEM || client->internal.tx_batch_len == 0U) {
+		return err_code;
+	}
+
+	/* Send the queued messages to make room for this one. */
+	err_code = publish_batch_flush(client);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	return publish_batch_append(client, param);
+}
+#endif /* CONFIG_MQTT_LIB_PUBLISH_PIPELINE */
+
 void mqtt_client_init(struct mqtt_client *client)
 {
 	NULL_PARAM_CHECK_VOID(client);
@@ -243,6 +346,9 @@ int mqtt_publish(struct mqtt_client *client,
 	struct buf_ctx packet;
 	struct iovec io_vector[2];
 	struct msghdr msg;
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+	int inflight = -ENOENT;
+#endif
 
 	NULL_PARAM_CHECK(client);
 	NULL_PARAM_CHECK(param);
@@ -254,6 +360,30 @@ int mqtt_publish(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	if (param->message.topic.qos != MQTT_QOS_0_AT_MOST_ONCE) {
+		inflight = inflight_find(client, param);
+		if (inflight < 0) {
+			err_code = inflight;
+			goto error;
+		}
+	}
+
+	err_code = publish_batch_queue(client, param);
+	if (err_code != -ENOMEM) {
+		goto sent;
+	}
+
+	/* Too big for the tx buffer, the payload is sent from the
+	 * application buffer.
+	 */
+#endif
+
 	tx_buf_init(client, &packet);
 
 	err_code = verify_tx_state(client);
@@ -278,6 +408,13 @@ int mqtt_publish(struct mqtt_client *client,
 
 	err_code = client_write_msg(client, &msg);
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+sent:
+	if (err_code == 0 && inflight >= 0) {
+		inflight_add(client, inflight, param);
+	}
+#endif
+
 error:
 	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
 			 client, client->internal.state, err_code);
@@ -601,6 +738,14 @@ int mqtt_live(struct mqtt_client *client)
 
 	mqtt_mutex_lock(client);
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+	err_code = publish_batch_flush(client);
+	if (err_code < 0) {
+		mqtt_mutex_unlock(client);
+		return err_code;
+	}
+#endif
+
 	elapsed_time = mqtt_elapsed_time_in_ms_get(
 				client->internal.last_activity);
 	if ((client->keepalive > 0) &&
@@ -618,12 +763,51 @@ int mqtt_live(struct mqtt_client *client)
 	}
 }
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+int mqtt_publish_flush(struct mqtt_client *client)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	err_code = publish_batch_flush(client);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
+int mqtt_publish_in_flight(struct mqtt_client *client)
+{
+	int count;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	count = client->internal.inflight_count;
+
+	mqtt_mutex_unlock(client);
+
+	return count;
+}
+#endif /* CONFIG_MQTT_LIB_PUBLISH_PIPELINE */
+
 int mqtt_keepalive_time_left(const struct mqtt_client *client)
 {
 	uint32_t elapsed_time = mqtt_elapsed_time_in_ms_get(
 					client->internal.last_activity);
 	uint32_t keepalive_ms = 1000U * client->keepalive;
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+	if (client->internal.tx_batch_len > 0U) {
+		/* Have mqtt_live() send the queued messages. */
+		return 0;
+	}
+#endif
+
 	if (client->keepalive == 0) {
 		/* Keep alive not enabled. */
 		return -1;
@@ -646,6 +830,10 @@ int mqtt_input(struct mqtt_client *client)
 
 	NET_DBG("state:0x%08x", client->internal.state);
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+	(void)publish_batch_flush(client);
+#endif
+
 	if (MQTT_HAS_STATE(client, MQTT_STATE_TCP_CONNECTED)) {
 		err_code = client_read(client);
 	} else {
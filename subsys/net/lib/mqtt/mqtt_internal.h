@@ -393,6 +393,53 @@ int subscribe_ack_decode(struct buf_ctx *buf,
 int unsubscribe_ack_decode(struct buf_ctx *buf,
 			   struct mqtt_unsuback_param *param);
 
+#if defined(CONFIG_MQTT_LIB_PUBLISH_PIPELINE)
+/**@brief Find the in-flight table entry for a QoS 1 or QoS 2 message.
+ *
+ * @param[in] client Client instance publishing the message.
+ * @param[in] param Parameters of the message.
+ *
+ * @return Index of the entry to track the message with, -EAGAIN if the
+ *         table is full or -EBUSY if the message id is in use.
+ */
+int inflight_find(struct mqtt_client *client,
+		  const struct mqtt_publish_param *param);
+
+/**@brief Track a message sent or queued for sending until it is
+ *        acknowledged.
+ *
+ * @param[in] client Client instance that published the message.
+ * @param[in] index Entry returned by @ref inflight_find.
+ * @param[in] param Parameters of the message.
+ */
+void inflight_add(struct mqtt_client *client, int index,
+		  const struct mqtt_publish_param *param);
+
+/**@brief Update the in-flight table with a PUBACK, PUBREC or PUBCOMP.
+ *
+ * @param[in] client Client instance that received the packet.
+ * @param[in] type Type of the packet.
+ * @param[in] message_id Message id in the packet.
+ */
+void inflight_ack(struct mqtt_client *client, uint8_t type,
+		  uint16_t message_id);
+
+/**@brief Forget all the messages in flight.
+ *
+ * @param[in] client Client instance for which the connection was closed.
+ */
+void inflight_reset(struct mqtt_client *client);
+#else
+static inline void inflight_ack(struct mqtt_client *client, uint8_t type,
+				uint16_t message_id)
+{
+}
+
+static inline void inflight_reset(struct mqtt_client *client)
+{
+}
+#endif /* CONFIG_MQTT_LIB_PUBLISH_PIPELINE */
+
 #ifdef __cplusplus
 }
 #endif
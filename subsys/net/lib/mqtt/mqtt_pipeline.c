@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file mqtt_pipeline.c
+ *
+ * @brief Tracking of the QoS 1 and QoS 2 messages in flight.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_mqtt_pipeline, CONFIG_MQTT_LOG_LEVEL);
+
+#include "mqtt_internal.h"
+#include "mqtt_os.h"
+
+int inflight_find(struct mqtt_client *client,
+		  const struct mqtt_publish_param *param)
+{
+	struct mqtt_internal *internal = &client->internal;
+	int free_index = -EAGAIN;
+
+	for (int i = 0; i < ARRAY_SIZE(internal->inflight); i++) {
+		const struct mqtt_inflight *entry = &internal->inflight[i];
+
+		if (entry->expected == 0U) {
+			if (free_index < 0) {
+				free_index = i;
+			}
+
+			continue;
+		}
+
+		if (entry->message_id == param->message_id) {
+			/* A retransmission replaces the original message. */
+			return param->dup_flag ? i : -EBUSY;
+		}
+	}
+
+	return free_index;
+}
+
+void inflight_add(struct mqtt_client *client, int index,
+		  const struct mqtt_publish_param *param)
+{
+	struct mqtt_inflight *entry = &client->internal.inflight[index];
+
+	if (entry->expected == 0U) {
+		client->internal.inflight_count++;
+	}
+
+	entry->message_id = param->message_id;
+	entry->expected = (param->message.topic.qos == MQTT_QOS_1_AT_LEAST_ONCE) ?
+			  MQTT_PKT_TYPE_PUBACK : MQTT_PKT_TYPE_PUBREC;
+}
+
+void inflight_ack(struct mqtt_client *client, uint8_t type,
+		  uint16_t message_id)
+{
+	struct mqtt_internal *internal = &client->internal;
+
+	ARRAY_FOR_EACH_PTR(internal->inflight, entry) {
+		if (entry->expected != type || entry->message_id != message_id) {
+			continue;
+		}
+
+		if (type == MQTT_PKT_TYPE_PUBREC) {
+			entry->expected = MQTT_PKT_TYPE_PUBCOMP;
+		} else {
+			entry->expected = 0U;
+			internal->inflight_count--;
+		}
+
+		return;
+	}
+
+	NET_DBG("[CID %p]: No message 0x%04x waiting for 0x%02x", client,
+		message_id, type);
+}
+
+void inflight_reset(struct mqtt_client *client)
+{
+	memset(client->internal.inflight, 0, sizeof(client->internal.inflight));
+	client->internal.inflight_count = 0U;
+}
@@ -8,9 +8,13 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(net_shell);
 
+#include <stdlib.h>
+#include <zephyr/net/net_route_ipv4.h>
+
 #include "net_shell_private.h"
 
 #include "../ip/route.h"
+#include "../ip/ipv4.h"
 
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 static void route_cb(struct net_route_entry *entry, void *user_data)
@@ -87,6 +91,60 @@ static void iface_per_route_cb(struct net_if *iface, void *user_data)
 }
 #endif /* CONFIG_NET_ROUTE */
 
+#if defined(CONFIG_NET_ROUTE_IPV4) && defined(CONFIG_NET_NATIVE)
+static void route_ipv4_cb(struct net_route_entry_ipv4 *entry, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *sh = data->sh;
+	struct net_if *iface = data->user_data;
+
+	if (entry->iface != iface) {
+		return;
+	}
+
+	PR("IPv4 prefix : %s/%d\t", net_sprint_ipv4_addr(&entry->addr),
+	   entry->prefix_len);
+
+	if (net_ipv4_is_addr_unspecified(&entry->gw)) {
+		PR("gateway : <on-link>\n");
+	} else {
+		PR("gateway : %s\n", net_sprint_ipv4_addr(&entry->gw));
+	}
+}
+
+static void iface_per_route_ipv4_cb(struct net_if *iface, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *sh = data->sh;
+	const char *extra;
+
+	PR("\nIPv4 routes for interface %d (%p) (%s)\n",
+	   net_if_get_by_iface(iface), iface,
+	   iface2str(iface, &extra));
+	PR("=========================================%s\n", extra);
+
+	data->user_data = iface;
+
+	net_route_ipv4_foreach(route_ipv4_cb, data);
+}
+#endif /* CONFIG_NET_ROUTE_IPV4 */
+
+#if defined(CONFIG_NET_IPV4_NAT)
+static void nat_cb(struct net_ipv4_nat_entry *entry, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *sh = data->sh;
+	uint32_t now = k_uptime_get_32();
+
+	PR("%-5s %15s:%-5u %15s:%-5u %15s:%-5u %u sec\n",
+	   net_proto2str(AF_INET, entry->proto),
+	   net_sprint_ipv4_addr(&entry->inside_addr), ntohs(entry->inside_port),
+	   net_sprint_ipv4_addr(&entry->outside_addr), ntohs(entry->outside_port),
+	   net_sprint_ipv4_addr(&entry->remote_addr), ntohs(entry->remote_port),
+	   net_timeout_remaining(&entry->timeout, now));
+}
+#endif /* CONFIG_NET_IPV4_NAT */
+
 #if defined(CONFIG_NET_ROUTE_MCAST) && defined(CONFIG_NET_NATIVE)
 static void route_mcast_cb(struct net_route_entry_mcast *entry,
 			   void *user_data)
@@ -202,17 +260,167 @@ static int cmd_net_ip6_route_del(const struct shell *sh, size_t argc, char *argv
 	return 0;
 }
 
+#if defined(CONFIG_NET_ROUTE_IPV4) && defined(CONFIG_NET_NATIVE)
+/* Parse <address>[/<prefix length>], a host route if there is no length */
+static int parse_ipv4_prefix(const struct shell *sh, char *str,
+			     struct in_addr *addr, uint8_t *prefix_len)
+{
+	char *slash = strchr(str, '/');
+	char *endptr;
+	long len = 32;
+
+	if (slash != NULL) {
+		*slash = '\0';
+		len = strtol(slash + 1, &endptr, 10);
+		if (*endptr != '\0' || endptr == slash + 1 || len < 0 || len > 32) {
+			PR_ERROR("Invalid prefix length: %s\n", slash + 1);
+			return -EINVAL;
+		}
+	}
+
+	if (net_addr_pton(AF_INET, str, addr)) {
+		PR_ERROR("Invalid address: %s\n", str);
+		return -EINVAL;
+	}
+
+	*prefix_len = len;
+
+	return 0;
+}
+
+static struct net_if *route_iface(const struct shell *sh, char *index_str)
+{
+	struct net_if *iface;
+	int idx;
+
+	idx = get_iface_idx(sh, index_str);
+	if (idx < 0) {
+		return NULL;
+	}
+
+	iface = net_if_get_by_index(idx);
+	if (!iface) {
+		PR_WARNING("No such interface in index %d\n", idx);
+	}
+
+	return iface;
+}
+
+static int cmd_net_ip4_route_add(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct net_if *iface;
+	struct in_addr prefix;
+	struct in_addr gw;
+	uint8_t prefix_len;
+
+	if (argc != 3 && argc != 4) {
+		PR_ERROR("Correct usage: net route add <index> "
+			 "<destination>[/<prefix len>] [<gateway>]\n");
+		return -EINVAL;
+	}
+
+	iface = route_iface(sh, argv[1]);
+	if (iface == NULL) {
+		return -ENOEXEC;
+	}
+
+	if (parse_ipv4_prefix(sh, argv[2], &prefix, &prefix_len) < 0) {
+		return -EINVAL;
+	}
+
+	if (argc == 4 && net_addr_pton(AF_INET, argv[3], &gw)) {
+		PR_ERROR("Invalid gateway: %s\n", argv[3]);
+		return -EINVAL;
+	}
+
+	if (net_route_ipv4_add(iface, &prefix, prefix_len,
+			       argc == 4 ? &gw : NULL) == NULL) {
+		PR_ERROR("Failed to add route\n");
+		return -ENOEXEC;
+	}
+
+	return 0;
+}
+
+static int cmd_net_ip4_route_del(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct net_if *iface;
+	struct in_addr prefix;
+	uint8_t prefix_len;
+
+	if (argc != 3) {
+		PR_ERROR("Correct usage: net route del <index> "
+			 "<destination>[/<prefix len>]\n");
+		return -EINVAL;
+	}
+
+	iface = route_iface(sh, argv[1]);
+	if (iface == NULL) {
+		return -ENOEXEC;
+	}
+
+	if (parse_ipv4_prefix(sh, argv[2], &prefix, &prefix_len) < 0) {
+		return -EINVAL;
+	}
+
+	if (net_route_ipv4_del_prefix(iface, &prefix, prefix_len) < 0) {
+		PR_WARNING("No route to %s/%u\n", argv[2], prefix_len);
+		return -ENOEXEC;
+	}
+
+	return 0;
+}
+#else
+static int cmd_net_ip4_route_add(const struct shell *sh, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s and %s to enable native %s routes.\n",
+		"CONFIG_NET_NATIVE", "CONFIG_NET_ROUTE_IPV4", "IPv4");
+	return 0;
+}
+
+static int cmd_net_ip4_route_del(const struct shell *sh, size_t argc, char *argv[])
+{
+	return cmd_net_ip4_route_add(sh, argc, argv);
+}
+#endif /* CONFIG_NET_ROUTE_IPV4 */
+
+/* IPv6 destinations contain a colon, the IPv4 ones do not */
+static bool is_ipv4_destination(size_t argc, char *argv[])
+{
+	return argc > 2 && strchr(argv[2], ':') == NULL;
+}
+
+static int cmd_net_route_add(const struct shell *sh, size_t argc, char *argv[])
+{
+	if (is_ipv4_destination(argc, argv)) {
+		return cmd_net_ip4_route_add(sh, argc, argv);
+	}
+
+	return cmd_net_ip6_route_add(sh, argc, argv);
+}
+
+static int cmd_net_route_del(const struct shell *sh, size_t argc, char *argv[])
+{
+	if (is_ipv4_destination(argc, argv)) {
+		return cmd_net_ip4_route_del(sh, argc, argv);
+	}
+
+	return cmd_net_ip6_route_del(sh, argc, argv);
+}
+
 static int cmd_net_route(const struct shell *sh, size_t argc, char *argv[])
 {
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
 
 #if defined(CONFIG_NET_NATIVE)
-#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST)
+#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST) || \
+	defined(CONFIG_NET_ROUTE_IPV4)
 	struct net_shell_user_data user_data;
-#endif
 
-#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST)
 	user_data.sh = sh;
 #endif
 
@@ -223,6 +431,19 @@ static int cmd_net_route(const struct shell *sh, size_t argc, char *argv[])
 		"network route");
 #endif
 
+#if defined(CONFIG_NET_ROUTE_IPV4)
+	net_if_foreach(iface_per_route_ipv4_cb, &user_data);
+#endif
+
+#if defined(CONFIG_NET_IPV4_NAT)
+	PR("\nIPv4 NAT translations\n");
+	PR("%-5s %21s %21s %21s %s\n", "Proto", "Inside", "Outside", "Remote",
+	   "Timeout");
+	if (net_ipv4_nat_foreach(nat_cb, &user_data) == 0) {
+		PR("<none>\n");
+	}
+#endif
+
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	net_route_mcast_foreach(route_mcast_cb, NULL, &user_data);
 #endif
@@ -233,12 +454,17 @@ static int cmd_net_route(const struct shell *sh, size_t argc, char *argv[])
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_route,
 	SHELL_CMD(add, NULL,
 		  "'net route add <index> <destination> <gateway>'"
-		  " adds the route to the destination.",
-		  cmd_net_ip6_route_add),
+		  " adds the IPv6 route to the destination.\n"
+		  "'net route add <index> <destination>[/<prefix len>] [<gateway>]'"
+		  " adds the IPv4 route to the destination, on-link if there"
+		  " is no gateway.",
+		  cmd_net_route_add),
 	SHELL_CMD(del, NULL,
 		  "'net route del <index> <destination>'"
-		  " deletes the route to the destination.",
-		  cmd_net_ip6_route_del),
+		  " deletes the IPv6 route to the destination.\n"
+		  "'net route del <index> <destination>[/<prefix len>]'"
+		  " deletes the IPv4 route to the destination.",
+		  cmd_net_route_del),
 	SHELL_SUBCMD_SET_END
 );
 
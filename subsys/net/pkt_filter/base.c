@@ -69,6 +69,439 @@ static struct npf_rule_list *get_ip_rules(uint8_t pf)
 	return NULL;
 }
 
+#ifdef CONFIG_NET_PKT_FILTER_COMPILE
+/*
+ * Rule compilation
+ *
+ * Each rule list is compiled into a program after every change. The
+ * consecutive rules that all have an equality test on the same packet field
+ * are grouped under a switch on that field. The rules of a group are sorted
+ * by value, which keeps their relative order for a given value: the rules
+ * testing different values cannot both match the same packet. A packet then
+ * jumps to the rules of its value and skips the others.
+ *
+ * Changes of the rule lists are serialized, and the compilation runs outside
+ * of the list lock. The list falls back to the rule walk from the change
+ * until the new program is swapped in.
+ */
+
+enum npf_op {
+	NPF_OP_TEST,
+	NPF_OP_SWITCH,
+	NPF_OP_CASE,
+	NPF_OP_JUMP,
+	NPF_OP_RESULT,
+};
+
+enum npf_key {
+	NPF_KEY_IFACE,
+	NPF_KEY_ORIG_IFACE,
+	NPF_KEY_ETH_TYPE,
+	NPF_KEY_COUNT,
+};
+
+/* Instructions are only counted while prog is NULL */
+struct npf_compiler {
+	struct npf_insn *prog;
+	uint16_t len;
+	bool overflow;
+};
+
+/* Rules being compiled, a rule needs at least one instruction */
+static struct npf_rule *npf_scratch[CONFIG_NET_PKT_FILTER_PROG_SIZE];
+static K_MUTEX_DEFINE(npf_update_lock);
+static K_HEAP_DEFINE(npf_prog_heap, CONFIG_NET_PKT_FILTER_PROG_HEAP_SIZE);
+
+static bool npf_test_key(struct npf_test *test, enum npf_key key,
+			 uintptr_t *value)
+{
+	if (key == NPF_KEY_IFACE && test->fn == npf_iface_match) {
+		*value = (uintptr_t)CONTAINER_OF(test, struct npf_test_iface,
+						 test)->iface;
+		return true;
+	}
+
+	if (key == NPF_KEY_ORIG_IFACE && test->fn == npf_orig_iface_match) {
+		*value = (uintptr_t)CONTAINER_OF(test, struct npf_test_iface,
+						 test)->iface;
+		return true;
+	}
+
+#ifdef CONFIG_NET_L2_ETHERNET
+	if (key == NPF_KEY_ETH_TYPE && test->fn == npf_eth_type_match) {
+		*value = CONTAINER_OF(test, struct npf_test_eth_type,
+				      test)->type;
+		return true;
+	}
+#endif
+
+	return false;
+}
+
+/* Index of the first test of a rule on the given field, -1 if none */
+static int npf_rule_key(struct npf_rule *rule, enum npf_key key,
+			uintptr_t *value)
+{
+	for (uint32_t i = 0; i < rule->nb_tests; i++) {
+		if (npf_test_key(rule->tests[i], key, value)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static uintptr_t npf_pkt_key(struct net_pkt *pkt, enum npf_key key)
+{
+	switch (key) {
+	case NPF_KEY_IFACE:
+		return (uintptr_t)net_pkt_iface(pkt);
+	case NPF_KEY_ORIG_IFACE:
+		return (uintptr_t)net_pkt_orig_iface(pkt);
+#ifdef CONFIG_NET_L2_ETHERNET
+	case NPF_KEY_ETH_TYPE:
+		return NET_ETH_HDR(pkt)->type;
+#endif
+	default:
+		return 0;
+	}
+}
+
+static struct npf_insn *npf_at(struct npf_compiler *c, uint16_t index)
+{
+	static struct npf_insn discard;
+
+	return c->prog != NULL && index < c->len ? &c->prog[index] : &discard;
+}
+
+static uint16_t npf_emit(struct npf_compiler *c, enum npf_op op)
+{
+	uint16_t index = c->len;
+
+	if (c->len < CONFIG_NET_PKT_FILTER_PROG_SIZE) {
+		c->len++;
+		npf_at(c, index)->op = op;
+	} else {
+		c->overflow = true;
+	}
+
+	return index;
+}
+
+static void npf_compile_rules(struct npf_compiler *c, struct npf_rule **rules,
+			      size_t count, uint32_t keys);
+
+/* The tests on the fields already switched on are known to be true */
+static void npf_compile_rule(struct npf_compiler *c, struct npf_rule *rule,
+			     uint32_t keys)
+{
+	uint16_t start = c->len;
+	uint16_t end;
+
+	for (uint32_t i = 0; i < rule->nb_tests; i++) {
+		bool known = false;
+		uintptr_t value;
+
+		for (int key = 0; key < NPF_KEY_COUNT; key++) {
+			if ((keys & BIT(key)) != 0U &&
+			    npf_rule_key(rule, key, &value) == (int)i) {
+				known = true;
+			}
+		}
+
+		if (!known) {
+			npf_at(c, npf_emit(c, NPF_OP_TEST))->test =
+				rule->tests[i];
+		}
+	}
+
+	npf_at(c, npf_emit(c, NPF_OP_RESULT))->result = rule->result;
+
+	/* A failed test continues with the next rule */
+	end = c->len;
+	for (uint16_t i = start; i < end - 1; i++) {
+		npf_at(c, i)->next = end;
+	}
+}
+
+static void npf_compile_switch(struct npf_compiler *c, struct npf_rule **rules,
+			       size_t count, uint32_t keys, enum npf_key key)
+{
+	uintptr_t values[2] = { 0 };
+	uint16_t cases = 0;
+	uint16_t first_case;
+	uint16_t sw;
+	uint16_t end;
+
+	/* Stable insertion sort by value */
+	for (size_t i = 1; i < count; i++) {
+		struct npf_rule *rule = rules[i];
+		size_t j = i;
+
+		(void)npf_rule_key(rule, key, &values[0]);
+
+		while (j > 0) {
+			(void)npf_rule_key(rules[j - 1], key, &values[1]);
+			if (values[1] <= values[0]) {
+				break;
+			}
+
+			rules[j] = rules[j - 1];
+			j--;
+		}
+
+		rules[j] = rule;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		(void)npf_rule_key(rules[i], key, &values[0]);
+		if (i == 0 || values[0] != values[1]) {
+			cases++;
+		}
+
+		values[1] = values[0];
+	}
+
+	sw = npf_emit(c, NPF_OP_SWITCH);
+	npf_at(c, sw)->key = key;
+	npf_at(c, sw)->count = cases;
+
+	first_case = c->len;
+	for (uint16_t i = 0; i < cases; i++) {
+		(void)npf_emit(c, NPF_OP_CASE);
+	}
+
+	for (size_t i = 0, group = 0; i < count; group++) {
+		struct npf_insn *insn = npf_at(c, first_case + group);
+		size_t n = 1;
+
+		(void)npf_rule_key(rules[i], key, &values[0]);
+
+		while (i + n < count) {
+			(void)npf_rule_key(rules[i + n], key, &values[1]);
+			if (values[1] != values[0]) {
+				break;
+			}
+
+			n++;
+		}
+
+		/* The previous group jumps over this one */
+		if (group > 0) {
+			(void)npf_emit(c, NPF_OP_JUMP);
+		}
+
+		insn->value = values[0];
+		insn->next = c->len;
+
+		npf_compile_rules(c, &rules[i], n, keys | BIT(key));
+		i += n;
+	}
+
+	end = c->len;
+	npf_at(c, sw)->next = end;
+
+	for (uint16_t i = 1; i < cases; i++) {
+		npf_at(c, npf_at(c, first_case + i)->next - 1)->next = end;
+	}
+}
+
+/* Number of rules from the first one with a test on the same field */
+static size_t npf_longest_run(struct npf_rule **rules, size_t count,
+			      uint32_t keys, enum npf_key *best)
+{
+	size_t longest = 0;
+
+	for (int key = 0; key < NPF_KEY_COUNT; key++) {
+		uintptr_t value;
+		size_t n = 0;
+
+		if ((keys & BIT(key)) != 0U) {
+			continue;
+		}
+
+		while (n < count && npf_rule_key(rules[n], key, &value) >= 0) {
+			n++;
+		}
+
+		if (n > longest) {
+			longest = n;
+			*best = key;
+		}
+	}
+
+	return longest;
+}
+
+static void npf_compile_rules(struct npf_compiler *c, struct npf_rule **rules,
+			      size_t count, uint32_t keys)
+{
+	size_t i = 0;
+
+	while (i < count && !c->overflow) {
+		enum npf_key key;
+		size_t n = npf_longest_run(&rules[i], count - i, keys, &key);
+
+		if (n > 1) {
+			npf_compile_switch(c, &rules[i], n, keys, key);
+			i += n;
+		} else {
+			npf_compile_rule(c, rules[i], keys);
+			i++;
+		}
+	}
+}
+
+static void npf_compile_pass(struct npf_compiler *c, size_t count)
+{
+	npf_compile_rules(c, npf_scratch, count, 0);
+
+	/* No matching rule */
+	npf_at(c, npf_emit(c, NPF_OP_RESULT))->result = NET_DROP;
+}
+
+/* Called with the updates of the rule lists serialized */
+static void npf_compile(struct npf_rule_list *rules)
+{
+	struct npf_compiler c = { 0 };
+	struct npf_rule *rule;
+	k_spinlock_key_t key;
+	size_t count = 0;
+
+	key = k_spin_lock(&rules->lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&rules->rule_head, rule, node) {
+		if (count == ARRAY_SIZE(npf_scratch)) {
+			c.overflow = true;
+			break;
+		}
+
+		npf_scratch[count++] = rule;
+	}
+
+	k_spin_unlock(&rules->lock, key);
+
+	if (count == 0) {
+		return;
+	}
+
+	/* Count the instructions first, the program is allocated to fit.
+	 * The second pass finds the rules sorted by the first one and emits
+	 * the same instructions.
+	 */
+	if (!c.overflow) {
+		npf_compile_pass(&c, count);
+	}
+
+	if (c.overflow) {
+		NET_DBG("rules %p too many to compile", rules);
+		return;
+	}
+
+	c.prog = k_heap_alloc(&npf_prog_heap, c.len * sizeof(struct npf_insn),
+			      K_NO_WAIT);
+	if (c.prog == NULL) {
+		NET_DBG("rules %p no memory for %u instructions", rules, c.len);
+		return;
+	}
+
+	c.len = 0;
+	npf_compile_pass(&c, count);
+
+	key = k_spin_lock(&rules->lock);
+	rules->prog = c.prog;
+	rules->prog_len = c.len;
+	k_spin_unlock(&rules->lock, key);
+
+	NET_DBG("rules %p compiled to %u instructions", rules, c.len);
+}
+
+static void npf_update_begin(void)
+{
+	(void)k_mutex_lock(&npf_update_lock, K_FOREVER);
+}
+
+/* Called with the rule list locked, the program is released by
+ * npf_update_end() once the list is unlocked.
+ */
+static struct npf_insn *npf_invalidate(struct npf_rule_list *rules)
+{
+	struct npf_insn *prog = rules->prog;
+
+	rules->prog = NULL;
+	rules->prog_len = 0;
+
+	return prog;
+}
+
+static void npf_update_end(struct npf_rule_list *rules, struct npf_insn *prog)
+{
+	if (prog != NULL) {
+		k_heap_free(&npf_prog_heap, prog);
+	}
+
+	npf_compile(rules);
+
+	(void)k_mutex_unlock(&npf_update_lock);
+}
+
+/* Binary search of the cases following a switch, sorted by value */
+static uint16_t npf_switch(const struct npf_insn *sw, uintptr_t value)
+{
+	const struct npf_insn *cases = sw + 1;
+	uint16_t low = 0;
+	uint16_t high = sw->count;
+
+	while (low < high) {
+		uint16_t mid = low + (high - low) / 2U;
+
+		if (cases[mid].value == value) {
+			return cases[mid].next;
+		}
+
+		if (cases[mid].value < value) {
+			low = mid + 1U;
+		} else {
+			high = mid;
+		}
+	}
+
+	return sw->next;
+}
+
+static enum net_verdict npf_run(const struct npf_insn *prog,
+				struct net_pkt *pkt)
+{
+	uint16_t pc = 0;
+
+	while (true) {
+		const struct npf_insn *insn = &prog[pc];
+
+		switch (insn->op) {
+		case NPF_OP_TEST:
+			pc = insn->test->fn(insn->test, pkt) ? pc + 1U :
+							       insn->next;
+			break;
+		case NPF_OP_SWITCH:
+			pc = npf_switch(insn, npf_pkt_key(pkt, insn->key));
+			break;
+		case NPF_OP_JUMP:
+			pc = insn->next;
+			break;
+		case NPF_OP_RESULT:
+			return insn->result;
+		default:
+			__ASSERT(false, "Invalid instruction %u", insn->op);
+			return NET_DROP;
+		}
+	}
+}
+#else
+#define npf_update_begin()
+#define npf_invalidate(rules) NULL
+#define npf_update_end(rules, prog) ARG_UNUSED(prog)
+#endif /* CONFIG_NET_PKT_FILTER_COMPILE */
+
 /*
  * Rule application
  */
@@ -98,8 +531,9 @@ static bool apply_tests(struct npf_rule *rule, struct net_pkt *pkt)
 /*
  * We return the specified result for the first rule whose tests are all true.
  */
-static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
+static enum net_verdict evaluate(struct npf_rule_list *rules, struct net_pkt *pkt)
 {
+	sys_slist_t *rule_head = &rules->rule_head;
 	struct npf_rule *rule;
 
 	NET_DBG("rule_head %p on pkt %p", rule_head, pkt);
@@ -109,6 +543,12 @@ static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
 		return NET_OK;
 	}
 
+#ifdef CONFIG_NET_PKT_FILTER_COMPILE
+	if (rules->prog != NULL) {
+		return npf_run(rules->prog, pkt);
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(rule_head, rule, node) {
 		if (apply_tests(rule, pkt) == true) {
 			return rule->result;
@@ -122,7 +562,7 @@ static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
 static enum net_verdict lock_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt)
 {
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
-	enum net_verdict result = evaluate(&rules->rule_head, pkt);
+	enum net_verdict result = evaluate(rules, pkt);
 
 	k_spin_unlock(&rules->lock, key);
 	return result;
@@ -173,12 +613,18 @@ bool net_pkt_filter_ip_recv_ok(struct net_pkt *pkt)
 
 void npf_insert_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 {
-	k_spinlock_key_t key = k_spin_lock(&rules->lock);
+	struct npf_insn *prog;
+	k_spinlock_key_t key;
+
+	npf_update_begin();
+	key = k_spin_lock(&rules->lock);
 
 	NET_DBG("inserting rule %p into %p", rule, rules);
 	sys_slist_prepend(&rules->rule_head, &rule->node);
+	prog = npf_invalidate(rules);
 
 	k_spin_unlock(&rules->lock, key);
+	npf_update_end(rules, prog);
 }
 
 void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
@@ -186,35 +632,58 @@ void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 	__ASSERT(sys_slist_peek_tail(&rules->rule_head) != &npf_default_ok.node, "");
 	__ASSERT(sys_slist_peek_tail(&rules->rule_head) != &npf_default_drop.node, "");
 
-	k_spinlock_key_t key = k_spin_lock(&rules->lock);
+	struct npf_insn *prog;
+	k_spinlock_key_t key;
+
+	npf_update_begin();
+	key = k_spin_lock(&rules->lock);
 
 	NET_DBG("appending rule %p into %p", rule, rules);
 	sys_slist_append(&rules->rule_head, &rule->node);
+	prog = npf_invalidate(rules);
 
 	k_spin_unlock(&rules->lock, key);
+	npf_update_end(rules, prog);
 }
 
 bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 {
-	k_spinlock_key_t key = k_spin_lock(&rules->lock);
-	bool result = sys_slist_find_and_remove(&rules->rule_head, &rule->node);
+	struct npf_insn *prog = NULL;
+	k_spinlock_key_t key;
+	bool result;
+
+	npf_update_begin();
+	key = k_spin_lock(&rules->lock);
+	result = sys_slist_find_and_remove(&rules->rule_head, &rule->node);
+
+	if (result) {
+		prog = npf_invalidate(rules);
+	}
 
 	k_spin_unlock(&rules->lock, key);
+	npf_update_end(rules, prog);
 	NET_DBG("removing rule %p from %p: %d", rule, rules, result);
 	return result;
 }
 
 bool npf_remove_all_rules(struct npf_rule_list *rules)
 {
-	k_spinlock_key_t key = k_spin_lock(&rules->lock);
-	bool result = !sys_slist_is_empty(&rules->rule_head);
+	struct npf_insn *prog = NULL;
+	k_spinlock_key_t key;
+	bool result;
+
+	npf_update_begin();
+	key = k_spin_lock(&rules->lock);
+	result = !sys_slist_is_empty(&rules->rule_head);
 
 	if (result) {
 		sys_slist_init(&rules->rule_head);
+		prog = npf_invalidate(rules);
 		NET_DBG("removing all rules from %p", rules);
 	}
 
 	k_spin_unlock(&rules->lock, key);
+	npf_update_end(rules, prog);
 	return result;
 }
 
@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/profiling/perf.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_PROFILING_PERF_TRACING
+#include <zephyr/tracing/tracing_format.h>
+#endif
+
+/*
+ * Layout of a frame record, relative to the frame pointer. On RISC-V the
+ * frame pointer points past the saved return address and frame pointer,
+ * on the other supported architectures it points at the saved frame
+ * pointer, which is directly followed by the return address.
+ */
+#if defined(CONFIG_RISCV)
+#define PERF_FRAME_RECORD(fp) ((uintptr_t *)(fp) - 2)
+#define PERF_FRAME_NEXT_FP(fp) (((uintptr_t *)(fp))[-2])
+#define PERF_FRAME_RA(fp) (((uintptr_t *)(fp))[-1])
+#else
+#define PERF_FRAME_RECORD(fp) ((uintptr_t *)(fp))
+#define PERF_FRAME_NEXT_FP(fp) (((uintptr_t *)(fp))[0])
+#define PERF_FRAME_RA(fp) (((uintptr_t *)(fp))[1])
+#endif
+
+/*
+ * Host thread stacks used by the POSIX architecture are not described by
+ * the thread stack info, so frames are only required to be increasing and
+ * no further apart than this.
+ */
+#define PERF_POSIX_MAX_FRAME_SIZE 0x10000
+
+static uintptr_t perf_buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
+static size_t perf_buf_used;
+static uint32_t perf_dropped;
+static bool perf_running;
+static struct k_spinlock perf_lock;
+
+static void perf_sample(struct k_timer *timer);
+
+static K_TIMER_DEFINE(perf_timer, perf_sample, NULL);
+
+#if defined(CONFIG_X86) && !defined(CONFIG_X86_64)
+static bool perf_on_irq_stack(uintptr_t addr)
+{
+	uintptr_t irq_stack_top = (uintptr_t)_current_cpu->irq_stack;
+
+	return (addr < irq_stack_top) && (addr >= (irq_stack_top - CONFIG_ISR_STACK_SIZE));
+}
+#endif
+
+#ifndef CONFIG_ARCH_POSIX
+static bool perf_on_stack(uintptr_t addr)
+{
+	const struct k_thread *thread = _current;
+
+	return (addr >= thread->stack_info.start) &&
+	       (addr < (thread->stack_info.start + thread->stack_info.size));
+}
+#endif
+
+static bool perf_frame_valid(uintptr_t fp, uintptr_t prev_fp)
+{
+	uintptr_t record = (uintptr_t)PERF_FRAME_RECORD(fp);
+
+	if ((fp == 0U) || ((fp & (sizeof(uintptr_t) - 1U)) != 0U) || (fp <= prev_fp)) {
+		return false;
+	}
+
+#ifdef CONFIG_ARCH_POSIX
+	ARG_UNUSED(record);
+
+	return (fp - prev_fp) < PERF_POSIX_MAX_FRAME_SIZE;
+#else
+	return perf_on_stack(record) && perf_on_stack(record + (2U * sizeof(uintptr_t)) - 1U);
+#endif
+}
+
+static size_t perf_frame_walk(uintptr_t fp, uintptr_t prev_fp, uintptr_t *frames,
+			      size_t depth, size_t max_depth)
+{
+	while ((depth < max_depth) && perf_frame_valid(fp, prev_fp)) {
+		uintptr_t ra = PERF_FRAME_RA(fp);
+
+		if (ra == 0U) {
+			break;
+		}
+
+		frames[depth++] = ra;
+		prev_fp = fp;
+		fp = PERF_FRAME_NEXT_FP(fp);
+	}
+
+	return depth;
+}
+
+#ifdef CONFIG_ARCH_POSIX
+/*
+ * Interrupts are handled on the stack of the interrupted thread, so the
+ * frame chain of the timer callback continues into the interrupted code.
+ * The frames of the interrupt handling are dropped by stackcollapse.py.
+ */
+static size_t perf_stack_walk(uintptr_t *frames, size_t max_depth)
+{
+	uintptr_t fp = (uintptr_t)__builtin_frame_address(0);
+
+	return perf_frame_walk(fp, fp - 1U, frames, 0, max_depth);
+}
+#else
+/*
+ * Walk the stack of the interrupted thread, starting from the program
+ * counter and frame pointer saved on interrupt entry. Samples of nested
+ * interrupts are skipped, as their saved state is not at a known place.
+ */
+static size_t perf_stack_walk(uintptr_t *frames, size_t max_depth)
+{
+	uintptr_t pc;
+	uintptr_t fp;
+	uintptr_t ra = 0U;
+	size_t depth = 0;
+
+	if (_current_cpu->nested != 1U) {
+		return 0;
+	}
+
+#if defined(CONFIG_RISCV) || defined(CONFIG_ARM64)
+	/*
+	 * The interrupt entry code saves the ESF on the thread stack and the
+	 * thread stack pointer at the top of the interrupt stack.
+	 */
+	const struct arch_esf *esf =
+		*(struct arch_esf **)((uintptr_t)_current_cpu->irq_stack - 16U);
+
+#if defined(CONFIG_RISCV)
+	pc = esf->mepc;
+	fp = esf->s0;
+	ra = esf->ra;
+
+	/*
+	 * Leaf functions only save the frame pointer of their caller, right
+	 * below their own frame pointer, and keep the return address in ra.
+	 */
+	if (perf_on_stack(fp - sizeof(uintptr_t)) &&
+	    perf_on_stack(((uintptr_t *)fp)[-1])) {
+		fp = ((uintptr_t *)fp)[-1];
+	}
+#else
+	pc = esf->elr;
+	fp = esf->fp;
+	ra = esf->lr;
+#endif
+#elif defined(CONFIG_X86_64)
+	/* The interrupt entry saves the state in the thread struct */
+	pc = _current->callee_saved.rip;
+	fp = _current->callee_saved.rbp;
+#else
+	/*
+	 * The interrupt entry pushes EDI, ECX, EDX and EAX below the EIP
+	 * pushed by the CPU, and saves the resulting thread stack pointer at
+	 * the top of the interrupt stack. EBP is left untouched, so the first
+	 * frame pointer of the interrupt handlers which is not on the
+	 * interrupt stack is the one of the interrupted code.
+	 */
+	pc = (*(uintptr_t **)((uintptr_t)_current_cpu->irq_stack - 4U))[4];
+	fp = (uintptr_t)__builtin_frame_address(0);
+	while ((fp != 0U) && perf_on_irq_stack(fp)) {
+		fp = PERF_FRAME_NEXT_FP(fp);
+	}
+#endif
+
+	frames[depth++] = pc;
+
+	/*
+	 * The return address register holds the caller of a leaf function,
+	 * or of any function interrupted in its prologue, whose frame record
+	 * has not been written. It may also hold a return address into the
+	 * interrupted function, which stackcollapse.py merges with the
+	 * program counter.
+	 */
+	if ((ra != 0U) && (depth < max_depth) &&
+	    !(perf_frame_valid(fp, 0U) && (PERF_FRAME_RA(fp) == ra))) {
+		frames[depth++] = ra;
+	}
+
+	return perf_frame_walk(fp, 0U, frames, depth, max_depth);
+}
+#endif
+
+static void perf_sample(struct k_timer *timer)
+{
+	uintptr_t frames[CONFIG_PROFILING_PERF_MAX_DEPTH];
+	k_spinlock_key_t key;
+	size_t depth;
+
+	ARG_UNUSED(timer);
+
+	depth = perf_stack_walk(frames, ARRAY_SIZE(frames));
+	if (depth == 0U) {
+		return;
+	}
+
+	key = k_spin_lock(&perf_lock);
+
+	if (!perf_running) {
+		k_spin_unlock(&perf_lock, key);
+		return;
+	}
+
+	if ((perf_buf_used + depth + 1U) > ARRAY_SIZE(perf_buf)) {
+		perf_dropped++;
+		k_spin_unlock(&perf_lock, key);
+		return;
+	}
+
+	perf_buf[perf_buf_used] = depth;
+	memcpy(&perf_buf[perf_buf_used + 1U], frames, depth * sizeof(uintptr_t));
+	perf_buf_used += depth + 1U;
+
+	k_spin_unlock(&perf_lock, key);
+}
+
+int perf_start(uint32_t frequency)
+{
+	k_spinlock_key_t key;
+	k_timeout_t period;
+
+	if ((frequency == 0U) || (frequency > CONFIG_SYS_CLOCK_TICKS_PER_SEC)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&perf_lock);
+
+	if (perf_running) {
+		k_spin_unlock(&perf_lock, key);
+		return -EALREADY;
+	}
+
+	perf_buf_used = 0;
+	perf_dropped = 0;
+	perf_running = true;
+
+	k_spin_unlock(&perf_lock, key);
+
+	period = K_TICKS(CONFIG_SYS_CLOCK_TICKS_PER_SEC / frequency);
+	k_timer_start(&perf_timer, period, period);
+
+	return 0;
+}
+
+int perf_stop(void)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&perf_lock);
+
+	if (!perf_running) {
+		k_spin_unlock(&perf_lock, key);
+		return -EALREADY;
+	}
+
+	perf_running = false;
+
+	k_spin_unlock(&perf_lock, key);
+
+	k_timer_stop(&perf_timer);
+
+	if (IS_ENABLED(CONFIG_PROFILING_PERF_TRACING)) {
+		(void)perf_trace_flush();
+	}
+
+	return 0;
+}
+
+bool perf_is_running(void)
+{
+	return perf_running;
+}
+
+size_t perf_buf_get(const uintptr_t **buf)
+{
+	*buf = perf_buf;
+
+	return perf_buf_used;
+}
+
+uint32_t perf_dropped_get(void)
+{
+	return perf_dropped;
+}
+
+int perf_trace_flush(void)
+{
+#ifdef CONFIG_PROFILING_PERF_TRACING
+	uint8_t record[sizeof(struct perf_record_hdr) +
+		       (CONFIG_PROFILING_PERF_MAX_DEPTH * sizeof(uintptr_t))];
+	struct perf_record_hdr hdr = {
+		.magic = PERF_RECORD_MAGIC,
+		.word_size = sizeof(uintptr_t),
+	};
+	size_t i = 0;
+
+	if (perf_running) {
+		return -EBUSY;
+	}
+
+	while (i < perf_buf_used) {
+		size_t depth = perf_buf[i];
+		size_t len = depth * sizeof(uintptr_t);
+
+		hdr.depth = (uint16_t)depth;
+		memcpy(record, &hdr, sizeof(hdr));
+		memcpy(&record[sizeof(hdr)], &perf_buf[i + 1U], len);
+		tracing_format_raw_data(record, sizeof(hdr) + len);
+
+		i += depth + 1U;
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
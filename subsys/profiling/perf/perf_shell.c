@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/profiling/perf.h>
+#include <zephyr/shell/shell.h>
+
+static const struct shell *perf_record_sh;
+
+static void perf_record_stop_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)perf_stop();
+
+	if (perf_record_sh != NULL) {
+		shell_print(perf_record_sh, "Sampling finished");
+		perf_record_sh = NULL;
+	}
+}
+
+static K_WORK_DELAYABLE_DEFINE(perf_record_work, perf_record_stop_handler);
+
+static int perf_frequency_parse(const struct shell *sh, size_t argc, char **argv,
+				size_t idx, uint32_t *frequency)
+{
+	int err = 0;
+
+	if (argc <= idx) {
+		*frequency = CONFIG_PROFILING_PERF_DEFAULT_FREQUENCY;
+		return 0;
+	}
+
+	*frequency = shell_strtoul(argv[idx], 10, &err);
+	if (err) {
+		shell_error(sh, "Unable to parse frequency (err %d)", err);
+	}
+
+	return err;
+}
+
+static int perf_start_report(const struct shell *sh, uint32_t frequency)
+{
+	int err = perf_start(frequency);
+
+	if (err == -EALREADY) {
+		shell_error(sh, "Sampling already running");
+	} else if (err) {
+		shell_error(sh, "Invalid frequency %u Hz (max %u Hz)", frequency,
+			    CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+	}
+
+	return err;
+}
+
+static int cmd_perf_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t frequency;
+	int err;
+
+	err = perf_frequency_parse(sh, argc, argv, 1, &frequency);
+	if (err) {
+		return err;
+	}
+
+	return perf_start_report(sh, frequency);
+}
+
+static int cmd_perf_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	(void)k_work_cancel_delayable(&perf_record_work);
+	perf_record_sh = NULL;
+
+	if (perf_stop() != 0) {
+		shell_error(sh, "Sampling not running");
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t duration;
+	uint32_t frequency;
+	int err = 0;
+
+	duration = shell_strtoul(argv[1], 10, &err);
+	if (err) {
+		shell_error(sh, "Unable to parse duration (err %d)", err);
+		return err;
+	}
+
+	err = perf_frequency_parse(sh, argc, argv, 2, &frequency);
+	if (err) {
+		return err;
+	}
+
+	err = perf_start_report(sh, frequency);
+	if (err) {
+		return err;
+	}
+
+	perf_record_sh = sh;
+	k_work_schedule(&perf_record_work, K_MSEC(duration));
+	shell_print(sh, "Sampling at %u Hz for %u ms", frequency, duration);
+
+	return 0;
+}
+
+static int cmd_perf_printbuf(const struct shell *sh, size_t argc, char **argv)
+{
+	const uintptr_t *buf;
+	size_t len;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (perf_is_running()) {
+		shell_error(sh, "Sampling running, stop it first");
+		return -EBUSY;
+	}
+
+	len = perf_buf_get(&buf);
+
+	shell_print(sh, "Perf buf length %zu, dropped %u", len, perf_dropped_get());
+
+	for (size_t i = 0; i < len; i++) {
+		shell_print(sh, "%0*lx", (int)(2 * sizeof(uintptr_t)), (unsigned long)buf[i]);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_PROFILING_PERF_TRACING
+static int cmd_perf_flush(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	err = perf_trace_flush();
+	if (err) {
+		shell_error(sh, "Unable to flush samples (err %d)", err);
+	}
+
+	return err;
+}
+#endif
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_perf,
+	SHELL_CMD_ARG(start, NULL, "[frequency (Hz)]", cmd_perf_start, 1, 1),
+	SHELL_CMD(stop, NULL, "Stop sampling.", cmd_perf_stop),
+	SHELL_CMD_ARG(record, NULL, "<duration (ms)> [frequency (Hz)]", cmd_perf_record, 2, 1),
+	SHELL_CMD(printbuf, NULL, "Print the sample buffer.", cmd_perf_printbuf),
+#ifdef CONFIG_PROFILING_PERF_TRACING
+	SHELL_CMD(flush, NULL, "Write the sample buffer to the tracing backend.",
+		  cmd_perf_flush),
+#endif
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(perf, &sub_perf, "Sampling profiler commands", NULL);
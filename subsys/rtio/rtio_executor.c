@@ -51,14 +51,35 @@ static inline void rtio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
 	iodev_sqe->sqe.iodev->api->submit(iodev_sqe);
 }
 
+/**
+ * @brief Pop the next entry of a chain or transaction
+ *
+ * With several producers the queue may look empty while another CPU is in
+ * the middle of pushing an entry. Entries are only pushed with sq_lock held,
+ * so once it is taken no push is in progress and the entry, queued together
+ * with the one it follows, can be popped.
+ */
+static inline struct mpsc_node *rtio_executor_pop_linked(struct rtio *r)
+{
+	struct mpsc_node *node = mpsc_pop(&r->sq);
+
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	if (node == NULL) {
+		K_SPINLOCK(&r->sq_lock) {
+			node = mpsc_pop(&r->sq);
+		}
+	}
+#endif
+
+	return node;
+}
+
 /**
  * @brief Submit operations in the queue to iodevs
  *
  * @param r RTIO context
- *
- * @retval 0 Always succeeds
  */
-void rtio_executor_submit(struct rtio *r)
+static void rtio_executor_drain(struct rtio *r)
 {
 	const uint16_t cancel_no_response = (RTIO_SQE_CANCELED | RTIO_SQE_NO_RESPONSE);
 	struct mpsc_node *node = mpsc_pop(&r->sq);
@@ -83,7 +104,7 @@ void rtio_executor_submit(struct rtio *r)
 			__ASSERT(transaction != chained,
 				    "Expected chained or transaction flag, not both");
 #endif
-			node = mpsc_pop(&iodev_sqe->r->sq);
+			node = rtio_executor_pop_linked(r);
 			next = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
 
 			/* If the current submission was cancelled before submit,
@@ -110,6 +131,32 @@ void rtio_executor_submit(struct rtio *r)
 	}
 }
 
+/**
+ * @brief Submit operations in the queue to iodevs
+ *
+ * @param r RTIO context
+ *
+ * @retval 0 Always succeeds
+ */
+void rtio_executor_submit(struct rtio *r)
+{
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+	/* The submission queue has a single consumer, so only the first caller
+	 * drains it. Callers arriving meanwhile, including completions resubmitting
+	 * multishot entries, leave their entries to it and make it go around again.
+	 */
+	if (atomic_inc(&r->submitters) != 0) {
+		return;
+	}
+
+	do {
+		rtio_executor_drain(r);
+	} while (atomic_dec(&r->submitters) != 1);
+#else
+	rtio_executor_drain(r);
+#endif
+}
+
 /**
  * @brief Handle common logic when :c:macro:`RTIO_SQE_MULTISHOT` is set
  *
@@ -134,7 +181,13 @@ static inline void rtio_executor_handle_multishot(struct rtio *r, struct rtio_io
 	}
 	if (!is_canceled) {
 		/* Request was not canceled, put the SQE back in the queue */
+#ifdef CONFIG_RTIO_MULTI_PRODUCER
+		K_SPINLOCK(&r->sq_lock) {
+			mpsc_push(&r->sq, &curr->q);
+		}
+#else
 		mpsc_push(&r->sq, &curr->q);
+#endif
 		rtio_executor_submit(r);
 	}
 }
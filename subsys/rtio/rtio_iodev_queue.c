@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/kernel.h>
+
+void z_rtio_iodev_queue_push(struct rtio_iodev_queue *queue, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct mpsc_node *prev = NULL;
+	struct mpsc_node *node;
+
+	/* Resolved on every push, so resubmitted multishot entries get a fresh one */
+	if (FIELD_GET(RTIO_SQE_DEADLINE, iodev_sqe->sqe.flags)) {
+		iodev_sqe->deadline = sys_timepoint_calc(iodev_sqe->sqe.deadline);
+	}
+
+	K_SPINLOCK(&queue->lock) {
+		/* Insert after every submission which compares equal to keep their order */
+		node = queue->head;
+		while (node != NULL &&
+		       !rtio_iodev_sqe_precedes(iodev_sqe,
+						CONTAINER_OF(node, struct rtio_iodev_sqe, q))) {
+			prev = node;
+			node = mpsc_ptr_get(node->next);
+		}
+
+		mpsc_ptr_set(iodev_sqe->q.next, node);
+		if (prev == NULL) {
+			queue->head = &iodev_sqe->q;
+		} else {
+			mpsc_ptr_set(prev->next, &iodev_sqe->q);
+		}
+	}
+}
+
+struct rtio_iodev_sqe *z_rtio_iodev_queue_pop(struct rtio_iodev_queue *queue)
+{
+	struct mpsc_node *node;
+
+	K_SPINLOCK(&queue->lock) {
+		node = queue->head;
+		if (node != NULL) {
+			queue->head = mpsc_ptr_get(node->next);
+		}
+	}
+
+	return (node == NULL) ? NULL : CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+}
+
+struct rtio_iodev_sqe *z_rtio_iodev_queue_peek(struct rtio_iodev_queue *queue)
+{
+	struct mpsc_node *node;
+
+	K_SPINLOCK(&queue->lock) {
+		node = queue->head;
+	}
+
+	return (node == NULL) ? NULL : CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+}
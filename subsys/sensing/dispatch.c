@@ -11,6 +11,85 @@
 
 LOG_MODULE_DECLARE(sensing, CONFIG_SENSING_LOG_LEVEL);
 
+#ifdef CONFIG_SENSING_DATA_REF
+/* References on the mempool buffers passed to clients, indexed by first block */
+static struct sensing_data_ref {
+	uint8_t *data;
+	uint32_t len;
+	atomic_t refs;
+} data_refs[CONFIG_SENSING_RTIO_BLOCK_COUNT];
+
+static struct sensing_data_ref *data_ref_get(const void *buf)
+{
+	uint16_t idx = __rtio_compute_mempool_block_index(&sensing_rtio_ctx, buf);
+
+	if (idx >= ARRAY_SIZE(data_refs) || data_refs[idx].data != buf) {
+		return NULL;
+	}
+
+	return &data_refs[idx];
+}
+
+int sensing_data_ref(const void *buf)
+{
+	struct sensing_data_ref *ref = data_ref_get(buf);
+
+	if (ref == NULL || atomic_get(&ref->refs) == 0) {
+		return -EINVAL;
+	}
+
+	/* The dispatcher holds a reference while clients are called */
+	atomic_inc(&ref->refs);
+
+	return 0;
+}
+
+int sensing_data_unref(const void *buf)
+{
+	struct sensing_data_ref *ref = data_ref_get(buf);
+	uint8_t *data;
+	uint32_t len;
+
+	if (ref == NULL || atomic_get(&ref->refs) == 0) {
+		return -EINVAL;
+	}
+
+	data = ref->data;
+	len = ref->len;
+
+	if (atomic_dec(&ref->refs) == 1) {
+		ref->data = NULL;
+		rtio_release_buffer(&sensing_rtio_ctx, data, len);
+	}
+
+	return 0;
+}
+
+static void data_ref_init(uint8_t *data, uint32_t len)
+{
+	struct sensing_data_ref *ref =
+		&data_refs[__rtio_compute_mempool_block_index(&sensing_rtio_ctx, data)];
+
+	ref->data = data;
+	ref->len = len;
+	atomic_set(&ref->refs, 1);
+}
+#else
+int sensing_data_ref(const void *buf)
+{
+	ARG_UNUSED(buf);
+
+	return -ENOTSUP;
+}
+
+int sensing_data_unref(const void *buf)
+{
+	ARG_UNUSED(buf);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_SENSING_DATA_REF */
+
 /* check whether it is right time for client to consume this sample */
 static inline bool sensor_test_consume_time(struct sensing_sensor *sensor,
 				     struct sensing_connection *conn,
@@ -113,7 +192,14 @@ static void dispatch_task(void *a, void *b, void *c)
 		    (uintptr_t)cqe.userdata < (uintptr_t)STRUCT_SECTION_END(sensing_sensor)) {
 			struct sensing_sensor *sensor = cqe.userdata;
 
+#ifdef CONFIG_SENSING_DATA_REF
+			data_ref_init(data, data_len);
+			send_data_to_clients(sensor, data);
+			sensing_data_unref(data);
+			continue;
+#else
 			send_data_to_clients(sensor, data);
+#endif
 		}
 
 		rtio_release_buffer(&sensing_rtio_ctx, data, data_len);
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sensing/sensing_fusion.h>
+
+LOG_MODULE_DECLARE(sensing, CONFIG_SENSING_LOG_LEVEL);
+
+static inline struct sensing_fusion_sample *stream_sample(struct sensing_fusion *fusion,
+							  uint8_t stream, uint16_t idx)
+{
+	const struct sensing_fusion_stream *s = &fusion->streams[stream];
+
+	return &fusion->samples[stream * fusion->depth + (s->head + idx) % fusion->depth];
+}
+
+static inline void stream_pop(struct sensing_fusion *fusion, uint8_t stream)
+{
+	struct sensing_fusion_stream *s = &fusion->streams[stream];
+
+	s->head = (s->head + 1) % fusion->depth;
+	s->count--;
+}
+
+static q31_t rescale(q31_t v, int8_t from, int8_t to)
+{
+	int64_t r;
+
+	if (to >= from) {
+		return v >> MIN(to - from, 31);
+	}
+
+	r = (int64_t)v << MIN(from - to, 32);
+
+	return (q31_t)CLAMP(r, INT32_MIN, INT32_MAX);
+}
+
+/* Interpolate a stream at a timestamp, false if the stream has not reached it yet */
+static bool stream_resample(struct sensing_fusion *fusion, uint8_t stream, uint64_t t,
+			    q31_t out[3])
+{
+	const struct sensing_fusion_stream *s = &fusion->streams[stream];
+	const struct sensing_fusion_sample *a;
+	const struct sensing_fusion_sample *b;
+	uint64_t offset;
+	uint64_t span;
+
+	if (s->count == 0 || stream_sample(fusion, stream, s->count - 1)->timestamp < t) {
+		return false;
+	}
+
+	/* Keep the last sample at or before t, later timestamps never need older ones */
+	while (s->count >= 2 && stream_sample(fusion, stream, 1)->timestamp <= t) {
+		stream_pop(fusion, stream);
+	}
+
+	a = stream_sample(fusion, stream, 0);
+	if (a->timestamp >= t) {
+		/* Samples before t were dropped, hold the oldest one */
+		memcpy(out, a->v, sizeof(a->v));
+		return true;
+	}
+
+	b = stream_sample(fusion, stream, 1);
+	span = b->timestamp - a->timestamp;
+	offset = t - a->timestamp;
+
+	/* The difference of two q31_t values takes 33 bits, keep its product with
+	 * the offset, which is below the span, within 64 bits on long gaps.
+	 */
+	while (span > (UINT32_MAX >> 2)) {
+		span >>= 1;
+		offset >>= 1;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		out[i] = a->v[i] + (q31_t)(((int64_t)b->v[i] - a->v[i]) * (int64_t)offset /
+					   (int64_t)span);
+	}
+
+	return true;
+}
+
+static bool fusion_align(struct sensing_fusion *fusion)
+{
+	uint64_t start = 0;
+
+	/* Start at the first time every stream has a sample for */
+	for (uint8_t i = 0; i < fusion->window.num_streams; i++) {
+		if (fusion->streams[i].count == 0) {
+			return false;
+		}
+
+		start = MAX(start, stream_sample(fusion, i, 0)->timestamp);
+	}
+
+	fusion->next_timestamp = start;
+	fusion->aligned = true;
+
+	return true;
+}
+
+static void fusion_process(struct sensing_fusion *fusion)
+{
+	struct sensing_fusion_window *window = &fusion->window;
+
+	if (!fusion->aligned && !fusion_align(fusion)) {
+		return;
+	}
+
+	while (true) {
+		for (uint8_t i = 0; i < window->num_streams; i++) {
+			if (!stream_resample(fusion, i, fusion->next_timestamp,
+					     window->data[i * window->len + fusion->filled])) {
+				return;
+			}
+		}
+
+		if (fusion->filled == 0) {
+			window->timestamp = fusion->next_timestamp;
+		}
+
+		fusion->filled++;
+		fusion->next_timestamp += window->period_us;
+
+		if (fusion->filled == window->len) {
+			fusion->filled = 0;
+			fusion->cb(fusion, window, fusion->user_data);
+		}
+	}
+}
+
+int sensing_fusion_add(struct sensing_fusion *fusion, uint8_t stream,
+		       const struct sensing_sensor_value_3d_q31 *value)
+{
+	struct sensing_fusion_stream *s;
+	struct sensing_fusion_sample *sample;
+	uint64_t timestamp;
+
+	if (stream >= fusion->window.num_streams) {
+		return -EINVAL;
+	}
+
+	s = &fusion->streams[stream];
+
+	for (uint16_t i = 0; i < value->header.reading_count; i++) {
+		timestamp = value->header.base_timestamp + value->readings[i].timestamp_delta;
+
+		if (s->count == 0) {
+			fusion->shift[stream] = value->shift;
+		} else if (timestamp <= stream_sample(fusion, stream, s->count - 1)->timestamp) {
+			LOG_DBG("stream %u: dropping out of order reading", stream);
+			continue;
+		}
+
+		if (s->count == fusion->depth) {
+			stream_pop(fusion, stream);
+			s->dropped++;
+		}
+
+		sample = stream_sample(fusion, stream, s->count);
+		sample->timestamp = timestamp;
+		for (int j = 0; j < 3; j++) {
+			sample->v[j] = rescale(value->readings[i].v[j], value->shift,
+					       fusion->shift[stream]);
+		}
+		s->count++;
+	}
+
+	fusion_process(fusion);
+
+	return 0;
+}
+
+int sensing_fusion_period_set(struct sensing_fusion *fusion, uint32_t period_us)
+{
+	if (period_us == 0U) {
+		return -EINVAL;
+	}
+
+	fusion->window.period_us = period_us;
+
+	return 0;
+}
+
+void sensing_fusion_reset(struct sensing_fusion *fusion)
+{
+	for (uint8_t i = 0; i < fusion->window.num_streams; i++) {
+		fusion->streams[i].head = 0;
+		fusion->streams[i].count = 0;
+	}
+
+	fusion->filled = 0;
+	fusion->aligned = false;
+}
@@ -9,11 +9,17 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sensing/sensing_sensor.h>
+#include <zephyr/sensing/sensing_fusion.h>
 
 LOG_MODULE_REGISTER(hinge_angle, CONFIG_SENSING_LOG_LEVEL);
 
 #define HINGE_REPORTER_NUM 2
 
+/* Samples buffered per reporter until the other one catches up */
+#define HINGE_FUSION_DEPTH 4
+/* Reporter interval until one is set, in micro seconds */
+#define HINGE_DEFAULT_INTERVAL_US 100000
+
 static struct sensing_sensor_register_info hinge_reg = {
 	.flags = SENSING_SENSOR_FLAG_REPORT_ON_CHANGE,
 	.sample_size = sizeof(struct sensing_sensor_value_q31),
@@ -24,8 +30,8 @@ static struct sensing_sensor_register_info hinge_reg = {
 struct hinge_angle_context {
 	struct rtio_iodev_sqe *sqe;
 	sensing_sensor_handle_t reporters[HINGE_REPORTER_NUM];
-	struct sensing_sensor_value_3d_q31 sample[HINGE_REPORTER_NUM];
-	int has_sample[HINGE_REPORTER_NUM];
+	/* Aligns the samples of the reporters by timestamp */
+	struct sensing_fusion *fusion;
 };
 
 static int hinge_init(const struct device *dev)
@@ -63,6 +69,10 @@ static int hinge_attr_set(const struct device *dev,
 		config.attri = SENSING_SENSOR_ATTRIBUTE_INTERVAL;
 		config.interval = (uint32_t)(USEC_PER_SEC * 1000LL /
 				sensor_value_to_milli(val));
+		ret = sensing_fusion_period_set(data->fusion, config.interval);
+		if (ret) {
+			break;
+		}
 		ret = sensing_set_config(data->reporters[0], &config, 1);
 		ret |= sensing_set_config(data->reporters[1], &config, 1);
 		break;
@@ -97,62 +107,72 @@ static const struct sensor_driver_api hinge_api = {
 	.submit = hinge_submit,
 };
 
-static q31_t calc_hinge_angle(struct hinge_angle_context *data)
+static q31_t calc_hinge_angle(const q31_t *acc0, const q31_t *acc1)
 {
 	q31_t val;
 
-	LOG_INF("Acc 0: x:%08x y:%08x z:%08x",
-			data->sample[0].readings[0].x,
-			data->sample[0].readings[0].y,
-			data->sample[0].readings[0].z);
-	LOG_INF("Acc 1: x:%08x y:%08x z:%08x",
-			data->sample[1].readings[0].x,
-			data->sample[1].readings[0].y,
-			data->sample[1].readings[0].z);
+	LOG_INF("Acc 0: x:%08x y:%08x z:%08x", acc0[0], acc0[1], acc0[2]);
+	LOG_INF("Acc 1: x:%08x y:%08x z:%08x", acc1[0], acc1[1], acc1[2]);
 
-	/* Todo: calc hinge angle base on data->sample[0] and data->sample[1] */
+	/* Todo: calc hinge angle base on acc0 and acc1 */
 	val = 0;
 
 	return val;
 }
 
-static void hinge_reporter_on_data_event(sensing_sensor_handle_t handle,
-		const void *buf, void *context)
+static void hinge_on_window(struct sensing_fusion *fusion,
+		const struct sensing_fusion_window *window, void *user_data)
 {
-	struct hinge_angle_context *data = context;
+	struct hinge_angle_context *data = user_data;
 	struct sensing_sensor_value_q31 *sample;
 	uint32_t buffer_len = 0;
-	int both = 0;
-	int i, ret;
+	int ret;
 
-	for (i = 0; i < HINGE_REPORTER_NUM; ++i) {
-		if (handle == data->reporters[i]) {
-			memcpy(&data->sample[i], buf, sizeof(data->sample[i]));
-			data->has_sample[i] = 1;
-		}
-		both += data->has_sample[i];
+	ARG_UNUSED(fusion);
+
+	if (data->sqe == NULL) {
+		return;
+	}
+
+	ret = rtio_sqe_rx_buf(data->sqe, sizeof(*sample), sizeof(*sample),
+			(uint8_t **)&sample, &buffer_len);
+	if (ret) {
+		rtio_iodev_sqe_err(data->sqe, ret);
+		return;
 	}
 
-	if (both == HINGE_REPORTER_NUM) {
-		data->has_sample[0] = 0;
-		data->has_sample[1] = 0;
+	sample->header.base_timestamp = window->timestamp;
+	sample->header.reading_count = 1;
+	sample->readings[0].timestamp_delta = 0;
+	sample->readings[0].v = calc_hinge_angle(sensing_fusion_window_get(window, 0, 0),
+			sensing_fusion_window_get(window, 1, 0));
 
-		ret = rtio_sqe_rx_buf(data->sqe, sizeof(*sample), sizeof(*sample),
-				(uint8_t **)&sample, &buffer_len);
-		if (ret) {
-			rtio_iodev_sqe_err(data->sqe, ret);
-			return;
-		}
+	rtio_iodev_sqe_ok(data->sqe, 0);
+}
 
-		sample->readings[0].v = calc_hinge_angle(data);
+static void hinge_reporter_on_data_event(sensing_sensor_handle_t handle,
+		const void *buf, void *context)
+{
+	struct hinge_angle_context *data = context;
+	int i;
 
-		rtio_iodev_sqe_ok(data->sqe, 0);
+	for (i = 0; i < HINGE_REPORTER_NUM; ++i) {
+		if (handle == data->reporters[i]) {
+			sensing_fusion_add(data->fusion, i, buf);
+		}
 	}
 }
 
 #define DT_DRV_COMPAT zephyr_sensing_hinge_angle
 #define SENSING_HINGE_ANGLE_DT_DEFINE(_inst)					\
 	static struct hinge_angle_context _CONCAT(hinge_ctx, _inst);		\
+	SENSING_FUSION_DEFINE(_CONCAT(hinge_fusion, _inst),			\
+		HINGE_REPORTER_NUM, HINGE_FUSION_DEPTH, 1,			\
+		HINGE_DEFAULT_INTERVAL_US, hinge_on_window,			\
+		&_CONCAT(hinge_ctx, _inst));					\
+	static struct hinge_angle_context _CONCAT(hinge_ctx, _inst) = {	\
+		.fusion = &_CONCAT(hinge_fusion, _inst),			\
+	};									\
 	static struct sensing_callback_list _CONCAT(hinge_cb, _inst) = {	\
 		.on_data_event = hinge_reporter_on_data_event,			\
 		.context = &_CONCAT(hinge_ctx, _inst),				\
@@ -212,7 +212,11 @@ static void shell_stack_dump(const struct k_thread *thread, void *user_data)
 	const char *tname;
 	int ret;
 
+#ifdef CONFIG_STACK_WATERMARK
+	ret = k_thread_stack_watermark_get(thread, &unused);
+#else
 	ret = k_thread_stack_space_get(thread, &unused);
+#endif
 	if (ret) {
 		shell_print(sh,
 			    "Unable to determine unused stack size (%d)\n",
@@ -234,6 +238,10 @@ static void shell_stack_dump(const struct k_thread *thread, void *user_data)
 K_KERNEL_STACK_ARRAY_DECLARE(z_interrupt_stacks, CONFIG_MP_MAX_NUM_CPUS,
 			     CONFIG_ISR_STACK_SIZE);
 
+#ifdef CONFIG_STACK_WATERMARK
+static struct _stack_watermark isr_stack_watermark[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
 static int cmd_kernel_stacks(const struct shell *sh,
 			     size_t argc, char **argv)
 {
@@ -259,7 +267,11 @@ static int cmd_kernel_stacks(const struct shell *sh,
 		size_t unused;
 		const uint8_t *buf = K_KERNEL_STACK_BUFFER(z_interrupt_stacks[i]);
 		size_t size = K_KERNEL_STACK_SIZEOF(z_interrupt_stacks[i]);
+#ifdef CONFIG_STACK_WATERMARK
+		int err = z_stack_watermark_get(buf, size, &isr_stack_watermark[i], &unused);
+#else
 		int err = z_stack_space_get(buf, size, &unused);
+#endif
 
 		(void)err;
 		__ASSERT_NO_MSG(err == 0);
@@ -300,6 +312,208 @@ static int cmd_kernel_heap(const struct shell *sh,
 }
 #endif
 
+#if defined(CONFIG_OBJ_CORE_STATS_LATENCY)
+static void shell_latency_print(const struct shell *sh, const char *type,
+				const void *obj, const char *name,
+				struct k_obj_core *obj_core)
+{
+	struct k_latency_stats stats;
+	uint32_t cyc_per_us = MAX(sys_clock_hw_cycles_per_sec() / USEC_PER_SEC, 1U);
+
+	if (k_obj_core_stats_query(obj_core, &stats, sizeof(stats)) != 0) {
+		return;
+	}
+
+	if (stats.count == 0U) {
+		return;
+	}
+
+	shell_print(sh, "%-6s %p %-" STRINGIFY(THREAD_MAX_NAM_LEN) "s "
+		    "%8u %8u %8u %8u %8u", type, obj, (name != NULL) ? name : "",
+		    stats.count, stats.p50 / cyc_per_us, stats.p90 / cyc_per_us,
+		    stats.p99 / cyc_per_us, stats.max / cyc_per_us);
+}
+
+static int shell_latency_obj(struct k_obj_core *obj_core, void *user_data)
+{
+	const struct shell *sh = user_data;
+	struct k_obj_type *type = obj_core->type;
+	const void *obj = (const uint8_t *)obj_core - type->obj_core_offset;
+
+	switch (type->id) {
+	case K_OBJ_TYPE_SEM_ID:
+		shell_latency_print(sh, "sem", obj, NULL, obj_core);
+		break;
+	case K_OBJ_TYPE_MUTEX_ID:
+		shell_latency_print(sh, "mutex", obj, NULL, obj_core);
+		break;
+	case K_OBJ_TYPE_MSGQ_ID:
+		shell_latency_print(sh, "msgq", obj, NULL, obj_core);
+		break;
+	case K_OBJ_TYPE_WORK_Q_ID:
+		shell_latency_print(sh, "workq", obj,
+				    k_thread_name_get(&((struct k_work_q *)obj)->thread),
+				    obj_core);
+		break;
+	case K_OBJ_TYPE_LATENCY_ID:
+		shell_latency_print(sh, "kernel", obj,
+				    ((const struct k_obj_core_latency *)obj)->name, obj_core);
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+static int shell_latency_reset_obj(struct k_obj_core *obj_core, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	(void)k_obj_core_stats_reset(obj_core);
+
+	return 0;
+}
+
+static const uint32_t shell_latency_types[] = {
+	K_OBJ_TYPE_SEM_ID,
+	K_OBJ_TYPE_MUTEX_ID,
+	K_OBJ_TYPE_MSGQ_ID,
+	K_OBJ_TYPE_WORK_Q_ID,
+	K_OBJ_TYPE_LATENCY_ID,
+};
+
+static int cmd_kernel_latency(const struct shell *sh,
+			      size_t argc, char **argv)
+{
+	bool reset = false;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") != 0) {
+			shell_error(sh, "Unsupported option: %s", argv[1]);
+			return -EINVAL;
+		}
+		reset = true;
+	}
+
+	if (!reset) {
+		shell_print(sh, "%-6s %-*s %-" STRINGIFY(THREAD_MAX_NAM_LEN) "s "
+			    "%8s %8s %8s %8s %8s", "type", (int)(2 * sizeof(void *) + 2),
+			    "object", "name", "count", "p50 us", "p90 us", "p99 us", "max us");
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(shell_latency_types); i++) {
+		struct k_obj_type *type = k_obj_type_find(shell_latency_types[i]);
+
+		if (type == NULL) {
+			continue;
+		}
+
+		k_obj_type_walk_unlocked(type,
+					 reset ? shell_latency_reset_obj : shell_latency_obj,
+					 (void *)sh);
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_OBJ_CORE_STATS_WORK_Q)
+static int shell_work_q_obj(struct k_obj_core *obj_core, void *user_data)
+{
+	const struct shell *sh = user_data;
+	struct k_work_q *queue = CONTAINER_OF(obj_core, struct k_work_q, obj_core);
+	const char *name = k_thread_name_get(&queue->thread);
+	uint32_t cyc_per_us = MAX(sys_clock_hw_cycles_per_sec() / USEC_PER_SEC, 1U);
+	struct k_work_q_stats_summary stats;
+
+	if (k_work_queue_stats_get(queue, &stats) != 0) {
+		return 0;
+	}
+
+	shell_print(sh, "%p %-" STRINGIFY(THREAD_MAX_NAM_LEN) "s %8u", queue,
+		    (name != NULL) ? name : "", stats.count);
+	shell_print(sh, "\tdelay us: min %u avg %u p50 %u p90 %u p99 %u max %u",
+		    stats.delay.min / cyc_per_us, stats.delay.avg / cyc_per_us,
+		    stats.delay.p50 / cyc_per_us, stats.delay.p90 / cyc_per_us,
+		    stats.delay.p99 / cyc_per_us, stats.delay.max / cyc_per_us);
+	shell_print(sh, "\trun us:   min %u avg %u p50 %u p90 %u p99 %u max %u",
+		    stats.run.min / cyc_per_us, stats.run.avg / cyc_per_us,
+		    stats.run.p50 / cyc_per_us, stats.run.p90 / cyc_per_us,
+		    stats.run.p99 / cyc_per_us, stats.run.max / cyc_per_us);
+
+	return 0;
+}
+
+static int shell_work_q_reset_obj(struct k_obj_core *obj_core, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	(void)k_obj_core_stats_reset(obj_core);
+
+	return 0;
+}
+
+static int cmd_kernel_work(const struct shell *sh,
+			   size_t argc, char **argv)
+{
+	struct k_obj_type *type = k_obj_type_find(K_OBJ_TYPE_WORK_Q_ID);
+	uint32_t cyc_per_us = MAX(sys_clock_hw_cycles_per_sec() / USEC_PER_SEC, 1U);
+	struct k_work_handler_stats handlers[8];
+	size_t total = 0;
+	size_t count;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") != 0) {
+			shell_error(sh, "Unsupported option: %s", argv[1]);
+			return -EINVAL;
+		}
+
+		if (type != NULL) {
+			k_obj_type_walk_unlocked(type, shell_work_q_reset_obj, NULL);
+		}
+		k_work_handler_stats_reset();
+
+		return 0;
+	}
+
+	shell_print(sh, "%-*s %-" STRINGIFY(THREAD_MAX_NAM_LEN) "s %8s",
+		    (int)(2 * sizeof(void *) + 2), "queue", "name", "count");
+
+	if (type != NULL) {
+		k_obj_type_walk_unlocked(type, shell_work_q_obj, (void *)sh);
+	}
+
+	/* The handler table is copied a few entries at a time */
+	do {
+		count = k_work_handler_stats_get(handlers, total, ARRAY_SIZE(handlers));
+
+		if ((total == 0U) && (count > 0U)) {
+			shell_print(sh, "\n%-*s %8s %10s %10s %10s",
+				    (int)(2 * sizeof(void *) + 2), "handler", "count",
+				    "avg us", "run max us", "dly max us");
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			const struct k_work_handler_stats *entry = &handlers[i];
+
+			shell_print(sh, "%p %8u %10u %10u %10u", (void *)entry->handler,
+				    entry->count,
+				    (uint32_t)(entry->run_total / entry->count) / cyc_per_us,
+				    entry->run_max / cyc_per_us, entry->delay_max / cyc_per_us);
+		}
+
+		total += count;
+	} while (count == ARRAY_SIZE(handlers));
+
+	if (total == CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS) {
+		shell_warn(sh, "Handler table full, further handlers are not tracked");
+	}
+
+	return 0;
+}
+#endif
+
 static int cmd_kernel_sleep(const struct shell *sh,
 			    size_t argc, char **argv)
 {
@@ -404,6 +618,15 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD_ARG(uptime, NULL, "Kernel uptime. Can be called with the -p or --pretty options",
 		      cmd_kernel_uptime, 1, 1),
 	SHELL_CMD(version, NULL, "Kernel version.", cmd_kernel_version),
+#if defined(CONFIG_OBJ_CORE_STATS_LATENCY)
+	SHELL_CMD_ARG(latency, NULL, "Latency histograms of kernel objects. "
+		      "Can be called with the reset option to clear them",
+		      cmd_kernel_latency, 1, 1),
+#endif
+#if defined(CONFIG_OBJ_CORE_STATS_WORK_Q)
+	SHELL_CMD_ARG(work, NULL, "Work queue delay and run time statistics. "
+		      "Can be called with the reset option to clear them", cmd_kernel_work, 1, 1),
+#endif
 	SHELL_CMD_ARG(sleep, NULL, "ms", cmd_kernel_sleep, 2, 0),
 #if defined(CONFIG_LOG_RUNTIME_FILTERING)
 	SHELL_CMD_ARG(log-level, NULL, "<module name> <severity (0-4)>",
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define RESOLUTION  12
+#define INTERVAL_US 50
+#define SAMPLINGS   64
+#define CHANNELS    (BIT(0) | BIT(1))
+#define RUN_TIME_MS 500
+#define BLK_SIZE    64
+#define NUM_BLKS    64
+
+static const struct device *adc = DEVICE_DT_GET(DT_NODELABEL(adc0));
+
+ADC_DT_STREAM_IODEV(stream_iodev, DT_NODELABEL(adc0), CHANNELS, RESOLUTION, INTERVAL_US,
+		    SAMPLINGS);
+
+RTIO_DEFINE_WITH_MEMPOOL(r, 4, 4, NUM_BLKS, BLK_SIZE, 4);
+
+struct result {
+	/* Samplings handed to the application */
+	uint32_t samplings;
+	/* Times the application was called back or woken up */
+	uint32_t events;
+	/* Samplings lost */
+	uint32_t dropped;
+	/* Cycles spent handling the samples */
+	uint32_t cycles;
+	int64_t sum;
+};
+
+static struct result result;
+static uint16_t seq_buf[SAMPLINGS * 2];
+
+static void report(const char *name, const struct result *res)
+{
+	TC_PRINT("%s: %u samplings/s, %u events per 1000 samplings, %u dropped, "
+		 "%u cycles per sampling\n",
+		 name, res->samplings * MSEC_PER_SEC / RUN_TIME_MS,
+		 res->samplings == 0 ? 0 : res->events * 1000 / res->samplings, res->dropped,
+		 res->samplings == 0 ? 0 : res->cycles / res->samplings);
+}
+
+static enum adc_action on_sampling(const struct device *dev, const struct adc_sequence *sequence,
+				   uint16_t sampling_index)
+{
+	const uint16_t *sample = &((const uint16_t *)sequence->buffer)[sampling_index * 2];
+	uint32_t start = k_cycle_get_32();
+
+	ARG_UNUSED(dev);
+
+	result.sum += sample[0] + sample[1];
+	result.samplings++;
+	result.events++;
+	result.cycles += k_cycle_get_32() - start;
+
+	return ADC_ACTION_CONTINUE;
+}
+
+/**
+ * @brief Sample with re-armed sequences and a callback per sampling
+ */
+ZTEST(adc_stream_bench, test_sequence_callback)
+{
+	const struct adc_sequence_options options = {
+		.interval_us = INTERVAL_US,
+		.callback = on_sampling,
+		.extra_samplings = SAMPLINGS - 1,
+	};
+	const struct adc_sequence sequence = {
+		.options = &options,
+		.channels = CHANNELS,
+		.buffer = seq_buf,
+		.buffer_size = sizeof(seq_buf),
+		.resolution = RESOLUTION,
+	};
+	int64_t end = k_uptime_get() + RUN_TIME_MS;
+
+	while (k_uptime_get() < end) {
+		zassert_ok(adc_read(adc, &sequence));
+	}
+
+	report("sequence", &result);
+	zassert_true(result.samplings > 0);
+}
+
+/**
+ * @brief Sample with an RTIO stream delivering a buffer of samplings at a time
+ */
+ZTEST(adc_stream_bench, test_stream)
+{
+	struct rtio_sqe *handle;
+	int64_t end = k_uptime_get() + RUN_TIME_MS;
+
+	zassert_ok(adc_stream(&stream_iodev, &r, NULL, &handle));
+
+	while (k_uptime_get() < end) {
+		struct rtio_cqe *cqe = rtio_cqe_consume_block(&r);
+		const struct adc_stream_header *hdr;
+		uint32_t start = k_cycle_get_32();
+		uint8_t *buf;
+		uint32_t buf_len;
+
+		zassert_ok(cqe->result);
+		zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe, &buf, &buf_len));
+
+		hdr = (const struct adc_stream_header *)buf;
+		for (int i = 0; i < hdr->samplings * 2; i++) {
+			result.sum += hdr->samples[i];
+		}
+		result.samplings += hdr->samplings;
+		result.dropped += hdr->dropped;
+		result.events++;
+
+		rtio_release_buffer(&r, buf, buf_len);
+		rtio_cqe_release(&r, cqe);
+		result.cycles += k_cycle_get_32() - start;
+	}
+
+	rtio_sqe_cancel(handle);
+	k_msleep(2 * SAMPLINGS * INTERVAL_US / USEC_PER_MSEC + 1);
+
+	report("stream", &result);
+	zassert_equal(result.dropped, 0, "Stream lost samplings");
+	zassert_true(result.samplings >= RUN_TIME_MS * USEC_PER_MSEC / INTERVAL_US * 9 / 10,
+		     "Stream fell behind: %u samplings", result.samplings);
+}
+
+static void *adc_stream_bench_setup(void)
+{
+	struct adc_channel_cfg cfg = {
+		.gain = ADC_GAIN_1,
+		.reference = ADC_REF_EXTERNAL0,
+		.acquisition_time = ADC_ACQ_TIME_DEFAULT,
+	};
+
+	zassert_true(device_is_ready(adc));
+	zassert_ok(adc_emul_ref_voltage_set(adc, ADC_REF_EXTERNAL0, 3300));
+
+	for (cfg.channel_id = 0; cfg.channel_id < 2; cfg.channel_id++) {
+		zassert_ok(adc_channel_setup(adc, &cfg));
+		zassert_ok(adc_emul_const_value_set(adc, cfg.channel_id, 1000 + cfg.channel_id));
+	}
+
+	return NULL;
+}
+
+static void adc_stream_bench_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&result, 0, sizeof(result));
+}
+
+ZTEST_SUITE(adc_stream_bench, NULL, adc_stream_bench_setup, adc_stream_bench_before, NULL, NULL);
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_pkt_filter.h>
+
+/* Filter decisions per measurement */
+#define LOOKUPS 20000
+/* Distinct packets the decisions are made on */
+#define PKT_COUNT 16
+#define RULE_PAIRS 50
+#define MAX_RULES (2 * RULE_PAIRS)
+/* Ethernet type of the packets no rule matches */
+#define OTHER_TYPE 0x88b5
+
+ETH_NET_DEVICE_INIT(bench_iface_a, "bench_a", NULL, NULL, NULL, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, NULL, NET_ETH_MTU);
+ETH_NET_DEVICE_INIT(bench_iface_b, "bench_b", NULL, NULL, NULL, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, NULL, NET_ETH_MTU);
+#define bench_iface_a NET_IF_GET_NAME(bench_iface_a, 0)[0]
+#define bench_iface_b NET_IF_GET_NAME(bench_iface_b, 0)[0]
+
+static NPF_IFACE_MATCH(match_iface_a, &bench_iface_a);
+static NPF_IFACE_MATCH(match_iface_b, &bench_iface_b);
+
+/* Rule i drops Ethernet type 0x8800 + i, even rules on the first interface
+ * and odd ones on the second, the way a list of per port protocol blocks
+ * looks like.
+ */
+#define RULE_TYPE(i) (0x8800 + (i))
+
+#define DEFINE_RULES(i, _) \
+	static NPF_ETH_TYPE_MATCH(type_a_##i, RULE_TYPE(2 * (i))); \
+	static NPF_ETH_TYPE_MATCH(type_b_##i, RULE_TYPE(2 * (i) + 1)); \
+	static NPF_RULE(rule_a_##i, NET_DROP, match_iface_a, type_a_##i); \
+	static NPF_RULE(rule_b_##i, NET_DROP, match_iface_b, type_b_##i)
+
+#define RULE_PTRS(i, _) &rule_a_##i, &rule_b_##i
+
+LISTIFY(RULE_PAIRS, DEFINE_RULES, (;));
+
+static struct npf_rule *rules[] = {
+	LISTIFY(RULE_PAIRS, RULE_PTRS, (,))
+};
+
+static struct net_pkt *pkts[PKT_COUNT];
+
+static struct net_pkt *build_pkt(uint16_t type, struct net_if *iface)
+{
+	struct net_eth_hdr hdr = {
+		.src = { { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 } },
+		.dst = { { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x02 } },
+		.type = htons(type),
+	};
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, 100, AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	zassert_not_null(pkt, "Failed to allocate packet");
+	zassert_ok(net_pkt_write(pkt, &hdr, sizeof(hdr)));
+
+	return pkt;
+}
+
+static void bench(int count)
+{
+	uint32_t start, cycles;
+	int accepted = 0;
+
+	for (int i = 0; i < count; i++) {
+		npf_append_recv_rule(rules[i]);
+	}
+
+	npf_append_recv_rule(&npf_default_ok);
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		if (net_pkt_filter_recv_ok(pkts[i % PKT_COUNT])) {
+			accepted++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	zassert_true(npf_remove_all_recv_rules());
+
+	TC_PRINT("%d rules: %u ns per packet, %d/%d accepted\n", count,
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / LOOKUPS), accepted,
+		 LOOKUPS);
+}
+
+/**
+ * @brief Packets of types the rules drop and of one no rule matches
+ */
+ZTEST(net_pkt_filter_bench, test_rules_10)
+{
+	bench(10);
+}
+
+ZTEST(net_pkt_filter_bench, test_rules_50)
+{
+	bench(50);
+}
+
+ZTEST(net_pkt_filter_bench, test_rules_100)
+{
+	bench(100);
+}
+
+static void *setup(void)
+{
+	/* Half of the packets walk the whole list to the default rule */
+	for (int i = 0; i < PKT_COUNT; i++) {
+		uint16_t type = (i % 2) ? OTHER_TYPE :
+			RULE_TYPE(sys_rand32_get() % MAX_RULES);
+
+		pkts[i] = build_pkt(type, (i % 4) < 2 ? &bench_iface_a :
+							&bench_iface_b);
+	}
+
+	TC_PRINT("Rule compilation %s\n",
+		 IS_ENABLED(CONFIG_NET_PKT_FILTER_COMPILE) ? "on" : "off");
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	ARRAY_FOR_EACH(pkts, i) {
+		net_pkt_unref(pkts[i]);
+	}
+}
+
+ZTEST_SUITE(net_pkt_filter_bench, NULL, setup, NULL, NULL, teardown);
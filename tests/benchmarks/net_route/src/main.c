@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+
+#include "ipv6.h"
+#include "nbr.h"
+#include "route.h"
+
+/* Forwarding decisions per measurement */
+#define LOOKUPS 20000
+/* Destinations of the hot traffic, fitting in the route cache */
+#define HOT_DSTS 8
+
+static struct net_if *iface;
+
+static struct in6_addr nexthop6 = { { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static uint8_t nexthop_mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x02 };
+
+static struct in6_addr dsts6[LOOKUPS];
+static struct in_addr dsts4[LOOKUPS];
+
+static int test_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static void test_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static struct dummy_api test_if_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_send,
+};
+
+NET_DEVICE_INIT(net_route_bench, "net_route_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &test_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+/* Route i is 2001:db8:<i>::/48 or /56. net_route_add() would merge nested
+ * prefixes with the same next hop, so the routes do not overlap.
+ */
+static void route6_prefix(int i, struct in6_addr *prefix, uint8_t *len)
+{
+	memset(prefix, 0, sizeof(*prefix));
+	prefix->s6_addr[0] = 0x20;
+	prefix->s6_addr[1] = 0x01;
+	prefix->s6_addr[2] = 0x0d;
+	prefix->s6_addr[3] = 0xb8;
+	sys_put_be16(i, &prefix->s6_addr[4]);
+	*len = (i % 2) ? 56 : 48;
+}
+
+static void report(const char *name, uint32_t cycles, int found)
+{
+	TC_PRINT("%s: %u ns per lookup, %d/%d routed\n", name,
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / LOOKUPS), found,
+		 LOOKUPS);
+}
+
+static void bench_ipv6(const char *name)
+{
+	struct net_route_entry *route;
+	struct in6_addr *nexthop;
+	uint32_t start, cycles;
+	int found = 0;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		if (net_route_get_info(NULL, &dsts6[i], &route, &nexthop) &&
+		    route != NULL) {
+			found++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	report(name, cycles, found);
+}
+
+static void bench_ipv4(const char *name)
+{
+	uint32_t start, cycles;
+	int found = 0;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		if (net_route_ipv4_lookup(NULL, &dsts4[i], NULL) != NULL) {
+			found++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	report(name, cycles, found);
+}
+
+/**
+ * @brief Route to destinations spread over all the IPv6 routes
+ */
+ZTEST(net_route_bench, test_ipv6_spread)
+{
+	for (int i = 0; i < LOOKUPS; i++) {
+		uint8_t len;
+
+		route6_prefix(sys_rand32_get() % CONFIG_NET_MAX_ROUTES, &dsts6[i],
+			      &len);
+		dsts6[i].s6_addr[15] = sys_rand8_get() | 1U;
+	}
+
+	bench_ipv6("IPv6 spread");
+}
+
+/**
+ * @brief Route to a few hot IPv6 destinations
+ */
+ZTEST(net_route_bench, test_ipv6_hot)
+{
+	for (int i = 0; i < LOOKUPS; i++) {
+		uint8_t len;
+
+		route6_prefix((i % HOT_DSTS) * (CONFIG_NET_MAX_ROUTES / HOT_DSTS),
+			      &dsts6[i], &len);
+		dsts6[i].s6_addr[15] = 1U;
+	}
+
+	bench_ipv6("IPv6 hot");
+}
+
+/**
+ * @brief Route to destinations spread over all the IPv4 routes
+ */
+ZTEST(net_route_bench, test_ipv4_spread)
+{
+	for (int i = 0; i < LOOKUPS; i++) {
+		uint32_t n = sys_rand32_get() % CONFIG_NET_MAX_IPV4_ROUTES;
+
+		dsts4[i].s4_addr[0] = 10;
+		dsts4[i].s4_addr[1] = n;
+		dsts4[i].s4_addr[2] = sys_rand8_get();
+		dsts4[i].s4_addr[3] = sys_rand8_get();
+	}
+
+	bench_ipv4("IPv4 spread");
+}
+
+/**
+ * @brief Route to a few hot IPv4 destinations
+ */
+ZTEST(net_route_bench, test_ipv4_hot)
+{
+	for (int i = 0; i < LOOKUPS; i++) {
+		dsts4[i].s4_addr[0] = 10;
+		dsts4[i].s4_addr[1] = (i % HOT_DSTS) * 17;
+		dsts4[i].s4_addr[2] = 1;
+		dsts4[i].s4_addr[3] = 1;
+	}
+
+	bench_ipv4("IPv4 hot");
+}
+
+static void *setup(void)
+{
+	struct net_linkaddr lladdr = {
+		.addr = nexthop_mac,
+		.len = sizeof(nexthop_mac),
+		.type = NET_LINK_DUMMY,
+	};
+	struct in_addr prefix4 = { { { 10, 0, 0, 0 } } };
+	struct in_addr gw4 = { { { 192, 0, 2, 1 } } };
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface);
+
+	zassert_not_null(net_ipv6_nbr_add(iface, &nexthop6, &lladdr, false,
+					  NET_IPV6_NBR_STATE_REACHABLE));
+
+	for (int i = 0; i < CONFIG_NET_MAX_ROUTES; i++) {
+		struct in6_addr prefix;
+		uint8_t len;
+
+		route6_prefix(i, &prefix, &len);
+		zassert_not_null(net_route_add(iface, &prefix, len, &nexthop6,
+					       NET_IPV6_ND_INFINITE_LIFETIME,
+					       NET_ROUTE_PREFERENCE_MEDIUM),
+				 "Cannot add route %d", i);
+	}
+
+	/* 10.<i>.0.0/16, with a default route */
+	zassert_not_null(net_route_ipv4_add(iface, &(struct in_addr){ 0 }, 0,
+					    &gw4));
+
+	for (int i = 0; i < CONFIG_NET_MAX_IPV4_ROUTES - 1; i++) {
+		prefix4.s4_addr[1] = i;
+		zassert_not_null(net_route_ipv4_add(iface, &prefix4, 16, &gw4),
+				 "Cannot add IPv4 route %d", i);
+	}
+
+	TC_PRINT("%d IPv6 and %d IPv4 routes, trie lookup %s, route cache %d\n",
+		 CONFIG_NET_MAX_ROUTES, CONFIG_NET_MAX_IPV4_ROUTES,
+		 IS_ENABLED(CONFIG_NET_ROUTE_LPM) ? "on" : "off",
+		 CONFIG_NET_ROUTE_CACHE_SIZE);
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_route_bench, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define SQ_SIZE     32
+#define CQ_SIZE     64
+#define ITERATIONS  10000
+#define CHAIN_LEN   4
+
+#define MAX_PRODUCERS     MAX(CONFIG_MP_MAX_NUM_CPUS, 2)
+#define PRODUCER_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Completes every submission right away, leaving only the RTIO overhead */
+static void null_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+}
+
+static const struct rtio_iodev_api null_iodev_api = {
+	.submit = null_iodev_submit,
+};
+
+RTIO_IODEV_DEFINE(null_iodev, &null_iodev_api, NULL);
+RTIO_DEFINE(r_bench, SQ_SIZE, CQ_SIZE);
+
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, MAX_PRODUCERS, PRODUCER_STACK_SIZE);
+static struct k_thread producer_threads[MAX_PRODUCERS];
+static uint32_t completions[MAX_PRODUCERS];
+
+/* One credit per completion queue entry, so completions are never dropped */
+K_SEM_DEFINE(cq_credits, CQ_SIZE, CQ_SIZE);
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	uintptr_t id = (uintptr_t)p1;
+	size_t chain_len = (size_t)(uintptr_t)p2;
+	struct rtio_sqe sqes[CHAIN_LEN];
+
+	ARG_UNUSED(p3);
+
+	for (size_t i = 0; i < chain_len; i++) {
+		rtio_sqe_prep_nop(&sqes[i], &null_iodev, (void *)id);
+		sqes[i].flags = (i + 1 < chain_len) ? RTIO_SQE_CHAINED : 0;
+	}
+
+	for (int i = 0; i < ITERATIONS / chain_len; i++) {
+		for (size_t j = 0; j < chain_len; j++) {
+			k_sem_take(&cq_credits, K_FOREVER);
+		}
+
+		while (rtio_sqe_copy_in(&r_bench, sqes, chain_len) != 0) {
+			/* Wait for the consumer to free up entries */
+			k_yield();
+		}
+
+		rtio_submit(&r_bench, 0);
+	}
+}
+
+static void producer_acquire_entry(void *p1, void *p2, void *p3)
+{
+	uintptr_t id = (uintptr_t)p1;
+	size_t chain_len = (size_t)(uintptr_t)p2;
+	struct rtio_sqe *sqe;
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < ITERATIONS / chain_len; i++) {
+		for (size_t j = 0; j < chain_len; j++) {
+			k_sem_take(&cq_credits, K_FOREVER);
+		}
+
+		for (size_t j = 0; j < chain_len; j++) {
+			sqe = rtio_sqe_acquire(&r_bench);
+			while (sqe == NULL) {
+				/* Wait for the consumer to free up entries */
+				k_yield();
+				sqe = rtio_sqe_acquire(&r_bench);
+			}
+
+			/* Let the other producers submit while the entry is being
+			 * filled in, it must not be executed before this one submits.
+			 */
+			memset(sqe, 0xa5, sizeof(*sqe));
+			k_yield();
+
+			rtio_sqe_prep_nop(sqe, &null_iodev, (void *)id);
+			sqe->flags = (j + 1 < chain_len) ? RTIO_SQE_CHAINED : 0;
+		}
+
+		rtio_submit(&r_bench, 0);
+	}
+}
+
+static void consume(uint32_t count)
+{
+	uint32_t i = 0;
+
+	while (i < count) {
+		struct rtio_cqe *cqe = rtio_cqe_consume(&r_bench);
+		uintptr_t id;
+
+		if (cqe == NULL) {
+			/* Producers run at the same priority */
+			k_yield();
+			continue;
+		}
+
+		id = (uintptr_t)cqe->userdata;
+		zassert_ok(cqe->result);
+		zassert_true(id < MAX_PRODUCERS, "Unexpected userdata %p", cqe->userdata);
+		completions[id]++;
+		rtio_cqe_release(&r_bench, cqe);
+		k_sem_give(&cq_credits);
+		i++;
+	}
+}
+
+static void run_producers(k_thread_entry_t entry, unsigned int num_producers, size_t chain_len)
+{
+	const uint32_t per_producer = ITERATIONS / chain_len * chain_len;
+	const int prio = k_thread_priority_get(k_current_get());
+	uint32_t start;
+	uint32_t cycles;
+
+	memset(completions, 0, sizeof(completions));
+
+	start = k_cycle_get_32();
+	for (unsigned int i = 0; i < num_producers; i++) {
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				K_THREAD_STACK_SIZEOF(producer_stacks[i]), entry,
+				(void *)(uintptr_t)i, (void *)(uintptr_t)chain_len, NULL,
+				prio, 0, K_NO_WAIT);
+	}
+
+	consume(num_producers * per_producer);
+	cycles = k_cycle_get_32() - start;
+
+	for (unsigned int i = 0; i < num_producers; i++) {
+		zassert_ok(k_thread_join(&producer_threads[i], K_FOREVER));
+	}
+
+	zassert_equal(atomic_get(&r_bench.xcqcnt), 0, "Completions were dropped");
+	for (unsigned int i = 0; i < num_producers; i++) {
+		zassert_equal(completions[i], per_producer, "Producer %u: %u of %u completions", i,
+			      completions[i], per_producer);
+	}
+
+	TC_PRINT("%u producer(s), chains of %zu: %6llu ns per SQE\n", num_producers, chain_len,
+		 k_cyc_to_ns_floor64(cycles) / (num_producers * per_producer));
+}
+
+ZTEST(rtio_smp, test_round_trip)
+{
+	struct rtio_sqe sqe;
+	uint32_t start;
+	uint32_t cycles;
+
+	rtio_sqe_prep_nop(&sqe, &null_iodev, NULL);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		struct rtio_cqe *cqe;
+
+		zassert_ok(rtio_sqe_copy_in(&r_bench, &sqe, 1));
+		rtio_submit(&r_bench, 0);
+
+		cqe = rtio_cqe_consume(&r_bench);
+		zassert_not_null(cqe, "Null iodev did not complete inline");
+		rtio_cqe_release(&r_bench, cqe);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("Round trip: %llu ns per SQE\n", k_cyc_to_ns_floor64(cycles) / ITERATIONS);
+}
+
+ZTEST(rtio_smp, test_producers)
+{
+	const unsigned int num_cpus = arch_num_cpus();
+
+	run_producers(producer_entry, 1, 1);
+
+	for (unsigned int n = 2; n <= num_cpus; n++) {
+		run_producers(producer_entry, n, 1);
+	}
+}
+
+ZTEST(rtio_smp, test_chained_producers)
+{
+	/* Chains are queued back to back while other producers submit theirs */
+	run_producers(producer_entry, 1, CHAIN_LEN);
+	run_producers(producer_entry, arch_num_cpus(), CHAIN_LEN);
+}
+
+ZTEST(rtio_smp, test_acquire_producers)
+{
+	/* Entries being filled in by one producer are not executed when
+	 * another one submits, even on a single CPU.
+	 */
+	run_producers(producer_acquire_entry, MAX(arch_num_cpus(), 2), 1);
+	run_producers(producer_acquire_entry, MAX(arch_num_cpus(), 2), CHAIN_LEN);
+}
+
+ZTEST_SUITE(rtio_smp, NULL, NULL, NULL, NULL, NULL);
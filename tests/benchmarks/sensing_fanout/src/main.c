@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/emul.h>
+#include <zephyr/sensing/sensing.h>
+#include <zephyr/ztest.h>
+
+#include "icm42688_emul.h"
+#include "icm42688_reg.h"
+
+#define NUM_CLIENTS 4
+#define INTERVAL_US 1000
+#define RUN_TIME_MS 500
+#define QUEUE_LEN   16
+
+#define WORKER_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+enum client_mode {
+	/* Copy the sample in the callback and process it later */
+	CLIENT_COPY,
+	/* Keep a reference on the shared buffer and process it later */
+	CLIENT_REF,
+};
+
+struct client {
+	sensing_sensor_handle_t handle;
+	struct sensing_callback_list cb;
+	enum client_mode mode;
+	struct k_msgq *queue;
+	uint32_t received;
+	uint32_t dropped;
+	uint32_t processed;
+	uint32_t cb_cycles;
+	int64_t sum;
+};
+
+K_MSGQ_DEFINE(copy_queue, sizeof(struct sensing_sensor_value_3d_q31), NUM_CLIENTS * QUEUE_LEN,
+	      4);
+K_MSGQ_DEFINE(ref_queue, sizeof(const struct sensing_sensor_value_3d_q31 *),
+	      NUM_CLIENTS * QUEUE_LEN, 4);
+
+static K_THREAD_STACK_DEFINE(worker_stack, WORKER_STACK_SIZE);
+static struct k_thread worker_thread;
+
+static const struct device *accel = DEVICE_DT_GET(DT_NODELABEL(accel));
+static const struct emul *target = EMUL_DT_GET(DT_NODELABEL(icm42688));
+
+static struct client clients[NUM_CLIENTS];
+
+/* Samples are processed by a single worker, standing in for the client threads */
+static void process(struct client *client, const struct sensing_sensor_value_3d_q31 *sample)
+{
+	client->sum += sample->readings[0].x;
+	client->processed++;
+}
+
+static void worker_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		struct sensing_sensor_value_3d_q31 sample;
+		const struct sensing_sensor_value_3d_q31 *ref;
+
+		if (k_msgq_get(&copy_queue, &sample, K_NO_WAIT) == 0) {
+			process(&clients[0], &sample);
+			continue;
+		}
+
+		if (k_msgq_get(&ref_queue, &ref, K_MSEC(1)) == 0) {
+			process(&clients[0], ref);
+			zassert_ok(sensing_data_unref(ref));
+		}
+	}
+}
+
+static void on_data_event(sensing_sensor_handle_t handle, const void *buf, void *context)
+{
+	struct client *client = context;
+	uint32_t start = k_cycle_get_32();
+	int rc;
+
+	ARG_UNUSED(handle);
+
+	client->received++;
+
+	if (client->mode == CLIENT_COPY) {
+		rc = k_msgq_put(client->queue, buf, K_NO_WAIT);
+	} else {
+		zassert_ok(sensing_data_ref(buf));
+		rc = k_msgq_put(client->queue, &buf, K_NO_WAIT);
+		if (rc != 0) {
+			zassert_ok(sensing_data_unref(buf));
+		}
+	}
+
+	if (rc != 0) {
+		client->dropped++;
+	}
+
+	client->cb_cycles += k_cycle_get_32() - start;
+}
+
+static void open_clients(enum client_mode mode)
+{
+	struct sensing_sensor_config config = {
+		.attri = SENSING_SENSOR_ATTRIBUTE_INTERVAL,
+		.interval = INTERVAL_US,
+	};
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		struct client *client = &clients[i];
+
+		*client = (struct client){
+			.cb = {
+				.on_data_event = on_data_event,
+				.context = client,
+			},
+			.mode = mode,
+			.queue = (mode == CLIENT_COPY) ? &copy_queue : &ref_queue,
+		};
+
+		zassert_ok(sensing_open_sensor_by_dt(accel, &client->cb, &client->handle));
+		zassert_ok(sensing_set_config(client->handle, &config, 1));
+	}
+}
+
+static void close_clients(void)
+{
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		zassert_ok(sensing_close_sensor(&clients[i].handle));
+	}
+
+	/* Let queued samples drain */
+	k_msleep(50);
+}
+
+static void *sensing_fanout_setup(void)
+{
+	const uint8_t accel_data[] = {0x10, 0x00, 0xf0, 0x00, 0x40, 0x00};
+	const uint8_t status = BIT_INT_STATUS_DATA_RDY;
+
+	icm42688_emul_set_reg(target, REG_ACCEL_DATA_X1, accel_data, sizeof(accel_data));
+	icm42688_emul_set_reg(target, REG_INT_STATUS, &status, 1);
+
+	k_thread_create(&worker_thread, worker_stack, K_THREAD_STACK_SIZEOF(worker_stack),
+			worker_entry, NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0,
+			K_NO_WAIT);
+
+	return NULL;
+}
+
+static const void *held;
+static struct sensing_sensor_value_3d_q31 held_copy;
+static uint32_t reused;
+
+static void on_data_event_hold(sensing_sensor_handle_t handle, const void *buf, void *context)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(context);
+
+	if (held == NULL) {
+		zassert_ok(sensing_data_ref(buf));
+		memcpy(&held_copy, buf, sizeof(held_copy));
+		held = buf;
+	} else if (buf == held) {
+		reused++;
+	}
+}
+
+ZTEST(sensing_fanout, test_ref_keeps_buffer)
+{
+	struct sensing_callback_list cb = {
+		.on_data_event = on_data_event_hold,
+	};
+	struct sensing_sensor_config config = {
+		.attri = SENSING_SENSOR_ATTRIBUTE_INTERVAL,
+		.interval = INTERVAL_US,
+	};
+	sensing_sensor_handle_t handle;
+
+	zassert_ok(sensing_open_sensor_by_dt(accel, &cb, &handle));
+	zassert_ok(sensing_set_config(handle, &config, 1));
+
+	/* Many more samples than mempool blocks pass while the first one is held */
+	k_msleep(CONFIG_SENSING_RTIO_BLOCK_COUNT * 2 * INTERVAL_US / USEC_PER_MSEC);
+
+	zassert_ok(sensing_close_sensor(&handle));
+	k_msleep(10);
+
+	zassert_not_null(held, "No sample received");
+	zassert_equal(reused, 0, "Held buffer was reused %u times", reused);
+	zassert_mem_equal(held, &held_copy, sizeof(held_copy));
+
+	zassert_ok(sensing_data_unref(held));
+	zassert_equal(sensing_data_unref(held), -EINVAL);
+	zassert_equal(sensing_data_ref(&held_copy), -EINVAL);
+}
+
+static void run(enum client_mode mode, const char *name)
+{
+	uint32_t received = 0;
+	uint32_t processed = 0;
+	uint32_t dropped = 0;
+	uint32_t cycles = 0;
+
+	open_clients(mode);
+	k_msleep(RUN_TIME_MS);
+	close_clients();
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		received += clients[i].received;
+		dropped += clients[i].dropped;
+		cycles += clients[i].cb_cycles;
+	}
+	processed = clients[0].processed;
+
+	zassert_true(received > 0, "No samples received");
+	zassert_equal(processed + dropped, received, "Lost samples");
+
+	TC_PRINT("%-4s: %u clients, %6u samples (%u dropped), %5llu ns per callback\n", name,
+		 NUM_CLIENTS, received, dropped, k_cyc_to_ns_floor64(cycles) / received);
+}
+
+ZTEST(sensing_fanout, test_benchmark)
+{
+	run(CLIENT_COPY, "copy");
+	run(CLIENT_REF, "ref");
+}
+
+ZTEST_SUITE(sensing_fanout, NULL, sensing_fanout_setup, NULL, NULL, NULL);
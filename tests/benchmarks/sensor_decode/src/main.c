@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#include "icm42688.h"
+#include "icm42688_decoder.h"
+#include "icm42688_emul.h"
+#include "icm42688_reg.h"
+
+#define NODE DT_NODELABEL(icm42688)
+
+/* Packets holding both accel and gyro data are 16 bytes */
+#define FRAME_SIZE 16
+#define NUM_FRAMES 120
+#define ITERATIONS 200
+
+/* Converting differently rounds the last bit */
+#define TOLERANCE 2
+
+static const struct device *dev = DEVICE_DT_GET(NODE);
+static const struct emul *target = EMUL_DT_GET(NODE);
+static const struct spi_dt_spec bus = SPI_DT_SPEC_GET(NODE, SPI_WORD_SET(8) | SPI_TRANSFER_MSB, 0);
+static const struct sensor_decoder_api *decoder;
+
+static uint8_t fifo_buf[sizeof(struct icm42688_fifo_data) + NUM_FRAMES * FRAME_SIZE];
+
+/* Per frame output of sensor_decode(), and bulk output of sensor_decode_q31() */
+static uint8_t decoded_buf[sizeof(struct sensor_three_axis_data) +
+			  (NUM_FRAMES - 1) * sizeof(struct sensor_three_axis_sample_data)]
+	__aligned(8);
+static struct sensor_three_axis_data *const decoded =
+	(struct sensor_three_axis_data *)decoded_buf;
+static q31_t values[NUM_FRAMES * 3];
+
+static void fill_frame(uint8_t *frame, uint32_t seed)
+{
+	frame[0] = FIFO_HEADER_ACCEL | FIFO_HEADER_GYRO;
+	for (int i = 0; i < 6; i++) {
+		/* Pseudo random readings spanning the full range */
+		seed = seed * 1103515245U + 12345U;
+		sys_put_be16((uint16_t)(seed >> 16), &frame[1 + i * 2]);
+		if ((int16_t)sys_get_be16(&frame[1 + i * 2]) <= -32767) {
+			sys_put_be16(0, &frame[1 + i * 2]);
+		}
+	}
+	frame[13] = seed & 0x3f;
+	sys_put_be16(0, &frame[14]);
+}
+
+static int spi_read_reg(uint8_t reg, uint8_t *data, size_t len)
+{
+	uint8_t addr = reg | REG_SPI_READ_BIT;
+	const struct spi_buf tx_buf = {.buf = &addr, .len = 1};
+	const struct spi_buf_set tx = {.buffers = &tx_buf, .count = 1};
+	struct spi_buf rx_buf[2] = {{.buf = NULL, .len = 1}, {.buf = data, .len = len}};
+	const struct spi_buf_set rx = {.buffers = rx_buf, .count = 2};
+
+	return spi_transceive_dt(&bus, &tx, &rx);
+}
+
+/* Load the emulator FIFO and read it back the way the streaming driver does */
+static void *sensor_decode_setup(void)
+{
+	struct icm42688_fifo_data *edata = (struct icm42688_fifo_data *)fifo_buf;
+	uint8_t frames[NUM_FRAMES * FRAME_SIZE];
+	uint8_t count[2];
+
+	zassert_ok(sensor_get_decoder(dev, &decoder));
+
+	for (int i = 0; i < NUM_FRAMES; i++) {
+		fill_frame(&frames[i * FRAME_SIZE], i);
+	}
+	zassert_ok(icm42688_emul_fifo_push(target, frames, sizeof(frames)));
+
+	zassert_ok(spi_read_reg(REG_FIFO_COUNTH, count, sizeof(count)));
+	zassert_equal(sys_get_be16(count), sizeof(frames));
+
+	*edata = (struct icm42688_fifo_data){
+		.header = {
+			.is_fifo = 1,
+			.accel_fs = ICM42688_ACCEL_FS_16G,
+			.gyro_fs = ICM42688_GYRO_FS_2000,
+		},
+		.accel_odr = ICM42688_ACCEL_ODR_32000,
+		.gyro_odr = ICM42688_GYRO_ODR_32000,
+		.fifo_count = sys_get_be16(count),
+	};
+	zassert_ok(spi_read_reg(REG_FIFO_DATA, &fifo_buf[sizeof(*edata)], sizeof(frames)));
+
+	return NULL;
+}
+
+static struct sensor_decode_context decode_context(enum sensor_channel chan_type)
+{
+	return (struct sensor_decode_context)SENSOR_DECODE_CONTEXT_INIT(decoder, fifo_buf,
+									 chan_type, 0);
+}
+
+static void check_three_axis(enum sensor_channel chan_type)
+{
+	struct sensor_decode_context ctx = decode_context(chan_type);
+	int8_t shift;
+	int count;
+
+	count = sensor_decode(&ctx, decoded, NUM_FRAMES);
+	zassert_equal(count, NUM_FRAMES);
+
+	ctx = decode_context(chan_type);
+	zassert_equal(sensor_decode_q31(&ctx, values, &shift, NUM_FRAMES), NUM_FRAMES);
+	zassert_equal(sensor_decode_q31(&ctx, values, &shift, NUM_FRAMES), 0);
+	zassert_equal(shift, decoded->shift);
+
+	for (int i = 0; i < count; i++) {
+		for (int axis = 0; axis < 3; axis++) {
+			q31_t expected = decoded->readings[i].values[axis];
+			q31_t actual = values[i * 3 + axis];
+
+			zassert_within(actual, expected, TOLERANCE,
+				       "Frame %d axis %d: expected %d, got %d", i, axis,
+				       expected, actual);
+		}
+	}
+}
+
+ZTEST(sensor_decode, test_accel_xyz)
+{
+	check_three_axis(SENSOR_CHAN_ACCEL_XYZ);
+}
+
+ZTEST(sensor_decode, test_gyro_xyz)
+{
+	check_three_axis(SENSOR_CHAN_GYRO_XYZ);
+}
+
+ZTEST(sensor_decode, test_single_axis_chunks)
+{
+	struct sensor_decode_context ctx = decode_context(SENSOR_CHAN_GYRO_XYZ);
+	int8_t shift;
+	int count = 0;
+	int rc;
+
+	zassert_equal(sensor_decode(&ctx, decoded, NUM_FRAMES), NUM_FRAMES);
+
+	/* Decode the Y axis only, a few frames at a time */
+	ctx = decode_context(SENSOR_CHAN_GYRO_Y);
+	while ((rc = sensor_decode_q31(&ctx, &values[count], &shift, 7)) > 0) {
+		count += rc;
+	}
+
+	zassert_equal(rc, 0);
+	zassert_equal(count, NUM_FRAMES);
+	zassert_equal(shift, decoded->shift);
+
+	for (int i = 0; i < count; i++) {
+		zassert_within(values[i], decoded->readings[i].y, TOLERANCE,
+			       "Frame %d: expected %d, got %d", i, decoded->readings[i].y,
+			       values[i]);
+	}
+}
+
+ZTEST(sensor_decode, test_generic_fallback)
+{
+	/* The temperature is not decoded in bulk by the driver */
+	struct sensor_decode_context ctx = decode_context(SENSOR_CHAN_DIE_TEMP);
+	struct sensor_q31_data *temp = (struct sensor_q31_data *)decoded_buf;
+	int8_t shift;
+
+	zassert_equal(sensor_decode(&ctx, temp, NUM_FRAMES), NUM_FRAMES);
+
+	ctx = decode_context(SENSOR_CHAN_DIE_TEMP);
+	zassert_equal(sensor_decode_q31(&ctx, values, &shift, NUM_FRAMES), NUM_FRAMES);
+	zassert_equal(shift, temp->shift);
+
+	for (int i = 0; i < NUM_FRAMES; i++) {
+		zassert_equal(values[i], temp->readings[i].temperature);
+	}
+}
+
+ZTEST(sensor_decode, test_q31_from_s16)
+{
+	const int16_t in[] = {0, 1, -1, INT16_MAX, -INT16_MAX, 1234, -4321};
+	const q31_t scale = INT32_MAX / 3;
+	q31_t out[ARRAY_SIZE(in)];
+
+	sensor_q31_from_s16(in, out, ARRAY_SIZE(in), scale);
+
+	for (int i = 0; i < ARRAY_SIZE(in); i++) {
+		int64_t expected = (int64_t)in[i] * scale / BIT(15);
+
+		zassert_within(out[i], expected, TOLERANCE, "in %d: expected %lld, got %d", in[i],
+			       expected, out[i]);
+	}
+}
+
+static uint32_t bench_decode(enum sensor_channel chan_type, uint16_t frames_per_call)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		struct sensor_decode_context ctx = decode_context(chan_type);
+
+		while (sensor_decode(&ctx, decoded, frames_per_call) > 0) {
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static uint32_t bench_decode_q31(enum sensor_channel chan_type)
+{
+	uint32_t start = k_cycle_get_32();
+	int8_t shift;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		struct sensor_decode_context ctx = decode_context(chan_type);
+
+		while (sensor_decode_q31(&ctx, values, &shift, NUM_FRAMES) > 0) {
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static void report(const char *name, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles) / ((uint64_t)ITERATIONS * NUM_FRAMES);
+
+	TC_PRINT("%-28s %8u cycles %6llu ns/frame\n", name, cycles, ns);
+}
+
+ZTEST(sensor_decode, test_benchmark)
+{
+	TC_PRINT("Decoding %d FIFO frames %d times\n", NUM_FRAMES, ITERATIONS);
+
+	report("accel decode, 1 frame/call", bench_decode(SENSOR_CHAN_ACCEL_XYZ, 1));
+	report("accel decode, all frames", bench_decode(SENSOR_CHAN_ACCEL_XYZ, NUM_FRAMES));
+	report("accel decode_q31", bench_decode_q31(SENSOR_CHAN_ACCEL_XYZ));
+	report("accel x decode_q31", bench_decode_q31(SENSOR_CHAN_ACCEL_X));
+	report("temp decode, all frames", bench_decode(SENSOR_CHAN_DIE_TEMP, NUM_FRAMES));
+	report("temp decode_q31 (generic)", bench_decode_q31(SENSOR_CHAN_DIE_TEMP));
+}
+
+ZTEST_SUITE(sensor_decode, NULL, sensor_decode_setup, NULL, NULL, NULL);
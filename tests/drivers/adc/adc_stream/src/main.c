@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define RESOLUTION  12
+#define REF_MV      BIT_MASK(RESOLUTION)
+#define CONST_MV    2000
+#define INTERVAL_US 100
+#define SAMPLINGS   32
+#define CHANNELS    (BIT(0) | BIT(1))
+#define PERIOD_NS   ((uint64_t)SAMPLINGS * INTERVAL_US * NSEC_PER_USEC)
+#define PERIOD_MS   DIV_ROUND_UP(SAMPLINGS * INTERVAL_US, USEC_PER_MSEC)
+#define BLK_SIZE    64
+#define NUM_BLKS    8
+
+static const struct device *adc = DEVICE_DT_GET(DT_NODELABEL(adc0));
+
+ADC_DT_STREAM_IODEV(stream_iodev, DT_NODELABEL(adc0), CHANNELS, RESOLUTION, INTERVAL_US,
+		    SAMPLINGS);
+ADC_DT_STREAM_IODEV(other_iodev, DT_NODELABEL(adc0), BIT(0), RESOLUTION, INTERVAL_US, 1);
+
+/* Samples averaged from 4 conversions each */
+#define OVERSAMPLING 2
+
+static struct adc_stream_config oversampled_cfg = {
+	.dev = DEVICE_DT_GET(DT_NODELABEL(adc0)),
+	.channels = CHANNELS,
+	.interval_us = INTERVAL_US,
+	.samplings = SAMPLINGS,
+	.resolution = RESOLUTION,
+	.oversampling = OVERSAMPLING,
+};
+RTIO_IODEV_DEFINE(oversampled_iodev, &__adc_iodev_api, &oversampled_cfg);
+
+RTIO_DEFINE_WITH_MEMPOOL(r, 8, 8, NUM_BLKS, BLK_SIZE, 4);
+
+/* Size of a buffer, as taken from the mempool */
+#define BUF_SIZE                                                                                   \
+	ROUND_UP(sizeof(struct adc_stream_header) + SAMPLINGS * 2 * sizeof(uint16_t), BLK_SIZE)
+
+static uint8_t user_buf[2][BUF_SIZE] __aligned(8);
+
+/* Channel 1 reads a ramp, so lost or repeated samplings show up */
+static uint32_t ramp;
+
+static int ramp_value(const struct device *dev, unsigned int chan, void *data, uint32_t *result)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(chan);
+	ARG_UNUSED(data);
+
+	*result = ramp++ % (REF_MV + 1);
+
+	return 0;
+}
+
+static struct rtio_cqe *wait_cqe(void)
+{
+	for (int i = 0; i < 10 * PERIOD_MS; i++) {
+		struct rtio_cqe *cqe = rtio_cqe_consume(&r);
+
+		if (cqe != NULL) {
+			return cqe;
+		}
+		k_msleep(1);
+	}
+
+	return NULL;
+}
+
+/* Check a buffer, returns the ramp value of its last sampling */
+static uint32_t check_buffer(const uint8_t *buf, uint32_t first)
+{
+	const struct adc_stream_header *hdr = (const struct adc_stream_header *)buf;
+
+	zassert_equal(hdr->channels, CHANNELS);
+	zassert_equal(hdr->samplings, SAMPLINGS);
+	zassert_equal(hdr->interval_ns, INTERVAL_US * NSEC_PER_USEC);
+
+	for (int i = 0; i < SAMPLINGS; i++) {
+		zassert_equal(hdr->samples[2 * i], CONST_MV, "Sampling %d of channel 0", i);
+		zassert_equal(hdr->samples[2 * i + 1], (first + i) % (REF_MV + 1),
+			      "Sampling %d of channel 1", i);
+	}
+
+	return first + SAMPLINGS - 1;
+}
+
+static void *adc_stream_setup(void)
+{
+	struct adc_channel_cfg cfg = {
+		.gain = ADC_GAIN_1,
+		.reference = ADC_REF_EXTERNAL0,
+		.acquisition_time = ADC_ACQ_TIME_DEFAULT,
+	};
+
+	zassert_true(device_is_ready(adc));
+	zassert_ok(adc_emul_ref_voltage_set(adc, ADC_REF_EXTERNAL0, REF_MV));
+
+	for (cfg.channel_id = 0; cfg.channel_id < 2; cfg.channel_id++) {
+		zassert_ok(adc_channel_setup(adc, &cfg));
+	}
+
+	zassert_ok(adc_emul_const_value_set(adc, 0, CONST_MV));
+	zassert_ok(adc_emul_value_func_set(adc, 1, ramp_value, NULL));
+
+	return NULL;
+}
+
+static void adc_stream_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	ramp = 0;
+}
+
+static void adc_stream_after(void *fixture)
+{
+	struct rtio_cqe *cqe;
+
+	ARG_UNUSED(fixture);
+
+	/* Let a canceled stream stop */
+	k_msleep(2 * PERIOD_MS);
+
+	while ((cqe = rtio_cqe_consume(&r)) != NULL) {
+		rtio_cqe_release(&r, cqe);
+	}
+}
+
+ZTEST(adc_stream, test_multishot)
+{
+	struct rtio_sqe *handle;
+	struct rtio_cqe *cqe;
+	uint64_t timestamp = 0;
+	uint32_t last = 0;
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	zassert_ok(adc_stream(&stream_iodev, &r, user_buf, &handle));
+
+	for (int i = 0; i < 4; i++) {
+		const struct adc_stream_header *hdr;
+
+		cqe = wait_cqe();
+		zassert_not_null(cqe, "No buffer %d", i);
+		zassert_ok(cqe->result);
+		zassert_equal_ptr(cqe->userdata, user_buf);
+		zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe, &buf, &buf_len));
+		zassert_equal(buf_len, BUF_SIZE);
+
+		hdr = (const struct adc_stream_header *)buf;
+		zassert_equal(hdr->dropped, 0);
+		if (i > 0) {
+			/* Buffers follow each other without a gap */
+			zassert_equal(hdr->timestamp_ns, timestamp + PERIOD_NS);
+		}
+		timestamp = hdr->timestamp_ns;
+		last = check_buffer(buf, i == 0 ? 0 : last + 1);
+
+		rtio_release_buffer(&r, buf, buf_len);
+		rtio_cqe_release(&r, cqe);
+	}
+
+	rtio_sqe_cancel(handle);
+	k_msleep(2 * PERIOD_MS);
+	zassert_is_null(rtio_cqe_consume(&r), "Canceled stream completed");
+}
+
+ZTEST(adc_stream, test_double_buffer)
+{
+	struct rtio_cqe *cqe;
+	uint64_t timestamp = 0;
+
+	/* The second read is armed while the first one completes */
+	for (int i = 0; i < ARRAY_SIZE(user_buf); i++) {
+		struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+
+		rtio_sqe_prep_read(sqe, &stream_iodev, RTIO_PRIO_NORM, user_buf[i],
+				   sizeof(user_buf[i]), user_buf[i]);
+	}
+	zassert_ok(rtio_submit(&r, 0));
+
+	for (int i = 0; i < ARRAY_SIZE(user_buf); i++) {
+		const struct adc_stream_header *hdr = (const void *)user_buf[i];
+
+		cqe = wait_cqe();
+		zassert_not_null(cqe);
+		zassert_ok(cqe->result);
+		zassert_equal_ptr(cqe->userdata, user_buf[i]);
+		rtio_cqe_release(&r, cqe);
+
+		zassert_equal(hdr->dropped, 0);
+		if (i > 0) {
+			zassert_equal(hdr->timestamp_ns, timestamp + PERIOD_NS);
+		}
+		timestamp = hdr->timestamp_ns;
+		check_buffer(user_buf[i], i * SAMPLINGS);
+	}
+
+	/* Without a pending read the stream stops */
+	k_msleep(2 * PERIOD_MS);
+	zassert_equal(ramp, 2 * SAMPLINGS, "Sampled without a pending read");
+}
+
+ZTEST(adc_stream, test_dropped)
+{
+	struct rtio_sqe *handle;
+	struct rtio_cqe *cqe[2];
+	const struct adc_stream_header *hdr;
+	uint8_t *buf[2];
+	uint32_t buf_len[2];
+
+	zassert_ok(adc_stream(&stream_iodev, &r, NULL, &handle));
+
+	/* Hold on to the buffers until the mempool runs out of blocks */
+	for (int i = 0; i < 2; i++) {
+		cqe[i] = wait_cqe();
+		zassert_not_null(cqe[i]);
+		zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe[i], &buf[i], &buf_len[i]));
+	}
+
+	k_msleep(3 * PERIOD_MS);
+
+	for (int i = 0; i < 2; i++) {
+		rtio_release_buffer(&r, buf[i], buf_len[i]);
+		rtio_cqe_release(&r, cqe[i]);
+	}
+
+	cqe[0] = wait_cqe();
+	zassert_not_null(cqe[0]);
+	zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe[0], &buf[0], &buf_len[0]));
+
+	hdr = (const struct adc_stream_header *)buf[0];
+	zassert_true(hdr->dropped > 0, "Lost samplings not reported");
+	zassert_equal(hdr->dropped % SAMPLINGS, 0);
+
+	rtio_release_buffer(&r, buf[0], buf_len[0]);
+	rtio_cqe_release(&r, cqe[0]);
+	rtio_sqe_cancel(handle);
+}
+
+ZTEST(adc_stream, test_busy)
+{
+	struct rtio_sqe *handle;
+	struct rtio_cqe *cqe;
+
+	zassert_ok(adc_stream(&stream_iodev, &r, user_buf[0], &handle));
+	zassert_ok(adc_stream(&other_iodev, &r, user_buf[1], NULL));
+
+	/* Only one stream configuration runs at a time */
+	cqe = wait_cqe();
+	zassert_not_null(cqe);
+	zassert_equal(cqe->result, -EBUSY);
+	zassert_equal_ptr(cqe->userdata, user_buf[1]);
+	rtio_cqe_release(&r, cqe);
+
+	rtio_sqe_cancel(handle);
+}
+
+ZTEST(adc_stream, test_oversampling)
+{
+	const struct adc_stream_header *hdr = (const void *)user_buf[0];
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+
+	rtio_sqe_prep_read(sqe, &oversampled_iodev, RTIO_PRIO_NORM, user_buf[0],
+			   sizeof(user_buf[0]), user_buf[0]);
+	zassert_ok(rtio_submit(&r, 0));
+
+	cqe = wait_cqe();
+	zassert_not_null(cqe);
+	zassert_ok(cqe->result);
+	rtio_cqe_release(&r, cqe);
+
+	zassert_equal(hdr->samplings, SAMPLINGS);
+	for (int i = 0; i < SAMPLINGS; i++) {
+		uint32_t first = i * BIT(OVERSAMPLING);
+
+		zassert_equal(hdr->samples[2 * i], CONST_MV, "Sampling %d of channel 0", i);
+		/* Average of the ramp values first to first + 3, rounded down */
+		zassert_equal(hdr->samples[2 * i + 1], first + 1, "Sampling %d of channel 1", i);
+	}
+}
+
+ZTEST_SUITE(adc_stream, NULL, adc_stream_setup, adc_stream_before, adc_stream_after, NULL);
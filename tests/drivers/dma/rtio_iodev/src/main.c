@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/dma/rtio.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define XFER_SIZE   16
+#define NUM_BLOCKS  3
+#define BURST_SIZE  4
+#define TIMEOUT_MS  100
+
+/* Stands in for a peripheral data register */
+static uint8_t periph_reg[XFER_SIZE];
+
+static uint8_t tx_buf[NUM_BLOCKS * XFER_SIZE];
+static uint8_t rx_buf[NUM_BLOCKS][XFER_SIZE];
+static uint8_t chain_buf[XFER_SIZE];
+
+DMA_RTIO_IODEV_DEFINE(dma_iodev, DEVICE_DT_GET(DT_NODELABEL(dma)), 0, (uintptr_t)periph_reg,
+		      .source_data_size = 1, .dest_data_size = 1,
+		      .source_burst_length = BURST_SIZE, .dest_burst_length = BURST_SIZE);
+
+RTIO_DEFINE_WITH_MEMPOOL(r, 8, 8, 4, XFER_SIZE, 4);
+
+static struct rtio_cqe *wait_cqe(void)
+{
+	struct rtio_cqe *cqe;
+
+	/* Transfers complete from the DMA emulator's work queue */
+	for (int i = 0; i < TIMEOUT_MS; i++) {
+		cqe = rtio_cqe_consume(&r);
+		if (cqe != NULL) {
+			return cqe;
+		}
+		k_msleep(1);
+	}
+
+	return NULL;
+}
+
+static void expect_cqe(int result, void *userdata)
+{
+	struct rtio_cqe *cqe = wait_cqe();
+
+	zassert_not_null(cqe, "No completion");
+	zassert_equal(cqe->result, result, "Expected %d, got %d", result, cqe->result);
+	zassert_equal_ptr(cqe->userdata, userdata);
+	rtio_cqe_release(&r, cqe);
+}
+
+static void *dma_rtio_setup(void)
+{
+	zassert_true(dma_rtio_is_ready(&dma_iodev));
+
+	return NULL;
+}
+
+static void dma_rtio_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = i;
+	}
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+	memset(chain_buf, 0, sizeof(chain_buf));
+}
+
+ZTEST(dma_rtio, test_copy)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+
+	rtio_sqe_prep_transceive(sqe, &dma_iodev, RTIO_PRIO_NORM, tx_buf, rx_buf[0], XFER_SIZE,
+				 tx_buf);
+	zassert_ok(rtio_submit(&r, 0));
+
+	expect_cqe(0, tx_buf);
+	zassert_mem_equal(rx_buf[0], tx_buf, XFER_SIZE);
+}
+
+ZTEST(dma_rtio, test_scatter_gather)
+{
+	struct rtio_sqe *sqe;
+
+	/* One transaction, moved as a single transfer of three blocks */
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		sqe = rtio_sqe_acquire(&r);
+		rtio_sqe_prep_transceive(sqe, &dma_iodev, RTIO_PRIO_NORM, &tx_buf[i * XFER_SIZE],
+					 rx_buf[i], XFER_SIZE, rx_buf);
+		sqe->flags |= RTIO_SQE_TRANSACTION;
+	}
+	sqe->flags &= ~RTIO_SQE_TRANSACTION;
+
+	zassert_ok(rtio_submit(&r, 0));
+
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		expect_cqe(0, rx_buf);
+	}
+
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		zassert_mem_equal(rx_buf[i], &tx_buf[i * XFER_SIZE], XFER_SIZE);
+	}
+}
+
+ZTEST(dma_rtio, test_chain)
+{
+	struct rtio_sqe *first = rtio_sqe_acquire(&r);
+	struct rtio_sqe *second = rtio_sqe_acquire(&r);
+
+	/* The second copy reads what the first one wrote */
+	rtio_sqe_prep_transceive(first, &dma_iodev, RTIO_PRIO_NORM, tx_buf, rx_buf[0], XFER_SIZE,
+				 rx_buf[0]);
+	first->flags |= RTIO_SQE_CHAINED;
+	rtio_sqe_prep_transceive(second, &dma_iodev, RTIO_PRIO_NORM, rx_buf[0], chain_buf,
+				 XFER_SIZE, chain_buf);
+
+	zassert_ok(rtio_submit(&r, 0));
+
+	expect_cqe(0, rx_buf[0]);
+	expect_cqe(0, chain_buf);
+	zassert_mem_equal(chain_buf, tx_buf, XFER_SIZE);
+}
+
+ZTEST(dma_rtio, test_tx_rx)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	rtio_sqe_prep_write(sqe, &dma_iodev, RTIO_PRIO_NORM, tx_buf, XFER_SIZE, tx_buf);
+	sqe->flags |= RTIO_SQE_CHAINED;
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_read_with_pool(sqe, &dma_iodev, RTIO_PRIO_NORM, periph_reg);
+
+	zassert_ok(rtio_submit(&r, 0));
+
+	/* The emulator copies whole blocks to and from the peripheral register */
+	expect_cqe(0, tx_buf);
+	zassert_mem_equal(periph_reg, tx_buf, XFER_SIZE);
+
+	cqe = wait_cqe();
+	zassert_not_null(cqe);
+	zassert_ok(cqe->result);
+	zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe, &buf, &buf_len));
+	zassert_equal(buf_len, XFER_SIZE);
+	zassert_mem_equal(buf, periph_reg, XFER_SIZE);
+	rtio_release_buffer(&r, buf, buf_len);
+	rtio_cqe_release(&r, cqe);
+}
+
+ZTEST(dma_rtio, test_mixed_directions)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+
+	rtio_sqe_prep_transceive(sqe, &dma_iodev, RTIO_PRIO_NORM, tx_buf, rx_buf[0], XFER_SIZE,
+				 NULL);
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_write(sqe, &dma_iodev, RTIO_PRIO_NORM, tx_buf, XFER_SIZE, rx_buf);
+
+	zassert_ok(rtio_submit(&r, 0));
+
+	/* The rest of a failed transaction is canceled */
+	expect_cqe(-EINVAL, NULL);
+	expect_cqe(-ECANCELED, rx_buf);
+}
+
+ZTEST(dma_rtio, test_too_many_blocks)
+{
+	struct rtio_sqe *sqe;
+
+	for (int i = 0; i <= CONFIG_DMA_RTIO_MAX_BLOCKS; i++) {
+		sqe = rtio_sqe_acquire(&r);
+		zassert_not_null(sqe);
+		rtio_sqe_prep_transceive(sqe, &dma_iodev, RTIO_PRIO_NORM, tx_buf, rx_buf[0], 1,
+					 chain_buf);
+		sqe->flags |= RTIO_SQE_TRANSACTION;
+	}
+	sqe->flags &= ~RTIO_SQE_TRANSACTION;
+
+	zassert_ok(rtio_submit(&r, 0));
+
+	expect_cqe(-ENOMEM, chain_buf);
+	for (int i = 0; i < CONFIG_DMA_RTIO_MAX_BLOCKS; i++) {
+		expect_cqe(-ECANCELED, chain_buf);
+	}
+}
+
+ZTEST_SUITE(dma_rtio, NULL, dma_rtio_setup, dma_rtio_before, NULL, NULL);
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define LATENCY_US 2000
+#define MEM_ADDR   0x10
+
+I2C_DT_IODEV_DEFINE(eeprom_iodev, DT_NODELABEL(i2c_eeprom));
+RTIO_DEFINE(r, 8, 8);
+
+static const struct device *bus = DEVICE_DT_GET(DT_BUS(DT_NODELABEL(i2c_eeprom)));
+
+static const uint8_t pattern[] = {0xde, 0xad, 0xbe, 0xef};
+
+static void prep_write(uint8_t addr, const uint8_t *data, uint8_t len, void *userdata)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	uint8_t buf[5];
+
+	zassert_not_null(sqe);
+	zassert_true(len < sizeof(buf));
+
+	buf[0] = addr;
+	memcpy(&buf[1], data, len);
+
+	rtio_sqe_prep_tiny_write(sqe, &eeprom_iodev, RTIO_PRIO_NORM, buf, len + 1, userdata);
+	sqe->iodev_flags = RTIO_IODEV_I2C_STOP;
+}
+
+static void prep_read(uint8_t addr, uint8_t *data, uint32_t len, int8_t prio, void *userdata)
+{
+	struct rtio_sqe *write_addr = rtio_sqe_acquire(&r);
+	struct rtio_sqe *read_data = rtio_sqe_acquire(&r);
+
+	zassert_not_null(write_addr);
+	zassert_not_null(read_data);
+
+	rtio_sqe_prep_tiny_write(write_addr, &eeprom_iodev, prio, &addr, 1, NULL);
+	write_addr->flags = RTIO_SQE_TRANSACTION;
+	rtio_sqe_prep_read(read_data, &eeprom_iodev, prio, data, len, userdata);
+	read_data->iodev_flags = RTIO_IODEV_I2C_RESTART | RTIO_IODEV_I2C_STOP;
+}
+
+static void consume_ok(void *userdata)
+{
+	struct rtio_cqe *cqe = rtio_cqe_consume_block(&r);
+
+	zassert_equal(cqe->result, 0, "Transfer failed (%d)", cqe->result);
+	zassert_equal(cqe->userdata, userdata);
+	rtio_cqe_release(&r, cqe);
+}
+
+ZTEST(i2c_emul_rtio, test_write_read)
+{
+	uint8_t buf[sizeof(pattern)] = {0};
+
+	prep_write(MEM_ADDR, pattern, sizeof(pattern), NULL);
+	zassert_ok(rtio_submit(&r, 1));
+	consume_ok(NULL);
+
+	prep_read(MEM_ADDR, buf, sizeof(buf), RTIO_PRIO_NORM, buf);
+	zassert_ok(rtio_submit(&r, 1));
+	consume_ok(buf);
+
+	zassert_mem_equal(buf, pattern, sizeof(pattern));
+}
+
+ZTEST(i2c_emul_rtio, test_latency)
+{
+	uint8_t buf[sizeof(pattern)] = {0};
+	int64_t start;
+	uint64_t elapsed_us;
+
+	i2c_emul_rtio_latency_set(bus, LATENCY_US);
+
+	/* The write completes before the read of the same bytes is started */
+	prep_write(MEM_ADDR + 8, pattern, sizeof(pattern), pattern);
+	prep_read(MEM_ADDR + 8, buf, sizeof(buf), RTIO_PRIO_NORM, buf);
+
+	start = k_uptime_ticks();
+	zassert_ok(rtio_submit(&r, 0));
+
+	/* Nothing completes before the latency passed */
+	zassert_is_null(rtio_cqe_consume(&r));
+
+	consume_ok((void *)pattern);
+	consume_ok(buf);
+	elapsed_us = k_ticks_to_us_ceil64(k_uptime_ticks() - start);
+
+	zassert_true(elapsed_us >= (2 * LATENCY_US), "Completed after %llu us", elapsed_us);
+	zassert_mem_equal(buf, pattern, sizeof(pattern));
+
+	i2c_emul_rtio_latency_set(bus, 0);
+}
+
+ZTEST(i2c_emul_rtio, test_coalesce)
+{
+	uint8_t buf[4][sizeof(pattern)] = {0};
+	int64_t start;
+	uint64_t elapsed_us;
+
+	i2c_emul_rtio_latency_set(bus, LATENCY_US);
+	i2c_emul_rtio_coalesce_set(bus, ARRAY_SIZE(buf));
+
+	for (int i = 0; i < ARRAY_SIZE(buf); i++) {
+		prep_read(MEM_ADDR, buf[i], sizeof(buf[i]), RTIO_PRIO_NORM, buf[i]);
+	}
+
+	start = k_uptime_ticks();
+	zassert_ok(rtio_submit(&r, 0));
+
+	/* The first read starts alone, the three queued behind it share one latency */
+	for (int i = 0; i < ARRAY_SIZE(buf); i++) {
+		consume_ok(buf[i]);
+	}
+	elapsed_us = k_ticks_to_us_ceil64(k_uptime_ticks() - start);
+
+	zassert_true(elapsed_us >= (2 * LATENCY_US), "Completed after %llu us", elapsed_us);
+	zassert_true(elapsed_us < (3 * LATENCY_US), "Not coalesced, took %llu us", elapsed_us);
+
+	i2c_emul_rtio_coalesce_set(bus, 1);
+	i2c_emul_rtio_latency_set(bus, 0);
+}
+
+ZTEST(i2c_emul_rtio, test_priority)
+{
+	uint8_t buf[3][sizeof(pattern)] = {0};
+
+	i2c_emul_rtio_latency_set(bus, LATENCY_US);
+
+	/* The first read holds the bus while the others queue up */
+	prep_read(MEM_ADDR, buf[0], sizeof(buf[0]), RTIO_PRIO_LOW, buf[0]);
+	prep_read(MEM_ADDR, buf[1], sizeof(buf[1]), RTIO_PRIO_LOW, buf[1]);
+	prep_read(MEM_ADDR, buf[2], sizeof(buf[2]), RTIO_PRIO_HIGH, buf[2]);
+	zassert_ok(rtio_submit(&r, 0));
+
+	consume_ok(buf[0]);
+	consume_ok(buf[2]);
+	consume_ok(buf[1]);
+
+	i2c_emul_rtio_latency_set(bus, 0);
+}
+
+ZTEST_SUITE(i2c_emul_rtio, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/spi_emul.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#include "icm42688_emul.h"
+#include "icm42688_reg.h"
+
+#define LATENCY_US 2000
+
+#define SPI_OP (SPI_OP_MODE_MASTER | SPI_WORD_SET(8) | SPI_TRANSFER_MSB)
+
+SPI_DT_IODEV_DEFINE(icm42688_iodev, DT_NODELABEL(icm42688), SPI_OP, 0U);
+/* Stands in for a display sharing the bus, its transfers never reach the emulator */
+SPI_DT_IODEV_DEFINE(display_iodev, DT_NODELABEL(icm42688), SPI_OP, 0U);
+RTIO_DEFINE(r, 8, 8);
+
+#define FRAME_CHUNKS 16
+
+static uint8_t frame[FRAME_CHUNKS * CONFIG_SPI_RTIO_CHUNK_SIZE];
+
+/* Device of each transfer on the bus in order, 'd' for a display transfer not chunked */
+static char transfers[FRAME_CHUNKS + 4];
+static size_t transfer_count;
+
+static const struct device *bus = DEVICE_DT_GET(DT_BUS(DT_NODELABEL(icm42688)));
+static const struct emul *target = EMUL_DT_GET(DT_NODELABEL(icm42688));
+
+static int mock_io(const struct emul *emul, const struct spi_config *config,
+		   const struct spi_buf_set *tx_bufs, const struct spi_buf_set *rx_bufs)
+{
+	const struct spi_dt_spec *display = display_iodev.data;
+	char device = 'I';
+
+	ARG_UNUSED(emul);
+	ARG_UNUSED(rx_bufs);
+
+	/* Called from the bus timer, so record rather than assert */
+	if (config == &display->config) {
+		device = (tx_bufs->count == 1 &&
+			  tx_bufs->buffers[0].len == CONFIG_SPI_RTIO_CHUNK_SIZE) ? 'D' : 'd';
+	}
+
+	if (transfer_count < sizeof(transfers)) {
+		transfers[transfer_count++] = device;
+	}
+
+	return (device == 'I') ? -ENOSYS : 0;
+}
+
+static struct spi_emul_api mock_api = {
+	.io = mock_io,
+};
+
+/* Queue a register read as a transaction of a register write and a read */
+static void prep_reg_read(uint8_t reg, uint8_t *buf, uint32_t len, void *userdata)
+{
+	struct rtio_sqe *write_reg = rtio_sqe_acquire(&r);
+	struct rtio_sqe *read_reg = rtio_sqe_acquire(&r);
+	uint8_t addr = reg | REG_SPI_READ_BIT;
+
+	zassert_not_null(write_reg);
+	zassert_not_null(read_reg);
+
+	rtio_sqe_prep_tiny_write(write_reg, &icm42688_iodev, RTIO_PRIO_NORM, &addr, 1, NULL);
+	write_reg->flags = RTIO_SQE_TRANSACTION;
+	rtio_sqe_prep_read(read_reg, &icm42688_iodev, RTIO_PRIO_NORM, buf, len, userdata);
+}
+
+static void consume_ok(void *userdata)
+{
+	struct rtio_cqe *cqe = rtio_cqe_consume_block(&r);
+
+	zassert_equal(cqe->result, 0, "Transfer failed (%d)", cqe->result);
+	zassert_equal(cqe->userdata, userdata);
+	rtio_cqe_release(&r, cqe);
+}
+
+ZTEST(spi_emul_rtio, test_read_transaction)
+{
+	const uint8_t expected[] = {0x12, 0x34, 0x56, 0x78};
+	uint8_t buf[sizeof(expected)] = {0};
+
+	icm42688_emul_set_reg(target, REG_ACCEL_DATA_X1, expected, sizeof(expected));
+
+	prep_reg_read(REG_ACCEL_DATA_X1, buf, sizeof(buf), buf);
+	zassert_ok(rtio_submit(&r, 1));
+	consume_ok(buf);
+
+	zassert_mem_equal(buf, expected, sizeof(expected));
+}
+
+ZTEST(spi_emul_rtio, test_tiny_write)
+{
+	uint8_t reset[] = {REG_DEVICE_CONFIG, BIT_SOFT_RESET};
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	uint8_t status = 0;
+
+	rtio_sqe_prep_tiny_write(sqe, &icm42688_iodev, RTIO_PRIO_NORM, reset, sizeof(reset),
+				 NULL);
+	zassert_ok(rtio_submit(&r, 1));
+	consume_ok(NULL);
+
+	icm42688_emul_get_reg(target, REG_INT_STATUS, &status, 1);
+	zassert_true(status & BIT_INT_STATUS_RESET_DONE, "Reset not handled by emulator");
+}
+
+ZTEST(spi_emul_rtio, test_latency)
+{
+	uint8_t who_am_i[2] = {0};
+	int64_t start;
+	uint64_t elapsed_us;
+
+	spi_emul_rtio_latency_set(bus, LATENCY_US);
+
+	/* Transactions queued on the same bus complete one latency apart */
+	prep_reg_read(REG_WHO_AM_I, &who_am_i[0], 1, &who_am_i[0]);
+	prep_reg_read(REG_WHO_AM_I, &who_am_i[1], 1, &who_am_i[1]);
+
+	start = k_uptime_ticks();
+	zassert_ok(rtio_submit(&r, 0));
+
+	/* Nothing completes before the latency passed */
+	zassert_is_null(rtio_cqe_consume(&r));
+
+	consume_ok(&who_am_i[0]);
+	consume_ok(&who_am_i[1]);
+	elapsed_us = k_ticks_to_us_ceil64(k_uptime_ticks() - start);
+
+	zassert_true(elapsed_us >= (2 * LATENCY_US), "Completed after %llu us", elapsed_us);
+	zassert_equal(who_am_i[0], WHO_AM_I_ICM42688);
+	zassert_equal(who_am_i[1], WHO_AM_I_ICM42688);
+
+	spi_emul_rtio_latency_set(bus, 0);
+}
+
+ZTEST(spi_emul_rtio, test_chunked_priority)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	uint8_t who_am_i = 0;
+	int64_t start;
+	uint64_t elapsed_us;
+
+	spi_emul_rtio_latency_set(bus, LATENCY_US);
+
+	/* A long display update at low priority holds the bus a chunk at a time */
+	rtio_sqe_prep_write(sqe, &display_iodev, RTIO_PRIO_LOW, frame, sizeof(frame), frame);
+	sqe->iodev_flags = RTIO_IODEV_SPI_CHUNKED;
+	zassert_ok(rtio_submit(&r, 0));
+
+	start = k_uptime_ticks();
+	prep_reg_read(REG_WHO_AM_I, &who_am_i, 1, &who_am_i);
+	zassert_ok(rtio_submit(&r, 0));
+
+	/* The sensor read goes right after the chunk in flight */
+	consume_ok(&who_am_i);
+	elapsed_us = k_ticks_to_us_ceil64(k_uptime_ticks() - start);
+	zassert_true(elapsed_us < (3 * LATENCY_US), "Read held off for %llu us", elapsed_us);
+	zassert_equal(who_am_i, WHO_AM_I_ICM42688);
+
+	consume_ok(frame);
+
+	zassert_equal(transfer_count, FRAME_CHUNKS + 1);
+	zassert_equal(transfers[0], 'D');
+	zassert_equal(transfers[1], 'I');
+	for (size_t i = 2; i < transfer_count; i++) {
+		zassert_equal(transfers[i], 'D');
+	}
+
+	spi_emul_rtio_latency_set(bus, 0);
+}
+
+ZTEST(spi_emul_rtio, test_coalesce)
+{
+	uint8_t who_am_i[4] = {0};
+	int64_t start;
+	uint64_t elapsed_us;
+
+	spi_emul_rtio_latency_set(bus, LATENCY_US);
+	spi_emul_rtio_coalesce_set(bus, ARRAY_SIZE(who_am_i));
+
+	for (int i = 0; i < ARRAY_SIZE(who_am_i); i++) {
+		prep_reg_read(REG_WHO_AM_I, &who_am_i[i], 1, &who_am_i[i]);
+	}
+
+	start = k_uptime_ticks();
+	zassert_ok(rtio_submit(&r, 0));
+
+	/* The first read starts alone, the three queued behind it share one latency */
+	for (int i = 0; i < ARRAY_SIZE(who_am_i); i++) {
+		consume_ok(&who_am_i[i]);
+		zassert_equal(who_am_i[i], WHO_AM_I_ICM42688);
+	}
+	elapsed_us = k_ticks_to_us_ceil64(k_uptime_ticks() - start);
+
+	zassert_true(elapsed_us >= (2 * LATENCY_US), "Completed after %llu us", elapsed_us);
+	zassert_true(elapsed_us < (3 * LATENCY_US), "Not coalesced, took %llu us", elapsed_us);
+	zassert_equal(transfer_count, ARRAY_SIZE(who_am_i));
+
+	spi_emul_rtio_coalesce_set(bus, 1);
+	spi_emul_rtio_latency_set(bus, 0);
+}
+
+static void *spi_emul_rtio_setup(void)
+{
+	target->bus.spi->mock_api = &mock_api;
+
+	return NULL;
+}
+
+static void spi_emul_rtio_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	transfer_count = 0;
+}
+
+ZTEST_SUITE(spi_emul_rtio, NULL, spi_emul_rtio_setup, spi_emul_rtio_before, NULL, NULL);
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/drivers/serial/uart_rtio.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define BLK_SIZE    32
+#define RX_LEN      (2 * BLK_SIZE)
+#define RX_TIMEOUT  1000
+#define TIMEOUT_MS  100
+#define CHAIN_LEN   8
+#define ITERATIONS  64
+
+static const struct device *euart0 = DEVICE_DT_GET(DT_NODELABEL(euart0));
+static const struct device *euart1 = DEVICE_DT_GET(DT_NODELABEL(euart1));
+
+UART_RTIO_IODEV_DEFINE(uart_iodev, DEVICE_DT_GET(DT_NODELABEL(euart0)), RX_LEN, RX_TIMEOUT);
+UART_RTIO_IODEV_DEFINE(loop_iodev, DEVICE_DT_GET(DT_NODELABEL(euart1)), RX_LEN, RX_TIMEOUT);
+
+RTIO_DEFINE_WITH_MEMPOOL(r, 32, 32, 32, BLK_SIZE, 4);
+
+static uint8_t tx_buf[CHAIN_LEN][RX_LEN];
+static uint8_t rx_buf[RX_LEN];
+
+static struct rtio_cqe *wait_cqe(void)
+{
+	struct rtio_cqe *cqe;
+
+	/* Transfers complete from the UART emulator's work queue */
+	for (int i = 0; i < TIMEOUT_MS; i++) {
+		cqe = rtio_cqe_consume(&r);
+		if (cqe != NULL) {
+			return cqe;
+		}
+		k_msleep(1);
+	}
+
+	return NULL;
+}
+
+static void expect_cqe(int result, void *userdata)
+{
+	struct rtio_cqe *cqe = wait_cqe();
+
+	zassert_not_null(cqe, "No completion");
+	zassert_equal(cqe->result, result, "Expected %d, got %d", result, cqe->result);
+	zassert_equal_ptr(cqe->userdata, userdata);
+	rtio_cqe_release(&r, cqe);
+}
+
+static void uart_rtio_flush_tx(const struct device *dev, size_t size, void *user_data)
+{
+	ARG_UNUSED(size);
+	ARG_UNUSED(user_data);
+
+	/* Nobody reads the looped back TX side, keep it from filling up */
+	uart_emul_flush_tx_data(dev);
+}
+
+static void *uart_rtio_setup(void)
+{
+	zassert_true(device_is_ready(euart0));
+	zassert_true(device_is_ready(euart1));
+
+	uart_emul_callback_tx_data_ready_set(euart1, uart_rtio_flush_tx, NULL);
+
+	return NULL;
+}
+
+static void uart_rtio_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < CHAIN_LEN; i++) {
+		for (int j = 0; j < RX_LEN; j++) {
+			tx_buf[i][j] = i + j;
+		}
+	}
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+	uart_emul_flush_rx_data(euart0);
+	uart_emul_flush_tx_data(euart0);
+}
+
+ZTEST(uart_rtio, test_tx_chain)
+{
+	static const uint8_t tiny[] = {0xaa, 0x55};
+	uint8_t out[2 * RX_LEN + sizeof(tiny)];
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_write(sqe, &uart_iodev, RTIO_PRIO_NORM, tx_buf[0], RX_LEN, tx_buf[0]);
+	sqe->flags |= RTIO_SQE_CHAINED;
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_tiny_write(sqe, &uart_iodev, RTIO_PRIO_NORM, tiny, sizeof(tiny), NULL);
+	sqe->flags |= RTIO_SQE_CHAINED;
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_write(sqe, &uart_iodev, RTIO_PRIO_NORM, tx_buf[1], RX_LEN, tx_buf[1]);
+
+	zassert_ok(rtio_submit(&r, 0));
+
+	expect_cqe(0, tx_buf[0]);
+	expect_cqe(0, NULL);
+	expect_cqe(0, tx_buf[1]);
+
+	zassert_equal(uart_emul_get_tx_data(euart0, out, sizeof(out)), sizeof(out));
+	zassert_mem_equal(out, tx_buf[0], RX_LEN);
+	zassert_mem_equal(&out[RX_LEN], tiny, sizeof(tiny));
+	zassert_mem_equal(&out[RX_LEN + sizeof(tiny)], tx_buf[1], RX_LEN);
+}
+
+ZTEST(uart_rtio, test_rx_buffer)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+
+	rtio_sqe_prep_read(sqe, &uart_iodev, RTIO_PRIO_NORM, rx_buf, sizeof(rx_buf), rx_buf);
+	zassert_ok(rtio_submit(&r, 0));
+
+	zassert_equal(uart_emul_put_rx_data(euart0, tx_buf[0], RX_LEN), RX_LEN);
+
+	expect_cqe(RX_LEN, rx_buf);
+	zassert_mem_equal(rx_buf, tx_buf[0], RX_LEN);
+}
+
+ZTEST(uart_rtio, test_rx_idle_timeout)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	rtio_sqe_prep_read_with_pool(sqe, &uart_iodev, RTIO_PRIO_NORM, NULL);
+	zassert_ok(rtio_submit(&r, 0));
+
+	/* Less than a block, the read completes once the line goes idle */
+	zassert_equal(uart_emul_put_rx_data(euart0, tx_buf[0], 10), 10);
+
+	cqe = wait_cqe();
+	zassert_not_null(cqe);
+	zassert_equal(cqe->result, 10);
+	zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe, &buf, &buf_len));
+	zassert_equal(buf_len, BLK_SIZE, "Unused blocks should have been released");
+	zassert_mem_equal(buf, tx_buf[0], 10);
+	rtio_release_buffer(&r, buf, buf_len);
+	rtio_cqe_release(&r, cqe);
+}
+
+ZTEST(uart_rtio, test_rx_multishot)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	rtio_sqe_prep_read_multishot(sqe, &uart_iodev, RTIO_PRIO_NORM, rx_buf);
+	zassert_ok(rtio_submit(&r, 0));
+
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(uart_emul_put_rx_data(euart0, tx_buf[i], RX_LEN), RX_LEN);
+
+		cqe = wait_cqe();
+		zassert_not_null(cqe);
+		zassert_equal(cqe->result, RX_LEN);
+		zassert_equal_ptr(cqe->userdata, rx_buf);
+		zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe, &buf, &buf_len));
+		zassert_equal(buf_len, RX_LEN);
+		zassert_mem_equal(buf, tx_buf[i], RX_LEN);
+		rtio_release_buffer(&r, buf, buf_len);
+		rtio_cqe_release(&r, cqe);
+	}
+
+	/* The canceled read consumes the next buffer without completing */
+	rtio_sqe_cancel(sqe);
+	zassert_equal(uart_emul_put_rx_data(euart0, tx_buf[0], RX_LEN), RX_LEN);
+	k_msleep(1);
+	zassert_is_null(rtio_cqe_consume(&r));
+}
+
+ZTEST(uart_rtio, test_throughput)
+{
+	struct rtio_sqe *rx_sqe = rtio_sqe_acquire(&r);
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	uint32_t start, cycles;
+	uint8_t *buf;
+	uint32_t buf_len;
+	size_t received = 0;
+	size_t sent = 0;
+
+	rtio_sqe_prep_read_multishot(rx_sqe, &loop_iodev, RTIO_PRIO_NORM, rx_buf);
+	zassert_ok(rtio_submit(&r, 0));
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		/* One chain per iteration, looped back into the multishot read */
+		for (int j = 0; j < CHAIN_LEN; j++) {
+			sqe = rtio_sqe_acquire(&r);
+			zassert_not_null(sqe);
+			rtio_sqe_prep_write(sqe, &loop_iodev, RTIO_PRIO_NORM, tx_buf[j], RX_LEN,
+					    NULL);
+			sqe->flags |= RTIO_SQE_CHAINED;
+		}
+		sqe->flags &= ~RTIO_SQE_CHAINED;
+
+		zassert_ok(rtio_submit(&r, 0));
+		sent += CHAIN_LEN * RX_LEN;
+
+		for (int j = 0; j < 2 * CHAIN_LEN; j++) {
+			cqe = rtio_cqe_consume_block(&r);
+			zassert_true(cqe->result >= 0, "Failed with %d", cqe->result);
+
+			if (cqe->userdata == rx_buf) {
+				zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe, &buf, &buf_len));
+				received += cqe->result;
+				rtio_release_buffer(&r, buf, buf_len);
+			}
+
+			rtio_cqe_release(&r, cqe);
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(received, sent);
+
+	TC_PRINT("%zu bytes in %llu us, %llu bytes/s\n", received,
+		 k_cyc_to_us_floor64(cycles),
+		 cycles == 0 ? 0 : (uint64_t)received * sys_clock_hw_cycles_per_sec() / cycles);
+
+	rtio_sqe_cancel(rx_sqe);
+	zassert_equal(uart_emul_put_rx_data(euart1, tx_buf[0], RX_LEN), RX_LEN);
+	k_msleep(1);
+	zassert_is_null(rtio_cqe_consume(&r));
+}
+
+ZTEST_SUITE(uart_rtio, NULL, uart_rtio_setup, uart_rtio_before, NULL, NULL);
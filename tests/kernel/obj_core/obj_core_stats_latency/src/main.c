@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#define WAIT_MS 10
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_SEM_DEFINE(test_sem, 0, 1);
+K_MUTEX_DEFINE(test_mutex);
+K_MSGQ_DEFINE(test_msgq, sizeof(uint32_t), 1, 4);
+
+static K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+static struct k_thread helper_thread;
+
+static void query_stats(struct k_obj_core *obj_core, struct k_latency_stats *stats)
+{
+	int status;
+
+	status = k_obj_core_stats_query(obj_core, stats, sizeof(*stats));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+}
+
+static void reset_stats(struct k_obj_core *obj_core)
+{
+	int status;
+
+	status = k_obj_core_stats_reset(obj_core);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+}
+
+static void check_one_wait(struct k_obj_core *obj_core)
+{
+	struct k_latency_stats stats;
+	uint32_t min_cycles = k_ms_to_cyc_floor32(WAIT_MS / 2);
+
+	query_stats(obj_core, &stats);
+	zassert_equal(stats.count, 1, "Expected 1 sample, got %u\n", stats.count);
+	zassert_true(stats.max >= min_cycles, "Expected at least %u cycles, got %u\n",
+		     min_cycles, stats.max);
+	zassert_true(stats.p99 <= stats.max);
+
+	reset_stats(obj_core);
+	query_stats(obj_core, &stats);
+	zassert_equal(stats.count, 0, "Expected 0 samples after reset, got %u\n",
+		      stats.count);
+	zassert_equal(stats.max, 0);
+}
+
+static void helper_entry(void *p1, void *p2, void *p3)
+{
+	void (*fn)(void) = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_msleep(WAIT_MS);
+	fn();
+}
+
+static void run_helper(void (*fn)(void))
+{
+	k_thread_create(&helper_thread, helper_stack, K_THREAD_STACK_SIZEOF(helper_stack),
+			helper_entry, fn, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+}
+
+ZTEST(obj_core_stats_latency, test_hist_percentiles)
+{
+	struct k_latency_hist hist = { 0 };
+
+	zassert_equal(k_latency_hist_bucket_max(0), 0);
+	zassert_equal(k_latency_hist_bucket_max(1), 1);
+	zassert_equal(k_latency_hist_bucket_max(4), 15);
+	zassert_equal(k_latency_hist_bucket_max(K_LATENCY_HIST_BUCKETS - 1), UINT32_MAX);
+
+	zassert_equal(k_latency_hist_percentile(&hist, 500), 0);
+
+	/* 98 fast samples in the [8, 15] bucket and two slow outliers */
+	for (int i = 0; i < 98; i++) {
+		k_latency_hist_record(&hist, 10);
+	}
+	k_latency_hist_record(&hist, 1000);
+	k_latency_hist_record(&hist, 5000);
+
+	zassert_equal(k_latency_hist_percentile(&hist, 500), 15);
+	zassert_equal(k_latency_hist_percentile(&hist, 980), 15);
+	zassert_equal(k_latency_hist_percentile(&hist, 990), 1023);
+	zassert_equal(k_latency_hist_percentile(&hist, 1000), 5000);
+
+	k_latency_hist_reset(&hist);
+	zassert_equal(k_latency_hist_percentile(&hist, 1000), 0);
+}
+
+static void give_sem(void)
+{
+	k_sem_give(&test_sem);
+}
+
+ZTEST(obj_core_stats_latency, test_sem_wait)
+{
+	reset_stats(K_OBJ_CORE(&test_sem));
+
+	/* Taking an available semaphore does not block, so is not recorded */
+	k_sem_give(&test_sem);
+	zassert_ok(k_sem_take(&test_sem, K_NO_WAIT));
+
+	run_helper(give_sem);
+	zassert_ok(k_sem_take(&test_sem, K_FOREVER));
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	check_one_wait(K_OBJ_CORE(&test_sem));
+}
+
+static void mutex_holder_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&test_mutex, K_FOREVER);
+	k_msleep(WAIT_MS);
+	k_mutex_unlock(&test_mutex);
+}
+
+ZTEST(obj_core_stats_latency, test_mutex_wait)
+{
+	reset_stats(K_OBJ_CORE(&test_mutex));
+
+	k_thread_create(&helper_thread, helper_stack, K_THREAD_STACK_SIZEOF(helper_stack),
+			mutex_holder_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the helper take the mutex first */
+	k_msleep(1);
+	zassert_ok(k_mutex_lock(&test_mutex, K_FOREVER));
+	zassert_ok(k_mutex_unlock(&test_mutex));
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	check_one_wait(K_OBJ_CORE(&test_mutex));
+}
+
+static void put_msg(void)
+{
+	uint32_t msg = 0x1234;
+
+	k_msgq_put(&test_msgq, &msg, K_NO_WAIT);
+}
+
+ZTEST(obj_core_stats_latency, test_msgq_wait)
+{
+	uint32_t msg;
+
+	reset_stats(K_OBJ_CORE(&test_msgq));
+
+	run_helper(put_msg);
+	zassert_ok(k_msgq_get(&test_msgq, &msg, K_FOREVER));
+	zassert_equal(msg, 0x1234);
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	check_one_wait(K_OBJ_CORE(&test_msgq));
+}
+
+static void work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+}
+
+ZTEST(obj_core_stats_latency, test_work_q_delay)
+{
+	static K_THREAD_STACK_DEFINE(work_q_stack, STACK_SIZE);
+	static struct k_work_q work_q;
+	struct k_work work;
+	struct k_latency_stats stats;
+
+	k_work_queue_start(&work_q, work_q_stack, K_THREAD_STACK_SIZEOF(work_q_stack),
+			   K_PRIO_PREEMPT(1), NULL);
+	k_work_init(&work, work_handler);
+
+	for (int i = 0; i < 4; i++) {
+		zassert_equal(k_work_submit_to_queue(&work_q, &work), 1);
+		k_work_flush(&work, &(struct k_work_sync){});
+	}
+
+	query_stats(K_OBJ_CORE(&work_q), &stats);
+	zassert_equal(stats.count, 4, "Expected 4 samples, got %u\n", stats.count);
+
+	reset_stats(K_OBJ_CORE(&work_q));
+	query_stats(K_OBJ_CORE(&work_q), &stats);
+	zassert_equal(stats.count, 0);
+
+	k_thread_abort(&work_q.thread);
+}
+
+static void timer_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	k_sem_give(&test_sem);
+}
+
+static int find_irq_wakeup(struct k_obj_core *obj_core, void *data)
+{
+	struct k_obj_core_latency *latency =
+		CONTAINER_OF(obj_core, struct k_obj_core_latency, obj_core);
+
+	if (strcmp(latency->name, "irq_wakeup") == 0) {
+		*(struct k_obj_core **)data = obj_core;
+		return 1;
+	}
+
+	return 0;
+}
+
+ZTEST(obj_core_stats_latency, test_irq_wakeup)
+{
+	struct k_obj_type *type = k_obj_type_find(K_OBJ_TYPE_LATENCY_ID);
+	struct k_obj_core *obj_core = NULL;
+	struct k_latency_stats stats;
+	struct k_timer timer;
+
+	zassert_not_null(type);
+	k_obj_type_walk_unlocked(type, find_irq_wakeup, &obj_core);
+	zassert_not_null(obj_core, "IRQ wakeup histogram not registered");
+
+	reset_stats(obj_core);
+
+	k_timer_init(&timer, timer_expiry, NULL);
+	k_timer_start(&timer, K_MSEC(WAIT_MS), K_NO_WAIT);
+	zassert_ok(k_sem_take(&test_sem, K_FOREVER));
+
+	query_stats(obj_core, &stats);
+	zassert_true(stats.count >= 1, "Expected wakeups to be recorded\n");
+}
+
+static int count_obj_core(struct k_obj_core *obj_core, void *data)
+{
+	struct k_obj_core *target = ((struct k_obj_core **)data)[0];
+	int *count = ((int **)data)[1];
+
+	if (obj_core == target) {
+		(*count)++;
+	}
+
+	return 0;
+}
+
+ZTEST(obj_core_stats_latency, test_work_q_restart)
+{
+	static K_THREAD_STACK_DEFINE(work_q_stack, STACK_SIZE);
+	static struct k_work_q work_q;
+	struct k_obj_type *type = k_obj_type_find(K_OBJ_TYPE_WORK_Q_ID);
+	int count = 0;
+	void *data[] = { K_OBJ_CORE(&work_q), &count };
+
+	zassert_not_null(type);
+
+	/* A queue restarted after its thread was aborted is linked once */
+	for (int i = 0; i < 2; i++) {
+		k_work_queue_init(&work_q);
+		k_work_queue_start(&work_q, work_q_stack,
+				   K_THREAD_STACK_SIZEOF(work_q_stack),
+				   K_PRIO_PREEMPT(0), NULL);
+		k_thread_abort(&work_q.thread);
+	}
+
+	k_obj_type_walk_unlocked(type, count_obj_core, data);
+	zassert_equal(count, 1, "Work queue linked %d times\n", count);
+}
+
+ZTEST_SUITE(obj_core_stats_latency, NULL, NULL,
+	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <kernel_internal.h>
+
+#define STACK_SIZE (2048 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(test_stack, STACK_SIZE);
+static struct k_thread test_thread;
+
+static K_THREAD_STACK_DEFINE(gap_stack, STACK_SIZE);
+static struct k_thread gap_thread;
+
+static K_SEM_DEFINE(use_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, 1);
+static size_t use_bytes;
+
+static void __noinline use_stack(size_t bytes)
+{
+	volatile uint8_t buf[bytes];
+
+	/* Touch every byte so the used area holds no untouched gap */
+	for (size_t i = 0; i < bytes; i++) {
+		buf[i] = (uint8_t)i | 1U;
+	}
+}
+
+static void __noinline use_stack_with_gap(void)
+{
+	volatile uint8_t buf[CONFIG_STACK_WATERMARK_GAP * 2];
+
+	/* Only the deepest byte is written, leaving an untouched area larger
+	 * than the scan gap above it, like a partially used local buffer.
+	 */
+	buf[0] = 0x55U;
+}
+
+static void __noinline use_stack_nested(void)
+{
+	volatile uint8_t buf[64];
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)i | 1U;
+	}
+
+	use_stack_with_gap();
+}
+
+static void gap_thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	use_stack_nested();
+}
+
+static void thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&use_sem, K_FOREVER);
+		use_stack(use_bytes);
+		k_sem_give(&done_sem);
+	}
+}
+
+static void thread_use_stack(size_t bytes)
+{
+	use_bytes = bytes;
+	k_sem_give(&use_sem);
+	zassert_ok(k_sem_take(&done_sem, K_FOREVER));
+}
+
+static void check_watermark(void)
+{
+	size_t exact;
+	size_t unused;
+
+	zassert_ok(k_thread_stack_space_get(&test_thread, &exact));
+	zassert_ok(k_thread_stack_watermark_get(&test_thread, &unused));
+	zassert_equal(unused, exact, "Watermark %zu, expected %zu", unused, exact);
+}
+
+ZTEST(stack_watermark, test_watermark_tracks_usage)
+{
+	size_t before;
+	size_t after;
+
+	thread_use_stack(256);
+	check_watermark();
+	zassert_ok(k_thread_stack_watermark_get(&test_thread, &before));
+
+	/* Usage that stays above the watermark does not move it */
+	thread_use_stack(64);
+	check_watermark();
+	zassert_ok(k_thread_stack_watermark_get(&test_thread, &after));
+	zassert_equal(after, before);
+
+	/* Deeper usage moves the watermark down */
+	thread_use_stack(1024);
+	check_watermark();
+	zassert_ok(k_thread_stack_watermark_get(&test_thread, &after));
+	zassert_true(after < before - 512, "Watermark %zu did not follow usage from %zu",
+		     after, before);
+}
+
+ZTEST(stack_watermark, test_watermark_untouched_buffer)
+{
+	size_t exact;
+	size_t unused;
+
+	k_thread_create(&gap_thread, gap_stack, K_THREAD_STACK_SIZEOF(gap_stack),
+			gap_thread_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_ok(k_thread_join(&gap_thread, K_FOREVER));
+
+	/* The first query must account the usage below the untouched buffer */
+	zassert_ok(k_thread_stack_space_get(&gap_thread, &exact));
+	zassert_ok(k_thread_stack_watermark_get(&gap_thread, &unused));
+	zassert_equal(unused, exact, "Watermark %zu, expected %zu", unused, exact);
+
+	/* Later queries start from it */
+	zassert_ok(k_thread_stack_watermark_get(&gap_thread, &unused));
+	zassert_equal(unused, exact, "Watermark %zu, expected %zu", unused, exact);
+}
+
+ZTEST(stack_watermark, test_watermark_current_thread)
+{
+	size_t exact;
+	size_t unused;
+	int ret;
+
+	ret = k_thread_stack_watermark_get(k_current_get(), &unused);
+	if (ret == -ENOTSUP) {
+		ztest_test_skip();
+	}
+	zassert_ok(ret);
+
+	/* The watermark never reports more usage than a full scan */
+	zassert_ok(k_thread_stack_space_get(k_current_get(), &exact));
+	zassert_true(unused >= exact);
+}
+
+ZTEST(stack_watermark, test_watermark_fully_used)
+{
+	static uint8_t buf[256];
+	struct _stack_watermark watermark = {0};
+	size_t unused;
+
+	/* A fully used stack leaves no unused bytes */
+	memset(buf, 0x55, sizeof(buf));
+	zassert_ok(z_stack_watermark_get(buf, sizeof(buf), &watermark, &unused));
+	zassert_equal(unused, 0);
+	zassert_true(watermark.scanned);
+
+	/* It is not scanned from the bottom again, which would find the
+	 * pattern restored below and report the stack as unused.
+	 */
+	memset(buf, 0xaa, sizeof(buf));
+	zassert_ok(z_stack_watermark_get(buf, sizeof(buf), &watermark, &unused));
+	zassert_equal(unused, 0, "Fully used stack was scanned again, %zu unused", unused);
+}
+
+static void *setup(void)
+{
+	k_thread_create(&test_thread, test_stack, K_THREAD_STACK_SIZEOF(test_stack),
+			thread_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	return NULL;
+}
+
+ZTEST_SUITE(stack_watermark, NULL, setup, NULL, NULL, NULL);
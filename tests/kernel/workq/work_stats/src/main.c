@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define FAST_US 100
+#define SLOW_US 2000
+
+static K_THREAD_STACK_DEFINE(work_q_stack, STACK_SIZE);
+static struct k_work_q work_q;
+
+static void fast_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_busy_wait(FAST_US);
+}
+
+static void slow_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_busy_wait(SLOW_US);
+}
+
+static void run_work(k_work_handler_t handler, int times)
+{
+	struct k_work work;
+
+	k_work_init(&work, handler);
+
+	for (int i = 0; i < times; i++) {
+		zassert_equal(k_work_submit_to_queue(&work_q, &work), 1);
+		zassert_true(k_work_flush(&work, &(struct k_work_sync){}));
+	}
+}
+
+static void query_stats(struct k_work_q_stats_summary *stats)
+{
+	int status;
+
+	status = k_work_queue_stats_get(&work_q, stats);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+}
+
+static const struct k_work_handler_stats *find_handler(const struct k_work_handler_stats *stats,
+						       size_t count, k_work_handler_t handler)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (stats[i].handler == handler) {
+			return &stats[i];
+		}
+	}
+
+	return NULL;
+}
+
+ZTEST(work_stats, test_work_q_stats)
+{
+	struct k_work_q_stats_summary stats;
+	struct k_latency_stats delay;
+	uint32_t fast_cycles = k_us_to_cyc_floor32(FAST_US);
+	uint32_t slow_cycles = k_us_to_cyc_floor32(SLOW_US);
+
+	run_work(fast_handler, 3);
+	run_work(slow_handler, 1);
+
+	query_stats(&stats);
+	zassert_equal(stats.count, 4, "Expected 4 items, got %u\n", stats.count);
+	zassert_true(stats.run.min >= fast_cycles);
+	zassert_true(stats.run.min < slow_cycles);
+	zassert_true(stats.run.max >= slow_cycles);
+	zassert_true(stats.run.avg > stats.run.min);
+	zassert_true(stats.run.avg < stats.run.max);
+	zassert_true(stats.run.p50 <= stats.run.p99);
+	zassert_true(stats.run.p99 <= stats.run.max);
+	zassert_true(stats.delay.min <= stats.delay.avg);
+	zassert_true(stats.delay.avg <= stats.delay.max);
+
+	/* The object core statistics are the delay histogram */
+	zassert_ok(k_obj_core_stats_query(K_OBJ_CORE(&work_q), &delay, sizeof(delay)));
+	zassert_equal(delay.count, 4);
+	zassert_equal(delay.max, stats.delay.max);
+
+	zassert_ok(k_obj_core_stats_reset(K_OBJ_CORE(&work_q)));
+	query_stats(&stats);
+	zassert_equal(stats.count, 0);
+	zassert_equal(stats.run.min, 0);
+	zassert_equal(stats.run.avg, 0);
+	zassert_equal(stats.run.max, 0);
+}
+
+ZTEST(work_stats, test_handler_stats)
+{
+	struct k_work_handler_stats stats[CONFIG_OBJ_CORE_STATS_WORK_Q_HANDLERS];
+	const struct k_work_handler_stats *entry;
+	size_t count;
+
+	run_work(fast_handler, 2);
+	run_work(slow_handler, 1);
+
+	count = k_work_handler_stats_get(stats, 0, ARRAY_SIZE(stats));
+	zassert_true(count >= 2, "Expected 2 handlers, got %zu\n", count);
+
+	entry = find_handler(stats, count, fast_handler);
+	zassert_not_null(entry);
+	zassert_equal(entry->count, 2);
+	zassert_true(entry->run_max >= k_us_to_cyc_floor32(FAST_US));
+	zassert_true(entry->run_total >= 2ULL * k_us_to_cyc_floor32(FAST_US));
+
+	entry = find_handler(stats, count, slow_handler);
+	zassert_not_null(entry);
+	zassert_equal(entry->count, 1);
+	zassert_true(entry->run_max >= k_us_to_cyc_floor32(SLOW_US));
+	zassert_equal(entry->run_total, entry->run_max);
+
+	/* Copying is bounded by the caller's buffer, the rest is copied by
+	 * skipping the handlers already copied.
+	 */
+	for (size_t i = 0; i < count; i++) {
+		struct k_work_handler_stats chunk;
+
+		zassert_equal(k_work_handler_stats_get(&chunk, i, 1), 1);
+		zassert_equal(chunk.handler, stats[i].handler);
+	}
+
+	zassert_equal(k_work_handler_stats_get(stats, count, 1), 0);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(k_obj_core_stats_reset(K_OBJ_CORE(&work_q)));
+	k_work_handler_stats_reset();
+}
+
+static void *setup(void)
+{
+	k_work_queue_start(&work_q, work_q_stack, K_THREAD_STACK_SIZEOF(work_q_stack),
+			   K_PRIO_PREEMPT(1), NULL);
+
+	return NULL;
+}
+
+ZTEST_SUITE(work_stats, NULL, setup, before, NULL, NULL);
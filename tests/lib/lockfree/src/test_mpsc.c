@@ -68,6 +68,38 @@ ZTEST(mpsc, test_push_pop)
 	zassert_is_null(node, "Pop on empty queue should return null");
 }
 
+/*
+ * @brief Peek at the element to be popped next
+ *
+ * @see mpsc_peek(), mpsc_pop()
+ *
+ * @ingroup tests
+ */
+ZTEST(mpsc, test_peek)
+{
+	mpsc_init(&push_pop_q);
+
+	zassert_is_null(mpsc_peek(&push_pop_q), "Peek on empty queue should return null");
+
+	mpsc_push(&push_pop_q, &push_pop_nodes[0]);
+	mpsc_push(&push_pop_q, &push_pop_nodes[1]);
+
+	for (int i = 0; i < ARRAY_SIZE(push_pop_nodes); i++) {
+		zassert_equal(mpsc_peek(&push_pop_q), &push_pop_nodes[i],
+			      "Peek should return the next node to pop");
+		zassert_equal(mpsc_peek(&push_pop_q), &push_pop_nodes[i],
+			      "Peek should not remove the node");
+		zassert_equal(mpsc_pop(&push_pop_q), &push_pop_nodes[i]);
+	}
+
+	zassert_is_null(mpsc_peek(&push_pop_q), "Peek on empty queue should return null");
+
+	/* The stub is pushed back when the last node is popped */
+	mpsc_push(&push_pop_q, &push_pop_nodes[0]);
+	zassert_equal(mpsc_peek(&push_pop_q), &push_pop_nodes[0]);
+	zassert_equal(mpsc_pop(&push_pop_q), &push_pop_nodes[0]);
+}
+
 #define MPSC_FREEQ_SZ 8
 #define MPSC_ITERATIONS 100000
 #define MPSC_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/icmp.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "icmpv4.h"
+#include "udp_internal.h"
+#include "route.h"
+#include "net_private.h"
+
+#define INSIDE_HOST  "192.0.2.10"
+#define REMOTE_HOST  "203.0.113.5"
+#define LAN_ADDR     "192.0.2.1"
+#define WAN_ADDR     "198.51.100.1"
+#define WAN_GATEWAY  "198.51.100.254"
+#define INSIDE_PORT  5000
+#define REMOTE_PORT  53
+#define ECHO_ID      0x1234
+
+static const uint8_t payload[] = "NAT test payload";
+
+static struct net_if *lan;
+static struct net_if *wan;
+
+static K_FIFO_DEFINE(lan_fifo);
+static K_FIFO_DEFINE(wan_fifo);
+
+static int test_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct net_pkt *clone;
+
+	ARG_UNUSED(dev);
+
+	clone = net_pkt_clone(pkt, K_NO_WAIT);
+	if (clone == NULL) {
+		return -ENOMEM;
+	}
+
+	k_fifo_put(net_pkt_iface(pkt) == lan ? &lan_fifo : &wan_fifo, clone);
+
+	return 0;
+}
+
+static void test_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[2][6] = {
+		{ 0x00, 0x00, 0x5e, 0x00, 0x53, 0x11 },
+		{ 0x00, 0x00, 0x5e, 0x00, 0x53, 0x12 },
+	};
+	static int count;
+
+	net_if_set_link_addr(iface, mac[count++], sizeof(mac[0]),
+			     NET_LINK_DUMMY);
+}
+
+static struct dummy_api test_if_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_send,
+};
+
+NET_DEVICE_INIT_INSTANCE(ipv4_nat_test_lan, "ipv4_nat_test_lan", 0, NULL, NULL,
+			 NULL, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+			 &test_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2),
+			 1500);
+
+NET_DEVICE_INIT_INSTANCE(ipv4_nat_test_wan, "ipv4_nat_test_wan", 1, NULL, NULL,
+			 NULL, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+			 &test_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2),
+			 1500);
+
+static struct in_addr addr(const char *str)
+{
+	struct in_addr in;
+
+	zassert_ok(net_addr_pton(AF_INET, str, &in), "Invalid %s", str);
+
+	return in;
+}
+
+static void iface_setup(struct net_if *iface, const char *str)
+{
+	struct in_addr in = addr(str);
+	struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &in, NET_ADDR_MANUAL, 0));
+	zassert_true(net_if_ipv4_set_netmask_by_addr(iface, &in, &netmask));
+	net_if_up(iface);
+}
+
+static void iface_cb(struct net_if *iface, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(DUMMY)) {
+		return;
+	}
+
+	if (lan == NULL) {
+		lan = iface;
+	} else if (wan == NULL) {
+		wan = iface;
+	}
+}
+
+static void flush(struct k_fifo *fifo)
+{
+	struct net_pkt *pkt;
+
+	while ((pkt = k_fifo_get(fifo, K_NO_WAIT)) != NULL) {
+		net_pkt_unref(pkt);
+	}
+}
+
+static struct net_pkt *alloc_pkt(struct net_if *iface, const char *src,
+				  const char *dst, uint8_t ttl, uint8_t proto)
+{
+	struct in_addr in_src = addr(src);
+	struct in_addr in_dst = addr(dst);
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(payload) +
+					   sizeof(struct net_icmpv4_echo_req),
+					   AF_INET, proto, K_SECONDS(1));
+	zassert_not_null(pkt, "Out of mem");
+
+	net_pkt_set_ipv4_ttl(pkt, ttl);
+	zassert_ok(net_ipv4_create(pkt, &in_src, &in_dst));
+
+	return pkt;
+}
+
+static void recv_pkt(struct net_if *iface, struct net_pkt *pkt, uint8_t proto)
+{
+	zassert_ok(net_pkt_write(pkt, payload, sizeof(payload)));
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, proto));
+	net_pkt_cursor_init(pkt);
+
+	zassert_ok(net_recv_data(iface, pkt));
+}
+
+static void send_udp(struct net_if *iface, const char *src, const char *dst,
+		     uint8_t ttl, uint16_t src_port, uint16_t dst_port)
+{
+	struct net_pkt *pkt = alloc_pkt(iface, src, dst, ttl, IPPROTO_UDP);
+
+	zassert_ok(net_udp_create(pkt, htons(src_port), htons(dst_port)));
+
+	recv_pkt(iface, pkt, IPPROTO_UDP);
+}
+
+static void send_echo(struct net_if *iface, const char *src, const char *dst,
+		      uint8_t type, uint16_t id)
+{
+	struct net_pkt *pkt = alloc_pkt(iface, src, dst, 64, IPPROTO_ICMP);
+	struct net_icmpv4_echo_req echo = {
+		.identifier = htons(id),
+		.sequence = htons(1),
+	};
+
+	zassert_ok(net_icmpv4_create(pkt, type, 0));
+	zassert_ok(net_pkt_write(pkt, &echo, sizeof(echo)));
+
+	recv_pkt(iface, pkt, IPPROTO_ICMP);
+}
+
+/* Check the headers of a sent packet and return its transport header */
+static void *check_pkt(struct net_pkt *pkt, const char *src, const char *dst,
+		       uint8_t ttl)
+{
+	struct in_addr in_src = addr(src);
+	struct in_addr in_dst = addr(dst);
+	struct net_ipv4_hdr *hdr;
+
+	zassert_not_null(pkt, "No packet sent");
+	hdr = NET_IPV4_HDR(pkt);
+
+	zassert_true(net_ipv4_addr_cmp_raw(hdr->src, (uint8_t *)&in_src),
+		     "Wrong source %s", net_sprint_ipv4_addr(hdr->src));
+	zassert_true(net_ipv4_addr_cmp_raw(hdr->dst, (uint8_t *)&in_dst),
+		     "Wrong destination %s", net_sprint_ipv4_addr(hdr->dst));
+	zassert_equal(hdr->ttl, ttl, "Wrong TTL %u", hdr->ttl);
+	zassert_equal(net_calc_chksum_ipv4(pkt), 0, "Wrong IPv4 checksum");
+
+	return (uint8_t *)hdr + sizeof(*hdr);
+}
+
+static void nat_cb(struct net_ipv4_nat_entry *entry, void *user_data)
+{
+	ARG_UNUSED(entry);
+	ARG_UNUSED(user_data);
+}
+
+static int nat_count(void)
+{
+	return net_ipv4_nat_foreach(nat_cb, NULL);
+}
+
+static void *setup(void)
+{
+	struct in_addr gw;
+	struct in_addr any = { 0 };
+
+	net_if_foreach(iface_cb, NULL);
+	zassert_not_null(lan);
+	zassert_not_null(wan);
+
+	iface_setup(lan, LAN_ADDR);
+	iface_setup(wan, WAN_ADDR);
+
+	gw = addr(WAN_GATEWAY);
+	zassert_not_null(net_route_ipv4_add(wan, &any, 0, &gw));
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)net_ipv4_nat_disable(wan);
+
+	flush(&lan_fifo);
+	flush(&wan_fifo);
+}
+
+ZTEST(ipv4_nat, test_forward)
+{
+	struct net_udp_hdr *udp;
+	struct net_pkt *pkt;
+
+	send_udp(lan, INSIDE_HOST, REMOTE_HOST, 64, INSIDE_PORT, REMOTE_PORT);
+
+	pkt = k_fifo_get(&wan_fifo, K_SECONDS(1));
+	udp = check_pkt(pkt, INSIDE_HOST, REMOTE_HOST, 63);
+	zassert_equal(ntohs(udp->src_port), INSIDE_PORT);
+	zassert_equal(ntohs(udp->dst_port), REMOTE_PORT);
+	zassert_equal(net_calc_verify_chksum_udp(pkt), 0, "Wrong UDP checksum");
+	net_pkt_unref(pkt);
+
+	zassert_equal(nat_count(), 0, "Translated without NAT");
+	zassert_is_null(k_fifo_get(&lan_fifo, K_NO_WAIT));
+}
+
+ZTEST(ipv4_nat, test_forward_ttl_exceeded)
+{
+	struct net_icmp_hdr *icmp;
+	struct net_pkt *pkt;
+
+	send_udp(lan, INSIDE_HOST, REMOTE_HOST, 1, INSIDE_PORT, REMOTE_PORT);
+
+	zassert_is_null(k_fifo_get(&wan_fifo, K_MSEC(100)),
+			"Expired packet forwarded");
+
+	pkt = k_fifo_get(&lan_fifo, K_SECONDS(1));
+	icmp = check_pkt(pkt, LAN_ADDR, INSIDE_HOST, CONFIG_NET_INITIAL_TTL);
+	zassert_equal(icmp->type, NET_ICMPV4_TIME_EXCEEDED);
+	zassert_equal(icmp->code, 0);
+	net_pkt_unref(pkt);
+}
+
+ZTEST(ipv4_nat, test_nat_udp)
+{
+	struct net_udp_hdr *udp;
+	struct net_pkt *pkt;
+	uint16_t port;
+
+	zassert_ok(net_ipv4_nat_enable(wan));
+	zassert_true(net_ipv4_nat_is_enabled(wan));
+	zassert_false(net_ipv4_nat_is_enabled(lan));
+
+	send_udp(lan, INSIDE_HOST, REMOTE_HOST, 64, INSIDE_PORT, REMOTE_PORT);
+
+	pkt = k_fifo_get(&wan_fifo, K_SECONDS(1));
+	udp = check_pkt(pkt, WAN_ADDR, REMOTE_HOST, 63);
+	port = ntohs(udp->src_port);
+	zassert_between_inclusive(port, CONFIG_NET_IPV4_NAT_PORT_MIN,
+				  CONFIG_NET_IPV4_NAT_PORT_MAX);
+	zassert_equal(ntohs(udp->dst_port), REMOTE_PORT);
+	zassert_equal(net_calc_verify_chksum_udp(pkt), 0, "Wrong UDP checksum");
+	net_pkt_unref(pkt);
+
+	zassert_equal(nat_count(), 1);
+
+	/* The reply is translated back to the inside host */
+	send_udp(wan, REMOTE_HOST, WAN_ADDR, 64, REMOTE_PORT, port);
+
+	pkt = k_fifo_get(&lan_fifo, K_SECONDS(1));
+	udp = check_pkt(pkt, REMOTE_HOST, INSIDE_HOST, 63);
+	zassert_equal(ntohs(udp->src_port), REMOTE_PORT);
+	zassert_equal(ntohs(udp->dst_port), INSIDE_PORT);
+	zassert_equal(net_calc_verify_chksum_udp(pkt), 0, "Wrong UDP checksum");
+	net_pkt_unref(pkt);
+
+	/* Packets of the same flow reuse the translation */
+	send_udp(lan, INSIDE_HOST, REMOTE_HOST, 64, INSIDE_PORT, REMOTE_PORT);
+
+	pkt = k_fifo_get(&wan_fifo, K_SECONDS(1));
+	udp = check_pkt(pkt, WAN_ADDR, REMOTE_HOST, 63);
+	zassert_equal(ntohs(udp->src_port), port);
+	net_pkt_unref(pkt);
+
+	zassert_equal(nat_count(), 1);
+
+	/* Neither another remote host nor another port gets in */
+	send_udp(wan, "203.0.113.6", WAN_ADDR, 64, REMOTE_PORT, port);
+	send_udp(wan, REMOTE_HOST, WAN_ADDR, 64, REMOTE_PORT, port + 1);
+
+	zassert_is_null(k_fifo_get(&lan_fifo, K_MSEC(100)),
+			"Unsolicited packet forwarded");
+}
+
+ZTEST(ipv4_nat, test_nat_icmp_echo)
+{
+	struct net_icmp_hdr *icmp;
+	struct net_icmpv4_echo_req *echo;
+	struct net_pkt *pkt;
+	uint16_t id;
+
+	zassert_ok(net_ipv4_nat_enable(wan));
+
+	send_echo(lan, INSIDE_HOST, REMOTE_HOST, NET_ICMPV4_ECHO_REQUEST, ECHO_ID);
+
+	pkt = k_fifo_get(&wan_fifo, K_SECONDS(1));
+	icmp = check_pkt(pkt, WAN_ADDR, REMOTE_HOST, 63);
+	zassert_equal(icmp->type, NET_ICMPV4_ECHO_REQUEST);
+	echo = (struct net_icmpv4_echo_req *)(icmp + 1);
+	id = ntohs(echo->identifier);
+	zassert_equal(net_calc_chksum_icmpv4(pkt), 0, "Wrong ICMPv4 checksum");
+	net_pkt_unref(pkt);
+
+	send_echo(wan, REMOTE_HOST, WAN_ADDR, NET_ICMPV4_ECHO_REPLY, id);
+
+	pkt = k_fifo_get(&lan_fifo, K_SECONDS(1));
+	icmp = check_pkt(pkt, REMOTE_HOST, INSIDE_HOST, 63);
+	zassert_equal(icmp->type, NET_ICMPV4_ECHO_REPLY);
+	echo = (struct net_icmpv4_echo_req *)(icmp + 1);
+	zassert_equal(ntohs(echo->identifier), ECHO_ID);
+	zassert_equal(net_calc_chksum_icmpv4(pkt), 0, "Wrong ICMPv4 checksum");
+	net_pkt_unref(pkt);
+}
+
+ZTEST(ipv4_nat, test_nat_table_full)
+{
+	struct net_pkt *pkt;
+
+	zassert_ok(net_ipv4_nat_enable(wan));
+
+	for (int i = 0; i < CONFIG_NET_IPV4_NAT_MAX_ENTRIES; i++) {
+		send_udp(lan, INSIDE_HOST, REMOTE_HOST, 64, INSIDE_PORT + i,
+			 REMOTE_PORT);
+
+		pkt = k_fifo_get(&wan_fifo, K_SECONDS(1));
+		zassert_not_null(pkt, "Flow %d not forwarded", i);
+		net_pkt_unref(pkt);
+	}
+
+	zassert_equal(nat_count(), CONFIG_NET_IPV4_NAT_MAX_ENTRIES);
+
+	send_udp(lan, INSIDE_HOST, REMOTE_HOST, 64,
+		 INSIDE_PORT + CONFIG_NET_IPV4_NAT_MAX_ENTRIES, REMOTE_PORT);
+
+	zassert_is_null(k_fifo_get(&wan_fifo, K_MSEC(100)),
+			"Forwarded without translation");
+}
+
+ZTEST(ipv4_nat, test_nat_timeout)
+{
+	struct net_pkt *pkt;
+
+	zassert_ok(net_ipv4_nat_enable(wan));
+
+	send_udp(lan, INSIDE_HOST, REMOTE_HOST, 64, INSIDE_PORT, REMOTE_PORT);
+
+	pkt = k_fifo_get(&wan_fifo, K_SECONDS(1));
+	zassert_not_null(pkt);
+	net_pkt_unref(pkt);
+
+	zassert_equal(nat_count(), 1);
+
+	k_sleep(K_MSEC(MSEC_PER_SEC * CONFIG_NET_IPV4_NAT_UDP_TIMEOUT + 500));
+
+	zassert_equal(nat_count(), 0, "Translation did not expire");
+}
+
+ZTEST(ipv4_nat, test_nat_disable)
+{
+	struct net_pkt *pkt;
+
+	zassert_ok(net_ipv4_nat_enable(wan));
+	zassert_ok(net_ipv4_nat_enable(wan), "Enabling twice failed");
+
+	send_udp(lan, INSIDE_HOST, REMOTE_HOST, 64, INSIDE_PORT, REMOTE_PORT);
+
+	pkt = k_fifo_get(&wan_fifo, K_SECONDS(1));
+	zassert_not_null(pkt);
+	net_pkt_unref(pkt);
+
+	zassert_equal(nat_count(), 1);
+
+	zassert_ok(net_ipv4_nat_disable(wan));
+	zassert_equal(net_ipv4_nat_disable(wan), -ENOENT);
+	zassert_false(net_ipv4_nat_is_enabled(wan));
+	zassert_equal(nat_count(), 0, "Translations left after disabling");
+}
+
+ZTEST_SUITE(ipv4_nat, NULL, setup, before, NULL, NULL);
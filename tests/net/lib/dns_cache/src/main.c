@@ -133,3 +133,98 @@ ZTEST(net_dns_cache_test, test_expired_entries_removed)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 3));
 	zassert_equal(AF_INET, info_read[0].ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "nx.example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(-ENXIO,
+		      dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1, NULL));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, &info_read, 1),
+		      "Negative entry returned as an address");
+
+	/* The name exists after all */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1, NULL));
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, TEST_DNS_CACHE_DEFAULT_TTL));
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1, NULL));
+}
+
+ZTEST(net_dns_cache_test, test_lookup_family)
+{
+	struct dns_addrinfo info4 = {.ai_family = AF_INET};
+	struct dns_addrinfo info6 = {.ai_family = AF_INET6};
+	struct dns_addrinfo info_read[2] = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info4, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info6, TEST_DNS_CACHE_DEFAULT_TTL));
+
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET6, info_read, 2, NULL));
+	zassert_equal(AF_INET6, info_read[0].ai_family);
+	zassert_equal(2, dns_cache_lookup(&test_dns_cache, query, AF_UNSPEC, info_read, 2, NULL));
+
+	/* New answers replace the ones of their family only */
+	zassert_ok(dns_cache_remove_family(&test_dns_cache, query, AF_INET6));
+	zassert_equal(0, dns_cache_lookup(&test_dns_cache, query, AF_INET6, info_read, 2, NULL));
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, info_read, 2, NULL));
+}
+
+ZTEST(net_dns_cache_test, test_many_queries)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	char query[sizeof("host-00.example.com")];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "host-%02u.example.com", (unsigned int)i);
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL));
+	}
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "host-%02u.example.com", (unsigned int)i);
+		zassert_equal(1, dns_cache_find(&test_dns_cache, query, &info_read, 1),
+			      "%s not found", query);
+	}
+
+	zassert_ok(dns_cache_remove(&test_dns_cache, "host-03.example.com"));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "host-03.example.com", &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "host-04.example.com", &info_read, 1));
+}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+ZTEST(net_dns_cache_test, test_prefetch)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+	uint32_t ttl = 2;
+	bool prefetch;
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, ttl));
+
+	for (int i = 0; i < CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS; i++) {
+		zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1,
+						  &prefetch));
+		zassert_false(prefetch, "Refresh asked for too early");
+	}
+
+	k_sleep(K_MSEC(ttl * 10 * (100 - CONFIG_DNS_RESOLVER_CACHE_PREFETCH_PERCENT) + 1));
+
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1,
+					  &prefetch));
+	zassert_true(prefetch, "Refresh not asked for");
+
+	/* Only once */
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1,
+					  &prefetch));
+	zassert_false(prefetch, "Refresh asked for twice");
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
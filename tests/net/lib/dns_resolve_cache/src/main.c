@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/dns_resolve.h>
+#include <zephyr/net/buf.h>
+
+#include "dns_pack.h"
+
+#define STACK_SIZE 2048
+#define THREAD_PRIORITY K_PRIO_COOP(2)
+#define QUERY_TIMEOUT 1000
+#define WAIT_TIME K_MSEC(2 * QUERY_TIMEOUT)
+#define MAX_BUF_SIZE 512
+
+/* Names starting with this do not exist, everything else resolves */
+#define NX_PREFIX "nx"
+
+#define RR_TYPE_SOA 6
+
+struct result {
+	struct k_sem done;
+	int status;
+	int addrs;
+};
+
+static int server_sock;
+static atomic_t queries_received;
+static uint32_t answer_ttl = 60;
+static int reply_delay_ms;
+
+NET_BUF_POOL_DEFINE(test_dns_name_pool, 1, MAX_BUF_SIZE, 0, NULL);
+
+/* Turns the query in buf into its response, returns the response length */
+static int make_response(uint8_t *buf, int len)
+{
+	struct dns_msg_t dns_msg = { .msg = buf, .msg_size = len };
+	struct net_buf *name;
+	enum dns_rr_type qtype;
+	bool exists;
+	int ret;
+
+	ret = mdns_unpack_query_header(&dns_msg, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	name = net_buf_alloc(&test_dns_name_pool, K_FOREVER);
+
+	ret = dns_unpack_query(&dns_msg, name, &qtype, NULL);
+	exists = strncmp(name->data + 1, NX_PREFIX, sizeof(NX_PREFIX) - 1) != 0;
+
+	net_buf_unref(name);
+
+	if (ret < 0 || qtype != DNS_RR_TYPE_A) {
+		return -EINVAL;
+	}
+
+	/* Response, recursion desired and available, the name error code */
+	buf[2] = 0x81;
+	buf[3] = exists ? 0x80 : 0x80 | DNS_HEADER_NAMEERROR;
+	sys_put_be16(exists ? 1 : 0, &buf[6]);
+	sys_put_be16(exists ? 0 : 1, &buf[8]);
+
+	len = dns_msg.query_offset;
+	if (!exists) {
+		/* The SOA record of the zone in the authority section, with
+		 * root names and zeroed timers.
+		 */
+		memset(&buf[len], 0, 34);
+		sys_put_be16(0xc000 | DNS_MSG_HEADER_SIZE, &buf[len]);
+		sys_put_be16(RR_TYPE_SOA, &buf[len + 2]);
+		sys_put_be16(DNS_CLASS_IN, &buf[len + 4]);
+		sys_put_be32(answer_ttl, &buf[len + 6]);
+		sys_put_be16(22, &buf[len + 10]);
+
+		return len + 34;
+	}
+
+	/* The answer points to the name of the question */
+	sys_put_be16(0xc000 | DNS_MSG_HEADER_SIZE, &buf[len]);
+	sys_put_be16(DNS_RR_TYPE_A, &buf[len + 2]);
+	sys_put_be16(DNS_CLASS_IN, &buf[len + 4]);
+	sys_put_be32(answer_ttl, &buf[len + 6]);
+	sys_put_be16(4, &buf[len + 10]);
+	buf[len + 12] = 192;
+	buf[len + 13] = 0;
+	buf[len + 14] = 2;
+	buf[len + 15] = 1;
+
+	return len + 16;
+}
+
+static void process_dns(void)
+{
+	static uint8_t buf[MAX_BUF_SIZE];
+	struct sockaddr_in client;
+	socklen_t client_len;
+	int len;
+
+	while (true) {
+		client_len = sizeof(client);
+		len = zsock_recvfrom(server_sock, buf, sizeof(buf), 0,
+				     (struct sockaddr *)&client, &client_len);
+		if (len < 0) {
+			continue;
+		}
+
+		atomic_inc(&queries_received);
+
+		len = make_response(buf, len);
+		if (len < 0) {
+			continue;
+		}
+
+		if (reply_delay_ms > 0) {
+			k_msleep(reply_delay_ms);
+		}
+
+		(void)zsock_sendto(server_sock, buf, len, 0,
+				   (struct sockaddr *)&client, client_len);
+	}
+}
+
+K_THREAD_DEFINE(dns_server_thread_id, STACK_SIZE,
+		process_dns, NULL, NULL, NULL,
+		THREAD_PRIORITY, 0, -1);
+
+static void result_cb(enum dns_resolve_status status,
+		      struct dns_addrinfo *info,
+		      void *user_data)
+{
+	struct result *result = user_data;
+
+	if (status == DNS_EAI_INPROGRESS) {
+		result->addrs++;
+		return;
+	}
+
+	result->status = status;
+	k_sem_give(&result->done);
+}
+
+static void resolve_start(const char *name, struct result *result)
+{
+	k_sem_init(&result->done, 0, 1);
+	result->status = 0;
+	result->addrs = 0;
+
+	zassert_ok(dns_resolve_name(dns_resolve_get_default(), name,
+				    DNS_QUERY_TYPE_A, NULL, result_cb, result,
+				    QUERY_TIMEOUT),
+		   "Cannot resolve %s", name);
+}
+
+static void resolve_wait(struct result *result, int status, int addrs)
+{
+	zassert_ok(k_sem_take(&result->done, WAIT_TIME), "No result");
+	zassert_equal(result->status, status, "Status %d, expected %d",
+		      result->status, status);
+	zassert_equal(result->addrs, addrs, "%d addresses, expected %d",
+		      result->addrs, addrs);
+}
+
+static void resolve(const char *name, int status, int addrs)
+{
+	struct result result;
+
+	resolve_start(name, &result);
+	resolve_wait(&result, status, addrs);
+}
+
+ZTEST(dns_resolve_cache, test_cache_hit)
+{
+	resolve("cached.example.com", DNS_EAI_ALLDONE, 1);
+	resolve("cached.example.com", DNS_EAI_ALLDONE, 1);
+	resolve("cached.example.com", DNS_EAI_ALLDONE, 1);
+
+	zassert_equal(atomic_get(&queries_received), 1,
+		      "Cached answer not used");
+}
+
+ZTEST(dns_resolve_cache, test_negative_cache)
+{
+	resolve(NX_PREFIX ".example.com", DNS_EAI_NODATA, 0);
+	resolve(NX_PREFIX ".example.com", DNS_EAI_NODATA, 0);
+
+	zassert_equal(atomic_get(&queries_received), 1,
+		      "Non-existent name not cached");
+}
+
+ZTEST(dns_resolve_cache, test_coalesce)
+{
+	struct result results[CONFIG_DNS_NUM_CONCUR_QUERIES];
+
+	reply_delay_ms = 200;
+
+	ARRAY_FOR_EACH_PTR(results, result) {
+		resolve_start("coalesced.example.com", result);
+	}
+
+	ARRAY_FOR_EACH_PTR(results, result) {
+		resolve_wait(result, DNS_EAI_ALLDONE, 1);
+	}
+
+	zassert_equal(atomic_get(&queries_received), 1,
+		      "Identical queries not coalesced");
+}
+
+ZTEST(dns_resolve_cache, test_coalesce_leader_cancel)
+{
+	struct result leader, waiting;
+	uint16_t dns_id;
+
+	reply_delay_ms = 200;
+
+	k_sem_init(&leader.done, 0, 1);
+	leader.addrs = 0;
+	zassert_ok(dns_resolve_name(dns_resolve_get_default(), "promoted.example.com",
+				    DNS_QUERY_TYPE_A, &dns_id, result_cb, &leader,
+				    QUERY_TIMEOUT));
+	resolve_start("promoted.example.com", &waiting);
+
+	/* The waiting query sends its own request instead of being cancelled */
+	zassert_ok(dns_resolve_cancel(dns_resolve_get_default(), dns_id));
+	resolve_wait(&leader, DNS_EAI_CANCELED, 0);
+	resolve_wait(&waiting, DNS_EAI_ALLDONE, 1);
+
+	zassert_equal(atomic_get(&queries_received), 2,
+		      "Waiting query not sent");
+}
+
+ZTEST(dns_resolve_cache, test_prefetch)
+{
+	answer_ttl = 2;
+
+	resolve("prefetched.example.com", DNS_EAI_ALLDONE, 1);
+	zassert_equal(atomic_get(&queries_received), 1);
+
+	/* In the second half of the TTL, a hit refreshes the entry in the
+	 * background.
+	 */
+	k_msleep(1200);
+	resolve("prefetched.example.com", DNS_EAI_ALLDONE, 1);
+	k_msleep(100);
+	zassert_equal(atomic_get(&queries_received), 2, "Entry not refreshed");
+
+	/* The original answer has expired by now, the refreshed one has not */
+	k_msleep(1000);
+	resolve("prefetched.example.com", DNS_EAI_ALLDONE, 1);
+	zassert_equal(atomic_get(&queries_received), 2,
+		      "Refreshed answer not cached");
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	atomic_clear(&queries_received);
+	answer_ttl = 60;
+	reply_delay_ms = 0;
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in addr;
+	int ret;
+
+	ret = net_ipaddr_parse(CONFIG_DNS_SERVER1, sizeof(CONFIG_DNS_SERVER1) - 1,
+			       (struct sockaddr *)&addr);
+	zassert_true(ret, "Cannot parse IP address %s", CONFIG_DNS_SERVER1);
+
+	server_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(server_sock >= 0, "Cannot create socket (%d)", errno);
+
+	zassert_ok(zsock_bind(server_sock, (struct sockaddr *)&addr, sizeof(addr)),
+		   "Cannot bind socket (%d)", errno);
+
+	k_thread_start(dns_server_thread_id);
+
+	return NULL;
+}
+
+ZTEST_SUITE(dns_resolve_cache, NULL, setup, before, NULL, NULL);
@@ -11,6 +11,7 @@
 #include <zephyr/net/http/service.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/posix/sys/eventfd.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/ztest.h>
 
 #define SUPPORT_BACKWARD_COMPATIBILITY 1
@@ -63,6 +64,32 @@ struct http_resource_detail_static index_html_gz_resource_detail = {
 HTTP_RESOURCE_DEFINE(index_html_gz_resource, test_http_service, "/",
 		     &index_html_gz_resource_detail);
 
+/* Larger than the connection window, and split into several frames */
+#define BIG_DATA_LEN    40000
+#define BIG_STREAMS     2
+#define QUIET_TIMEOUT   200
+
+static uint8_t big_data[BIG_DATA_LEN];
+struct http_resource_detail_static big_resource_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "application/octet-stream",
+		},
+	.static_data = big_data,
+	.static_data_len = sizeof(big_data),
+};
+
+HTTP_RESOURCE_DEFINE(big_resource, test_http_service, "/big",
+		     &big_resource_detail);
+
+struct big_stream {
+	uint32_t stream_id;
+	size_t received;
+	bool headers;
+	bool ended;
+};
+
 static void test_streams(void)
 {
 	int ret;
@@ -317,6 +344,401 @@ ZTEST(server_function_tests, test_http_server_start_stop)
 	zassert_ok(http_server_stop(), "Failed to stop the server");
 }
 
+static int connect_client(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int client_fd;
+	int ret;
+
+	ret = zsock_inet_pton(AF_INET, MY_IPV4_ADDR, &sa.sin_addr.s_addr);
+	zassert_equal(1, ret, "inet_pton() failed to convert %s", MY_IPV4_ADDR);
+
+	client_fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_not_equal(client_fd, -1, "failed to create client socket (%d)", errno);
+
+	ret = zsock_connect(client_fd, (struct sockaddr *)&sa, sizeof(sa));
+	zassert_not_equal(ret, -1, "failed to connect (%d)", errno);
+
+	return client_fd;
+}
+
+static void send_all(int fd, const void *buf, size_t len)
+{
+	while (len > 0) {
+		int ret = zsock_send(fd, buf, len, 0);
+
+		zassert_true(ret > 0, "send() failed (%d)", errno);
+
+		buf = (const uint8_t *)buf + ret;
+		len -= ret;
+	}
+}
+
+static void recv_all(int fd, uint8_t *buf, size_t len)
+{
+	while (len > 0) {
+		int ret = zsock_recv(fd, buf, len, 0);
+
+		zassert_true(ret > 0, "recv() failed (%d)", errno);
+
+		buf += ret;
+		len -= ret;
+	}
+}
+
+static size_t put_frame_header(uint8_t *buf, size_t len, uint8_t type,
+			       uint8_t flags, uint32_t stream_id)
+{
+	sys_put_be24(len, &buf[HTTP_SERVER_FRAME_LENGTH_OFFSET]);
+	buf[HTTP_SERVER_FRAME_TYPE_OFFSET] = type;
+	buf[HTTP_SERVER_FRAME_FLAGS_OFFSET] = flags;
+	sys_put_be32(stream_id, &buf[HTTP_SERVER_FRAME_STREAM_ID_OFFSET]);
+
+	return HTTP_SERVER_FRAME_HEADER_SIZE;
+}
+
+/* Preface, SETTINGS with the initial window size and GET /big on each stream */
+static void send_big_requests(int fd, uint32_t initial_window,
+			      struct big_stream *streams)
+{
+	static const uint8_t get_big[] = {
+		0x82, 0x86, 0x04, 0x04, '/', 'b', 'i', 'g',
+	};
+	uint8_t buf[128];
+	size_t len = 0;
+
+	memcpy(buf, HTTP2_PREFACE, sizeof(HTTP2_PREFACE) - 1);
+	len += sizeof(HTTP2_PREFACE) - 1;
+
+	len += put_frame_header(&buf[len], sizeof(struct http_settings_field),
+				HTTP_SERVER_SETTINGS_FRAME, 0, 0);
+	sys_put_be16(HTTP_SETTINGS_INITIAL_WINDOW_SIZE, &buf[len]);
+	sys_put_be32(initial_window, &buf[len + sizeof(uint16_t)]);
+	len += sizeof(struct http_settings_field);
+
+	for (int i = 0; i < BIG_STREAMS; i++) {
+		streams[i] = (struct big_stream){ .stream_id = 2 * i + 1 };
+
+		len += put_frame_header(&buf[len], sizeof(get_big),
+					HTTP_SERVER_HEADERS_FRAME,
+					HTTP_SERVER_FLAG_END_HEADERS |
+					HTTP_SERVER_FLAG_END_STREAM,
+					streams[i].stream_id);
+		memcpy(&buf[len], get_big, sizeof(get_big));
+		len += sizeof(get_big);
+	}
+
+	send_all(fd, buf, len);
+}
+
+static void send_window_update(int fd, uint32_t stream_id, uint32_t increment)
+{
+	uint8_t buf[HTTP_SERVER_FRAME_HEADER_SIZE + sizeof(uint32_t)];
+
+	put_frame_header(buf, sizeof(uint32_t), HTTP_SERVER_WINDOW_UPDATE_FRAME,
+			 0, stream_id);
+	sys_put_be32(increment, &buf[HTTP_SERVER_FRAME_HEADER_SIZE]);
+
+	send_all(fd, buf, sizeof(buf));
+}
+
+static void check_big_headers(const uint8_t *block, size_t len)
+{
+	static struct http_hpack_header_buf header;
+	bool found = false;
+
+	while (len > 0) {
+		int ret = http_hpack_decode_header(block, len, &header);
+
+		zassert_true(ret > 0, "Cannot decode headers (%d)", ret);
+
+		if (header.name_len == sizeof("content-length") - 1 &&
+		    memcmp(header.name, "content-length", header.name_len) == 0) {
+			zassert_equal(header.value_len,
+				      sizeof(STRINGIFY(BIG_DATA_LEN)) - 1);
+			zassert_mem_equal(header.value, STRINGIFY(BIG_DATA_LEN),
+					  header.value_len);
+			found = true;
+		}
+
+		block += ret;
+		len -= ret;
+	}
+
+	zassert_true(found, "No content-length header");
+}
+
+/* Receive the frames the server sends until it goes quiet. Checks the data,
+ * that no frame exceeds the windows or the default frame size, and if
+ * interleaved is set, that the streams take turns.
+ */
+static void recv_big_frames(int fd, struct big_stream *streams, int window[],
+			    bool interleaved)
+{
+	static uint8_t payload[HTTP_SERVER_DEFAULT_MAX_FRAME_SIZE];
+	struct zsock_pollfd pfd = { .fd = fd, .events = ZSOCK_POLLIN };
+	struct big_stream *last = NULL;
+	uint8_t header[HTTP_SERVER_FRAME_HEADER_SIZE];
+
+	while (zsock_poll(&pfd, 1, QUIET_TIMEOUT) > 0) {
+		struct big_stream *stream = NULL;
+		uint32_t stream_id;
+		uint32_t length;
+
+		recv_all(fd, header, sizeof(header));
+
+		length = sys_get_be24(&header[HTTP_SERVER_FRAME_LENGTH_OFFSET]);
+		stream_id = sys_get_be32(&header[HTTP_SERVER_FRAME_STREAM_ID_OFFSET]);
+		zassert_true(length <= sizeof(payload), "Frame too large (%u)", length);
+
+		recv_all(fd, payload, length);
+
+		for (int i = 0; i < BIG_STREAMS; i++) {
+			if (streams[i].stream_id == stream_id) {
+				stream = &streams[i];
+			}
+		}
+
+		if (header[HTTP_SERVER_FRAME_TYPE_OFFSET] == HTTP_SERVER_HEADERS_FRAME) {
+			zassert_not_null(stream, "HEADERS on stream %u", stream_id);
+			zassert_false(stream->headers, "HEADERS sent twice");
+
+			check_big_headers(payload, length);
+			stream->headers = true;
+			continue;
+		}
+
+		if (header[HTTP_SERVER_FRAME_TYPE_OFFSET] != HTTP_SERVER_DATA_FRAME) {
+			continue;
+		}
+
+		zassert_not_null(stream, "DATA on stream %u", stream_id);
+		zassert_true(stream->headers, "DATA before HEADERS");
+		zassert_false(stream->ended, "DATA after END_STREAM");
+		zassert_true((int)length <= window[0] &&
+			     (int)length <= window[1 + stream - streams],
+			     "Flow control window exceeded");
+		zassert_mem_equal(payload, &big_data[stream->received], length,
+				  "Wrong data on stream %u", stream_id);
+
+		/* Once all streams have a response in progress, they
+		 * take turns.
+		 */
+		if (interleaved && streams[0].headers && streams[1].headers &&
+		    !streams[0].ended && !streams[1].ended && last != NULL) {
+			zassert_not_equal(stream, last, "Streams not interleaved");
+		}
+
+		window[0] -= length;
+		window[1 + stream - streams] -= length;
+		stream->received += length;
+		stream->ended = (header[HTTP_SERVER_FRAME_FLAGS_OFFSET] &
+				 HTTP_SERVER_FLAG_END_STREAM) != 0;
+		zassert_equal(stream->ended, stream->received == BIG_DATA_LEN,
+			      "END_STREAM does not match the data");
+
+		last = stream;
+	}
+}
+
+ZTEST(server_function_tests, test_http_stream_interleaving)
+{
+	struct big_stream streams[BIG_STREAMS];
+	int window[1 + BIG_STREAMS] = {
+		HTTP_SERVER_DEFAULT_SEND_WINDOW_SIZE,
+		HTTP_SERVER_DEFAULT_SEND_WINDOW_SIZE,
+		HTTP_SERVER_DEFAULT_SEND_WINDOW_SIZE,
+	};
+	int client_fd;
+
+	zassert_ok(http_server_start(), "Failed to start the server");
+
+	client_fd = connect_client();
+	send_big_requests(client_fd, HTTP_SERVER_DEFAULT_SEND_WINDOW_SIZE, streams);
+
+	/* Both responses share the connection window. */
+	recv_big_frames(client_fd, streams, window, true);
+	zassert_equal(window[0], 0, "Connection window not used up");
+	zassert_true(streams[0].received > 0 && streams[1].received > 0,
+		     "A stream got no data");
+
+	send_window_update(client_fd, 0, 2 * BIG_DATA_LEN);
+	window[0] += 2 * BIG_DATA_LEN;
+	recv_big_frames(client_fd, streams, window, true);
+	zassert_true(streams[0].ended && streams[1].ended, "Responses not complete");
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_HEADERS_CACHE)
+	zassert_true(big_resource_detail.headers_block_len > 0,
+		     "Response headers not cached");
+#endif
+
+	zassert_ok(zsock_close(client_fd), "close() failed on the client fd (%d)", errno);
+	zassert_ok(http_server_stop(), "Failed to stop the server");
+}
+
+ZTEST(server_function_tests, test_http_flow_control)
+{
+	struct big_stream streams[BIG_STREAMS];
+	int window[1 + BIG_STREAMS] = {
+		HTTP_SERVER_DEFAULT_SEND_WINDOW_SIZE, 1000, 1000,
+	};
+	int client_fd;
+
+	zassert_ok(http_server_start(), "Failed to start the server");
+
+	client_fd = connect_client();
+	send_big_requests(client_fd, 1000, streams);
+
+	recv_big_frames(client_fd, streams, window, false);
+	zassert_equal(streams[0].received, 1000, "Stream window not used up");
+	zassert_equal(streams[1].received, 1000, "Stream window not used up");
+
+	/* Only the stream with the window opened continues */
+	send_window_update(client_fd, streams[0].stream_id, BIG_DATA_LEN);
+	window[1] += BIG_DATA_LEN;
+	recv_big_frames(client_fd, streams, window, false);
+	zassert_true(streams[0].ended, "Response not complete");
+	zassert_equal(streams[1].received, 1000, "Data beyond the stream window");
+
+	/* Then the connection window runs out */
+	send_window_update(client_fd, streams[1].stream_id, BIG_DATA_LEN);
+	window[2] += BIG_DATA_LEN;
+	recv_big_frames(client_fd, streams, window, false);
+	zassert_equal(window[0], 0, "Connection window not used up");
+	zassert_false(streams[1].ended, "Data beyond the connection window");
+
+	send_window_update(client_fd, 0, BIG_DATA_LEN);
+	window[0] += BIG_DATA_LEN;
+	recv_big_frames(client_fd, streams, window, false);
+	zassert_true(streams[1].ended, "Response not complete");
+
+	zassert_ok(zsock_close(client_fd), "close() failed on the client fd (%d)", errno);
+	zassert_ok(http_server_stop(), "Failed to stop the server");
+}
+
+#define IDLE_CLIENTS 3
+
+/* Receive frames until one of the type, with the flags set, arrives on the
+ * stream. Returns false if the server goes quiet before that.
+ */
+static bool recv_frame(int fd, uint8_t type, uint8_t flags, uint32_t stream_id)
+{
+	static uint8_t payload[BUFFER_SIZE];
+	struct zsock_pollfd pfd = { .fd = fd, .events = ZSOCK_POLLIN };
+	uint8_t header[HTTP_SERVER_FRAME_HEADER_SIZE];
+
+	while (zsock_poll(&pfd, 1, QUIET_TIMEOUT) > 0) {
+		uint32_t length;
+
+		recv_all(fd, header, sizeof(header));
+
+		length = sys_get_be24(&header[HTTP_SERVER_FRAME_LENGTH_OFFSET]);
+		zassert_true(length <= sizeof(payload), "Frame too large (%u)", length);
+
+		recv_all(fd, payload, length);
+
+		if (header[HTTP_SERVER_FRAME_TYPE_OFFSET] == type &&
+		    (header[HTTP_SERVER_FRAME_FLAGS_OFFSET] & flags) == flags &&
+		    sys_get_be32(&header[HTTP_SERVER_FRAME_STREAM_ID_OFFSET]) == stream_id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Preface and SETTINGS, done once the server has acknowledged the settings */
+static void http2_handshake(int fd)
+{
+	uint8_t buf[sizeof(HTTP2_PREFACE) - 1 + HTTP_SERVER_FRAME_HEADER_SIZE];
+	size_t len = sizeof(HTTP2_PREFACE) - 1;
+
+	memcpy(buf, HTTP2_PREFACE, len);
+	len += put_frame_header(&buf[len], 0, HTTP_SERVER_SETTINGS_FRAME, 0, 0);
+
+	send_all(fd, buf, len);
+
+	zassert_true(recv_frame(fd, HTTP_SERVER_SETTINGS_FRAME,
+				HTTP_SERVER_FLAG_SETTINGS_ACK, 0),
+		     "No SETTINGS ACK");
+}
+
+/* HEADERS: GET / */
+static size_t put_get_root(uint8_t *buf, uint32_t stream_id)
+{
+	static const uint8_t get_root[] = { 0x82, 0x86, 0x84 };
+	size_t len;
+
+	len = put_frame_header(buf, sizeof(get_root), HTTP_SERVER_HEADERS_FRAME,
+			       HTTP_SERVER_FLAG_END_HEADERS |
+			       HTTP_SERVER_FLAG_END_STREAM, stream_id);
+	memcpy(&buf[len], get_root, sizeof(get_root));
+
+	return len + sizeof(get_root);
+}
+
+ZTEST(server_function_tests, test_http_idle_clients)
+{
+	const int buffers = CONFIG_HTTP_SERVER_CLIENT_BUFFER_COUNT;
+	uint8_t req[HTTP_SERVER_FRAME_HEADER_SIZE + 3];
+	int fds[IDLE_CLIENTS];
+	size_t len;
+
+	zassert_ok(http_server_start(), "Failed to start the server");
+
+	/* Idle connections hold no buffer, so all the clients get served
+	 * even if there are fewer buffers than clients.
+	 */
+	for (int i = 0; i < IDLE_CLIENTS; i++) {
+		fds[i] = connect_client();
+		http2_handshake(fds[i]);
+	}
+
+	for (int i = 0; i < IDLE_CLIENTS; i++) {
+		len = put_get_root(req, 1);
+		send_all(fds[i], req, len);
+
+		zassert_true(recv_frame(fds[i], HTTP_SERVER_DATA_FRAME,
+					HTTP_SERVER_FLAG_END_STREAM, 1),
+			     "No response on client %d", i);
+	}
+
+	/* Clients in the middle of a request hold on to their buffers, a
+	 * client sending a request meanwhile waits until one is released.
+	 */
+	if (buffers < IDLE_CLIENTS) {
+		len = put_get_root(req, 3);
+
+		for (int i = 0; i < buffers; i++) {
+			send_all(fds[i], req, HTTP_SERVER_FRAME_HEADER_SIZE);
+		}
+
+		send_all(fds[buffers], req, len);
+		zassert_false(recv_frame(fds[buffers], HTTP_SERVER_DATA_FRAME,
+					 HTTP_SERVER_FLAG_END_STREAM, 3),
+			      "Request handled without a buffer");
+
+		send_all(fds[0], &req[HTTP_SERVER_FRAME_HEADER_SIZE],
+			 len - HTTP_SERVER_FRAME_HEADER_SIZE);
+		zassert_true(recv_frame(fds[0], HTTP_SERVER_DATA_FRAME,
+					HTTP_SERVER_FLAG_END_STREAM, 3),
+			     "No response on client 0");
+		zassert_true(recv_frame(fds[buffers], HTTP_SERVER_DATA_FRAME,
+					HTTP_SERVER_FLAG_END_STREAM, 3),
+			     "Waiting client not served");
+	}
+
+	for (int i = 0; i < IDLE_CLIENTS; i++) {
+		zassert_ok(zsock_close(fds[i]), "close() failed on the client fd (%d)",
+			   errno);
+	}
+
+	zassert_ok(http_server_stop(), "Failed to stop the server");
+}
+
 ZTEST(server_function_tests, test_get_frame_type_name)
 {
 	zassert_equal(strcmp(get_frame_type_name(HTTP_SERVER_DATA_FRAME), "DATA"), 0,
@@ -361,13 +783,10 @@ ZTEST(server_function_tests, test_parse_http_frames)
 		0x0b, 0x83
 	};
 
-	memcpy(ctx_client1.buffer, buffer1, sizeof(buffer1));
-	memcpy(ctx_client2.buffer, buffer2, sizeof(buffer2));
-
-	ctx_client1.cursor = ctx_client1.buffer;
+	ctx_client1.cursor = buffer1;
 	ctx_client1.data_len = ARRAY_SIZE(buffer1);
 
-	ctx_client2.cursor = ctx_client2.buffer;
+	ctx_client2.cursor = buffer2;
 	ctx_client2.data_len = ARRAY_SIZE(buffer2);
 
 	/* Test: Buffer with the first frame */
@@ -399,4 +818,14 @@ ZTEST(server_function_tests, test_parse_http_frames)
 		      "Expected stream_identifier for the 2nd frame doesn't match");
 }
 
-ZTEST_SUITE(server_function_tests, NULL, NULL, NULL, NULL, NULL);
+static void *server_function_tests_setup(void)
+{
+	for (int i = 0; i < sizeof(big_data); i++) {
+		big_data[i] = i % 251;
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(server_function_tests, NULL, server_function_tests_setup,
+	    NULL, NULL, NULL);
@@ -0,0 +1,544 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/mqtt.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+
+#define STACK_SIZE 2048
+#define THREAD_PRIORITY K_PRIO_COOP(2)
+#define BROKER_PORT 11883
+#define WAIT_TIME_MS 2000
+#define POLL_TIMEOUT_MS 10
+#define BUFFER_SIZE 1024
+#define BROKER_BUFFER_SIZE 2048
+#define TOPIC "telemetry/sensor"
+#define PAYLOAD "{\"temp\":21.5,\"hum\":40.2,\"seq\":0}"
+#define BENCHMARK_COUNT 200
+
+#define PKT_CONNECT 0x10
+#define PKT_CONNACK 0x20
+#define PKT_PUBLISH 0x30
+#define PKT_PUBACK 0x40
+#define PKT_PUBREC 0x50
+#define PKT_PUBREL 0x60
+#define PKT_PUBCOMP 0x70
+#define PKT_PINGREQ 0xC0
+#define PKT_PINGRESP 0xD0
+
+static int server_sock;
+static int broker_sock = -1;
+static K_MUTEX_DEFINE(broker_lock);
+static atomic_t publishes_received;
+static bool hold_acks;
+static uint16_t held_ids[2 * CONFIG_MQTT_LIB_PUBLISH_WINDOW];
+static int held_count;
+
+static uint8_t rx_buffer[BUFFER_SIZE];
+static uint8_t tx_buffer[BUFFER_SIZE];
+static uint8_t large_payload[BUFFER_SIZE + 512];
+static struct mqtt_client client;
+static struct sockaddr_in broker_addr;
+static bool connected;
+static int pubcomps;
+static uint16_t next_id;
+
+/* Appends an acknowledgment, or the CONNACK for a zero message id */
+static size_t put_ack(uint8_t *buf, uint8_t type, uint16_t message_id)
+{
+	buf[0] = type;
+	buf[1] = 2;
+	sys_put_be16(message_id, &buf[2]);
+
+	return 4;
+}
+
+/* Length of the packet at the start of buf, 0 if it is incomplete */
+static size_t packet_len(const uint8_t *buf, size_t len, size_t *header_len)
+{
+	uint32_t remaining = 0;
+
+	for (size_t i = 1; i < MIN(len, 5); i++) {
+		remaining |= (buf[i] & 0x7F) << (7 * (i - 1));
+
+		if ((buf[i] & 0x80) == 0) {
+			*header_len = i + 1;
+
+			return (i + 1 + remaining <= len) ? i + 1 + remaining : 0;
+		}
+	}
+
+	return 0;
+}
+
+/* Handles a packet from the client, returns the length of the response */
+static size_t handle_packet(const uint8_t *pkt, size_t header_len, uint8_t *resp)
+{
+	const uint8_t *var_header = pkt + header_len;
+	uint8_t qos = (pkt[0] >> 1) & 0x03;
+	uint16_t message_id;
+
+	switch (pkt[0] & 0xF0) {
+	case PKT_CONNECT:
+		return put_ack(resp, PKT_CONNACK, 0);
+
+	case PKT_PUBLISH:
+		atomic_inc(&publishes_received);
+
+		if (qos == 0) {
+			return 0;
+		}
+
+		message_id = sys_get_be16(var_header + 2 +
+					  sys_get_be16(var_header));
+
+		if (qos == 2) {
+			return put_ack(resp, PKT_PUBREC, message_id);
+		}
+
+		if (hold_acks) {
+			held_ids[held_count++] = message_id;
+			return 0;
+		}
+
+		return put_ack(resp, PKT_PUBACK, message_id);
+
+	case PKT_PUBREL:
+		return put_ack(resp, PKT_PUBCOMP, sys_get_be16(var_header));
+
+	case PKT_PINGREQ:
+		resp[0] = PKT_PINGRESP;
+		resp[1] = 0;
+		return 2;
+
+	default:
+		return 0;
+	}
+}
+
+/* Like a real broker, answers all the packets received at once with one
+ * write.
+ */
+static void process_broker(void)
+{
+	static uint8_t buf[BROKER_BUFFER_SIZE];
+	static uint8_t resp[BROKER_BUFFER_SIZE];
+	size_t len = 0;
+
+	while (true) {
+		size_t offset = 0;
+		size_t resp_len = 0;
+		size_t header_len;
+		size_t pkt_len;
+		ssize_t ret;
+
+		if (broker_sock < 0) {
+			broker_sock = zsock_accept(server_sock, NULL, NULL);
+			if (broker_sock < 0) {
+				/* The listening socket was closed */
+				return;
+			}
+
+			len = 0;
+			continue;
+		}
+
+		ret = zsock_recv(broker_sock, buf + len, sizeof(buf) - len, 0);
+		if (ret <= 0) {
+			zsock_close(broker_sock);
+			broker_sock = -1;
+			continue;
+		}
+
+		len += ret;
+
+		k_mutex_lock(&broker_lock, K_FOREVER);
+
+		while ((pkt_len = packet_len(buf + offset, len - offset,
+					     &header_len)) > 0) {
+			if (resp_len > sizeof(resp) - 4) {
+				(void)zsock_send(broker_sock, resp, resp_len, 0);
+				resp_len = 0;
+			}
+
+			resp_len += handle_packet(buf + offset, header_len,
+						  resp + resp_len);
+			offset += pkt_len;
+		}
+
+		if (resp_len > 0) {
+			(void)zsock_send(broker_sock, resp, resp_len, 0);
+		}
+
+		k_mutex_unlock(&broker_lock);
+
+		memmove(buf, buf + offset, len - offset);
+		len -= offset;
+	}
+}
+
+K_THREAD_DEFINE(broker_thread_id, STACK_SIZE,
+		process_broker, NULL, NULL, NULL,
+		THREAD_PRIORITY, 0, -1);
+
+static void broker_release_acks(void)
+{
+	uint8_t resp[4 * ARRAY_SIZE(held_ids)];
+	size_t resp_len = 0;
+	ssize_t ret;
+
+	k_mutex_lock(&broker_lock, K_FOREVER);
+
+	for (int i = 0; i < held_count; i++) {
+		resp_len += put_ack(resp + resp_len, PKT_PUBACK, held_ids[i]);
+	}
+
+	hold_acks = false;
+	held_count = 0;
+
+	ret = zsock_send(broker_sock, resp, resp_len, 0);
+
+	k_mutex_unlock(&broker_lock);
+
+	zassert_equal(ret, resp_len, "Cannot send acks (%d)", errno);
+}
+
+static void evt_handler(struct mqtt_client *const c, const struct mqtt_evt *evt)
+{
+	switch (evt->type) {
+	case MQTT_EVT_CONNACK:
+		connected = (evt->result == 0);
+		break;
+
+	case MQTT_EVT_DISCONNECT:
+		connected = false;
+		break;
+
+	case MQTT_EVT_PUBREC: {
+		const struct mqtt_pubrel_param param = {
+			.message_id = evt->param.pubrec.message_id,
+		};
+
+		(void)mqtt_publish_qos2_release(c, &param);
+		break;
+	}
+
+	case MQTT_EVT_PUBCOMP:
+		pubcomps++;
+		break;
+
+	default:
+		break;
+	}
+}
+
+/* One iteration of the usual application loop */
+static void process_client(void)
+{
+	struct zsock_pollfd fds = {
+		.fd = client.transport.tcp.sock,
+		.events = ZSOCK_POLLIN,
+	};
+	int timeout = MIN(mqtt_keepalive_time_left(&client), POLL_TIMEOUT_MS);
+	int ret;
+
+	zassert_true(zsock_poll(&fds, 1, timeout) >= 0, "poll failed (%d)", errno);
+
+	if (fds.revents & ZSOCK_POLLIN) {
+		zassert_ok(mqtt_input(&client));
+	}
+
+	ret = mqtt_live(&client);
+	zassert_true(ret == 0 || ret == -EAGAIN, "mqtt_live failed (%d)", ret);
+}
+
+static void wait_in_flight(int count)
+{
+	int64_t end = k_uptime_get() + WAIT_TIME_MS;
+
+	while (mqtt_publish_in_flight(&client) > count) {
+		zassert_true(k_uptime_get() < end, "%d messages not acknowledged",
+			     mqtt_publish_in_flight(&client) - count);
+		process_client();
+	}
+}
+
+static void wait_received(int count)
+{
+	int64_t end = k_uptime_get() + WAIT_TIME_MS;
+
+	while (atomic_get(&publishes_received) < count) {
+		zassert_true(k_uptime_get() < end, "%d of %d messages received",
+			     (int)atomic_get(&publishes_received), count);
+		k_msleep(POLL_TIMEOUT_MS);
+	}
+}
+
+static void init_publish(struct mqtt_publish_param *param, enum mqtt_qos qos)
+{
+	memset(param, 0, sizeof(*param));
+
+	param->message.topic.qos = qos;
+	param->message.topic.topic.utf8 = (uint8_t *)TOPIC;
+	param->message.topic.topic.size = sizeof(TOPIC) - 1;
+	param->message.payload.data = (uint8_t *)PAYLOAD;
+	param->message.payload.len = sizeof(PAYLOAD) - 1;
+
+	if (qos != MQTT_QOS_0_AT_MOST_ONCE) {
+		if (++next_id == 0U) {
+			next_id = 1U;
+		}
+
+		param->message_id = next_id;
+	}
+}
+
+static int publish(enum mqtt_qos qos)
+{
+	struct mqtt_publish_param param;
+
+	init_publish(&param, qos);
+
+	return mqtt_publish(&client, &param);
+}
+
+ZTEST(mqtt_pipeline, test_batch)
+{
+	for (int i = 0; i < 10; i++) {
+		zassert_ok(publish(MQTT_QOS_0_AT_MOST_ONCE));
+	}
+
+	/* Nothing is sent until the queue is flushed */
+	k_msleep(100);
+	zassert_equal(atomic_get(&publishes_received), 0, "Messages not queued");
+	zassert_equal(mqtt_keepalive_time_left(&client), 0,
+		      "Queued messages not signaled");
+
+	zassert_ok(mqtt_publish_flush(&client));
+	wait_received(10);
+}
+
+ZTEST(mqtt_pipeline, test_batch_full)
+{
+	/* 51 byte QoS 0 messages, 19 of them leave 4 bytes of the buffer free */
+	const size_t msg_len = 51;
+	const size_t buf_size = 19 * msg_len + 4;
+	struct mqtt_publish_param param;
+
+	zassert_ok(mqtt_publish_flush(&client));
+
+	/* Anything written past the end of the tx buffer shows up here */
+	memset(tx_buffer + buf_size, 0xAA, sizeof(tx_buffer) - buf_size);
+	client.tx_buf_size = buf_size;
+
+	for (int i = 0; i < 21; i++) {
+		init_publish(&param, MQTT_QOS_0_AT_MOST_ONCE);
+		param.message.payload.len = msg_len - 4 - (sizeof(TOPIC) - 1);
+
+		zassert_ok(mqtt_publish(&client, &param), "Message %d not queued", i);
+	}
+
+	/* The 20th message did not fit in the 4 bytes left */
+	wait_received(19);
+	zassert_ok(mqtt_publish_flush(&client));
+	wait_received(21);
+
+	client.tx_buf_size = sizeof(tx_buffer);
+
+	for (size_t i = buf_size; i < sizeof(tx_buffer); i++) {
+		zassert_equal(tx_buffer[i], 0xAA, "Written past the tx buffer at %zu", i);
+	}
+}
+
+ZTEST(mqtt_pipeline, test_large_message)
+{
+	struct mqtt_publish_param param;
+
+	zassert_ok(publish(MQTT_QOS_1_AT_LEAST_ONCE));
+
+	/* Too big to be queued, it is sent after the queued message */
+	init_publish(&param, MQTT_QOS_1_AT_LEAST_ONCE);
+	param.message.payload.data = large_payload;
+	param.message.payload.len = sizeof(large_payload);
+
+	zassert_ok(mqtt_publish(&client, &param));
+	zassert_equal(mqtt_publish_in_flight(&client), 2);
+
+	wait_in_flight(0);
+	zassert_equal(atomic_get(&publishes_received), 2);
+}
+
+ZTEST(mqtt_pipeline, test_window)
+{
+	struct mqtt_publish_param param;
+
+	hold_acks = true;
+
+	for (int i = 0; i < CONFIG_MQTT_LIB_PUBLISH_WINDOW; i++) {
+		zassert_ok(publish(MQTT_QOS_1_AT_LEAST_ONCE));
+	}
+
+	zassert_equal(mqtt_publish_in_flight(&client),
+		      CONFIG_MQTT_LIB_PUBLISH_WINDOW);
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE), -EAGAIN,
+		      "Window not enforced");
+
+	/* QoS 0 messages are not acknowledged, and not limited */
+	zassert_ok(publish(MQTT_QOS_0_AT_MOST_ONCE));
+
+	/* The id of a message in flight can only be reused to retransmit it */
+	init_publish(&param, MQTT_QOS_1_AT_LEAST_ONCE);
+	param.message_id = next_id - 2;
+	zassert_equal(mqtt_publish(&client, &param), -EBUSY);
+
+	param.dup_flag = 1U;
+	zassert_ok(mqtt_publish(&client, &param));
+	zassert_equal(mqtt_publish_in_flight(&client),
+		      CONFIG_MQTT_LIB_PUBLISH_WINDOW);
+
+	zassert_ok(mqtt_publish_flush(&client));
+	wait_received(CONFIG_MQTT_LIB_PUBLISH_WINDOW + 2);
+
+	broker_release_acks();
+	wait_in_flight(0);
+
+	zassert_ok(publish(MQTT_QOS_1_AT_LEAST_ONCE));
+	wait_in_flight(0);
+}
+
+ZTEST(mqtt_pipeline, test_qos2)
+{
+	for (int i = 0; i < 4; i++) {
+		zassert_ok(publish(MQTT_QOS_2_EXACTLY_ONCE));
+	}
+
+	zassert_equal(mqtt_publish_in_flight(&client), 4);
+
+	wait_in_flight(0);
+	zassert_equal(pubcomps, 4);
+}
+
+struct benchmark {
+	uint32_t time_ms;
+	uint32_t segments;
+};
+
+static void run_benchmark(bool flush_each, struct benchmark *result)
+{
+	struct net_stats before;
+	struct net_stats after;
+	uint32_t start;
+	int ret;
+
+	net_mgmt(NET_REQUEST_STATS_GET_ALL, NULL, &before, sizeof(before));
+	start = k_uptime_get_32();
+
+	for (int i = 0; i < BENCHMARK_COUNT; i++) {
+		while ((ret = publish(MQTT_QOS_1_AT_LEAST_ONCE)) == -EAGAIN) {
+			next_id--;
+			process_client();
+		}
+
+		zassert_ok(ret);
+
+		if (flush_each) {
+			zassert_ok(mqtt_publish_flush(&client));
+		}
+	}
+
+	wait_in_flight(0);
+
+	result->time_ms = k_uptime_get_32() - start;
+	net_mgmt(NET_REQUEST_STATS_GET_ALL, NULL, &after, sizeof(after));
+	result->segments = after.tcp.sent - before.tcp.sent;
+
+	zassert_equal(atomic_get(&publishes_received), BENCHMARK_COUNT);
+}
+
+ZTEST(mqtt_pipeline, test_benchmark)
+{
+	struct benchmark single;
+	struct benchmark batched;
+
+	run_benchmark(true, &single);
+	atomic_clear(&publishes_received);
+	run_benchmark(false, &batched);
+
+	TC_PRINT("%d QoS 1 messages, window %d\n", BENCHMARK_COUNT,
+		 CONFIG_MQTT_LIB_PUBLISH_WINDOW);
+	TC_PRINT("one write per message: %u ms, %u TCP segments\n",
+		 single.time_ms, single.segments);
+	TC_PRINT("batched writes:        %u ms, %u TCP segments\n",
+		 batched.time_ms, batched.segments);
+
+	zassert_true(2 * batched.segments < single.segments,
+		     "Messages not coalesced");
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	atomic_clear(&publishes_received);
+	hold_acks = false;
+	held_count = 0;
+	pubcomps = 0;
+}
+
+static void *setup(void)
+{
+	int64_t end;
+
+	broker_addr.sin_family = AF_INET;
+	broker_addr.sin_port = htons(BROKER_PORT);
+	zsock_inet_pton(AF_INET, "127.0.0.1", &broker_addr.sin_addr);
+
+	server_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(server_sock >= 0, "Cannot create socket (%d)", errno);
+
+	zassert_ok(zsock_bind(server_sock, (struct sockaddr *)&broker_addr,
+			      sizeof(broker_addr)),
+		   "Cannot bind socket (%d)", errno);
+	zassert_ok(zsock_listen(server_sock, 1), "Cannot listen (%d)", errno);
+
+	k_thread_start(broker_thread_id);
+
+	mqtt_client_init(&client);
+
+	client.broker = &broker_addr;
+	client.evt_cb = evt_handler;
+	client.client_id.utf8 = (uint8_t *)"zephyr_pipeline";
+	client.client_id.size = strlen("zephyr_pipeline");
+	client.transport.type = MQTT_TRANSPORT_NON_SECURE;
+	client.rx_buf = rx_buffer;
+	client.rx_buf_size = sizeof(rx_buffer);
+	client.tx_buf = tx_buffer;
+	client.tx_buf_size = sizeof(tx_buffer);
+
+	zassert_ok(mqtt_connect(&client), "Cannot connect");
+
+	end = k_uptime_get() + WAIT_TIME_MS;
+	while (!connected) {
+		zassert_true(k_uptime_get() < end, "No CONNACK");
+		process_client();
+	}
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)mqtt_disconnect(&client);
+	zsock_close(server_sock);
+}
+
+ZTEST_SUITE(mqtt_pipeline, NULL, setup, before, NULL, teardown);
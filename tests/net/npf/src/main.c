@@ -216,6 +216,59 @@ ZTEST(net_pkt_filter_test_suite, test_npf_example1)
 	zassert_true(npf_remove_recv_rule(&small_ip_pkt), "");
 }
 
+/*
+ * Rules testing the same interface and Ethernet type one after the other,
+ * which the rule compiler turns into nested switches.
+ */
+
+static NPF_IFACE_MATCH(match_iface_b, &dummy_iface_b);
+static NPF_ETH_TYPE_MATCH(ipv6_packet, NET_ETH_PTYPE_IPV6);
+static NPF_ETH_TYPE_MATCH(arp_packet, NET_ETH_PTYPE_ARP);
+
+static NPF_RULE(reject_a_ipv6, NET_DROP, match_iface_a, ipv6_packet);
+static NPF_RULE(accept_b_ip, NET_OK, ip_packet, match_iface_b);
+static NPF_RULE(accept_a_ip, NET_OK, match_iface_a, ip_packet);
+static NPF_RULE(reject_a_small, NET_DROP, match_iface_a, maxsize_200);
+static NPF_RULE(reject_b_arp, NET_DROP, match_iface_b, arp_packet);
+
+static bool recv_ok(int type, int size, struct net_if *iface)
+{
+	struct net_pkt *pkt = build_test_pkt(type, size, iface);
+	bool ok = net_pkt_filter_recv_ok(pkt);
+
+	net_pkt_unref(pkt);
+
+	return ok;
+}
+
+ZTEST(net_pkt_filter_test_suite, test_npf_grouped_rules)
+{
+	npf_append_recv_rule(&reject_a_ipv6);
+	npf_append_recv_rule(&accept_b_ip);
+	npf_append_recv_rule(&accept_a_ip);
+	npf_append_recv_rule(&reject_a_small);
+	npf_append_recv_rule(&reject_b_arp);
+	npf_append_recv_rule(&npf_default_ok);
+
+	zassert_true(recv_ok(NET_ETH_PTYPE_IP, 100, &dummy_iface_a), "");
+	zassert_true(recv_ok(NET_ETH_PTYPE_IP, 300, &dummy_iface_a), "");
+	zassert_false(recv_ok(NET_ETH_PTYPE_IPV6, 300, &dummy_iface_a), "");
+	zassert_false(recv_ok(NET_ETH_PTYPE_ARP, 100, &dummy_iface_a), "");
+	zassert_true(recv_ok(NET_ETH_PTYPE_ARP, 300, &dummy_iface_a), "");
+	zassert_true(recv_ok(NET_ETH_PTYPE_IP, 100, &dummy_iface_b), "");
+	zassert_true(recv_ok(NET_ETH_PTYPE_IPV6, 100, &dummy_iface_b), "");
+	zassert_false(recv_ok(NET_ETH_PTYPE_ARP, 100, &dummy_iface_b), "");
+
+	/* the first match must still win once a rule in a group is gone */
+	zassert_true(npf_remove_recv_rule(&accept_a_ip), "");
+
+	zassert_false(recv_ok(NET_ETH_PTYPE_IP, 100, &dummy_iface_a), "");
+	zassert_true(recv_ok(NET_ETH_PTYPE_IP, 300, &dummy_iface_a), "");
+	zassert_true(recv_ok(NET_ETH_PTYPE_IP, 100, &dummy_iface_b), "");
+
+	zassert_true(npf_remove_all_recv_rules(), "");
+}
+
 /*
  * Example 2 in NPF_RULE() documentation.
  */
@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+
+#include "lpm_trie.h"
+#include "route.h"
+
+#define MAX_PREFIXES 32
+#define ITERATIONS   2000
+
+struct prefix {
+	uint8_t key[NET_LPM_KEY_MAX_LEN];
+	uint8_t len;
+	bool used;
+};
+
+static struct net_lpm_node nodes[2 * MAX_PREFIXES];
+static struct net_lpm_trie trie;
+static struct prefix prefixes[MAX_PREFIXES];
+
+static bool key_has_prefix(const uint8_t *key, const uint8_t *prefix,
+			   uint8_t len)
+{
+	for (uint8_t i = 0; i < len; i++) {
+		uint8_t mask = BIT(7 - i % 8);
+
+		if ((key[i / 8] & mask) != (prefix[i / 8] & mask)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static struct prefix *reference_lookup(const uint8_t *key)
+{
+	struct prefix *best = NULL;
+
+	ARRAY_FOR_EACH_PTR(prefixes, p) {
+		if (p->used && key_has_prefix(key, p->key, p->len) &&
+		    (best == NULL || p->len > best->len)) {
+			best = p;
+		}
+	}
+
+	return best;
+}
+
+/* Keys sharing their first bytes, so that the prefixes nest and diverge */
+static void random_key(uint8_t *key)
+{
+	for (int i = 0; i < NET_LPM_KEY_MAX_LEN; i++) {
+		key[i] = i < 2 ? 0x20 : ((sys_rand8_get() & 3) == 0 ?
+					 sys_rand8_get() : 0);
+	}
+}
+
+static bool prefix_exists(const struct prefix *new)
+{
+	ARRAY_FOR_EACH_PTR(prefixes, p) {
+		if (p->used && p->len == new->len &&
+		    key_has_prefix(p->key, new->key, new->len)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void test_trie(uint8_t key_bits)
+{
+	int free_count = 0;
+
+	net_lpm_init(&trie, nodes, ARRAY_SIZE(nodes), key_bits);
+	memset(prefixes, 0, sizeof(prefixes));
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		struct prefix *p = &prefixes[sys_rand32_get() % MAX_PREFIXES];
+		uint8_t key[NET_LPM_KEY_MAX_LEN];
+
+		switch (sys_rand8_get() % 3) {
+		case 0:
+			if (p->used) {
+				break;
+			}
+
+			random_key(p->key);
+			p->len = sys_rand8_get() % (key_bits + 1);
+
+			if (prefix_exists(p)) {
+				break;
+			}
+
+			zassert_ok(net_lpm_insert(&trie, p->key, p->len, p));
+			p->used = true;
+			break;
+		case 1:
+			if (!p->used) {
+				break;
+			}
+
+			zassert_equal_ptr(net_lpm_remove(&trie, p->key, p->len), p);
+			zassert_is_null(net_lpm_get(&trie, p->key, p->len));
+			p->used = false;
+			break;
+		default:
+			random_key(key);
+			zassert_equal_ptr(net_lpm_lookup(&trie, key, NULL, NULL),
+					  reference_lookup(key),
+					  "Lookup differs from linear search");
+
+			if (p->used) {
+				zassert_equal_ptr(net_lpm_get(&trie, p->key, p->len), p);
+			}
+			break;
+		}
+	}
+
+	ARRAY_FOR_EACH_PTR(prefixes, p) {
+		if (p->used) {
+			zassert_equal_ptr(net_lpm_remove(&trie, p->key, p->len), p);
+		}
+	}
+
+	zassert_is_null(trie.root, "Trie not empty");
+
+	for (struct net_lpm_node *n = trie.free; n != NULL; n = n->child[0]) {
+		free_count++;
+	}
+
+	zassert_equal(free_count, ARRAY_SIZE(nodes), "Trie node leaked");
+}
+
+ZTEST(route_lpm, test_trie_ipv4)
+{
+	test_trie(32);
+}
+
+ZTEST(route_lpm, test_trie_ipv6)
+{
+	test_trie(128);
+}
+
+ZTEST(route_lpm, test_trie_full)
+{
+	uint8_t key[NET_LPM_KEY_MAX_LEN] = { 0 };
+
+	/* Two nodes, one prefix and the node joining it to the next one */
+	net_lpm_init(&trie, nodes, 2, 32);
+
+	key[0] = 0x0a;
+	zassert_ok(net_lpm_insert(&trie, key, 8, &prefixes[0]));
+
+	key[0] = 0xc0;
+	zassert_equal(net_lpm_insert(&trie, key, 8, &prefixes[1]), -ENOMEM);
+
+	/* Updating needs no node */
+	key[0] = 0x0a;
+	zassert_ok(net_lpm_insert(&trie, key, 8, &prefixes[1]));
+	zassert_equal_ptr(net_lpm_get(&trie, key, 8), &prefixes[1]);
+
+	zassert_equal(net_lpm_insert(&trie, key, 33, &prefixes[1]), -EINVAL);
+	zassert_equal(net_lpm_insert(&trie, key, 8, NULL), -EINVAL);
+}
+
+static int test_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static void test_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[2][6] = {
+		{ 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 },
+		{ 0x00, 0x00, 0x5e, 0x00, 0x53, 0x02 },
+	};
+	static int count;
+
+	net_if_set_link_addr(iface, mac[count++], sizeof(mac[0]),
+			     NET_LINK_DUMMY);
+}
+
+static struct dummy_api test_if_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_send,
+};
+
+NET_DEVICE_INIT_INSTANCE(route_lpm_test_0, "route_lpm_test_0", 0, NULL, NULL,
+			 NULL, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+			 &test_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2),
+			 1500);
+
+NET_DEVICE_INIT_INSTANCE(route_lpm_test_1, "route_lpm_test_1", 1, NULL, NULL,
+			 NULL, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+			 &test_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2),
+			 1500);
+
+static struct net_if *iface0;
+static struct net_if *iface1;
+
+static struct in_addr addr(const char *str)
+{
+	struct in_addr in;
+
+	zassert_ok(net_addr_pton(AF_INET, str, &in), "Invalid %s", str);
+
+	return in;
+}
+
+static struct net_route_entry_ipv4 *add(struct net_if *iface, const char *prefix,
+					uint8_t len, const char *gw)
+{
+	struct in_addr in_prefix = addr(prefix);
+	struct in_addr in_gw;
+
+	if (gw != NULL) {
+		in_gw = addr(gw);
+	}
+
+	return net_route_ipv4_add(iface, &in_prefix, len,
+				  gw != NULL ? &in_gw : NULL);
+}
+
+static struct net_if *lookup(struct net_if *iface, const char *dst)
+{
+	struct in_addr in_dst = addr(dst);
+
+	return net_route_ipv4_lookup(iface, &in_dst, NULL);
+}
+
+/* Check the interface and next hop of the route to dst, none if route_iface is NULL */
+static void check_route(struct net_if *iface, const char *dst,
+			struct net_if *route_iface, const char *nexthop)
+{
+	struct in_addr in_dst = addr(dst);
+	struct in_addr in_nexthop;
+
+	zassert_equal_ptr(net_route_ipv4_lookup(iface, &in_dst, &in_nexthop),
+			  route_iface, "Wrong route to %s", dst);
+
+	if (route_iface != NULL) {
+		struct in_addr expected = addr(nexthop);
+
+		zassert_true(net_ipv4_addr_cmp(&in_nexthop, &expected),
+			     "Wrong next hop to %s", dst);
+	}
+}
+
+static void route_cb(struct net_route_entry_ipv4 *entry, void *user_data)
+{
+	ARG_UNUSED(entry);
+	ARG_UNUSED(user_data);
+}
+
+ZTEST(route_lpm, test_ipv4_routes)
+{
+	struct net_route_entry_ipv4 *def, *net, *host, *other;
+	struct in_addr prefix;
+	struct in_addr gw;
+
+	def = add(iface0, "0.0.0.0", 0, "192.0.2.1");
+	net = add(iface0, "198.51.100.0", 24, "192.0.2.2");
+	host = add(iface0, "198.51.100.7", 32, NULL);
+	other = add(iface1, "198.51.100.0", 24, "203.0.113.1");
+
+	zassert_not_null(def);
+	zassert_not_null(net);
+	zassert_not_null(host);
+	zassert_not_null(other);
+	zassert_equal(net_route_ipv4_foreach(route_cb, NULL), 4);
+
+	check_route(iface0, "198.51.100.8", iface0, "192.0.2.2");
+	check_route(iface0, "198.51.100.7", iface0, "198.51.100.7");
+	check_route(iface0, "8.8.8.8", iface0, "192.0.2.1");
+	check_route(iface1, "198.51.100.7", iface1, "203.0.113.1");
+	check_route(iface1, "8.8.8.8", NULL, NULL);
+
+	/* Same prefix and interface updates the gateway */
+	zassert_equal_ptr(add(iface0, "198.51.100.0", 24, "192.0.2.3"), net);
+	gw = addr("192.0.2.3");
+	zassert_true(net_ipv4_addr_cmp(&net->gw, &gw));
+
+	/* Deleting the first of two routes sharing a prefix */
+	zassert_ok(net_route_ipv4_del(other));
+	zassert_equal(net_route_ipv4_del(other), -ENOENT);
+	check_route(iface0, "198.51.100.8", iface0, "192.0.2.3");
+	check_route(iface1, "198.51.100.8", NULL, NULL);
+
+	zassert_ok(net_route_ipv4_del(net));
+	check_route(iface0, "198.51.100.8", iface0, "192.0.2.1");
+
+	/* Deleting by prefix only deletes the route of the interface */
+	zassert_not_null(add(iface1, "198.51.100.0", 24, "203.0.113.1"));
+	prefix = addr("198.51.100.0");
+	zassert_equal(net_route_ipv4_del_prefix(iface0, &prefix, 24), -ENOENT);
+	zassert_ok(net_route_ipv4_del_prefix(iface1, &prefix, 24));
+	zassert_equal(net_route_ipv4_del_prefix(iface1, &prefix, 24), -ENOENT);
+	check_route(iface1, "198.51.100.8", NULL, NULL);
+	check_route(iface0, "198.51.100.7", iface0, "198.51.100.7");
+
+	zassert_equal(net_route_ipv4_del_by_iface(iface0), 2);
+	check_route(NULL, "198.51.100.7", NULL, NULL);
+}
+
+ZTEST(route_lpm, test_ipv4_routes_full)
+{
+	struct in_addr prefix = addr("10.0.0.0");
+
+	for (int i = 0; i < CONFIG_NET_MAX_IPV4_ROUTES; i++) {
+		prefix.s4_addr[1] = i;
+		zassert_not_null(net_route_ipv4_add(iface0, &prefix, 16, NULL));
+	}
+
+	prefix.s4_addr[1] = CONFIG_NET_MAX_IPV4_ROUTES;
+	zassert_is_null(net_route_ipv4_add(iface0, &prefix, 16, NULL));
+
+	for (int i = 0; i < CONFIG_NET_MAX_IPV4_ROUTES; i++) {
+		char dst[NET_IPV4_ADDR_LEN];
+
+		snprintk(dst, sizeof(dst), "10.%d.1.1", i);
+		zassert_not_null(lookup(iface0, dst), "No route to %s", dst);
+	}
+
+	zassert_equal(net_route_ipv4_del_by_iface(iface0),
+		      CONFIG_NET_MAX_IPV4_ROUTES);
+}
+
+ZTEST(route_lpm, test_ipv4_routes_iface_down)
+{
+	struct net_route_entry_ipv4 *def, *net;
+
+	def = add(iface0, "0.0.0.0", 0, "192.0.2.1");
+	net = add(iface1, "203.0.113.0", 24, NULL);
+
+	zassert_not_null(def);
+	zassert_not_null(net);
+	check_route(NULL, "203.0.113.1", iface1, "203.0.113.1");
+
+	/* Routes of an interface that is down are kept, but not selected */
+	zassert_ok(net_if_down(iface1));
+	check_route(NULL, "203.0.113.1", iface0, "192.0.2.1");
+	zassert_is_null(lookup(iface1, "203.0.113.1"));
+	zassert_equal(net_route_ipv4_foreach(route_cb, NULL), 2);
+
+	zassert_ok(net_if_up(iface1));
+	check_route(NULL, "203.0.113.1", iface1, "203.0.113.1");
+
+	zassert_equal(net_route_ipv4_del_by_iface(iface0), 1);
+	zassert_equal(net_route_ipv4_del_by_iface(iface1), 1);
+}
+
+static void iface_cb(struct net_if *iface, void *user_data)
+{
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(DUMMY)) {
+		return;
+	}
+
+	if (iface0 == NULL) {
+		iface0 = iface;
+	} else if (iface1 == NULL) {
+		iface1 = iface;
+	}
+}
+
+static void *setup(void)
+{
+	net_if_foreach(iface_cb, NULL);
+
+	zassert_not_null(iface0);
+	zassert_not_null(iface1);
+
+	return NULL;
+}
+
+ZTEST_SUITE(route_lpm, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+
+#define RX_RING_SIZE 10
+#define RX_TIMEOUT   K_MSEC(500)
+
+static struct net_if *test_iface;
+
+static struct net_pkt *received[RX_RING_SIZE];
+static int received_count;
+static K_SEM_DEFINE(received_sem, 0, RX_RING_SIZE);
+
+static enum net_verdict test_recv(struct net_if *iface, struct net_pkt *pkt)
+{
+	if (received_count < ARRAY_SIZE(received)) {
+		received[received_count++] = pkt;
+		k_sem_give(&received_sem);
+		return NET_OK;
+	}
+
+	return NET_DROP;
+}
+
+static int test_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static void test_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[6] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static struct dummy_api test_if_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_send,
+	.recv = test_recv,
+};
+
+NET_DEVICE_INIT(rx_batch_test, "rx_batch_test", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &test_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static struct net_pkt *alloc_rx_pkt(uint8_t id)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(test_iface, sizeof(id), AF_UNSPEC,
+					   0, K_NO_WAIT);
+	zassert_not_null(pkt, "Failed to allocate packet");
+	zassert_ok(net_pkt_write_u8(pkt, id), "Failed to write payload");
+
+	return pkt;
+}
+
+static uint8_t pkt_id(struct net_pkt *pkt)
+{
+	uint8_t id;
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_read_u8(pkt, &id), "Failed to read payload");
+
+	return id;
+}
+
+static void wait_received(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&received_sem, RX_TIMEOUT),
+			   "Packet %d not received", i);
+	}
+
+	zassert_equal(k_sem_take(&received_sem, K_MSEC(50)), -EAGAIN,
+		      "Unexpected packet received");
+}
+
+ZTEST(net_rx_batch, test_batch_in_order)
+{
+	struct net_pkt *pkts[RX_RING_SIZE];
+
+	for (int i = 0; i < ARRAY_SIZE(pkts); i++) {
+		pkts[i] = alloc_rx_pkt(i);
+	}
+
+	zassert_ok(net_recv_data_batch(test_iface, pkts, ARRAY_SIZE(pkts)));
+
+	wait_received(ARRAY_SIZE(pkts));
+
+	for (int i = 0; i < ARRAY_SIZE(pkts); i++) {
+		zassert_equal(received[i], pkts[i], "Packet %d out of order", i);
+		zassert_equal(pkt_id(received[i]), i, "Packet %d corrupted", i);
+	}
+}
+
+ZTEST(net_rx_batch, test_batch_skip)
+{
+	struct net_pkt *pkts[3];
+
+	pkts[0] = alloc_rx_pkt(0);
+	pkts[1] = NULL;
+	pkts[2] = net_pkt_rx_alloc(test_iface, K_NO_WAIT);
+	zassert_not_null(pkts[2], "Failed to allocate packet");
+
+	/* The empty packet is dropped, the NULL entry ignored */
+	zassert_ok(net_recv_data_batch(test_iface, pkts, ARRAY_SIZE(pkts)));
+
+	wait_received(1);
+	zassert_equal(received[0], pkts[0], "Wrong packet received");
+}
+
+ZTEST(net_rx_batch, test_batch_iface_down)
+{
+	struct net_pkt *pkt = alloc_rx_pkt(0);
+
+	zassert_ok(net_if_down(test_iface), "Failed to set iface down");
+
+	zassert_equal(net_recv_data_batch(test_iface, &pkt, 1), -ENETDOWN,
+		      "Packet accepted by a down iface");
+
+	zassert_ok(net_if_up(test_iface), "Failed to set iface up");
+
+	/* The caller still owns the packet on error */
+	net_pkt_unref(pkt);
+
+	zassert_equal(net_recv_data_batch(NULL, &pkt, 1), -EINVAL);
+	zassert_ok(net_recv_data_batch(test_iface, NULL, 0));
+}
+
+static struct rx_ring {
+	struct net_rx_poll poll;
+	struct net_pkt *pkts[RX_RING_SIZE];
+	int head;
+	int tail;
+	int polls;
+	bool masked;
+	struct k_sem done;
+} rx_ring;
+
+static int rx_ring_poll(struct net_rx_poll *poll, struct net_pkt **pkts,
+			int budget)
+{
+	struct rx_ring *ring = CONTAINER_OF(poll, struct rx_ring, poll);
+	int count = 0;
+
+	zassert_true(ring->masked, "Polled with the interrupt unmasked");
+
+	while (count < budget && ring->tail < ring->head) {
+		pkts[count++] = ring->pkts[ring->tail++];
+	}
+
+	ring->polls++;
+
+	return count;
+}
+
+static void rx_ring_done(struct net_rx_poll *poll)
+{
+	struct rx_ring *ring = CONTAINER_OF(poll, struct rx_ring, poll);
+
+	ring->masked = false;
+	k_sem_give(&ring->done);
+}
+
+ZTEST(net_rx_batch, test_rx_poll)
+{
+	k_sem_init(&rx_ring.done, 0, 1);
+	net_rx_poll_init(&rx_ring.poll, test_iface, rx_ring_poll, rx_ring_done);
+
+	for (int i = 0; i < RX_RING_SIZE; i++) {
+		rx_ring.pkts[rx_ring.head++] = alloc_rx_pkt(i);
+	}
+
+	/* What the interrupt handler of the driver does */
+	rx_ring.masked = true;
+	zassert_ok(net_rx_poll_schedule(&rx_ring.poll));
+
+	zassert_ok(k_sem_take(&rx_ring.done, RX_TIMEOUT), "Poll never done");
+	wait_received(RX_RING_SIZE);
+
+	/* 10 packets with a budget of 4 take 3 polls */
+	zassert_equal(rx_ring.polls,
+		      DIV_ROUND_UP(RX_RING_SIZE, CONFIG_NET_RX_POLL_BUDGET),
+		      "Unexpected number of polls");
+
+	for (int i = 0; i < RX_RING_SIZE; i++) {
+		zassert_equal(pkt_id(received[i]), i, "Packet %d out of order", i);
+	}
+}
+
+static void *setup(void)
+{
+	test_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(test_iface, "No dummy iface");
+
+	return NULL;
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < received_count; i++) {
+		net_pkt_unref(received[i]);
+	}
+
+	received_count = 0;
+	k_sem_reset(&received_sem);
+}
+
+ZTEST_SUITE(net_rx_batch, NULL, setup, NULL, after, NULL);
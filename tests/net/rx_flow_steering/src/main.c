@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+
+#include "net_private.h"
+
+#define FLOW_COUNT 16
+#define SEQ_COUNT  3
+#define RX_TIMEOUT K_MSEC(500)
+
+struct flow {
+	k_tid_t thread;
+	int next_seq;
+};
+
+static struct net_if *test_iface;
+
+static struct flow flows[FLOW_COUNT];
+static bool out_of_order;
+static bool moved;
+static struct k_spinlock lock;
+static K_SEM_DEFINE(received_sem, 0, FLOW_COUNT * SEQ_COUNT);
+
+static enum net_verdict test_recv(struct net_if *iface, struct net_pkt *pkt)
+{
+	const uint8_t *data = pkt->buffer->data + sizeof(struct net_ipv4_hdr);
+	uint16_t id = sys_get_be16(data);
+	uint8_t seq = data[2 * sizeof(uint16_t)];
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(iface);
+
+	key = k_spin_lock(&lock);
+
+	if (id < FLOW_COUNT) {
+		struct flow *flow = &flows[id];
+
+		if (seq != flow->next_seq++) {
+			out_of_order = true;
+		}
+
+		if (flow->thread == NULL) {
+			flow->thread = k_current_get();
+		} else if (flow->thread != k_current_get()) {
+			moved = true;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	net_pkt_unref(pkt);
+	k_sem_give(&received_sem);
+
+	return NET_OK;
+}
+
+static int test_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static void test_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[6] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static struct dummy_api test_if_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_send,
+	.recv = test_recv,
+};
+
+NET_DEVICE_INIT(rx_flow_test, "rx_flow_test", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &test_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+/* A link layer with a header of its own, which is not parsed for steering */
+#define FRAMED_L2 FRAMED
+#define FRAMED_L2_CTX_TYPE void*
+
+static struct net_if *framed_iface;
+
+static enum net_verdict framed_l2_recv(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return NET_DROP;
+}
+
+static int framed_l2_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+NET_L2_INIT(FRAMED_L2, framed_l2_recv, framed_l2_send, NULL, NULL);
+
+static struct net_if_api framed_if_api = {
+	.init = test_iface_init,
+};
+
+NET_DEVICE_INIT(rx_flow_framed, "rx_flow_framed", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &framed_if_api,
+		FRAMED_L2, NET_L2_GET_CTX_TYPE(FRAMED_L2), 127);
+
+/* An IPv4 header followed by the UDP ports, the flow id being the source
+ * port, and a sequence number. The dummy L2 has no link layer header.
+ */
+static struct net_pkt *alloc_flow_pkt(struct net_if *iface, uint16_t id,
+				      uint8_t seq, uint16_t frag_offset)
+{
+	struct net_ipv4_hdr hdr = {
+		.vhl = 0x45,
+		.ttl = 64,
+		.proto = IPPROTO_UDP,
+		.src = { 192, 0, 2, 1 },
+		.dst = { 192, 0, 2, 2 },
+	};
+	struct net_pkt *pkt;
+
+	sys_put_be16(frag_offset, hdr.offset);
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(hdr) + 5,
+					   AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Failed to allocate packet");
+
+	zassert_ok(net_pkt_write(pkt, &hdr, sizeof(hdr)));
+	zassert_ok(net_pkt_write_be16(pkt, id));
+	zassert_ok(net_pkt_write_be16(pkt, 4242));
+	zassert_ok(net_pkt_write_u8(pkt, seq));
+
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+ZTEST(net_rx_flow_steering, test_flow_order)
+{
+	k_tid_t threads[FLOW_COUNT];
+	int thread_count = 0;
+
+	for (int seq = 0; seq < SEQ_COUNT; seq++) {
+		for (int id = 0; id < FLOW_COUNT; id++) {
+			zassert_ok(net_recv_data(test_iface,
+						 alloc_flow_pkt(test_iface, id,
+								seq, 0)));
+		}
+	}
+
+	for (int i = 0; i < FLOW_COUNT * SEQ_COUNT; i++) {
+		zassert_ok(k_sem_take(&received_sem, RX_TIMEOUT),
+			   "Packet %d not received", i);
+	}
+
+	zassert_false(out_of_order, "Packets of a flow reordered");
+	zassert_false(moved, "Flow handled by several threads");
+
+	ARRAY_FOR_EACH_PTR(flows, flow) {
+		bool found = false;
+
+		zassert_equal(flow->next_seq, SEQ_COUNT);
+
+		for (int i = 0; i < thread_count; i++) {
+			found |= threads[i] == flow->thread;
+		}
+
+		if (!found) {
+			threads[thread_count++] = flow->thread;
+		}
+	}
+
+	/* 16 flows all hashing to the same of 4 threads is as good as
+	 * impossible.
+	 */
+	zassert_true(thread_count > 1, "All flows handled by one thread");
+	zassert_true(thread_count <= CONFIG_NET_TC_RX_COUNT);
+}
+
+ZTEST(net_rx_flow_steering, test_flow_hash)
+{
+	struct net_pkt *first, *next, *other;
+
+	/* Only the first fragment has the ports, the fragments of a
+	 * datagram must go to the same thread anyway.
+	 */
+	first = alloc_flow_pkt(test_iface, 1, 0, BIT(13));
+	next = alloc_flow_pkt(test_iface, 2, 0, 185);
+	zassert_equal(net_rx_flow2tc(first), net_rx_flow2tc(next),
+		      "Fragments steered to different threads");
+
+	net_pkt_unref(first);
+	net_pkt_unref(next);
+
+	/* Not an IP packet */
+	other = alloc_flow_pkt(test_iface, 3, 0, 0);
+	other->buffer->data[0] = 0U;
+	zassert_equal(net_rx_flow2tc(other), 0, "Non IP packet not on thread 0");
+
+	net_pkt_unref(other);
+}
+
+ZTEST(net_rx_flow_steering, test_flow_hash_framed)
+{
+	/* Frames of a link layer with its own header, like the 802.15.4
+	 * data frames with frame control 0x41, are not hashed even if they
+	 * happen to look like IP packets.
+	 */
+	for (int id = 0; id < FLOW_COUNT; id++) {
+		struct net_pkt *pkt = alloc_flow_pkt(framed_iface, id, 0, 0);
+
+		pkt->buffer->data[0] = 0x41;
+		zassert_equal(net_rx_flow2tc(pkt), 0, "Frame %d hashed", id);
+
+		net_pkt_unref(pkt);
+	}
+}
+
+static void *setup(void)
+{
+	test_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(test_iface, "No dummy iface");
+
+	framed_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(FRAMED));
+	zassert_not_null(framed_iface, "No framed iface");
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_rx_flow_steering, NULL, setup, NULL, NULL, NULL);
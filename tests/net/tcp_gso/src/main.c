@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+#include "tcp_private.h"
+
+#define SRC_PORT 4242
+#define DST_PORT 5001
+#define SEQ      0xfffffc00
+#define MSS      1000
+#define MAX_SEGS 4
+
+#define ETH_HDR_LEN sizeof(struct net_eth_hdr)
+#define IP4_HDR_LEN sizeof(struct net_ipv4_hdr)
+#define IP6_HDR_LEN sizeof(struct net_ipv6_hdr)
+#define TCP_HDR_LEN sizeof(struct net_tcp_hdr)
+
+static struct in_addr my_addr4 = { { { 192, 0, 2, 1 } } };
+static struct in_addr dst_addr4 = { { { 192, 0, 2, 2 } } };
+static struct in_addr my_addr4_tso = { { { 192, 0, 42, 1 } } };
+static struct in_addr dst_addr4_tso = { { { 192, 0, 42, 2 } } };
+static struct in6_addr my_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 1, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr dst_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 1, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static uint8_t payload[MSS * (MAX_SEGS - 1) - 100];
+
+struct frame {
+	uint8_t data[MSS + ETH_HDR_LEN + IP6_HDR_LEN + TCP_HDR_LEN];
+	size_t len;
+	uint16_t gso_size;
+};
+
+static struct frame frames[MAX_SEGS];
+static int frame_count;
+static K_SEM_DEFINE(frame_sem, 0, MAX_SEGS);
+
+struct eth_context {
+	uint8_t mac_addr[6];
+	enum ethernet_hw_caps caps;
+};
+
+static struct eth_context eth_ctx_sw = {
+	.caps = 0,
+};
+
+static struct eth_context eth_ctx_tso = {
+	.caps = ETHERNET_HW_TX_CHKSUM_OFFLOAD | ETHERNET_HW_TCP_SEG_OFFLOAD,
+};
+
+static struct net_if *iface_sw;
+static struct net_if *iface_tso;
+
+static void eth_iface_init(struct net_if *iface)
+{
+	struct eth_context *ctx = net_if_get_device(iface)->data;
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+{
+	struct frame *frame;
+
+	ARG_UNUSED(dev);
+
+	if (frame_count == MAX_SEGS) {
+		return -ENOMEM;
+	}
+
+	/* A TSO frame is only checked up to the payload of the first segment */
+	frame = &frames[frame_count++];
+	frame->len = net_pkt_get_len(pkt);
+	frame->gso_size = net_pkt_gso_size(pkt);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_read(pkt, frame->data, MIN(frame->len, sizeof(frame->data)));
+
+	k_sem_give(&frame_sem);
+
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_caps(const struct device *dev)
+{
+	struct eth_context *ctx = dev->data;
+
+	return ctx->caps;
+}
+
+static const struct ethernet_api eth_api = {
+	.iface_api.init = eth_iface_init,
+	.get_capabilities = eth_caps,
+	.send = eth_tx,
+};
+
+static int eth_init(const struct device *dev)
+{
+	struct eth_context *ctx = dev->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	ctx->mac_addr[0] = 0x00;
+	ctx->mac_addr[1] = 0x00;
+	ctx->mac_addr[2] = 0x5E;
+	ctx->mac_addr[3] = 0x00;
+	ctx->mac_addr[4] = 0x53;
+	ctx->mac_addr[5] = sys_rand8_get();
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_sw_test, "eth_sw_test", eth_init, NULL, &eth_ctx_sw, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_api, NET_ETH_MTU);
+
+ETH_NET_DEVICE_INIT(eth_tso_test, "eth_tso_test", eth_init, NULL, &eth_ctx_tso, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_api, NET_ETH_MTU);
+
+static uint32_t chksum_add(uint32_t sum, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i + 1 < len; i += 2) {
+		sum += sys_get_be16(&data[i]);
+	}
+
+	if (len & 1) {
+		sum += data[len - 1] << 8;
+	}
+
+	return sum;
+}
+
+static uint16_t chksum_fold(uint32_t sum)
+{
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+static struct net_pkt *gso_pkt_create(struct net_if *iface, sa_family_t family,
+				      const void *src, const void *dst, uint8_t flags)
+{
+	struct net_tcp_hdr tcp_hdr = {
+		.src_port = htons(SRC_PORT),
+		.dst_port = htons(DST_PORT),
+		.offset = (TCP_HDR_LEN / 4) << 4,
+		.flags = flags,
+	};
+	struct net_pkt *pkt;
+
+	sys_put_be32(SEQ, tcp_hdr.seq);
+	sys_put_be16(8192, tcp_hdr.wnd);
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(payload), family, IPPROTO_TCP,
+					K_FOREVER);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	if (family == AF_INET) {
+		zassert_ok(net_ipv4_create(pkt, src, dst));
+	} else {
+		zassert_ok(net_ipv6_create(pkt, src, dst));
+	}
+
+	zassert_ok(net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr)));
+	zassert_ok(net_pkt_write(pkt, payload, sizeof(payload)));
+
+	net_pkt_set_gso_size(pkt, MSS);
+	net_pkt_cursor_init(pkt);
+
+	if (family == AF_INET) {
+		zassert_ok(net_ipv4_finalize(pkt, IPPROTO_TCP));
+	} else {
+		zassert_ok(net_ipv6_finalize(pkt, IPPROTO_TCP));
+	}
+
+	return pkt;
+}
+
+/* Check a segment starting at its IP header */
+static void check_segment(const uint8_t *ip, size_t len, sa_family_t family, int idx,
+			  int count, uint8_t flags)
+{
+	size_t ip_len = family == AF_INET ? IP4_HDR_LEN : IP6_HDR_LEN;
+	const struct net_tcp_hdr *tcp_hdr = (const struct net_tcp_hdr *)(ip + ip_len);
+	size_t seg_len = MIN(MSS, sizeof(payload) - idx * MSS);
+	uint8_t seg_flags = flags;
+	uint32_t sum;
+
+	zassert_equal(len, ip_len + TCP_HDR_LEN + seg_len, "Segment %d length", idx);
+
+	if (family == AF_INET) {
+		const struct net_ipv4_hdr *hdr = (const struct net_ipv4_hdr *)ip;
+
+		zassert_equal(ntohs(hdr->len), len, "Segment %d IPv4 length", idx);
+		zassert_equal(chksum_fold(chksum_add(0, ip, IP4_HDR_LEN)), 0xffff,
+			      "Segment %d IPv4 checksum", idx);
+
+		sum = chksum_add(0, hdr->src, 2 * sizeof(struct in_addr));
+	} else {
+		const struct net_ipv6_hdr *hdr = (const struct net_ipv6_hdr *)ip;
+
+		zassert_equal(ntohs(hdr->len), len - IP6_HDR_LEN, "Segment %d IPv6 length", idx);
+
+		sum = chksum_add(0, hdr->src, 2 * sizeof(struct in6_addr));
+	}
+
+	sum += IPPROTO_TCP + TCP_HDR_LEN + seg_len;
+	sum = chksum_add(sum, (const uint8_t *)tcp_hdr, TCP_HDR_LEN + seg_len);
+	zassert_equal(chksum_fold(sum), 0xffff, "Segment %d TCP checksum", idx);
+
+	if (idx < count - 1) {
+		seg_flags &= ~(PSH | FIN);
+	}
+
+	zassert_equal(sys_get_be32(tcp_hdr->seq), (uint32_t)(SEQ + idx * MSS),
+		      "Segment %d sequence number", idx);
+	zassert_equal(tcp_hdr->flags, seg_flags, "Segment %d flags", idx);
+	zassert_mem_equal(tcp_hdr->optdata, &payload[idx * MSS], seg_len,
+			  "Segment %d payload", idx);
+}
+
+static void iface_cb(struct net_if *iface, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return;
+	}
+
+	if (net_if_get_device(iface)->data == &eth_ctx_sw) {
+		iface_sw = iface;
+	} else if (net_if_get_device(iface)->data == &eth_ctx_tso) {
+		iface_tso = iface;
+	}
+}
+
+static void *tcp_gso_setup(void)
+{
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+
+	net_if_foreach(iface_cb, NULL);
+	zassert_not_null(iface_sw, "No interface without TSO");
+	zassert_not_null(iface_tso, "No interface with TSO");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface_sw, &my_addr4, NET_ADDR_MANUAL, 0));
+	zassert_not_null(net_if_ipv4_addr_add(iface_tso, &my_addr4_tso, NET_ADDR_MANUAL, 0));
+
+	return NULL;
+}
+
+static void tcp_gso_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	frame_count = 0;
+	k_sem_reset(&frame_sem);
+}
+
+/**
+ * @brief Test software segmentation of a packet larger than the MTU
+ */
+ZTEST(tcp_gso, test_sw_segmentation)
+{
+	struct net_pkt *pkt;
+	int count = DIV_ROUND_UP(sizeof(payload), MSS);
+
+	pkt = gso_pkt_create(iface_sw, AF_INET, &my_addr4, &dst_addr4, PSH | ACK);
+	zassert_true(net_pkt_get_len(pkt) > net_if_get_mtu(iface_sw),
+		     "GSO packet should exceed the MTU");
+	zassert_ok(net_send_data(pkt));
+
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&frame_sem, K_MSEC(500)), "Segment %d not sent", i);
+	}
+
+	zassert_equal(k_sem_take(&frame_sem, K_MSEC(50)), -EAGAIN, "Too many segments");
+
+	for (int i = 0; i < count; i++) {
+		zassert_equal(frames[i].gso_size, 0, "Segment %d should not be a GSO packet", i);
+		check_segment(frames[i].data + ETH_HDR_LEN, frames[i].len - ETH_HDR_LEN,
+			      AF_INET, i, count, PSH | ACK);
+	}
+}
+
+/**
+ * @brief Test a driver with TSO receiving the packet unsegmented
+ */
+ZTEST(tcp_gso, test_hw_segmentation)
+{
+	struct net_pkt *pkt;
+	size_t len;
+
+	pkt = gso_pkt_create(iface_tso, AF_INET, &my_addr4_tso, &dst_addr4_tso, PSH | ACK);
+	len = net_pkt_get_len(pkt);
+	zassert_ok(net_send_data(pkt));
+
+	zassert_ok(k_sem_take(&frame_sem, K_MSEC(500)), "Packet not sent");
+	zassert_equal(k_sem_take(&frame_sem, K_MSEC(50)), -EAGAIN, "Packet was segmented");
+
+	zassert_equal(frames[0].len, ETH_HDR_LEN + len);
+	zassert_equal(frames[0].gso_size, MSS);
+}
+
+static int collect_segment(struct net_pkt *seg, void *user_data)
+{
+	struct frame *frame;
+
+	ARG_UNUSED(user_data);
+
+	zassert_true(frame_count < MAX_SEGS, "Too many segments");
+
+	frame = &frames[frame_count++];
+	frame->len = net_pkt_get_len(seg);
+
+	net_pkt_cursor_init(seg);
+	zassert_ok(net_pkt_read(seg, frame->data, frame->len));
+
+	return 0;
+}
+
+/**
+ * @brief Test segmenting an IPv6 packet carrying FIN
+ */
+ZTEST(tcp_gso, test_segment_ipv6)
+{
+	struct net_pkt *pkt;
+	int count = DIV_ROUND_UP(sizeof(payload), MSS);
+
+	pkt = gso_pkt_create(iface_sw, AF_INET6, &my_addr6, &dst_addr6, FIN | PSH | ACK);
+	zassert_ok(net_tcp_gso_segment(pkt, collect_segment, NULL));
+	net_pkt_unref(pkt);
+
+	zassert_equal(frame_count, count);
+
+	for (int i = 0; i < count; i++) {
+		check_segment(frames[i].data, frames[i].len, AF_INET6, i, count,
+			      FIN | PSH | ACK);
+	}
+}
+
+ZTEST_SUITE(tcp_gso, NULL, tcp_gso_setup, tcp_gso_before, NULL, NULL);
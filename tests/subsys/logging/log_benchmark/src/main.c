@@ -230,6 +230,74 @@ ZTEST(test_log_benchmark, test_log_message_with_string)
 		cyc / repeat, us / repeat);
 }
 
+#ifdef CONFIG_LOG_RUNTIME_FILTERING
+#define DISABLED_LOG_REPEAT 1000
+
+static uint32_t disabled_log_cycles(void)
+{
+	uint32_t cyc = test_helpers_cycle_get();
+
+	for (int i = 0; i < DISABLED_LOG_REPEAT; i++) {
+		LOG_INF("disabled %d", i);
+		/* Prevent the filter check from being hoisted out of the loop. */
+		compiler_barrier();
+	}
+
+	return (test_helpers_cycle_get() - cyc) / DISABLED_LOG_REPEAT;
+}
+
+static void all_sources_filter_set(uint32_t level)
+{
+	for (uint32_t i = 0; i < log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID); i++) {
+		log_filter_set(NULL, Z_LOG_LOCAL_DOMAIN_ID, (int16_t)i, level);
+	}
+}
+
+/** Measure the cost of a log call filtered out at runtime, both when no
+ * source has the level enabled and when another source has it enabled.
+ */
+ZTEST(test_log_benchmark, test_log_runtime_filtered_out)
+{
+	int src_id = log_source_id_get(STRINGIFY(LOG_MODULE_NAME));
+	int other_id = -1;
+	uint32_t cyc;
+
+	zassert_true(src_id >= 0);
+
+	/* Find another source compiled with info messages */
+	for (uint32_t i = 0; i < log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID); i++) {
+		if (((int)i != src_id) &&
+		    (log_filter_get(NULL, Z_LOG_LOCAL_DOMAIN_ID, (int16_t)i, false) >=
+		     LOG_LEVEL_INF)) {
+			other_id = (int)i;
+			break;
+		}
+	}
+	zassert_true(other_id >= 0, "No other source with info level");
+
+	test_helpers_log_setup();
+	log_backend_enable(&backend, &backend_ctrl_blk, LOG_LEVEL_DBG);
+
+	all_sources_filter_set(LOG_LEVEL_WRN);
+	zassert_false(Z_LOG_RUNTIME_LEVEL_ENABLED(LOG_LEVEL_INF) &&
+		      IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING_SUMMARY));
+	cyc = disabled_log_cycles();
+	PRINT("Filtered out message, level disabled for all sources: %u cycles\n", cyc);
+
+	log_filter_set(NULL, Z_LOG_LOCAL_DOMAIN_ID, other_id, LOG_LEVEL_DBG);
+	zassert_true(Z_LOG_RUNTIME_LEVEL_ENABLED(LOG_LEVEL_INF));
+	cyc = disabled_log_cycles();
+	PRINT("Filtered out message, level enabled for another source: %u cycles\n", cyc);
+
+	zassert_false(test_helpers_log_dropped_pending());
+	zassert_equal(log_buffered_cnt(), 0, "Filtered out messages were stored");
+
+	all_sources_filter_set(LOG_LEVEL_DBG);
+	log_backend_disable(&backend);
+	test_helpers_log_setup();
+}
+#endif /* CONFIG_LOG_RUNTIME_FILTERING */
+
 /*test case main entry*/
 static void *log_benchmark_setup(void)
 {
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/profiling/perf.h>
+#include <zephyr/ztest.h>
+
+#define TEST_FREQUENCY 100
+#define TEST_DURATION_MS 200
+
+/* Return address into test_busy_loop() of the busy function */
+static uintptr_t busy_return_addr;
+
+static void __noinline test_busy_function(int64_t end)
+{
+	while (k_uptime_get() < end) {
+		k_busy_wait(100);
+	}
+
+	busy_return_addr = (uintptr_t)__builtin_return_address(0);
+}
+
+static void __noinline test_busy_loop(void)
+{
+	test_busy_function(k_uptime_get() + TEST_DURATION_MS);
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)perf_stop();
+}
+
+ZTEST(perf, test_invalid_args)
+{
+	zassert_equal(perf_start(0), -EINVAL);
+	zassert_equal(perf_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC + 1), -EINVAL);
+	zassert_equal(perf_stop(), -EALREADY);
+}
+
+ZTEST(perf, test_already_running)
+{
+	zassert_ok(perf_start(TEST_FREQUENCY));
+	zassert_true(perf_is_running());
+	zassert_equal(perf_start(TEST_FREQUENCY), -EALREADY);
+	zassert_ok(perf_stop());
+	zassert_false(perf_is_running());
+}
+
+ZTEST(perf, test_samples)
+{
+	const uintptr_t *buf;
+	size_t samples = 0;
+	size_t len;
+	size_t i = 0;
+
+	zassert_ok(perf_start(TEST_FREQUENCY));
+	test_busy_loop();
+	zassert_ok(perf_stop());
+
+	len = perf_buf_get(&buf);
+	zassert_true(len > 0, "No samples recorded");
+
+	while (i < len) {
+		size_t depth = buf[i];
+
+		zassert_between_inclusive(depth, 1, CONFIG_PROFILING_PERF_MAX_DEPTH,
+					  "Invalid depth %zu at %zu", depth, i);
+		for (size_t j = 1; j <= depth; j++) {
+			zassert_not_equal(buf[i + j], 0);
+		}
+
+		i += depth + 1;
+		samples++;
+	}
+
+	zassert_equal(i, len, "Sample record overruns the buffer");
+	zassert_true(samples <= (TEST_FREQUENCY * TEST_DURATION_MS / MSEC_PER_SEC) + 2,
+		     "Too many samples: %zu", samples);
+}
+
+/*
+ * The samples taken while the test thread is busy must reach the code the
+ * timer interrupted: test_busy_function() or one of its callees, called
+ * from test_busy_loop(). stackcollapse.py resolves the return address into
+ * test_busy_loop(), so the function appears in the folded stacks.
+ */
+ZTEST(perf, test_interrupted_code)
+{
+	const uintptr_t *buf;
+	size_t samples = 0;
+	size_t found = 0;
+	size_t len;
+	size_t i = 0;
+
+	zassert_ok(perf_start(TEST_FREQUENCY));
+	test_busy_loop();
+	zassert_ok(perf_stop());
+
+	len = perf_buf_get(&buf);
+
+	while (i < len) {
+		size_t depth = buf[i];
+
+		for (size_t j = 1; j <= depth; j++) {
+			if (buf[i + j] == busy_return_addr) {
+				found++;
+				break;
+			}
+		}
+
+		i += depth + 1;
+		samples++;
+	}
+
+	zassert_true(samples > 0, "No samples recorded");
+	zassert_true(found * 2 > samples, "Busy function in %zu of %zu samples",
+		     found, samples);
+}
+
+ZTEST_SUITE(perf, NULL, NULL, NULL, after, NULL);
@@ -17,7 +17,7 @@ struct rtio_iodev_test_data {
 	struct k_timer timer;
 
 	/* Queue of requests */
-	struct mpsc io_q;
+	struct rtio_iodev_queue io_q;
 
 	/* Currently executing transaction */
 	struct rtio_iodev_sqe *txn_head;
@@ -40,17 +40,15 @@ static void rtio_iodev_test_next(struct rtio_iodev_test_data *data, bool complet
 		goto out;
 	}
 
-	struct mpsc_node *next = mpsc_pop(&data->io_q);
+	struct rtio_iodev_sqe *next_sqe = rtio_iodev_queue_pop(&data->io_q);
 
 	/* Nothing left to do, cleanup */
-	if (next == NULL) {
+	if (next_sqe == NULL) {
 		data->txn_head = NULL;
 		data->txn_curr = NULL;
 		goto out;
 	}
 
-	struct rtio_iodev_sqe *next_sqe = CONTAINER_OF(next, struct rtio_iodev_sqe, q);
-
 	data->txn_head = next_sqe;
 	data->txn_curr = next_sqe;
 	k_timer_start(&data->timer, K_MSEC(10), K_NO_WAIT);
@@ -111,7 +109,7 @@ static void rtio_iodev_test_submit(struct rtio_iodev_sqe *iodev_sqe)
 	atomic_inc(&data->submit_count);
 
 	/* The only safe operation is enqueuing */
-	mpsc_push(&data->io_q, &iodev_sqe->q);
+	rtio_iodev_queue_push(&data->io_q, iodev_sqe);
 
 	rtio_iodev_test_next(data, false);
 }
@@ -124,7 +122,7 @@ void rtio_iodev_test_init(struct rtio_iodev *test)
 {
 	struct rtio_iodev_test_data *data = test->data;
 
-	mpsc_init(&data->io_q);
+	rtio_iodev_queue_init(&data->io_q);
 	data->txn_head = NULL;
 	data->txn_curr = NULL;
 	k_timer_init(&data->timer, rtio_iodev_timer_fn, NULL);
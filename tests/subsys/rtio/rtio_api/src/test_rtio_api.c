@@ -732,6 +732,114 @@ ZTEST(rtio_api, test_rtio_callback_chaining)
 	test_rtio_callback_chaining_(&r_callback_chaining);
 }
 
+#ifdef CONFIG_RTIO_DEADLINE
+#define DEADLINE_BULK_COUNT 6
+/* Each test iodev op takes 10 ms */
+#define DEADLINE_OP_MS 10
+
+RTIO_DEFINE(r_deadline, DEADLINE_BULK_COUNT + 2, DEADLINE_BULK_COUNT + 2);
+RTIO_IODEV_TEST_DEFINE(iodev_test_deadline);
+
+/**
+ * @brief Test ordering of pending iodev work by deadline and priority
+ *
+ * Ensures a submission with a deadline overtakes low priority bulk work queued
+ * ahead of it on the same iodev, waiting at most for the op in flight, followed
+ * by a high priority submission without a deadline.
+ */
+ZTEST(rtio_api, test_rtio_deadline)
+{
+	uintptr_t bulk[DEADLINE_BULK_COUNT];
+	uintptr_t urgent, high;
+	void *order[DEADLINE_BULK_COUNT + 2];
+	struct rtio_sqe *sqe;
+	struct rtio_cqe cqe;
+	int64_t start, latency = -1;
+
+	rtio_iodev_test_init(&iodev_test_deadline);
+
+	for (int i = 0; i < DEADLINE_BULK_COUNT; i++) {
+		sqe = rtio_sqe_acquire(&r_deadline);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, &iodev_test_deadline, &bulk[i]);
+		sqe->prio = RTIO_PRIO_LOW;
+	}
+	zassert_ok(rtio_submit(&r_deadline, 0));
+
+	sqe = rtio_sqe_acquire(&r_deadline);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, &iodev_test_deadline, &high);
+	sqe->prio = RTIO_PRIO_HIGH;
+
+	sqe = rtio_sqe_acquire(&r_deadline);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, &iodev_test_deadline, &urgent);
+	rtio_sqe_set_deadline(sqe, K_MSEC(3 * DEADLINE_OP_MS));
+
+	start = k_uptime_get();
+	zassert_ok(rtio_submit(&r_deadline, 0));
+
+	for (int i = 0; i < ARRAY_SIZE(order); i++) {
+		zassert_equal(rtio_cqe_copy_out(&r_deadline, &cqe, 1, K_MSEC(100)), 1,
+			      "Expected a completion");
+		zassert_ok(cqe.result, "Result should be ok");
+		order[i] = cqe.userdata;
+		if (cqe.userdata == &urgent) {
+			latency = k_uptime_get() - start;
+		}
+	}
+
+	TC_PRINT("deadline submission completed after %lld ms\n", latency);
+	zassert_true(latency >= 0 && latency < 3 * DEADLINE_OP_MS,
+		     "Deadline submission should only wait for the op in flight");
+
+	zassert_equal_ptr(order[0], &bulk[0], "Op in flight should complete first");
+	zassert_equal_ptr(order[1], &urgent, "Deadline should overtake pending work");
+	zassert_equal_ptr(order[2], &high, "High priority should overtake low priority");
+	for (int i = 1; i < DEADLINE_BULK_COUNT; i++) {
+		zassert_equal_ptr(order[i + 2], &bulk[i], "Equal submissions should keep their order");
+	}
+}
+
+/**
+ * @brief Test deadlines are resolved when queued on the iodev
+ *
+ * Ensures K_NO_WAIT deadlines go first and that a resubmitted entry, as a
+ * multishot one is, gets its deadline from the time it is queued again.
+ */
+ZTEST(rtio_api, test_rtio_deadline_resolve)
+{
+	struct rtio_iodev_queue queue;
+	struct rtio_iodev_sqe a = {0};
+	struct rtio_iodev_sqe b = {0};
+	struct rtio_iodev_sqe c = {0};
+
+	rtio_iodev_queue_init(&queue);
+
+	rtio_sqe_prep_nop(&a.sqe, NULL, NULL);
+	rtio_sqe_set_deadline(&a.sqe, K_MSEC(50));
+	rtio_sqe_prep_nop(&b.sqe, NULL, NULL);
+	rtio_sqe_set_deadline(&b.sqe, K_MSEC(25));
+	rtio_sqe_prep_nop(&c.sqe, NULL, NULL);
+	rtio_sqe_set_deadline(&c.sqe, K_NO_WAIT);
+
+	rtio_iodev_queue_push(&queue, &a);
+	zassert_equal_ptr(rtio_iodev_queue_pop(&queue), &a);
+
+	k_msleep(30);
+
+	/* Queued again 30 ms later, a is now due after b */
+	rtio_iodev_queue_push(&queue, &a);
+	rtio_iodev_queue_push(&queue, &b);
+	rtio_iodev_queue_push(&queue, &c);
+
+	zassert_equal_ptr(rtio_iodev_queue_pop(&queue), &c, "K_NO_WAIT should go first");
+	zassert_equal_ptr(rtio_iodev_queue_pop(&queue), &b, "Stale deadline was used");
+	zassert_equal_ptr(rtio_iodev_queue_pop(&queue), &a);
+	zassert_is_null(rtio_iodev_queue_pop(&queue));
+}
+#endif /* CONFIG_RTIO_DEADLINE */
+
 static void *rtio_api_setup(void)
 {
 #ifdef CONFIG_USERSPACE
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2024 Trackunit Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/sensing/sensing.h>
+#include <zephyr/sensing/sensing_fusion.h>
+
+#define WINDOW_LEN   8
+#define PERIOD_US    2000
+#define DEPTH        32
+#define RUN_TIME_MS  200
+
+struct fusion_result {
+	uint32_t windows;
+	uint64_t last_timestamp;
+	bool spacing_ok;
+	bool values_ok;
+	q31_t first[2][3];
+};
+
+static struct fusion_result result;
+
+static void on_window(struct sensing_fusion *fusion, const struct sensing_fusion_window *window,
+		      void *user_data)
+{
+	struct fusion_result *res = user_data;
+
+	ARG_UNUSED(fusion);
+
+	if (res->windows > 0 &&
+	    window->timestamp != res->last_timestamp + (uint64_t)window->len * window->period_us) {
+		res->spacing_ok = false;
+	}
+
+	if (res->windows == 0) {
+		for (uint8_t i = 0; i < window->num_streams; i++) {
+			memcpy(res->first[i], sensing_fusion_window_get(window, i, 0),
+			       sizeof(res->first[i]));
+		}
+	}
+
+	res->last_timestamp = window->timestamp;
+	res->windows++;
+}
+
+#define RAMP_START 10000
+
+/* Both ramp streams carry 16 per us once their shift is applied */
+static void on_ramp_window(struct sensing_fusion *fusion,
+			   const struct sensing_fusion_window *window, void *user_data)
+{
+	struct fusion_result *res = user_data;
+
+	for (uint16_t i = 0; i < window->len; i++) {
+		q31_t t = window->timestamp + i * window->period_us - RAMP_START;
+
+		for (uint8_t j = 0; j < window->num_streams; j++) {
+			const q31_t *v = sensing_fusion_window_get(window, j, i);
+
+			if (v[0] != (t * 16) >> window->shift[j] ||
+			    v[1] != -((t * 16) >> window->shift[j])) {
+				res->values_ok = false;
+			}
+		}
+	}
+
+	on_window(fusion, window, user_data);
+}
+
+#define GAP_PERIOD_US (1U << 31)
+#define GAP_START     (INT32_MIN + 1)
+#define GAP_END       INT32_MAX
+
+/* Both gap streams go from GAP_START to GAP_END over a window */
+static void on_gap_window(struct sensing_fusion *fusion,
+			  const struct sensing_fusion_window *window, void *user_data)
+{
+	struct fusion_result *res = user_data;
+
+	for (uint16_t i = 0; i < window->len; i++) {
+		q31_t expected = GAP_START + ((int64_t)GAP_END - GAP_START) * i / window->len;
+
+		for (uint8_t j = 0; j < window->num_streams; j++) {
+			if (sensing_fusion_window_get(window, j, i)[0] != expected) {
+				res->values_ok = false;
+			}
+		}
+	}
+
+	on_window(fusion, window, user_data);
+}
+
+SENSING_FUSION_DEFINE(ramp_fusion, 2, DEPTH, WINDOW_LEN, PERIOD_US, on_ramp_window, &result);
+SENSING_FUSION_DEFINE(gap_fusion, 2, DEPTH, WINDOW_LEN, GAP_PERIOD_US, on_gap_window, &result);
+SENSING_FUSION_DEFINE(emul_fusion, 2, DEPTH, WINDOW_LEN, PERIOD_US, on_window, &result);
+
+static void add_reading(struct sensing_fusion *fusion, uint8_t stream, uint64_t timestamp,
+			q31_t v, int8_t shift)
+{
+	struct sensing_sensor_value_3d_q31 value = {
+		.header = {
+			.base_timestamp = timestamp,
+			.reading_count = 1,
+		},
+		.shift = shift,
+		.readings[0] = {
+			.x = v,
+			.y = -v,
+			.z = 0,
+		},
+	};
+
+	zassert_ok(sensing_fusion_add(fusion, stream, &value));
+}
+
+static void sensing_fusion_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&result, 0, sizeof(result));
+	result.spacing_ok = true;
+	result.values_ok = true;
+	sensing_fusion_reset(&ramp_fusion);
+	sensing_fusion_reset(&gap_fusion);
+	sensing_fusion_reset(&emul_fusion);
+}
+
+/**
+ * @brief Test resampling of two streams at different rates
+ *
+ * Both streams carry the same ramp, stream 0 at 1 kHz and stream 1 at 625 Hz,
+ * starting 300 us later and with a larger shift, so every resampled value is
+ * known exactly.
+ */
+ZTEST(sensing_fusion, test_fusion_resample)
+{
+	uint32_t t0 = 0, t1 = 300;
+
+	while (t0 < 200000 || t1 < 200000) {
+		if (t0 <= t1) {
+			add_reading(&ramp_fusion, 0, RAMP_START + t0, t0, 4);
+			t0 += 1000;
+		} else {
+			add_reading(&ramp_fusion, 1, RAMP_START + t1, t1 / 2, 5);
+			t1 += 1600;
+		}
+	}
+
+	/* From 300 us up to the last stream 1 reading at 198700 us, 100 samples */
+	zassert_equal(result.windows, 100 / WINDOW_LEN);
+	zassert_true(result.spacing_ok, "Windows should be back to back");
+	zassert_true(result.values_ok, "Resampled values should follow the ramp");
+	zassert_equal(result.first[0][0], 300);
+	zassert_equal(result.first[1][0], 150);
+	zassert_equal(sensing_fusion_dropped(&ramp_fusion, 0), 0);
+	zassert_equal(sensing_fusion_dropped(&ramp_fusion, 1), 0);
+}
+
+/**
+ * @brief Test a stream stalling while the other keeps reporting
+ */
+ZTEST(sensing_fusion, test_fusion_stalled_stream)
+{
+	for (int i = 0; i < DEPTH + 5; i++) {
+		add_reading(&ramp_fusion, 0, RAMP_START + i * 1000, i * 1000, 4);
+	}
+
+	zassert_equal(result.windows, 0, "No window without every stream");
+	zassert_equal(sensing_fusion_dropped(&ramp_fusion, 0), 5);
+
+	/* Resampling starts at the first time both streams cover */
+	add_reading(&ramp_fusion, 1, RAMP_START + 5000, 2500, 5);
+	add_reading(&ramp_fusion, 1, RAMP_START + 36000, 18000, 5);
+
+	/* From 5000 us up to 36000 us, 16 samples */
+	zassert_equal(result.windows, 16 / WINDOW_LEN);
+	zassert_true(result.values_ok, "Resampled values should follow the ramp");
+
+	zassert_equal(sensing_fusion_add(&ramp_fusion, 2, NULL), -EINVAL);
+}
+
+/**
+ * @brief Test interpolating full scale readings hours apart
+ */
+ZTEST(sensing_fusion, test_fusion_long_gap)
+{
+	const uint64_t gap = (uint64_t)WINDOW_LEN * GAP_PERIOD_US;
+
+	for (uint8_t i = 0; i < 2; i++) {
+		add_reading(&gap_fusion, i, 0, GAP_START, 0);
+		add_reading(&gap_fusion, i, gap, GAP_END, 0);
+	}
+
+	zassert_equal(result.windows, 1);
+	zassert_true(result.values_ok, "Resampled values should follow the readings");
+}
+
+static void on_emul_data(sensing_sensor_handle_t handle, const void *buf, void *context)
+{
+	uint8_t stream = (uint8_t)(uintptr_t)context;
+
+	ARG_UNUSED(handle);
+
+	zassert_ok(sensing_fusion_add(&emul_fusion, stream, buf));
+}
+
+static struct sensing_callback_list emul_cb[2] = {
+	{ .on_data_event = on_emul_data, .context = (void *)0 },
+	{ .on_data_event = on_emul_data, .context = (void *)1 },
+};
+
+static const struct sensing_sensor_info *find_accel(const char *name)
+{
+	const struct sensing_sensor_info *info;
+	int num;
+
+	zassert_ok(sensing_get_sensors(&num, &info));
+
+	for (int i = 0; i < num; i++) {
+		if (info[i].type == SENSING_SENSOR_TYPE_MOTION_ACCELEROMETER_3D &&
+		    strcmp(info[i].name, name) == 0) {
+			return &info[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Test fusing two emulated accelerometers sampled at different rates
+ */
+ZTEST(sensing_fusion, test_fusion_emulated)
+{
+	static const char *const names[] = {"base-accel-gyro", "lid-accel-gyro"};
+	static const uint32_t intervals[] = {1000, 1600};
+	sensing_sensor_handle_t handles[2];
+
+	for (int i = 0; i < 2; i++) {
+		const struct sensing_sensor_info *info = find_accel(names[i]);
+		struct sensing_sensor_config config = {
+			.attri = SENSING_SENSOR_ATTRIBUTE_INTERVAL,
+			.interval = intervals[i],
+		};
+
+		zassert_not_null(info, "%s not found", names[i]);
+		zassert_ok(sensing_open_sensor(info, &emul_cb[i], &handles[i]));
+		zassert_ok(sensing_set_config(handles[i], &config, 1));
+	}
+
+	k_msleep(RUN_TIME_MS);
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(sensing_close_sensor(&handles[i]));
+	}
+	k_msleep(10);
+
+	TC_PRINT("%u windows of %u samples from %u + %u dropped readings\n", result.windows,
+		 WINDOW_LEN, sensing_fusion_dropped(&emul_fusion, 0),
+		 sensing_fusion_dropped(&emul_fusion, 1));
+
+	zassert_true(result.windows >= RUN_TIME_MS * USEC_PER_MSEC / (WINDOW_LEN * PERIOD_US) / 2,
+		     "Too few windows: %u", result.windows);
+	zassert_true(result.spacing_ok, "Windows should be back to back");
+}
+
+ZTEST_SUITE(sensing_fusion, NULL, NULL, sensing_fusion_before, NULL, NULL);